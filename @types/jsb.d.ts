@@ -150,6 +150,13 @@ declare namespace jsb {
     export let onWindowEnter: () => void | undefined;
     export function openURL(url: string): void;
     export function garbageCollect(): void;
+    /**
+     * Starts recording the next `frameCount` frames with the native profiler. Once they are recorded, the trace is
+     * written to `path` as a Chrome trace JSON file in the background, so the file doesn't exist when this returns.
+     * Relative paths are resolved against the writable path. Only available when the engine is built with the profiler.
+     * @returns The path the file will be written to.
+     */
+    export function captureProfilerTrace(path: string, frameCount: number): string;
     enum AudioFormat {
         UNKNOWN,
         SIGNED_8,
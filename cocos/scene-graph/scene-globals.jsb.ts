@@ -170,6 +170,10 @@ export const OctreeInfo: typeof JsbOctreeInfo = jsb.OctreeInfo;
 export type OctreeInfo = JsbOctreeInfo;
 legacyCC.OctreeInfo = OctreeInfo;
 
+// native only, the web renderer has no BVH, so the settings are not serialized with the scene
+export const BVHInfo = jsb.BVHInfo;
+legacyCC.BVHInfo = BVHInfo;
+
 export const LightProbeInfo: typeof JsbLightProbeInfo = jsb.LightProbeInfo;
 export type LightProbeInfo = JsbLightProbeInfo;
 //legacyCC.LightProbeInfo = LightProbeInfo;
@@ -195,6 +199,7 @@ legacyCC.PostSettingsInfo = PostSettingsInfo;
         this._skyboxRef = this.getSkyboxInfo();
         this._fogRef = this.getFogInfo();
         this._octreeRef = this.getOctreeInfo();
+        this._bvhRef = this.getBVHInfo();
         this._lightProbeRef = this.getLightProbeInfo();
         this._skinRef = this.getSkinInfo();
         this._postSettingsRef = this.getPostSettingsInfo();
@@ -272,6 +277,18 @@ legacyCC.PostSettingsInfo = PostSettingsInfo;
         },
     });
 
+    Object.defineProperty(sceneGlobalsProto, 'bvh', {
+        enumerable: true,
+        configurable: true,
+        get() {
+            return this._bvhRef;
+        },
+        set(v) {
+            this._bvhRef = v;
+            this.setBVHInfo(v);
+        },
+    });
+
     Object.defineProperty(sceneGlobalsProto, 'lightProbeInfo', {
         enumerable: true,
         configurable: true,
@@ -23,11 +23,16 @@
 ****************************************************************************/
 
 #include "2d/renderer/Batcher2d.h"
+#include <algorithm>
+#include <cstddef>
 #include "application/ApplicationManager.h"
+#include "base/job-system/JobSystem.h"
 #include "base/TypeDef.h"
 #include "core/Root.h"
 #include "core/scene-graph/Scene.h"
 #include "editor-support/MiddlewareManager.h"
+#include "math/MathUtil.h"
+#include "profiler/Profiler.h"
 #include "renderer/pipeline/Define.h"
 #include "scene/Pass.h"
 
@@ -53,19 +58,11 @@ CC_FORCE_INLINE void fillIndexBuffers(RenderDrawInfo* drawInfo) { // NOLINT(read
     buffer->setIndexOffset(indexOffset);
 }
 
-CC_FORCE_INLINE void fillVertexBuffers(RenderEntity* entity, RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
-    Node* node = entity->getNode();
-    const Mat4& matrix = node->getWorldMatrix();
-    uint8_t stride = drawInfo->getStride();
-    uint32_t size = drawInfo->getVbCount() * stride;
-    float* vbBuffer = drawInfo->getVbBuffer();
-    for (int i = 0; i < size; i += stride) {
-        Render2dLayout* curLayout = drawInfo->getRender2dLayout(i);
-        // make sure that the layout of Vec3 is three consecutive floats
-        static_assert(sizeof(Vec3) == 3 * sizeof(float));
-        // cast to reduce value copy instructions
-        reinterpret_cast<Vec3*>(vbBuffer + i)->transformMat4(curLayout->position, matrix);
-    }
+CC_FORCE_INLINE void fillVertexBuffers(const Mat4& matrix, RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
+    // local positions are the first 3 floats of each vertex in the render 2d buffer
+    static_assert(offsetof(Render2dLayout, position) == 0 && sizeof(Vec3) == 3 * sizeof(float));
+    const auto* local = reinterpret_cast<const float*>(drawInfo->getRender2dLayout(0));
+    MathUtil::transformPoints(matrix.m, local, drawInfo->getVbBuffer(), drawInfo->getStride(), drawInfo->getVbCount());
 }
 
 CC_FORCE_INLINE void setIndexRange(RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
@@ -78,22 +75,36 @@ CC_FORCE_INLINE void setIndexRange(RenderDrawInfo* drawInfo) { // NOLINT(readabi
     }
 }
 
-CC_FORCE_INLINE void fillColor(RenderEntity* entity, RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
-    uint8_t stride = drawInfo->getStride();
-    uint32_t size = drawInfo->getVbCount() * stride;
-    float* vbBuffer = drawInfo->getVbBuffer();
-    Color temp = entity->getColor();
-    
-    uint32_t offset = 0;
-    for (int i = 0; i < size; i += stride) {
-        offset = i + 5;
-        // NOTE: Only support RGBA32F (4 floats) color fomat now.
-        // Spine set 'UIRenderer._useVertexOpacity = true', it uses RGBA32 (4 bytes) color and fills color in Skeleton._updateColor and spine/simple.ts assembler.
-        // So for Spine rendering, it will never go here to fill color.
-        vbBuffer[offset] = static_cast<float>(temp.r) / 255.0F;
-        vbBuffer[offset+1] = static_cast<float>(temp.g) / 255.0F;
-        vbBuffer[offset+2] = static_cast<float>(temp.b) / 255.0F;
-        vbBuffer[offset+3] = entity->getOpacity();
+CC_FORCE_INLINE void fillColor(const Color& color, float opacity, RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
+    // Colors are RGBA32F (4 floats) or, for vfmtPosUvColor4B render data, normalized RGBA8 (1 word).
+    // Spine set 'UIRenderer._useVertexOpacity = true', it fills color in Skeleton._updateColor and spine/simple.ts assembler.
+    // So for Spine rendering, it will never go here to fill color.
+    const UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
+    const UIVertexLayout layout = buffer ? buffer->getVertexLayout() : UIVertexLayout{};
+    fillUIVertexColor(drawInfo->getVbBuffer(), drawInfo->getVbCount(), drawInfo->getStride(),
+                      layout, color, opacity);
+}
+
+// Hashes the state of a draw info the batches generated from it depend on.
+void hashDrawInfo(ccstd::hash_t& version, const RenderDrawInfo* drawInfo) {
+    // the retained draw infos are weak references
+    ccstd::hash_combine(version, drawInfo);
+    ccstd::hash_combine(version, drawInfo->getEnumDrawInfoType());
+    ccstd::hash_combine(version, drawInfo->getIsMeshBuffer());
+    ccstd::hash_combine(version, drawInfo->getDataHash());
+    ccstd::hash_combine(version, drawInfo->getIbCount());
+    ccstd::hash_combine(version, drawInfo->getTexture());
+    ccstd::hash_combine(version, drawInfo->getSampler());
+    const Material* material = drawInfo->getMaterial();
+    ccstd::hash_combine(version, material);
+    if (material) {
+        ccstd::hash_combine(version, material->getHash());
+    }
+    const UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
+    ccstd::hash_combine(version, buffer);
+    if (buffer) {
+        // the batches index from where the preceding root nodes stopped
+        ccstd::hash_combine(version, buffer->getIndexOffset());
     }
 }
 
@@ -124,6 +135,11 @@ Batcher2d::~Batcher2d() { // NOLINT
     for (auto* drawBatch : _batches) {
         delete drawBatch;
     }
+    for (auto& iter : _retainedRoots) {
+        for (auto* drawBatch : iter.second.batches) {
+            delete drawBatch;
+        }
+    }
     _attributes.clear();
 
     if (_maskClearModel != nullptr) {
@@ -143,6 +159,7 @@ ccstd::vector<RecordedRendererInfo> &Batcher2d::getRecordedRendererInfoQueue() {
 }
 
 void Batcher2d::syncMeshBuffersToNative(uint16_t accId, ccstd::vector<UIMeshBuffer*>&& buffers) {
+    clearRetainedBatches();
     _meshBuffersMap[accId] = std::move(buffers);
 }
 
@@ -163,11 +180,44 @@ void Batcher2d::updateDescriptorSet() {
 
 void Batcher2d::syncRootNodesToNative(ccstd::vector<Node*>&& rootNodes) {
     _rootNodeArr = std::move(rootNodes);
+
+    for (auto iter = _retainedRoots.begin(); iter != _retainedRoots.end();) {
+        if (std::find(_rootNodeArr.begin(), _rootNodeArr.end(), iter->first) == _rootNodeArr.end()) {
+            releaseRetainedBatches(iter->second);
+            iter = _retainedRoots.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void Batcher2d::setRetainedModeEnabled(bool enabled) {
+    if (!enabled) {
+        clearRetainedBatches();
+    }
+    _retainedMode = enabled;
 }
 
 void Batcher2d::fillBuffersAndMergeBatches() {
     size_t index = 0;
     for (auto* rootNode : _rootNodeArr) {
+        auto* scene = rootNode->getScene()->getRenderScene();
+        if (_retainedMode) {
+            // Batches never span root nodes, start each one from a clean state so that they only depend on its hierarchy.
+            resetRenderStates();
+            _currHash = 0;
+
+            auto& retained = _retainedRoots[rootNode];
+            if (replayRetainedBatches(retained, rootNode, scene)) {
+                continue;
+            }
+            retained.drawInfos.clear();
+            retained.materials.clear();
+            _recordingRoot = &retained;
+            _walkRetainable = true;
+        }
+        const uint32_t atlasMergedBatchCount = _atlasMergedBatchCount;
+
         // _batches will add by generateBatch
         walk(rootNode, 1, false);
         
@@ -177,15 +227,184 @@ void Batcher2d::fillBuffersAndMergeBatches() {
         
         generateBatch(_currEntity, _currDrawInfo);
 
-        auto* scene = rootNode->getScene()->getRenderScene();
         size_t const count = _batches.size();
         for (size_t i = index; i < count; i++) {
             scene->addBatch(_batches.at(i));
         }
-        index = count;
+        if (_recordingRoot) {
+            _recordingRoot->atlasMergedBatchCount = _atlasMergedBatchCount - atlasMergedBatchCount;
+            retainBatches(*_recordingRoot, index);
+            _recordingRoot = nullptr;
+        }
+        index = _batches.size();
+    }
+
+    flushPendingFills();
+}
+
+void Batcher2d::flushPendingFills() {
+    // vertex data is only read when the buffers are uploaded, so it is filled after the walk
+    constexpr uint32_t FILLS_PER_JOB = 64;
+    const auto count = static_cast<uint32_t>(_pendingFills.size());
+    const auto jobCount = (count + FILLS_PER_JOB - 1) / FILLS_PER_JOB;
+    parallelForEachIndex(jobCount, [this, count](uint32_t job) {
+        const uint32_t end = std::min(count, (job + 1) * FILLS_PER_JOB);
+        for (uint32_t i = job * FILLS_PER_JOB; i < end; ++i) {
+            const auto& fill = _pendingFills[i];
+            if (fill.matrix) {
+                fillVertexBuffers(*fill.matrix, fill.drawInfo);
+            }
+            if (fill.fillColor) {
+                fillColor(fill.color, fill.opacity, fill.drawInfo);
+            }
+        }
+    });
+    _pendingFills.clear();
+}
+
+bool Batcher2d::replayRetainedBatches(RetainedRoot2D& retained, Node* rootNode, scene::RenderScene* scene) {
+    if (!retained.retainable) {
+        retained.version = 0;
+        return false;
+    }
+
+    ccstd::hash_t version = 0;
+    ccstd::hash_combine(version, _stencilManager->getStencilStage());
+    ccstd::hash_combine(version, sorting2DCount > 0);
+    walkRetained(rootNode, 1, false, version);
+    // after the walk, which may pack new textures
+    ccstd::hash_combine(version, _dynamicAtlas.getVersion());
+    if (version != retained.version) {
+        // refilled vertex data stays valid, the batches are regenerated by walk()
+        retained.version = version;
+        return false;
+    }
+
+    // the index buffers are rebuilt every frame
+    for (auto* drawInfo : retained.drawInfos) {
+        fillIndexBuffers(drawInfo);
+        drawInfo->getMeshBuffer()->setDirty(true);
+    }
+    for (auto* material : retained.materials) {
+        for (const auto& pass : *material->getPasses()) {
+            pass->update();
+        }
+    }
+    for (auto* batch : retained.batches) {
+        if (auto* ds = batch->getDescriptorSet()) {
+            ds->forceUpdate();
+        }
+        scene->addBatch(batch);
+    }
+    ++_replayedRootCount;
+    _replayedBatchCount += static_cast<uint32_t>(retained.batches.size());
+    _atlasMergedBatchCount += retained.atlasMergedBatchCount;
+    return true;
+}
+
+void Batcher2d::retainBatches(RetainedRoot2D& retained, size_t first) {
+    releaseRetainedBatches(retained);
+    retained.retainable = _walkRetainable;
+    if (retained.retainable) {
+        // owned by the root from now on, reset() doesn't free them
+        const auto begin = _batches.begin() + static_cast<std::ptrdiff_t>(first);
+        retained.batches.assign(begin, _batches.end());
+        _batches.erase(begin, _batches.end());
+    } else {
+        retained.drawInfos.clear();
+        retained.materials.clear();
+    }
+}
+
+void Batcher2d::walkRetained(Node* node, float parentOpacity, bool parentColorDirty, ccstd::hash_t& version) { // NOLINT(misc-no-recursion)
+    // Same traversal as walk(), it refills dirty vertex data and hashes what the batches are generated from.
+    if (!node->isActiveInHierarchy()) {
+        return;
+    }
+    bool breakWalk = false;
+    auto* entity = static_cast<RenderEntity*>(node->getUserData());
+
+    const bool isCurrentColorDirty = node->_isColorDirty() || parentColorDirty;
+    const float finalOpacity = parentOpacity * node->_getLocalOpacity() * (entity ? entity->getColorAlpha() : 1.F);
+    node->_setFinalOpacity(finalOpacity);
+
+    const bool visible = math::isNotEqualF(finalOpacity, 0);
+    ccstd::hash_combine(version, node);
+    ccstd::hash_combine(version, node->getLayer());
+
+    if (entity) {
+        ccstd::hash_combine(version, entity);
+        ccstd::hash_combine(version, visible);
+        ccstd::hash_combine(version, entity->isEnabled());
+        ccstd::hash_combine(version, entity->getIsMask());
+        ccstd::hash_combine(version, entity->getUseLocal());
+        ccstd::hash_combine(version, entity->getPriority());
+        ccstd::hash_combine(version, entity->getRenderEntityType());
+        if (!visible) {
+            breakWalk = true;
+        } else if (entity->isEnabled()) {
+            if (isCurrentColorDirty) {
+                entity->setOpacity(finalOpacity);
+                entity->setVBColorDirty(true);
+            }
+
+            const uint32_t size = entity->getRenderDrawInfosSize();
+            ccstd::hash_combine(version, size);
+            for (uint32_t i = 0; i < size; i++) {
+                auto* drawInfo = entity->getRenderDrawInfoAt(i);
+                hashDrawInfo(version, drawInfo);
+                if (drawInfo->getEnumDrawInfoType() == RenderDrawInfoType::COMP && !drawInfo->getIsMeshBuffer()) {
+                    fillDrawInfo(entity, drawInfo, node, getAtlasRegion(entity, drawInfo));
+                }
+            }
+            entity->setVBColorDirty(false);
+        }
+
+        if (entity->getRenderEntityType() == RenderEntityType::CROSSED) {
+            breakWalk = true;
+        }
+    }
+
+    if (!breakWalk) {
+        const auto& children = node->getChildren();
+        ccstd::hash_combine(version, children.size());
+        float thisOpacity = (entity && entity->isEnabled()) ? entity->getOpacity() : finalOpacity;
+        for (const auto& child : children) {
+            walkRetained(child, thisOpacity, isCurrentColorDirty, version);
+        }
+    }
+
+    if (isCurrentColorDirty) {
+        node->_setColorDirty(false);
     }
 }
 
+void Batcher2d::releaseDrawInfo(RenderDrawInfo* drawInfo) {
+    _dynamicAtlas.releaseDrawInfo(drawInfo);
+    // another draw info may be allocated at the same address and match the hash, regenerate every root
+    for (auto& iter : _retainedRoots) {
+        auto& retained = iter.second;
+        retained.version = 0;
+        retained.drawInfos.clear();
+        retained.materials.clear();
+    }
+}
+
+void Batcher2d::releaseRetainedBatches(RetainedRoot2D& retained) {
+    for (auto* batch : retained.batches) {
+        batch->clear();
+        _drawBatchPool.free(batch);
+    }
+    retained.batches.clear();
+}
+
+void Batcher2d::clearRetainedBatches() {
+    for (auto& iter : _retainedRoots) {
+        releaseRetainedBatches(iter.second);
+    }
+    _retainedRoots.clear();
+}
+
 void Batcher2d::handleUIRenderer(RenderEntity *entity) { // NOLINT(misc-no-recursion)
     uint32_t size = entity->getRenderDrawInfosSize();
     for (uint32_t i = 0; i < size; i++) {
@@ -305,6 +524,19 @@ CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, Render
         dataHash = 0;
     }
 
+    const ccstd::hash_t sourceHash = dataHash;
+    const DynamicAtlasRegion* region = getAtlasRegion(entity, drawInfo);
+    gfx::Texture* texture = drawInfo->getTexture();
+    if (region) {
+        // Same inputs as the data hash of script, with the page in place of the texture.
+        dataHash = 0;
+        ccstd::hash_combine(dataHash, drawInfo->getMeshBuffer());
+        ccstd::hash_combine(dataHash, entity->getNode()->getLayer());
+        ccstd::hash_combine(dataHash, region->page);
+        ccstd::hash_combine(dataHash, drawInfo->getSampler()->getHash());
+        texture = region->page;
+    }
+
     // may slow
     bool isMask = entity->getIsMask();
     if (isMask) {
@@ -333,39 +565,25 @@ CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, Render
         _currEntity = entity;
         _currDrawInfo = drawInfo;
 
-        _currTexture = drawInfo->getTexture();
+        _currTexture = texture;
         _currSampler = drawInfo->getSampler();
         if (_currSampler == nullptr) {
             _currSamplerHash = 0;
         } else {
             _currSamplerHash = _currSampler->getHash();
         }
+    } else if (sourceHash != _currSourceHash) {
+        // would have broken the batch without the atlas
+        ++_atlasMergedBatchCount;
     }
+    _currSourceHash = sourceHash;
 
     if (!drawInfo->getIsMeshBuffer()) {
-        if (!drawInfo->isVertexPositionInWorld()) {
-            if (node->getChangedFlags() || node->isTransformDirty() || drawInfo->getVertDirty()) {
-                fillVertexBuffers(entity, drawInfo);
-                drawInfo->setVertDirty(false);
-            }
-        }
-
-        if (entity->getVBColorDirty()) {
-            switch (entity->getFillColorType()) {
-                case FillColorType::COLOR: {
-                    fillColor(entity, drawInfo);
-                    break;
-                }
-                case FillColorType::VERTEX: {
-                    // Use vertex color directly, so do nothing here.
-                    break;
-                }
-                default:
-                    break;
-            }
-        }
-
+        fillDrawInfo(entity, drawInfo, node, region);
         fillIndexBuffers(drawInfo);
+        if (_recordingRoot) {
+            _recordingRoot->drawInfos.push_back(drawInfo);
+        }
     }
 
     if (isMask) {
@@ -373,6 +591,38 @@ CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, Render
     }
 }
 
+CC_FORCE_INLINE void Batcher2d::fillDrawInfo(RenderEntity* entity, RenderDrawInfo* drawInfo, Node* node, const DynamicAtlasRegion* region) {
+    if (region || _dynamicAtlas.hasRemappedUVs()) {
+        const UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
+        _dynamicAtlas.remapUVs(drawInfo, region, buffer ? buffer->getVertexLayout() : UIVertexLayout{});
+    }
+
+    const Mat4* matrix = nullptr;
+    if (!drawInfo->isVertexPositionInWorld()) {
+        if (node->getChangedFlags() || node->isTransformDirty() || drawInfo->getVertDirty()) {
+            // resolved here, the world transform is updated lazily and not thread safe
+            matrix = &entity->getNode()->getWorldMatrix();
+            drawInfo->setVertDirty(false);
+        }
+    }
+
+    // With FillColorType::VERTEX the vertex color is used directly, so do nothing here.
+    const bool needFillColor = entity->getVBColorDirty() && entity->getFillColorType() == FillColorType::COLOR;
+
+    if (_parallelFill) {
+        if (matrix || needFillColor) {
+            _pendingFills.push_back({drawInfo, matrix, entity->getColor(), entity->getOpacity(), needFillColor});
+        }
+    } else {
+        if (matrix) {
+            fillVertexBuffers(*matrix, drawInfo);
+        }
+        if (needFillColor) {
+            fillColor(entity->getColor(), entity->getOpacity(), drawInfo);
+        }
+    }
+}
+
 CC_FORCE_INLINE void Batcher2d::handleModelDraw(RenderEntity* entity, RenderDrawInfo* drawInfo) {
     generateBatch(_currEntity, _currDrawInfo);
     resetRenderStates();
@@ -452,6 +702,10 @@ CC_FORCE_INLINE void Batcher2d::handleDrawInfo(RenderEntity* entity, RenderDrawI
     CC_ASSERT(entity);
     CC_ASSERT(drawInfo);
     RenderDrawInfoType drawInfoType = drawInfo->getEnumDrawInfoType();
+    if (drawInfoType != RenderDrawInfoType::COMP || drawInfo->getIsMeshBuffer() || entity->getIsMask() || entity->getUseLocal()) {
+        // their batches depend on per frame state: model transforms, middleware buffers, masks and local transforms
+        _walkRetainable = false;
+    }
 
     switch (drawInfoType) {
         case RenderDrawInfoType::COMP:
@@ -531,6 +785,9 @@ void Batcher2d::generateBatch(RenderEntity* entity, RenderDrawInfo* drawInfo) {
             curdrawBatch->setDescriptorSet(getDescriptorSet(_currTexture, _currSampler, pass->getLocalSetLayout()));
         }
         _batches.push_back(curdrawBatch);
+        if (_recordingRoot) {
+            _recordingRoot->materials.push_back(_currMaterial);
+        }
     }
 }
 
@@ -620,6 +877,9 @@ gfx::DescriptorSet* Batcher2d::getDescriptorSet(gfx::Texture* texture, gfx::Samp
 }
 
 void Batcher2d::releaseDescriptorSetCache(gfx::Texture* texture, gfx::Sampler* sampler) {
+    // retained batches may refer to the released descriptor set
+    clearRetainedBatches();
+    _dynamicAtlas.releaseTexture(texture);
     ccstd::hash_t hash = 2;
     size_t textureHash;
     if (texture != nullptr) {
@@ -642,12 +902,47 @@ bool Batcher2d::initialize() {
 }
 
 void Batcher2d::update() {
+    _dynamicAtlas.update();
     fillBuffersAndMergeBatches();
     resetRenderStates();
+
+    const auto batchCount = static_cast<uint32_t>(_batches.size()) + _replayedBatchCount;
+    CC_PROFILE_RENDER_UPDATE(UIBatches, batchCount);
+    CC_PROFILE_RENDER_UPDATE(UIBatchesWithoutAtlas, batchCount + _atlasMergedBatchCount);
+}
+
+void Batcher2d::setDynamicAtlasEnabled(bool enabled) {
+    _atlasMaterials.clear();
+    if (enabled) {
+        // the builtin sprite shaders only sample the texture at the vertex uvs, custom materials may not
+        for (const char* name : {"ui-sprite-material", "ui-sprite-gray-material"}) {
+            if (auto* material = BuiltinResMgr::getInstance()->get<Material>(ccstd::string(name))) {
+                _atlasMaterials.push_back(material);
+            }
+        }
+    }
+    // draw infos already remapped are moved back to their textures as they are drawn
+    _dynamicAtlas.setEnabled(enabled);
+    clearRetainedBatches();
+}
+
+const DynamicAtlasRegion* Batcher2d::getAtlasRegion(RenderEntity* entity, RenderDrawInfo* drawInfo) {
+    if (!_dynamicAtlas.isEnabled() || drawInfo->getIsMeshBuffer() || entity->getUseLocal()) {
+        return nullptr;
+    }
+    if (std::find(_atlasMaterials.begin(), _atlasMaterials.end(), drawInfo->getMaterial()) == _atlasMaterials.end()) {
+        return nullptr;
+    }
+    const UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
+    if (!buffer) {
+        return nullptr;
+    }
+    return _dynamicAtlas.getRegion(drawInfo->getTexture(), drawInfo->getSampler());
 }
 
 void Batcher2d::uploadBuffers() {
-    if (_batches.empty()) {
+    _dynamicAtlas.flush();
+    if (_batches.empty() && _replayedBatchCount == 0) {
         return;
     }
 
@@ -675,6 +970,9 @@ void Batcher2d::reset() {
         meshRenderData->resetMeshIA();
     }
     _meshRenderDrawInfo.clear();
+    _replayedRootCount = 0;
+    _replayedBatchCount = 0;
+    _atlasMergedBatchCount = 0;
 
     // meshDataArray
     for (auto& map : _meshBuffersMap) {
@@ -693,6 +991,7 @@ void Batcher2d::reset() {
     _currMaterial = nullptr;
     _currTexture = nullptr;
     _currSampler = nullptr;
+    _currSourceHash = 0;
 
     // stencilManager
 }
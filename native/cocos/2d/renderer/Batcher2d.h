@@ -23,6 +23,7 @@
 ****************************************************************************/
 
 #pragma once
+#include "2d/renderer/DynamicAtlasManager.h"
 #include "2d/renderer/RenderDrawInfo.h"
 #include "2d/renderer/RenderEntity.h"
 #include "2d/renderer/UIMeshBuffer.h"
@@ -44,6 +45,30 @@ struct RecordedRendererInfo {
     RenderEntity *renderEntity{nullptr};
 };
 
+// Vertex data of a draw info to refill after the walk.
+struct PendingVertexFill {
+    RenderDrawInfo* drawInfo{nullptr};
+    // null if the positions are up to date
+    const Mat4* matrix{nullptr};
+    Color color;
+    float opacity{1.F};
+    bool fillColor{false};
+};
+
+// Batches of a root node kept across frames by the retained mode.
+struct RetainedRoot2D {
+    // structure and material version of the hierarchy the batches were generated from
+    ccstd::hash_t version{0};
+    bool retainable{false};
+    // owned, returned to the draw batch pool when regenerated
+    ccstd::vector<scene::DrawBatch2D*> batches;
+    // weak reference, in index fill order
+    ccstd::vector<RenderDrawInfo*> drawInfos;
+    // weak reference
+    ccstd::vector<Material*> materials;
+    uint32_t atlasMergedBatchCount{0};
+};
+
 class Batcher2d final {
 public:
     static void setSorting2DCount(int32_t v);
@@ -60,7 +85,21 @@ public:
     void reset();
 
     void syncRootNodesToNative(ccstd::vector<Node*>&& rootNodes);
+    // Fills the positions and colors of dirty draw infos on the job system after the walk.
+    inline void setParallelFillEnabled(bool enabled) { _parallelFill = enabled; }
+    inline bool isParallelFillEnabled() const { return _parallelFill; }
+    // Replays the batches of root nodes whose hierarchy is unchanged, only the vertex data of dirty entities is refilled.
+    void setRetainedModeEnabled(bool enabled);
+    inline bool isRetainedModeEnabled() const { return _retainedMode; }
+    // Number of root nodes replayed since the last reset().
+    inline uint32_t getReplayedRootCount() const { return _replayedRootCount; }
+    // Packs the textures of sprites with the builtin sprite materials into shared pages to batch them together.
+    void setDynamicAtlasEnabled(bool enabled);
+    inline bool isDynamicAtlasEnabled() const { return _dynamicAtlas.isEnabled(); }
+    inline DynamicAtlasManager* getDynamicAtlas() { return &_dynamicAtlas; }
     void releaseDescriptorSetCache(gfx::Texture* texture, gfx::Sampler* sampler);
+    // Drops every reference to a draw info being destroyed.
+    void releaseDrawInfo(RenderDrawInfo* drawInfo);
 
     UIMeshBuffer* getMeshBuffer(uint16_t accId, uint16_t bufferId);
     gfx::Device* getDevice();
@@ -92,6 +131,15 @@ private:
     void handleUIRenderer(RenderEntity *entity);
     int32_t recordUIRenderer(RenderEntity *entity);
     void flushRecordedUIRenderers();
+    void flushPendingFills();
+    void fillDrawInfo(RenderEntity* entity, RenderDrawInfo* drawInfo, Node* node, const DynamicAtlasRegion* region);
+    const DynamicAtlasRegion* getAtlasRegion(RenderEntity* entity, RenderDrawInfo* drawInfo);
+
+    bool replayRetainedBatches(RetainedRoot2D& retained, Node* rootNode, scene::RenderScene* scene);
+    void retainBatches(RetainedRoot2D& retained, size_t first);
+    void walkRetained(Node* node, float parentOpacity, bool parentColorDirty, ccstd::hash_t& version);
+    void releaseRetainedBatches(RetainedRoot2D& retained);
+    void clearRetainedBatches();
 
     StencilManager* _stencilManager{nullptr};
 
@@ -106,6 +154,24 @@ private:
     
     ccstd::vector<RecordedRendererInfo> _recordedRendererInfoQueue;
 
+    bool _parallelFill{false};
+    ccstd::vector<PendingVertexFill> _pendingFills;
+
+    bool _retainedMode{false};
+    bool _walkRetainable{false};
+    uint32_t _replayedRootCount{0};
+    uint32_t _replayedBatchCount{0};
+    // weak reference, the root being walked in retained mode
+    RetainedRoot2D* _recordingRoot{nullptr};
+    ccstd::unordered_map<Node*, RetainedRoot2D> _retainedRoots;
+
+    DynamicAtlasManager _dynamicAtlas;
+    // weak reference, materials whose draws may use the atlas
+    ccstd::vector<Material*> _atlasMaterials;
+    // data hash of the last draw info as sent by script, for counting the batches the atlas merged
+    ccstd::hash_t _currSourceHash{0};
+    uint32_t _atlasMergedBatchCount{0};
+
     // weak reference
     gfx::Device* _device{nullptr}; // use getDevice()
 
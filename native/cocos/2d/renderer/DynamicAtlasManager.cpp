@@ -0,0 +1,424 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "2d/renderer/DynamicAtlasManager.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "2d/renderer/RenderDrawInfo.h"
+#include "base/Log.h"
+#include "base/std/hash/hash.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/gfx-base/GFXQueue.h"
+
+namespace cc {
+
+namespace {
+
+ccstd::hash_t hashUVs(const float *vb, uint32_t stride, uint32_t count, uint32_t uvOffset) {
+    ccstd::hash_t hash = count;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t bits = 0;
+        memcpy(&bits, vb + i * stride + uvOffset, sizeof(bits));
+        ccstd::hash_combine(hash, bits);
+    }
+    return hash;
+}
+
+void transformUVs(float *vb, uint32_t stride, uint32_t count, uint32_t uvOffset, const float scale[2], const float offset[2]) {
+    for (uint32_t i = 0; i < count; ++i) {
+        float *uv = vb + i * stride + uvOffset;
+        uv[0] = uv[0] * scale[0] + offset[0];
+        uv[1] = uv[1] * scale[1] + offset[1];
+    }
+}
+
+} // namespace
+
+AtlasSkyline::AtlasSkyline(uint32_t width, uint32_t height) {
+    reset(width, height);
+}
+
+void AtlasSkyline::reset(uint32_t width, uint32_t height) {
+    _width = width;
+    _height = height;
+    _segments.clear();
+    _segments.push_back({0, 0, width});
+}
+
+bool AtlasSkyline::fits(size_t index, uint32_t width, uint32_t height, uint32_t &y) const {
+    const uint32_t x = _segments[index].x;
+    if (x + width > _width) {
+        return false;
+    }
+    y = 0;
+    uint32_t widthLeft = width;
+    for (size_t i = index; widthLeft > 0; ++i) {
+        const auto &segment = _segments[i];
+        y = std::max(y, segment.y);
+        if (y + height > _height) {
+            return false;
+        }
+        widthLeft -= std::min(widthLeft, segment.width);
+    }
+    return true;
+}
+
+bool AtlasSkyline::insert(uint32_t width, uint32_t height, uint32_t &x, uint32_t &y) {
+    if (width == 0 || height == 0) {
+        return false;
+    }
+
+    size_t bestIndex = _segments.size();
+    uint32_t bestTop = std::numeric_limits<uint32_t>::max();
+    uint32_t bestWidth = std::numeric_limits<uint32_t>::max();
+    for (size_t i = 0; i < _segments.size(); ++i) {
+        uint32_t top = 0;
+        if (!fits(i, width, height, top)) {
+            continue;
+        }
+        // lowest top edge first, then the narrowest segment to waste less room
+        if (top + height < bestTop || (top + height == bestTop && _segments[i].width < bestWidth)) {
+            bestIndex = i;
+            bestTop = top + height;
+            bestWidth = _segments[i].width;
+            x = _segments[i].x;
+            y = top;
+        }
+    }
+    if (bestIndex == _segments.size()) {
+        return false;
+    }
+
+    _segments.insert(_segments.begin() + static_cast<std::ptrdiff_t>(bestIndex), {x, y + height, width});
+
+    // trim the segments now covered by the new one
+    for (size_t i = bestIndex + 1; i < _segments.size();) {
+        const auto &prev = _segments[i - 1];
+        auto &segment = _segments[i];
+        const uint32_t prevEnd = prev.x + prev.width;
+        if (segment.x >= prevEnd) {
+            break;
+        }
+        const uint32_t shrink = prevEnd - segment.x;
+        if (segment.width <= shrink) {
+            _segments.erase(_segments.begin() + static_cast<std::ptrdiff_t>(i));
+            continue;
+        }
+        segment.x += shrink;
+        segment.width -= shrink;
+        break;
+    }
+
+    // merge neighbours of the same height
+    for (size_t i = 1; i < _segments.size();) {
+        if (_segments[i - 1].y == _segments[i].y) {
+            _segments[i - 1].width += _segments[i].width;
+            _segments.erase(_segments.begin() + static_cast<std::ptrdiff_t>(i));
+        } else {
+            ++i;
+        }
+    }
+    return true;
+}
+
+DynamicAtlasManager::~DynamicAtlasManager() {
+    _pendingCopies.clear();
+    _bindings.clear();
+    _entries.clear();
+    _pages.clear();
+    _cmdBuff = nullptr;
+}
+
+void DynamicAtlasManager::setEnabled(bool enabled) {
+    const auto *device = gfx::Device::getInstance();
+    // the copies recorded by flush() are no-ops on GLES2
+    if (enabled && device && device->getGfxAPI() == gfx::API::GLES2) {
+        CC_LOG_WARNING("The 2D dynamic atlas is not supported on GLES2.");
+        enabled = false;
+    }
+    _enabled = enabled;
+}
+
+bool DynamicAtlasManager::isPackable(const gfx::Texture *texture, const gfx::Sampler *sampler) {
+    if (texture == nullptr || sampler == nullptr) {
+        return false;
+    }
+    const auto &info = texture->getInfo();
+    // The pages have no mipmaps, and the copies read the source texture as a transfer source.
+    // Only textures uploaded from memory are packed, render targets change without the atlas knowing.
+    return info.type == gfx::TextureType::TEX2D &&
+           info.format == PAGE_FORMAT &&
+           info.width <= MAX_TEXTURE_SIZE && info.height <= MAX_TEXTURE_SIZE &&
+           info.externalRes == nullptr &&
+           hasAllFlags(info.usage, gfx::TextureUsageBit::TRANSFER_SRC | gfx::TextureUsageBit::TRANSFER_DST) &&
+           sampler->getInfo().mipFilter == gfx::Filter::NONE;
+}
+
+bool DynamicAtlasManager::isCandidate(gfx::Format format, uint32_t width, uint32_t height) const {
+    return _enabled && format == PAGE_FORMAT && width <= MAX_TEXTURE_SIZE && height <= MAX_TEXTURE_SIZE;
+}
+
+const DynamicAtlasRegion *DynamicAtlasManager::getRegion(gfx::Texture *texture, const gfx::Sampler *sampler) {
+    if (!_enabled || !isPackable(texture, sampler)) {
+        return nullptr;
+    }
+
+    auto iter = _entries.find(texture->getObjectID());
+    if (iter != _entries.end()) {
+        iter->second.lastUsedFrame = _frame;
+        _pages[iter->second.region.pageIndex].lastUsedFrame = _frame;
+        return &iter->second.region;
+    }
+
+    Entry entry;
+    for (uint32_t i = 0; i < _pages.size(); ++i) {
+        if (insert(texture, i, entry)) {
+            return &_entries.emplace(texture->getObjectID(), entry).first->second.region;
+        }
+    }
+
+    uint32_t pageIndex = 0;
+    if (_pages.size() < MAX_PAGE_COUNT) {
+        pageIndex = static_cast<uint32_t>(_pages.size());
+        auto &page = _pages.emplace_back();
+        page.texture = gfx::Device::getInstance()->createTexture({
+            gfx::TextureType::TEX2D,
+            gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST,
+            PAGE_FORMAT,
+            PAGE_SIZE,
+            PAGE_SIZE,
+        });
+        page.skyline.reset(PAGE_SIZE, PAGE_SIZE);
+    } else {
+        auto lru = std::min_element(_pages.begin(), _pages.end(), [](const Page &a, const Page &b) {
+            return a.lastUsedFrame < b.lastUsedFrame;
+        });
+        if (lru->lastUsedFrame == _frame) {
+            // every page is drawn this frame, the texture is used as is
+            return nullptr;
+        }
+        pageIndex = static_cast<uint32_t>(lru - _pages.begin());
+        evictPage(pageIndex);
+    }
+
+    if (!insert(texture, pageIndex, entry)) {
+        return nullptr;
+    }
+    return &_entries.emplace(texture->getObjectID(), entry).first->second.region;
+}
+
+bool DynamicAtlasManager::insert(gfx::Texture *texture, uint32_t pageIndex, Entry &entry) {
+    auto &page = _pages[pageIndex];
+    const uint32_t width = texture->getWidth();
+    const uint32_t height = texture->getHeight();
+    uint32_t x = 0;
+    uint32_t y = 0;
+    if (!page.skyline.insert(width + PADDING * 2, height + PADDING * 2, x, y)) {
+        return false;
+    }
+    x += PADDING;
+    y += PADDING;
+
+    auto &region = entry.region;
+    region.page = page.texture;
+    region.pageIndex = pageIndex;
+    region.stamp = ++_stamp;
+    region.uvScale[0] = static_cast<float>(width) / static_cast<float>(PAGE_SIZE);
+    region.uvScale[1] = static_cast<float>(height) / static_cast<float>(PAGE_SIZE);
+    region.uvOffset[0] = static_cast<float>(x) / static_cast<float>(PAGE_SIZE);
+    region.uvOffset[1] = static_cast<float>(y) / static_cast<float>(PAGE_SIZE);
+    entry.x = x;
+    entry.y = y;
+    entry.lastUsedFrame = _frame;
+    page.lastUsedFrame = _frame;
+
+    _pendingCopies.push_back({texture, pageIndex, x, y});
+    ++_version;
+    return true;
+}
+
+void DynamicAtlasManager::evictPage(uint32_t pageIndex) {
+    for (auto iter = _entries.begin(); iter != _entries.end();) {
+        if (iter->second.region.pageIndex == pageIndex) {
+            iter = _entries.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    _pendingCopies.erase(std::remove_if(_pendingCopies.begin(), _pendingCopies.end(), [pageIndex](const PendingCopy &copy) {
+                             return copy.pageIndex == pageIndex;
+                         }),
+                         _pendingCopies.end());
+    auto &page = _pages[pageIndex];
+    page.skyline.reset(PAGE_SIZE, PAGE_SIZE);
+    page.lastUsedFrame = 0;
+    ++_version;
+}
+
+void DynamicAtlasManager::remapUVs(RenderDrawInfo *drawInfo, const DynamicAtlasRegion *region, const UIVertexLayout &layout) {
+    float *vb = drawInfo->getVbBuffer();
+    const uint32_t stride = drawInfo->getStride();
+    const uint32_t count = drawInfo->getVbCount();
+    if (vb == nullptr || count == 0) {
+        return;
+    }
+
+    auto iter = _bindings.find(drawInfo);
+    if (iter != _bindings.end()) {
+        auto &binding = iter->second;
+        // Script rewrites the uvs when the sprite frame changes, only a matching hash means they are still remapped.
+        const bool remapped = binding.vb == vb && binding.vertexCount == count &&
+                              binding.uvHash == hashUVs(vb, stride, count, layout.uvOffset);
+        if (remapped) {
+            if (region && region->stamp == binding.stamp) {
+                return;
+            }
+            const float scale[2]{1.F / binding.uvScale[0], 1.F / binding.uvScale[1]};
+            const float offset[2]{-binding.uvOffset[0] * scale[0], -binding.uvOffset[1] * scale[1]};
+            transformUVs(vb, stride, count, layout.uvOffset, scale, offset);
+        }
+        if (!region) {
+            _bindings.erase(iter);
+            return;
+        }
+    } else if (!region) {
+        return;
+    }
+
+    transformUVs(vb, stride, count, layout.uvOffset, region->uvScale, region->uvOffset);
+    auto &binding = _bindings[drawInfo];
+    binding.vb = vb;
+    binding.vertexCount = count;
+    binding.stamp = region->stamp;
+    std::copy(std::begin(region->uvScale), std::end(region->uvScale), std::begin(binding.uvScale));
+    std::copy(std::begin(region->uvOffset), std::end(region->uvOffset), std::begin(binding.uvOffset));
+    binding.uvHash = hashUVs(vb, stride, count, layout.uvOffset);
+}
+
+void DynamicAtlasManager::updateTexture(gfx::Texture *texture) {
+    if (texture == nullptr) {
+        return;
+    }
+    auto iter = _entries.find(texture->getObjectID());
+    if (iter == _entries.end()) {
+        return;
+    }
+    const bool pending = std::any_of(_pendingCopies.begin(), _pendingCopies.end(), [texture](const PendingCopy &copy) {
+        return copy.source.get() == texture;
+    });
+    if (!pending) {
+        // same place in the page, the uvs already remapped stay valid
+        const auto &entry = iter->second;
+        _pendingCopies.push_back({texture, entry.region.pageIndex, entry.x, entry.y});
+    }
+}
+
+void DynamicAtlasManager::releaseTexture(const gfx::Texture *texture) {
+    if (texture == nullptr) {
+        return;
+    }
+    // the texels stay in the page until it is evicted
+    _entries.erase(texture->getObjectID());
+    _pendingCopies.erase(std::remove_if(_pendingCopies.begin(), _pendingCopies.end(), [texture](const PendingCopy &copy) {
+                             return copy.source.get() == texture;
+                         }),
+                         _pendingCopies.end());
+}
+
+void DynamicAtlasManager::releaseDrawInfo(const RenderDrawInfo *drawInfo) {
+    _bindings.erase(drawInfo);
+}
+
+void DynamicAtlasManager::flush() {
+    if (_pendingCopies.empty()) {
+        return;
+    }
+    auto *device = gfx::Device::getInstance();
+    if (!_cmdBuff) {
+        _cmdBuff = device->createCommandBuffer({device->getQueue(), gfx::CommandBufferType::PRIMARY});
+    }
+
+    // sampled textures move to transfer accesses for the copies and back
+    ccstd::vector<const gfx::Texture *> textures;
+    ccstd::vector<gfx::AccessFlags> prevAccesses;
+    ccstd::vector<gfx::AccessFlags> transferAccesses;
+    auto addTexture = [&](const gfx::Texture *texture, gfx::AccessFlags prevAccess, gfx::AccessFlags transferAccess) {
+        if (std::find(textures.begin(), textures.end(), texture) == textures.end()) {
+            textures.push_back(texture);
+            prevAccesses.push_back(prevAccess);
+            transferAccesses.push_back(transferAccess);
+        }
+    };
+    for (const auto &copy : _pendingCopies) {
+        const auto &page = _pages[copy.pageIndex];
+        addTexture(page.texture, page.initialized ? gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE : gfx::AccessFlagBit::NONE, gfx::AccessFlagBit::TRANSFER_WRITE);
+        addTexture(copy.source, gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE, gfx::AccessFlagBit::TRANSFER_READ);
+    }
+
+    ccstd::vector<gfx::TextureBarrier *> barriers(textures.size());
+    auto transition = [&](bool toTransfer) {
+        for (size_t i = 0; i < textures.size(); ++i) {
+            gfx::TextureBarrierInfo info;
+            info.prevAccesses = toTransfer ? prevAccesses[i] : transferAccesses[i];
+            info.nextAccesses = toTransfer ? transferAccesses[i] : gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE;
+            barriers[i] = device->getTextureBarrier(info);
+        }
+        _cmdBuff->pipelineBarrier(nullptr, nullptr, nullptr, 0, barriers.data(), textures.data(), static_cast<uint32_t>(textures.size()));
+    };
+
+    _cmdBuff->begin();
+    transition(true);
+    for (const auto &copy : _pendingCopies) {
+        const uint32_t width = copy.source->getWidth();
+        const uint32_t height = copy.source->getHeight();
+        // the texture itself, then its outermost texels extruded into the padding
+        gfx::TextureCopy regions[5];
+        regions[0].dstOffset = {static_cast<int32_t>(copy.x), static_cast<int32_t>(copy.y), 0};
+        regions[0].extent = {width, height, 1};
+        regions[1].dstOffset = {static_cast<int32_t>(copy.x) - 1, static_cast<int32_t>(copy.y), 0};
+        regions[1].extent = {1, height, 1};
+        regions[2].srcOffset = {static_cast<int32_t>(width) - 1, 0, 0};
+        regions[2].dstOffset = {static_cast<int32_t>(copy.x + width), static_cast<int32_t>(copy.y), 0};
+        regions[2].extent = {1, height, 1};
+        regions[3].dstOffset = {static_cast<int32_t>(copy.x), static_cast<int32_t>(copy.y) - 1, 0};
+        regions[3].extent = {width, 1, 1};
+        regions[4].srcOffset = {0, static_cast<int32_t>(height) - 1, 0};
+        regions[4].dstOffset = {static_cast<int32_t>(copy.x), static_cast<int32_t>(copy.y + height), 0};
+        regions[4].extent = {width, 1, 1};
+        _cmdBuff->copyTexture(copy.source, _pages[copy.pageIndex].texture, regions, 5);
+    }
+    transition(false);
+    _cmdBuff->end();
+
+    gfx::CommandBuffer *cmdBuff = _cmdBuff;
+    device->getQueue()->submit(&cmdBuff, 1);
+
+    for (const auto &copy : _pendingCopies) {
+        _pages[copy.pageIndex].initialized = true;
+    }
+    _pendingCopies.clear();
+}
+
+} // namespace cc
@@ -0,0 +1,175 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "2d/renderer/UIVertexLayout.h"
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/TypeDef.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "renderer/gfx-base/GFXCommandBuffer.h"
+#include "renderer/gfx-base/GFXTexture.h"
+#include "renderer/gfx-base/states/GFXSampler.h"
+
+namespace cc {
+class RenderDrawInfo;
+
+// Skyline bin packer, each rect goes to the lowest spot along the skyline it fits in.
+class AtlasSkyline final {
+public:
+    AtlasSkyline() = default;
+    AtlasSkyline(uint32_t width, uint32_t height);
+
+    void reset(uint32_t width, uint32_t height);
+    // Returns false if there is no room left for the rect.
+    bool insert(uint32_t width, uint32_t height, uint32_t &x, uint32_t &y);
+
+    inline uint32_t getWidth() const { return _width; }
+    inline uint32_t getHeight() const { return _height; }
+
+private:
+    struct Segment {
+        uint32_t x{0};
+        uint32_t y{0};
+        uint32_t width{0};
+    };
+
+    bool fits(size_t index, uint32_t width, uint32_t height, uint32_t &y) const;
+
+    ccstd::vector<Segment> _segments;
+    uint32_t _width{0};
+    uint32_t _height{0};
+};
+
+// Where a texture is packed, as the transform from its uv space into the page's.
+struct DynamicAtlasRegion {
+    // weak reference
+    gfx::Texture *page{nullptr};
+    uint32_t pageIndex{0};
+    // unique for each time a texture is packed
+    uint32_t stamp{0};
+    float uvScale[2]{1.F, 1.F};
+    float uvOffset[2]{0.F, 0.F};
+};
+
+// Packs small sprite textures into shared pages at first use, so that 2D draws using different textures can be batched.
+// The vertex uvs of the draw infos are remapped in place, pages are evicted least recently used first.
+class DynamicAtlasManager final {
+public:
+    static constexpr uint32_t PAGE_SIZE{2048};
+    static constexpr uint32_t MAX_PAGE_COUNT{4};
+    static constexpr uint32_t MAX_TEXTURE_SIZE{512};
+    // texels around each texture filled with its edges, against bleeding under linear filtering
+    static constexpr uint32_t PADDING{2};
+    static constexpr gfx::Format PAGE_FORMAT{gfx::Format::RGBA8};
+
+    DynamicAtlasManager() = default;
+    ~DynamicAtlasManager();
+
+    static bool isPackable(const gfx::Texture *texture, const gfx::Sampler *sampler);
+    // Whether a texture of this format and size may be packed, it has to be created as a transfer source then.
+    bool isCandidate(gfx::Format format, uint32_t width, uint32_t height) const;
+
+    // Stays disabled on backends which can't copy between textures.
+    // Textures created while disabled are never packed.
+    void setEnabled(bool enabled);
+    inline bool isEnabled() const { return _enabled; }
+
+    // Starts a new frame for the least recently used bookkeeping.
+    inline void update() { ++_frame; }
+    // Packs the texture on first use. Returns null if it isn't packable or every page is in use this frame.
+    const DynamicAtlasRegion *getRegion(gfx::Texture *texture, const gfx::Sampler *sampler);
+    // Moves the uvs of the draw info into the region, or back to its own texture if region is null.
+    void remapUVs(RenderDrawInfo *drawInfo, const DynamicAtlasRegion *region, const UIVertexLayout &layout);
+    inline bool hasRemappedUVs() const { return !_bindings.empty(); }
+
+    // Copies the texture into its region again after its contents are uploaded.
+    void updateTexture(gfx::Texture *texture);
+    // Forgets where the texture is packed, before it is destroyed.
+    void releaseTexture(const gfx::Texture *texture);
+    void releaseDrawInfo(const RenderDrawInfo *drawInfo);
+    // Records and submits the copies of the textures packed since the last flush.
+    void flush();
+
+    // Changes whenever a texture is packed or a page is evicted.
+    inline uint32_t getVersion() const { return _version; }
+    inline uint32_t getPageCount() const { return static_cast<uint32_t>(_pages.size()); }
+    inline uint32_t getPendingCopyCount() const { return static_cast<uint32_t>(_pendingCopies.size()); }
+
+private:
+    struct Page {
+        IntrusivePtr<gfx::Texture> texture;
+        AtlasSkyline skyline;
+        uint32_t lastUsedFrame{0};
+        bool initialized{false};
+    };
+
+    struct Entry {
+        DynamicAtlasRegion region;
+        // texel position in the page
+        uint32_t x{0};
+        uint32_t y{0};
+        uint32_t lastUsedFrame{0};
+    };
+
+    // uv transform last applied to the vertices of a draw info
+    struct Binding {
+        // weak reference
+        float *vb{nullptr};
+        uint32_t vertexCount{0};
+        uint32_t stamp{0};
+        float uvScale[2]{1.F, 1.F};
+        float uvOffset[2]{0.F, 0.F};
+        ccstd::hash_t uvHash{0};
+    };
+
+    struct PendingCopy {
+        // the texture may be destroyed by script before the copy is flushed
+        IntrusivePtr<gfx::Texture> source;
+        uint32_t pageIndex{0};
+        uint32_t x{0};
+        uint32_t y{0};
+    };
+
+    bool insert(gfx::Texture *texture, uint32_t pageIndex, Entry &entry);
+    void evictPage(uint32_t pageIndex);
+
+    bool _enabled{false};
+    uint32_t _frame{0};
+    uint32_t _version{0};
+    uint32_t _stamp{0};
+
+    ccstd::vector<Page> _pages;
+    // keyed by texture object id, so that a recycled texture address can't alias an old entry
+    ccstd::unordered_map<uint32_t, Entry> _entries;
+    ccstd::unordered_map<const RenderDrawInfo *, Binding> _bindings;
+    ccstd::vector<PendingCopy> _pendingCopies;
+    IntrusivePtr<gfx::CommandBuffer> _cmdBuff;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(DynamicAtlasManager);
+};
+
+} // namespace cc
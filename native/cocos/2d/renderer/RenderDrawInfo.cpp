@@ -44,6 +44,10 @@ RenderDrawInfo::RenderDrawInfo() {
 }
 
 RenderDrawInfo::~RenderDrawInfo() {
+    auto* root = Root::getInstance();
+    if (root && root->getBatcher2D()) {
+        root->getBatcher2D()->releaseDrawInfo(this);
+    }
     destroy();
 }
 
@@ -60,7 +64,8 @@ gfx::InputAssembler* RenderDrawInfo::requestIA(gfx::Device* device) {
 void RenderDrawInfo::uploadBuffers() {
     CC_ASSERT(_drawInfoAttrs._isMeshBuffer && _drawInfoAttrs._drawInfoType == RenderDrawInfoType::COMP);
     if (_drawInfoAttrs._vbCount == 0 || _drawInfoAttrs._ibCount == 0) return;
-    uint32_t size = _drawInfoAttrs._vbCount * 9 * sizeof(float); // magic Number
+    const uint32_t stride = getUIVertexLayout(_ia->getAttributes()).stride;
+    uint32_t size = _drawInfoAttrs._vbCount * stride * sizeof(float);
     gfx::Buffer* vBuffer = _ia->getVertexBuffers()[0];
     vBuffer->resize(size);
     vBuffer->update(_vDataBuffer);
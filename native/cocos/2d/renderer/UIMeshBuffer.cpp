@@ -51,6 +51,7 @@ void UIMeshBuffer::setIData(uint16_t* iData) {
 void UIMeshBuffer::initialize(ccstd::vector<gfx::Attribute>&& attrs, bool needCreateLayout) {
     _attributes = attrs;
     _vertexFormatBytes = getAttributesStride(attrs);
+    _vertexLayout = getUIVertexLayout(_attributes);
     if (needCreateLayout) {
         _meshBufferLayout = new MeshBufferLayout();
     }
@@ -107,13 +108,14 @@ void UIMeshBuffer::uploadBuffers() {
         if (byteCount > vBuffer->getSize()) {
             vBuffer->resize(byteCount);
         }
-        vBuffer->update(_vData);
+        // only the filled range, the rest of the buffer is stale
+        vBuffer->update(_vData, byteCount);
     }
     gfx::Buffer* iBuffer = _ia->getIndexBuffer();
     if (indexCount * 2 > iBuffer->getSize()) {
         iBuffer->resize(indexCount * 2);
     }
-    iBuffer->update(_iData);
+    iBuffer->update(_iData, indexCount * 2);
 
     setDirty(false);
 }
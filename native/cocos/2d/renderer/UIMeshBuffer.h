@@ -26,6 +26,7 @@
 #include "base/Ptr.h"
 #include "base/Macros.h"
 #include "base/TypeDef.h"
+#include "2d/renderer/UIVertexLayout.h"
 #include "renderer/gfx-base/GFXInputAssembler.h"
 #include "renderer/gfx-base/GFXDef-common.h"
 #include "renderer/gfx-base/GFXBuffer.h"
@@ -73,6 +74,7 @@ public:
     inline const ccstd::vector<gfx::Attribute>& getAttributes() const {
         return _attributes;
     }
+    inline const UIVertexLayout& getVertexLayout() const { return _vertexLayout; }
 
 protected:
     CC_DISALLOW_COPY_MOVE_ASSIGN(UIMeshBuffer);
@@ -89,6 +91,7 @@ private:
     uint32_t _initIDataCount{0};
 
     ccstd::vector<gfx::Attribute> _attributes;
+    UIVertexLayout _vertexLayout;
     IntrusivePtr<gfx::InputAssembler> _ia;
     IntrusivePtr<gfx::Buffer> _vb;
     IntrusivePtr<gfx::Buffer> _ib;
@@ -0,0 +1,96 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstring>
+#include "base/std/container/vector.h"
+#include "math/Color.h"
+#include "renderer/gfx-base/GFXDef.h"
+
+namespace cc {
+
+// Where colour and uv live inside a 2D vertex, offsets and stride are counted in 4 byte words.
+// Colours are RGBA32F (vfmtPosUvColor) or normalized RGBA8 (vfmtPosUvColor4B), uvs are always RG32F.
+struct UIVertexLayout {
+    uint8_t stride{9};
+    uint8_t uvOffset{3};
+    uint8_t colorOffset{5};
+    gfx::Format colorFormat{gfx::Format::RGBA32F};
+
+    inline bool isPackedColor() const { return colorFormat == gfx::Format::RGBA8; }
+};
+
+inline UIVertexLayout getUIVertexLayout(const ccstd::vector<gfx::Attribute> &attrs) {
+    UIVertexLayout layout;
+    uint32_t offset = 0;
+    for (const auto &attr : attrs) {
+        if (attr.name == gfx::ATTR_NAME_TEX_COORD) {
+            layout.uvOffset = static_cast<uint8_t>(offset / 4);
+        } else if (attr.name == gfx::ATTR_NAME_COLOR) {
+            layout.colorOffset = static_cast<uint8_t>(offset / 4);
+            layout.colorFormat = attr.format;
+        }
+        offset += gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attr.format)].size;
+    }
+    if (offset) {
+        layout.stride = static_cast<uint8_t>(offset / 4);
+    }
+    return layout;
+}
+
+inline uint32_t packUIVertexColor(const Color &color, float opacity) {
+    const auto alpha = static_cast<uint32_t>(opacity * 255.0F + 0.5F);
+    // little endian, r in the lowest byte like gfx::Format::RGBA8
+    return static_cast<uint32_t>(color.r) | (static_cast<uint32_t>(color.g) << 8) |
+           (static_cast<uint32_t>(color.b) << 16) | ((alpha > 255 ? 255 : alpha) << 24);
+}
+
+/**
+ * Writes the same colour to vertexCount vertices. stride is the vertex stride in floats,
+ * it may differ from layout.stride when the vertices carry extra attributes.
+ */
+inline void fillUIVertexColor(float *vb, uint32_t vertexCount, uint32_t stride,
+                              const UIVertexLayout &layout, const Color &color, float opacity) {
+    const uint32_t size = vertexCount * stride;
+    if (layout.isPackedColor()) {
+        const uint32_t packed = packUIVertexColor(color, opacity);
+        for (uint32_t i = layout.colorOffset; i < size; i += stride) {
+            memcpy(vb + i, &packed, sizeof(packed));
+        }
+        return;
+    }
+    const float rgba[4] = {
+        static_cast<float>(color.r) / 255.0F,
+        static_cast<float>(color.g) / 255.0F,
+        static_cast<float>(color.b) / 255.0F,
+        opacity,
+    };
+    for (uint32_t i = layout.colorOffset; i < size; i += stride) {
+        // a single 16 byte store per vertex
+        memcpy(vb + i, rgba, sizeof(rgba));
+    }
+}
+
+} // namespace cc
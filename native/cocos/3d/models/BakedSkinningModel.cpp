@@ -109,25 +109,27 @@ void BakedSkinningModel::updateTransform(uint32_t stamp) {
     }
 }
 
-void BakedSkinningModel::updateUBOs(uint32_t stamp) {
-    Super::updateUBOs(stamp);
+void BakedSkinningModel::prepareUBOs(uint32_t stamp) {
+    Super::prepareUBOs(stamp);
 
-    IAnimInfo &info = _jointMedium.animInfo;
+    const IAnimInfo &info = _jointMedium.animInfo;
     const int idx = _instAnimInfoIdx;
-    const float *curFrame = info.curFrame;
-    bool hasNonInstancingPass = false;
+    if (idx < 0) {
+        return;
+    }
     for (const auto &subModel : _subModels) {
-        if (idx >= 0) {
-            auto &views = subModel->getInstancedAttributeBlock().views[idx];
-            setTypedArrayValue(views, 0, *curFrame);
-        } else {
-            hasNonInstancingPass = true;
-        }
+        auto &views = subModel->getInstancedAttributeBlock().views[idx];
+        setTypedArrayValue(views, 0, *info.curFrame);
     }
+}
+
+void BakedSkinningModel::uploadUBOs(uint32_t stamp) {
+    Super::uploadUBOs(stamp);
 
-    const uint32_t frameDataBytes = info.frameDataBytes;
+    IAnimInfo &info = _jointMedium.animInfo;
+    const bool hasNonInstancingPass = _instAnimInfoIdx < 0 && !_subModels.empty();
     if (hasNonInstancingPass && *info.dirtyForJSB != 0) {
-        info.buffer->update(curFrame, frameDataBytes);
+        info.buffer->update(info.curFrame, info.frameDataBytes);
         *info.dirtyForJSB = 0;
     }
 }
@@ -56,7 +56,8 @@ public:
     ccstd::vector<scene::IMacroPatch> getMacroPatches(index_t subModelIndex) override;
     void updateLocalDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet) override;
     void updateTransform(uint32_t stamp) override;
-    void updateUBOs(uint32_t stamp) override;
+    void prepareUBOs(uint32_t stamp) override;
+    void uploadUBOs(uint32_t stamp) override;
     void updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attributes, scene::SubModel *subModel) override;
     void updateInstancedJointTextureInfo();
     // void                             uploadAnimation(AnimationClip *anim); // TODO(xwx): AnimationClip not define
@@ -23,12 +23,14 @@
 ****************************************************************************/
 #include "3d/models/SkinningModel.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "3d/assets/Mesh.h"
 #include "3d/assets/Skeleton.h"
 #include "core/platform/Debug.h"
 #include "core/scene-graph/Node.h"
+#include "math/MathUtil.h"
 #include "renderer/gfx-base/GFXBuffer.h"
 #include "scene/Pass.h"
 #include "scene/RenderScene.h"
@@ -115,21 +117,29 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
     }
 }
 
+void SkinningModel::updateJointTransforms(uint32_t stamp) {
+    for (JointInfo &jointInfo : _joints) {
+        cc::getWorldMatrix(jointInfo.transform, static_cast<int32_t>(stamp));
+    }
+    _jointTransformStamp = stamp;
+}
+
 void SkinningModel::updateTransform(uint32_t stamp) {
     auto *root = getTransform();
     if (root->getChangedFlags() || root->isTransformDirty()) {
         root->updateWorldTransform();
         _localDataUpdated = true;
     }
+    if (_jointTransformStamp != stamp) {
+        updateJointTransforms(stamp);
+    }
     Vec3 v3Min{INFINITY, INFINITY, INFINITY};
     Vec3 v3Max{-INFINITY, -INFINITY, -INFINITY};
     geometry::AABB ab1;
     Vec3 v31;
     Vec3 v32;
-    for (JointInfo &jointInfo : _joints) {
-        auto &transform = jointInfo.transform;
-        Mat4 worldMatrix = cc::getWorldMatrix(transform, static_cast<int32_t>(stamp));
-        jointInfo.bound->transform(worldMatrix, &ab1);
+    for (const JointInfo &jointInfo : _joints) {
+        jointInfo.bound->transform(jointInfo.transform->world, &ab1);
         ab1.getBoundary(&v31, &v32);
         Vec3::min(v3Min, v31, &v3Min);
         Vec3::max(v3Max, v32, &v3Max);
@@ -141,27 +151,37 @@ void SkinningModel::updateTransform(uint32_t stamp) {
     }
 }
 
-void SkinningModel::updateUBOs(uint32_t stamp) {
-    Super::updateUBOs(stamp);
-    uint32_t bIdx = 0;
-    Mat4 mat4;
+void SkinningModel::prepareUBOs(uint32_t stamp) {
+    Super::prepareUBOs(stamp);
+    float jointData[12];
     for (const JointInfo &jointInfo : _joints) {
-        Mat4::multiply(jointInfo.transform->world, jointInfo.bindpose, &mat4);
-        for (uint32_t buffer : jointInfo.buffers) {
-            uploadJointData(jointInfo.indices[bIdx] * 12, mat4, _dataArray[buffer]);
-            bIdx++;
+        MathUtil::multiplyJointMatrix(jointInfo.transform->world.m, jointInfo.bindpose.m, jointData);
+        for (size_t i = 0; i < jointInfo.buffers.size(); ++i) {
+            const auto buffer = jointInfo.buffers[i];
+            float *dst = _dataArray[buffer] + jointInfo.indices[i] * 12;
+            if (memcmp(dst, jointData, sizeof(jointData)) != 0) {
+                memcpy(dst, jointData, sizeof(jointData));
+                _dirtyBuffers[buffer] = 1;
+            }
         }
-        bIdx = 0;
     }
+}
+
+void SkinningModel::uploadUBOs(uint32_t stamp) {
+    Super::uploadUBOs(stamp);
     if (_realTimeTextureMode) {
         updateRealTimeJointTextureBuffer();
     } else {
-        bIdx = 0;
+        uint32_t bIdx = 0;
         for (gfx::Buffer *buffer : _buffers) {
-            buffer->update(_dataArray[bIdx], buffer->getSize());
+            // buffers whose joints didn't move keep last frame's data
+            if (_dirtyBuffers[bIdx]) {
+                buffer->update(_dataArray[bIdx], buffer->getSize());
+            }
             bIdx++;
         }
     }
+    std::fill(_dirtyBuffers.begin(), _dirtyBuffers.end(), 0);
 }
 
 void SkinningModel::initSubModel(index_t idx, RenderingSubMesh *subMeshData, Material *mat) {
@@ -187,13 +207,6 @@ ccstd::vector<scene::IMacroPatch> SkinningModel::getMacroPatches(index_t subMode
     return myPatches;
 }
 
-void SkinningModel::uploadJointData(uint32_t base, const Mat4 &mat, float *dst) {
-    memcpy(reinterpret_cast<void *>(dst + base), mat.m, sizeof(float) * 12);
-    dst[base + 3] = mat.m[12];
-    dst[base + 7] = mat.m[13];
-    dst[base + 11] = mat.m[14];
-}
-
 void SkinningModel::updateLocalDescriptors(index_t submodelIdx, gfx::DescriptorSet *descriptorset) {
     Super::updateLocalDescriptors(submodelIdx, descriptorset);
     uint32_t idx = _bufferIndices[submodelIdx];
@@ -253,6 +266,7 @@ void SkinningModel::ensureEnoughBuffers(uint32_t count) {
             }
         }
     }
+    _dirtyBuffers.assign(count, 1);
 }
 
 void SkinningModel::initRealTimeJointTexture() {
@@ -307,6 +321,10 @@ void SkinningModel::updateRealTimeJointTextureBuffer() {
     uint32_t width = REALTIME_JOINT_TEXTURE_WIDTH;
     uint32_t height = REALTIME_JOINT_TEXTURE_HEIGHT;
     for (const auto &texture : _realTimeJointTexture->textures) {
+        if (!_dirtyBuffers[bIdx]) {
+            bIdx++;
+            continue;
+        }
         auto *buffer = _realTimeJointTexture->buffer;
         auto *dst = buffer;
         auto *src = _dataArray[bIdx];
@@ -347,6 +365,7 @@ void SkinningModel::releaseData() {
         }
         _dataArray.clear();
     }
+    _dirtyBuffers.clear();
     CC_SAFE_DELETE(_realTimeJointTexture);
     if (!_buffers.empty()) {
         for (gfx::Buffer *buffer : _buffers) {
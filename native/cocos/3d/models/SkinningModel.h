@@ -55,7 +55,8 @@ public:
 
     void updateLocalDescriptors(index_t submodelIdx, gfx::DescriptorSet *descriptorset) override;
     void updateTransform(uint32_t stamp) override;
-    void updateUBOs(uint32_t stamp) override;
+    void prepareUBOs(uint32_t stamp) override;
+    void uploadUBOs(uint32_t stamp) override;
     void destroy() override;
 
     void initSubModel(index_t idx, RenderingSubMesh *subMeshData, Material *mat) override;
@@ -64,8 +65,10 @@ public:
 
     void bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *mesh);
 
+    // Evaluates the joint hierarchy, joint transforms are shared between models so this is not thread safe.
+    void updateJointTransforms(uint32_t stamp);
+
 private:
-    static void uploadJointData(uint32_t base, const Mat4 &mat, float *dst);
     void ensureEnoughBuffers(uint32_t count);
     void updateRealTimeJointTextureBuffer();
     void initRealTimeJointTexture();
@@ -76,6 +79,8 @@ private:
     ccstd::vector<IntrusivePtr<gfx::Buffer>> _buffers;
     ccstd::vector<JointInfo> _joints;
     ccstd::vector<float *> _dataArray;
+    ccstd::vector<uint8_t> _dirtyBuffers; // whether a data array changed since its last upload
+    uint32_t _jointTransformStamp{0xFFFFFFFF};
     bool _realTimeTextureMode = false;
     RealTimeJointTexture *_realTimeJointTexture = nullptr;
 
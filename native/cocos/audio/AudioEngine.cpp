@@ -33,6 +33,7 @@
 #include "base/memory/Memory.h"
 #include "base/std/container/queue.h"
 #include "platform/FileUtils.h"
+#include "profiler/Profiler.h"
 
 #if CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_OPENHARMONY
     // OpenHarmony and Android use the same audio playback module
@@ -117,6 +118,7 @@ public:
 
 private:
     void threadFunc() {
+        CC_PROFILE_THREAD_NAME("AudioWorker");
         while (true) {
             std::function<void()> task = nullptr;
             {
@@ -133,6 +135,7 @@ private:
                 }
             }
 
+            CC_PROFILE(AudioTask);
             task();
         }
     }
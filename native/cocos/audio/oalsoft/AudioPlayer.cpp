@@ -33,6 +33,7 @@
 #include "audio/oalsoft/AudioCache.h"
 #include "base/Log.h"
 #include "base/memory/Memory.h"
+#include "profiler/Profiler.h"
 
 using namespace cc; // NOLINT
 
@@ -218,6 +219,7 @@ bool AudioPlayer::play2d() {
 }
 
 void AudioPlayer::rotateBufferThread(int offsetFrame) {
+    CC_PROFILE_THREAD_NAME("AudioStream");
     char *tmpBuffer = nullptr;
     AudioDecoder *decoder = AudioDecoderManager::createDecoder(_audioCache->_fileFullPath.c_str());
     do {
@@ -0,0 +1,336 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/PixelConvert.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include "base/job-system/JobSystem.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CC_PIXEL_SSE2
+    #include <emmintrin.h>
+    #if defined(__SSSE3__) || defined(__AVX2__)
+        #define CC_PIXEL_SSSE3
+        #include <tmmintrin.h>
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define CC_PIXEL_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace cc {
+namespace pixel {
+
+namespace {
+
+// Images below this size are converted on the calling thread.
+constexpr uint32_t PARALLEL_MIN_PIXELS = 256 * 256;
+constexpr uint32_t PIXELS_PER_JOB = 64 * 1024;
+
+// Rounded c * a / 255.
+inline uint8_t mulDiv255(uint32_t c, uint32_t a) {
+    const uint32_t t = c * a + 128;
+    return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+}
+
+// 255 / a for every alpha, 1 for zero alpha so those pixels keep their colors.
+const float *getUnpremultiplyScales() {
+    static const auto SCALES = [] {
+        std::array<float, 256> scales{};
+        scales[0] = 1.F;
+        for (uint32_t a = 1; a < 256; ++a) {
+            scales[a] = 255.F / static_cast<float>(a);
+        }
+        return scales;
+    }();
+    return SCALES.data();
+}
+
+inline uint8_t unpremultiply(uint8_t c, float scale) {
+    return static_cast<uint8_t>(std::min(255L, std::lrintf(static_cast<float>(c) * scale)));
+}
+
+void expandL8(const uint8_t *src, uint8_t *dst, uint32_t count) {
+    uint32_t i = 0;
+#if defined(CC_PIXEL_SSE2)
+    const __m128i opaque = _mm_set1_epi8(-1);
+    for (; i + 16 <= count; i += 16) {
+        const __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i ggLo = _mm_unpacklo_epi8(g, g);
+        const __m128i gaLo = _mm_unpacklo_epi8(g, opaque);
+        const __m128i ggHi = _mm_unpackhi_epi8(g, g);
+        const __m128i gaHi = _mm_unpackhi_epi8(g, opaque);
+        auto *out = reinterpret_cast<__m128i *>(dst + i * 4);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(ggLo, gaLo));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(ggLo, gaLo));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(ggHi, gaHi));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(ggHi, gaHi));
+    }
+#elif defined(CC_PIXEL_NEON)
+    const uint8x16_t opaque = vdupq_n_u8(255);
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16_t g = vld1q_u8(src + i);
+        vst4q_u8(dst + i * 4, (uint8x16x4_t{{g, g, g, opaque}}));
+    }
+#endif
+    for (; i < count; ++i) {
+        uint8_t *out = dst + i * 4;
+        out[0] = out[1] = out[2] = src[i];
+        out[3] = 255;
+    }
+}
+
+void expandLA8(const uint8_t *src, uint8_t *dst, uint32_t count) {
+    uint32_t i = 0;
+#if defined(CC_PIXEL_SSE2)
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+    for (; i + 8 <= count; i += 8) {
+        const __m128i la = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 2));
+        const __m128i l = _mm_and_si128(la, lowBytes);
+        const __m128i ll = _mm_or_si128(l, _mm_slli_epi16(l, 8));
+        auto *out = reinterpret_cast<__m128i *>(dst + i * 4);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(ll, la));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(ll, la));
+    }
+#elif defined(CC_PIXEL_NEON)
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16x2_t la = vld2q_u8(src + i * 2);
+        vst4q_u8(dst + i * 4, (uint8x16x4_t{{la.val[0], la.val[0], la.val[0], la.val[1]}}));
+    }
+#endif
+    for (; i < count; ++i) {
+        uint8_t *out = dst + i * 4;
+        out[0] = out[1] = out[2] = src[i * 2];
+        out[3] = src[i * 2 + 1];
+    }
+}
+
+void expandRGB8(const uint8_t *src, uint8_t *dst, uint32_t count) {
+    uint32_t i = 0;
+#if defined(CC_PIXEL_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    for (; i + 16 <= count; i += 16) {
+        const auto *in = reinterpret_cast<const __m128i *>(src + i * 3);
+        const __m128i a = _mm_loadu_si128(in);
+        const __m128i b = _mm_loadu_si128(in + 1);
+        const __m128i c = _mm_loadu_si128(in + 2);
+        auto *out = reinterpret_cast<__m128i *>(dst + i * 4);
+        _mm_storeu_si128(out, _mm_or_si128(_mm_shuffle_epi8(a, shuffle), opaque));
+        _mm_storeu_si128(out + 1, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), shuffle), opaque));
+        _mm_storeu_si128(out + 2, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), shuffle), opaque));
+        _mm_storeu_si128(out + 3, _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(c, 4), shuffle), opaque));
+    }
+#elif defined(CC_PIXEL_SSE2)
+    // No byte shuffle in SSE2, move whole pixels with 4 byte loads instead, the last one would read past `src`.
+    for (; i + 1 < count; ++i) {
+        uint32_t pixel;
+        memcpy(&pixel, src + i * 3, 4);
+        pixel |= 0xFF000000;
+        memcpy(dst + i * 4, &pixel, 4);
+    }
+#elif defined(CC_PIXEL_NEON)
+    const uint8x16_t opaque = vdupq_n_u8(255);
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+        vst4q_u8(dst + i * 4, (uint8x16x4_t{{rgb.val[0], rgb.val[1], rgb.val[2], opaque}}));
+    }
+#endif
+    for (; i < count; ++i) {
+        uint8_t *out = dst + i * 4;
+        out[0] = src[i * 3];
+        out[1] = src[i * 3 + 1];
+        out[2] = src[i * 3 + 2];
+        out[3] = 255;
+    }
+}
+
+void swapRB(const uint8_t *src, uint8_t *dst, uint32_t count) {
+    uint32_t i = 0;
+#if defined(CC_PIXEL_SSE2)
+    const __m128i rbMask = _mm_set1_epi32(0x00FF00FF);
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+        const __m128i rb = _mm_and_si128(v, rbMask);
+        const __m128i br = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), _mm_or_si128(_mm_andnot_si128(rbMask, v), br));
+    }
+#elif defined(CC_PIXEL_NEON)
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x4_t v = vld4q_u8(src + i * 4);
+        std::swap(v.val[0], v.val[2]);
+        vst4q_u8(dst + i * 4, v);
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint8_t *in = src + i * 4;
+        uint8_t *out = dst + i * 4;
+        const uint8_t r = in[0];
+        out[0] = in[2];
+        out[1] = in[1];
+        out[2] = r;
+        out[3] = in[3];
+    }
+}
+
+void premultiply(const uint8_t *src, uint8_t *dst, uint32_t count) {
+    uint32_t i = 0;
+#if defined(CC_PIXEL_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alphaScale = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i bias = _mm_set1_epi16(128);
+    // Two pixels in 16 bit lanes, alpha is multiplied by 255 so it comes out unchanged.
+    const auto multiply = [&](__m128i px) {
+        __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(px, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        a = _mm_or_si128(_mm_and_si128(a, colorMask), alphaScale);
+        const __m128i t = _mm_add_epi16(_mm_mullo_epi16(px, a), bias);
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    };
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+        const __m128i lo = multiply(_mm_unpacklo_epi8(v, zero));
+        const __m128i hi = multiply(_mm_unpackhi_epi8(v, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(CC_PIXEL_NEON)
+    // (t + (t >> 8)) >> 8 with t = x + 128, as two rounding shifts.
+    const auto div255 = [](uint16x8_t x) {
+        return vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8);
+    };
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x4_t v = vld4q_u8(src + i * 4);
+        const uint8x8_t aLo = vget_low_u8(v.val[3]);
+        const uint8x8_t aHi = vget_high_u8(v.val[3]);
+        for (uint32_t c = 0; c < 3; ++c) {
+            const uint16x8_t lo = vmull_u8(vget_low_u8(v.val[c]), aLo);
+            const uint16x8_t hi = vmull_u8(vget_high_u8(v.val[c]), aHi);
+            v.val[c] = vcombine_u8(div255(lo), div255(hi));
+        }
+        vst4q_u8(dst + i * 4, v);
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint8_t *in = src + i * 4;
+        uint8_t *out = dst + i * 4;
+        const uint8_t a = in[3];
+        out[0] = mulDiv255(in[0], a);
+        out[1] = mulDiv255(in[1], a);
+        out[2] = mulDiv255(in[2], a);
+        out[3] = a;
+    }
+}
+
+void unpremultiply(const uint8_t *src, uint8_t *dst, uint32_t count) {
+    const float *scales = getUnpremultiplyScales();
+    uint32_t i = 0;
+#if defined(CC_PIXEL_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    // One pixel per float lane group, out of range colors saturate to 255 when packing.
+    const auto scale = [&](__m128i px, const uint8_t *in) {
+        const float s = scales[in[3]];
+        return _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(px), _mm_set_ps(1.F, s, s, s)));
+    };
+    for (; i + 4 <= count; i += 4) {
+        const uint8_t *in = src + i * 4;
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+        const __m128i lo = _mm_unpacklo_epi8(v, zero);
+        const __m128i hi = _mm_unpackhi_epi8(v, zero);
+        const __m128i p0 = scale(_mm_unpacklo_epi16(lo, zero), in);
+        const __m128i p1 = scale(_mm_unpackhi_epi16(lo, zero), in + 4);
+        const __m128i p2 = scale(_mm_unpacklo_epi16(hi, zero), in + 8);
+        const __m128i p3 = scale(_mm_unpackhi_epi16(hi, zero), in + 12);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4),
+                         _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3)));
+    }
+#elif defined(CC_PIXEL_NEON) && defined(__aarch64__)
+    const auto scale = [&](uint16x4_t px, const uint8_t *in) {
+        const float s = scales[in[3]];
+        const float32x4_t f = vmulq_f32(vcvtq_f32_u32(vmovl_u16(px)), float32x4_t{s, s, s, 1.F});
+        return vqmovun_s32(vcvtnq_s32_f32(f));
+    };
+    for (; i + 4 <= count; i += 4) {
+        const uint8_t *in = src + i * 4;
+        const uint8x16_t v = vld1q_u8(in);
+        const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+        const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+        const uint8x8_t outLo = vqmovn_u16(vcombine_u16(scale(vget_low_u16(lo), in), scale(vget_high_u16(lo), in + 4)));
+        const uint8x8_t outHi = vqmovn_u16(vcombine_u16(scale(vget_low_u16(hi), in + 8), scale(vget_high_u16(hi), in + 12)));
+        vst1q_u8(dst + i * 4, vcombine_u8(outLo, outHi));
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint8_t *in = src + i * 4;
+        uint8_t *out = dst + i * 4;
+        const float s = scales[in[3]];
+        out[0] = unpremultiply(in[0], s);
+        out[1] = unpremultiply(in[1], s);
+        out[2] = unpremultiply(in[2], s);
+        out[3] = in[3];
+    }
+}
+
+} // namespace
+
+uint32_t getSourceBytesPerPixel(Conversion conversion) {
+    switch (conversion) {
+        case Conversion::L8_TO_RGBA8: return 1;
+        case Conversion::LA8_TO_RGBA8: return 2;
+        case Conversion::RGB8_TO_RGBA8: return 3;
+        default: return 4;
+    }
+}
+
+void convertPixels(Conversion conversion, const uint8_t *src, uint8_t *dst, uint32_t count) {
+    switch (conversion) {
+        case Conversion::L8_TO_RGBA8: expandL8(src, dst, count); break;
+        case Conversion::LA8_TO_RGBA8: expandLA8(src, dst, count); break;
+        case Conversion::RGB8_TO_RGBA8: expandRGB8(src, dst, count); break;
+        case Conversion::SWAP_RB: swapRB(src, dst, count); break;
+        case Conversion::PREMULTIPLY: premultiply(src, dst, count); break;
+        case Conversion::UNPREMULTIPLY: unpremultiply(src, dst, count); break;
+    }
+}
+
+void convertImage(Conversion conversion, const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t height) {
+    if (width * height < PARALLEL_MIN_PIXELS) {
+        convertPixels(conversion, src, dst, width * height);
+        return;
+    }
+
+    const uint32_t rowsPerJob = std::max(PIXELS_PER_JOB / width, 1U);
+    const uint32_t jobCount = (height + rowsPerJob - 1) / rowsPerJob;
+    const size_t srcStride = static_cast<size_t>(width) * getSourceBytesPerPixel(conversion);
+    const size_t dstStride = static_cast<size_t>(width) * 4;
+    parallelForEachIndex(jobCount, [&](uint32_t job) {
+        const uint32_t row = job * rowsPerJob;
+        const uint32_t rows = std::min(rowsPerJob, height - row);
+        convertPixels(conversion, src + row * srcStride, dst + row * dstStride, rows * width);
+    });
+}
+
+} // namespace pixel
+} // namespace cc
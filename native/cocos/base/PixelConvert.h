@@ -0,0 +1,55 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+
+namespace cc {
+namespace pixel {
+
+enum class Conversion : uint8_t {
+    L8_TO_RGBA8,   // gray to opaque RGBA8
+    LA8_TO_RGBA8,  // gray and alpha to RGBA8
+    RGB8_TO_RGBA8, // RGB8 to opaque RGBA8
+    SWAP_RB,       // RGBA8 to BGRA8 and back
+    PREMULTIPLY,   // RGBA8, multiplies colors by alpha
+    UNPREMULTIPLY, // RGBA8, divides colors by alpha, pixels with zero alpha are left as is
+};
+
+// Bytes per pixel read by `conversion`, every conversion writes 4 bytes per pixel.
+CC_DLL uint32_t getSourceBytesPerPixel(Conversion conversion);
+
+/**
+ * Converts `count` pixels from `src` to `dst` with the SSE2/SSSE3 or NEON kernel available on the target.
+ * SWAP_RB, PREMULTIPLY and UNPREMULTIPLY can run in place with `src` == `dst`, other buffers must not overlap.
+ */
+CC_DLL void convertPixels(Conversion conversion, const uint8_t *src, uint8_t *dst, uint32_t count);
+
+// Same as convertPixels for a tightly packed image, large images are split by rows over the job system.
+CC_DLL void convertImage(Conversion conversion, const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t height);
+
+} // namespace pixel
+} // namespace cc
@@ -49,3 +49,43 @@ using JobGraph = DummyJobGraph;
 using JobSystem = DummyJobSystem;
 } // namespace cc
 #endif
+
+namespace cc {
+
+namespace detail {
+inline bool &isInsideParallelJob() {
+    thread_local bool inside = false;
+    return inside;
+}
+} // namespace detail
+
+/**
+ * @en Runs func(i) for every i in [0, count) on the job system and waits for all of them.
+ * The calling thread runs index 0 itself. Calls made from inside a job run sequentially,
+ * so workers never block waiting on each other.
+ * @zh 在 JobSystem 上并行执行 func(i)，i 属于 [0, count)，并等待全部完成。调用线程执行第 0 项，嵌套调用会顺序执行。
+ */
+template <typename Function>
+void parallelForEachIndex(uint32_t count, const Function &func) {
+    auto *jobSystem = JobSystem::getInstance();
+    if (count < 2 || jobSystem->threadCount() < 2 || detail::isInsideParallelJob()) {
+        for (uint32_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    const auto job = [&func](uint32_t i) {
+        detail::isInsideParallelJob() = true;
+        func(i);
+        detail::isInsideParallelJob() = false;
+    };
+
+    JobGraph g(jobSystem);
+    g.createForEachIndexJob(1U, count, 1U, job);
+    g.run();
+    job(0);
+    g.waitForAll();
+}
+
+} // namespace cc
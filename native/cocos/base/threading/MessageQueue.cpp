@@ -60,7 +60,7 @@ void MessageQueue::MemoryAllocator::recycle(uint8_t *const chunk, bool const fre
     if (freeByUser) {
         _chunkFreeQueue.enqueue(chunk);
     } else {
-        free(chunk);
+        memoryFreeForMultiThread(chunk);
     }
 }
 
@@ -88,7 +88,7 @@ MessageQueue::MemoryAllocator::~MemoryAllocator() noexcept {
 void MessageQueue::MemoryAllocator::destroy() noexcept {
     uint8_t *chunk = nullptr;
     if (_chunkPool.try_dequeue(chunk)) {
-        ::free(chunk);
+        memoryFreeForMultiThread(chunk);
         _chunkCount.fetch_sub(1, std::memory_order_acq_rel);
     }
 }
@@ -27,19 +27,20 @@
 #include <cstdint>
 #include "../memory/Memory.h"
 #include "Event.h"
+#include "ThreadLocalPool.h"
 #include "concurrentqueue/concurrentqueue.h"
 
 namespace cc {
 
-// TODO(YunHsiao): thread-specific allocators
+// memory allocated on one thread and freed on another, served by per-thread size-class pools
 template <typename T>
 inline T *memoryAllocateForMultiThread(uint32_t const count) noexcept {
-    return static_cast<T *>(malloc(sizeof(T) * count));
+    return static_cast<T *>(ThreadLocalPool::allocate(sizeof(T) * count));
 }
 
 template <typename T>
 inline void memoryFreeForMultiThread(T *const p) noexcept {
-    free(p);
+    ThreadLocalPool::deallocate(p);
 }
 
 inline uint32_t constexpr align(uint32_t const val, uint32_t const alignment) noexcept {
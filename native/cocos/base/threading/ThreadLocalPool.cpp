@@ -0,0 +1,299 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "ThreadLocalPool.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include "base/memory/Memory.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+namespace {
+
+struct ThreadCache;
+
+struct alignas(ThreadLocalPool::ALIGNMENT) BlockHeader {
+    ThreadCache *owner; // nullptr for blocks that bypass the caches
+    size_t size;        // size of the block without the header
+};
+
+static_assert(sizeof(BlockHeader) % ThreadLocalPool::ALIGNMENT == 0, "payload must stay aligned");
+
+// free blocks are linked through their payload
+inline BlockHeader *&nextOf(BlockHeader *block) noexcept {
+    return *reinterpret_cast<BlockHeader **>(block + 1);
+}
+
+// class may be padded
+#if (CC_COMPILER == CC_COMPILER_MSVC)
+    #pragma warning(disable : 4324)
+#endif
+
+struct SizeClass {
+    // touched by the owner thread only
+    BlockHeader *localHead{nullptr};
+    uint32_t localCount{0};
+    // pushed by other threads, keep it off the cache line of the local list
+    alignas(64) std::atomic<BlockHeader *> remoteHead{nullptr};
+};
+
+struct ThreadCache {
+    SizeClass sizeClasses[ThreadLocalPool::SIZE_CLASS_COUNT];
+    // bytes in the local lists of all size classes, touched by the owner thread only
+    size_t cachedBytes{0};
+    // written by the owner thread only, read by getStats
+    std::atomic<uint64_t> allocationCount{0};
+    std::atomic<uint64_t> allocatedBytes{0};
+    std::atomic<uint64_t> systemAllocationCount{0};
+    // no thread owns the cache, set between thread exit and adoption by another thread
+    std::atomic<bool> idle{false};
+};
+
+#if (CC_COMPILER == CC_COMPILER_MSVC)
+    #pragma warning(default : 4324)
+#endif
+
+struct Registry {
+    std::mutex mutex;
+    ccstd::vector<ThreadCache *> caches;     // every cache ever created
+    ccstd::vector<ThreadCache *> idleCaches; // caches released by exited threads
+    std::atomic<uint64_t> reservedBytes{0};
+    // allocations not served by any cache
+    std::atomic<uint64_t> bypassAllocationCount{0};
+    std::atomic<uint64_t> bypassAllocatedBytes{0};
+};
+
+Registry &getRegistry() noexcept {
+    // intentionally leaked: blocks may still be released during static destruction,
+    // and other threads may still hold blocks owned by caches of exited threads
+    static auto *registry = new Registry;
+    return *registry;
+}
+
+inline void increase(std::atomic<uint64_t> &counter, uint64_t value) noexcept {
+    // single writer, no need for a locked read-modify-write
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline uint32_t sizeClassOf(size_t size) noexcept {
+    uint32_t log2 = ThreadLocalPool::MIN_BLOCK_SIZE_LOG2;
+    while ((size_t{1} << log2) < size && log2 <= ThreadLocalPool::MAX_BLOCK_SIZE_LOG2) {
+        ++log2;
+    }
+    return log2 - ThreadLocalPool::MIN_BLOCK_SIZE_LOG2;
+}
+
+inline size_t blockSizeOf(uint32_t sizeClass) noexcept {
+    return size_t{1} << (sizeClass + ThreadLocalPool::MIN_BLOCK_SIZE_LOG2);
+}
+
+inline uint32_t maxCachedBlocksOf(uint32_t sizeClass) noexcept {
+    return std::max(static_cast<uint32_t>(ThreadLocalPool::CACHED_BYTES_PER_SIZE_CLASS / blockSizeOf(sizeClass)), ThreadLocalPool::MIN_CACHED_BLOCKS_PER_SIZE_CLASS);
+}
+
+BlockHeader *systemAllocate(size_t size) noexcept {
+    auto *block = static_cast<BlockHeader *>(CC_MALLOC_ALIGN(sizeof(BlockHeader) + size, ThreadLocalPool::ALIGNMENT));
+    CC_ASSERT(block);
+    block->size = size;
+    getRegistry().reservedBytes.fetch_add(sizeof(BlockHeader) + size, std::memory_order_relaxed);
+    return block;
+}
+
+void systemFree(BlockHeader *block) noexcept {
+    getRegistry().reservedBytes.fetch_sub(sizeof(BlockHeader) + block->size, std::memory_order_relaxed);
+    CC_FREE_ALIGN(block);
+}
+
+// called by the owner thread only
+void cacheBlock(ThreadCache *cache, uint32_t index, BlockHeader *block) noexcept {
+    SizeClass &sizeClass = cache->sizeClasses[index];
+    const size_t blockSize = blockSizeOf(index);
+    if (sizeClass.localCount < maxCachedBlocksOf(index) && cache->cachedBytes + blockSize <= ThreadLocalPool::CACHED_BYTES_PER_THREAD) {
+        nextOf(block) = sizeClass.localHead;
+        sizeClass.localHead = block;
+        ++sizeClass.localCount;
+        cache->cachedBytes += blockSize;
+    } else {
+        systemFree(block);
+    }
+}
+
+// called by the owner thread only
+void reclaimRemoteBlocks(ThreadCache *cache, uint32_t index) noexcept {
+    BlockHeader *block = cache->sizeClasses[index].remoteHead.exchange(nullptr, std::memory_order_acquire);
+    while (block) {
+        BlockHeader *next = nextOf(block);
+        cacheBlock(cache, index, block);
+        block = next;
+    }
+}
+
+// called by the owner thread only, before the cache goes idle
+void trimCache(ThreadCache *cache) noexcept {
+    for (auto &sizeClass : cache->sizeClasses) {
+        BlockHeader *block = sizeClass.remoteHead.exchange(nullptr, std::memory_order_acquire);
+        while (block) {
+            BlockHeader *next = nextOf(block);
+            systemFree(block);
+            block = next;
+        }
+        block = sizeClass.localHead;
+        while (block) {
+            BlockHeader *next = nextOf(block);
+            systemFree(block);
+            block = next;
+        }
+        sizeClass.localHead = nullptr;
+        sizeClass.localCount = 0;
+    }
+    cache->cachedBytes = 0;
+}
+
+thread_local ThreadCache *currentCache{nullptr};
+thread_local bool threadExited{false};
+
+struct ThreadCacheHandle {
+    ThreadCache *cache{nullptr};
+
+    ~ThreadCacheHandle() {
+        currentCache = nullptr;
+        threadExited = true;
+        if (!cache) return;
+
+        // blocks still in flight keep pointing to this cache,
+        // so it is handed over to the next thread instead of being deleted
+        cache->idle.store(true, std::memory_order_release);
+        trimCache(cache);
+        auto &registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.idleCaches.push_back(cache);
+    }
+};
+
+thread_local ThreadCacheHandle threadCacheHandle;
+
+ThreadCache *getThreadCache() noexcept {
+    if (currentCache) return currentCache;
+    // thread-local storage is being torn down
+    if (threadExited) return nullptr;
+
+    auto &registry = getRegistry();
+    ThreadCache *cache = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        if (!registry.idleCaches.empty()) {
+            cache = registry.idleCaches.back();
+            registry.idleCaches.pop_back();
+        } else {
+            cache = new ThreadCache;
+            registry.caches.push_back(cache);
+        }
+    }
+    cache->idle.store(false, std::memory_order_release);
+    threadCacheHandle.cache = cache;
+    currentCache = cache;
+    return cache;
+}
+
+} // namespace
+
+void *ThreadLocalPool::allocate(size_t size) noexcept {
+    if (size == 0) return nullptr;
+
+    const uint32_t index = sizeClassOf(size);
+    ThreadCache *cache = index < SIZE_CLASS_COUNT ? getThreadCache() : nullptr;
+    if (!cache) {
+        auto &registry = getRegistry();
+        registry.bypassAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        registry.bypassAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        BlockHeader *block = systemAllocate(size);
+        block->owner = nullptr;
+        return block + 1;
+    }
+
+    SizeClass &sizeClass = cache->sizeClasses[index];
+    if (!sizeClass.localHead) {
+        reclaimRemoteBlocks(cache, index);
+    }
+
+    BlockHeader *block = sizeClass.localHead;
+    if (block) {
+        sizeClass.localHead = nextOf(block);
+        --sizeClass.localCount;
+        cache->cachedBytes -= blockSizeOf(index);
+    } else {
+        block = systemAllocate(blockSizeOf(index));
+        increase(cache->systemAllocationCount, 1);
+    }
+    block->owner = cache;
+
+    increase(cache->allocationCount, 1);
+    increase(cache->allocatedBytes, size);
+    return block + 1;
+}
+
+void ThreadLocalPool::deallocate(const void *ptr) noexcept {
+    if (!ptr) return;
+
+    auto *block = const_cast<BlockHeader *>(static_cast<const BlockHeader *>(ptr) - 1);
+    ThreadCache *owner = block->owner;
+    // blocks of idle caches would linger until another thread adopts the cache
+    if (!owner || (owner != currentCache && owner->idle.load(std::memory_order_acquire))) {
+        systemFree(block);
+        return;
+    }
+
+    const uint32_t index = sizeClassOf(block->size);
+    if (owner == currentCache) {
+        cacheBlock(owner, index, block);
+        return;
+    }
+
+    SizeClass &sizeClass = owner->sizeClasses[index];
+    BlockHeader *head = sizeClass.remoteHead.load(std::memory_order_relaxed);
+    do {
+        nextOf(block) = head;
+    } while (!sizeClass.remoteHead.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+}
+
+ThreadLocalPool::Stats ThreadLocalPool::getStats() noexcept {
+    auto &registry = getRegistry();
+    Stats stats;
+    stats.allocationCount = registry.bypassAllocationCount.load(std::memory_order_relaxed);
+    stats.allocatedBytes = registry.bypassAllocatedBytes.load(std::memory_order_relaxed);
+    stats.systemAllocationCount = stats.allocationCount;
+    stats.reservedBytes = registry.reservedBytes.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto *cache : registry.caches) {
+        stats.allocationCount += cache->allocationCount.load(std::memory_order_relaxed);
+        stats.allocatedBytes += cache->allocatedBytes.load(std::memory_order_relaxed);
+        stats.systemAllocationCount += cache->systemAllocationCount.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+} // namespace cc
@@ -0,0 +1,84 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "base/Macros.h"
+
+namespace cc {
+
+/**
+ * Size-class pools for memory that is allocated on one thread and released on another,
+ * e.g. message queue chunks and the payloads gfx agents hand over to the render thread.
+ *
+ * Every thread owns a cache of free blocks per power-of-two size class. Blocks released
+ * by their owner go straight back into its cache without any synchronization, blocks
+ * released by other threads are pushed onto a lock-free list of the owning cache and
+ * reclaimed by the owner on its next allocation from that size class.
+ * The free memory a cache holds is bounded per size class and per thread.
+ * Requests larger than the biggest size class go to the system allocator directly.
+ */
+class CC_DLL ThreadLocalPool final {
+public:
+    static constexpr size_t ALIGNMENT = 16;
+    static constexpr uint32_t MIN_BLOCK_SIZE_LOG2 = 6;  // 64B
+    static constexpr uint32_t MAX_BLOCK_SIZE_LOG2 = 22; // 4MB
+    static constexpr uint32_t SIZE_CLASS_COUNT = MAX_BLOCK_SIZE_LOG2 - MIN_BLOCK_SIZE_LOG2 + 1;
+    // upper bound of free memory a thread keeps around per size class
+    static constexpr size_t CACHED_BYTES_PER_SIZE_CLASS = 1U * 1024U * 1024U;
+    // so that the biggest size classes can still recycle a block
+    static constexpr uint32_t MIN_CACHED_BLOCKS_PER_SIZE_CLASS = 1;
+    // upper bound of free memory a thread keeps around over all size classes,
+    // blocks released beyond it go back to the system allocator
+    static constexpr size_t CACHED_BYTES_PER_THREAD = 8U * 1024U * 1024U;
+
+    struct Stats {
+        uint64_t allocationCount{0};       // total allocations served
+        uint64_t allocatedBytes{0};        // total bytes requested
+        uint64_t systemAllocationCount{0}; // allocations that had to go to the system allocator
+        uint64_t reservedBytes{0};         // bytes currently held from the system allocator
+    };
+
+    ThreadLocalPool() = delete;
+
+    /**
+     * Returns memory aligned to ALIGNMENT, never nullptr for non-zero sizes.
+     * Safe to call from any thread.
+     */
+    static void *allocate(size_t size) noexcept;
+
+    /**
+     * Releases memory returned by allocate, from any thread.
+     */
+    static void deallocate(const void *ptr) noexcept;
+
+    /**
+     * Totals over all threads, counters are monotonic except reservedBytes.
+     */
+    static Stats getStats() noexcept;
+};
+
+} // namespace cc
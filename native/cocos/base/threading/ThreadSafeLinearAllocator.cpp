@@ -23,6 +23,7 @@
 ****************************************************************************/
 
 #include "ThreadSafeLinearAllocator.h"
+#include "ThreadLocalPool.h"
 #include "acl/core/memory_utils.h"
 #include "base/Macros.h"
 
@@ -30,8 +31,9 @@ namespace cc {
 
 ThreadSafeLinearAllocator::ThreadSafeLinearAllocator(size_t size, size_t alignment) noexcept
 : _capacity(size), _alignment(alignment) {
-    if (alignment == 1) {
-        _buffer = CC_MALLOC(size);
+    // usually filled on one thread and released on another
+    if (alignment <= ThreadLocalPool::ALIGNMENT) {
+        _buffer = ThreadLocalPool::allocate(size);
     } else {
         _buffer = CC_MALLOC_ALIGN(size, alignment);
     }
@@ -39,8 +41,8 @@ ThreadSafeLinearAllocator::ThreadSafeLinearAllocator(size_t size, size_t alignme
 }
 
 ThreadSafeLinearAllocator::~ThreadSafeLinearAllocator() {
-    if (_alignment == 1) {
-        CC_FREE(_buffer);
+    if (_alignment <= ThreadLocalPool::ALIGNMENT) {
+        ThreadLocalPool::deallocate(_buffer);
     } else {
         CC_FREE_ALIGN(_buffer);
     }
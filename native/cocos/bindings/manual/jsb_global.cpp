@@ -33,7 +33,9 @@
 #include "base/ZipUtils.h"
 #include "base/base64.h"
 #include "bindings/auto/jsb_cocos_auto.h"
+#include "bindings/auto/jsb_gfx_auto.h"
 #include "core/data/JSBNativeDataHolder.h"
+#include "core/utils/ImageUtils.h"
 #include "gfx-base/GFXDef.h"
 #include "jsb_conversions.h"
 #include "network/Downloader.h"
@@ -41,6 +43,9 @@
 #include "platform/Image.h"
 #include "platform/interfaces/modules/ISystem.h"
 #include "platform/interfaces/modules/ISystemWindow.h"
+#include "profiler/Profiler.h"
+#include "renderer/core/TextureLoader.h"
+#include "renderer/gfx-base/GFXDevice.h"
 #include "ui/edit-box/EditBox.h"
 #include "xxtea/xxtea.h"
 
@@ -499,40 +504,16 @@ struct ImageInfo {
     ccstd::vector<uint32_t> mipmapLevelDataSize;
 };
 
-uint8_t *convertRGB2RGBA(uint32_t length, uint8_t *src) {
-    auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i] = *src++;
-        dst[i + 1] = *src++;
-        dst[i + 2] = *src++;
-        dst[i + 3] = 255;
-    }
-    return dst;
-}
-
-uint8_t *convertIA2RGBA(uint32_t length, uint8_t *src) {
-    auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i] = *src;
-        dst[i + 1] = *src;
-        dst[i + 2] = *src++;
-        dst[i + 3] = *src++;
-    }
-    return dst;
-}
-
-uint8_t *convertI2RGBA(uint32_t length, uint8_t *src) {
-    auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i] = *src;
-        dst[i + 1] = *src;
-        dst[i + 2] = *src++;
-        dst[i + 3] = 255;
-    }
-    return dst;
-}
-
 struct ImageInfo *createImageInfo(Image *img) {
+    // Convert to RGBA888 because standard web api will return only RGBA888.
+    // PNG/JPEG/WebP decoders already expand rows to RGBA888, this only handles the remaining formats.
+    // If not, then it may have issue in glTexSubImage. For example, engine
+    // will create a big texture, and update its content with small pictures.
+    // The big texture is RGBA888, then the small picture should be the same
+    // format, or it will cause 0x502 error on OpenGL ES 2.
+    const bool converted = !img->isCompressed() && img->getRenderFormat() != cc::gfx::Format::RGBA8;
+    ImageUtils::convert2RGBA(img);
+
     auto *imgInfo = ccnew struct ImageInfo();
     imgInfo->length = static_cast<uint32_t>(img->getDataLen());
     imgInfo->width = img->getWidth();
@@ -541,40 +522,7 @@ struct ImageInfo *createImageInfo(Image *img) {
     imgInfo->format = img->getRenderFormat();
     imgInfo->compressed = img->isCompressed();
     imgInfo->mipmapLevelDataSize = img->getMipmapLevelDataSize();
-
-    // Convert to RGBA888 because standard web api will return only RGBA888.
-    // If not, then it may have issue in glTexSubImage. For example, engine
-    // will create a big texture, and update its content with small pictures.
-    // The big texture is RGBA888, then the small picture should be the same
-    // format, or it will cause 0x502 error on OpenGL ES 2.
-    if (!imgInfo->compressed && imgInfo->format != cc::gfx::Format::RGBA8) {
-        imgInfo->length = img->getWidth() * img->getHeight() * 4;
-        uint8_t *dst = nullptr;
-        uint32_t length = imgInfo->length;
-        uint8_t *src = imgInfo->data;
-        switch (imgInfo->format) {
-            case cc::gfx::Format::A8:
-            case cc::gfx::Format::LA8:
-                dst = convertIA2RGBA(length, src);
-                break;
-            case cc::gfx::Format::L8:
-            case cc::gfx::Format::R8:
-            case cc::gfx::Format::R8I:
-                dst = convertI2RGBA(length, src);
-                break;
-            case cc::gfx::Format::RGB8:
-                dst = convertRGB2RGBA(length, src);
-                break;
-            default:
-                SE_LOGE("unknown image format");
-                break;
-        }
-
-        if (dst != imgInfo->data) free(imgInfo->data);
-        imgInfo->data = dst;
-        imgInfo->hasAlpha = true;
-    }
-
+    imgInfo->hasAlpha = converted;
     return imgInfo;
 }
 } // namespace
@@ -588,21 +536,23 @@ bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackV
 
     std::shared_ptr<se::Value> callbackPtr = std::make_shared<se::Value>(callbackVal);
 
-    auto initImageFunc = [path, callbackPtr](const ccstd::string &fullPath, unsigned char *imageData, int imageBytes) {
+    auto initImageFunc = [path, callbackPtr](const ccstd::string &filePath, unsigned char *imageData, int imageBytes) {
         auto *img = ccnew Image();
+        // Let the decoders write RGBA888 rows instead of converting the whole image afterwards.
+        img->setExpandToRGBA8(cc::gfx::Format::L8, true);
+        img->setExpandToRGBA8(cc::gfx::Format::LA8, true);
+        img->setExpandToRGBA8(cc::gfx::Format::RGB8, true);
 
         gIOThreadPool->pushTask([=](int /*tid*/) {
-            // NOTE: FileUtils::getInstance()->fullPathForFilename isn't a threadsafe method,
-            // Image::initWithImageFile will call fullPathForFilename internally which may
-            // cause thread race issues. Therefore, we get the full path of file before
-            // going into task callback.
-            // Be careful of invoking any Cocos2d-x interface in a sub-thread.
+            // NOTE: FileUtils resolves paths thread-safely, so Image::initWithImageFile resolves
+            // the file on this thread and path lookups don't serialize on the JS thread.
+            // Be careful of invoking any other Cocos2d-x interface in a sub-thread.
             bool loadSucceed = false;
-            if (fullPath.empty()) {
+            if (filePath.empty()) {
                 loadSucceed = img->initWithImageData(imageData, imageBytes);
                 free(imageData);
             } else {
-                loadSucceed = img->initWithImageFile(fullPath);
+                loadSucceed = img->initWithImageFile(filePath);
             }
 
             ImageInfo *imgInfo = nullptr;
@@ -662,17 +612,46 @@ bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackV
         }
         initImageFunc("", imageData, imageBytes);
     } else {
-        ccstd::string fullPath(FileUtils::getInstance()->fullPathForFilename(path));
-        if (0 == path.find("file://")) {
-            fullPath = FileUtils::getInstance()->fullPathForFilename(path.substr(strlen("file://")));
-        }
+        // The worker resolves the path, a missing file is reported through the callback.
+        initImageFunc(0 == path.find("file://") ? path.substr(strlen("file://")) : path, nullptr, 0);
+    }
+    return true;
+}
 
-        if (fullPath.empty()) {
-            SE_REPORT_ERROR("File (%s) doesn't exist!", path.c_str());
-            return false;
+bool jsb_global_load_texture(const ccstd::string &path, const se::Value &callbackVal) { // NOLINT(readability-identifier-naming)
+    std::shared_ptr<se::Value> callbackPtr = std::make_shared<se::Value>(callbackVal);
+    auto filePath = 0 == path.find("file://") ? path.substr(strlen("file://")) : path;
+
+    gIOThreadPool->pushTask([=](int /*tid*/) {
+        // Decoded pixels stay in the format the device samples, they are only copied by the upload.
+        IntrusivePtr<Image> img = TextureLoader::decode(filePath, gfx::Device::getInstance());
+        auto app = CC_CURRENT_APPLICATION();
+        if (!app) {
+            return;
         }
-        initImageFunc(fullPath, nullptr, 0);
-    }
+        auto engine = app->getEngine();
+        CC_ASSERT_NOT_NULL(engine);
+        engine->getScheduler()->performFunctionInCocosThread([=]() {
+            se::AutoHandleScope hs;
+            se::ValueArray seArgs;
+
+            gfx::Texture *texture = img ? TextureLoader::upload(img, gfx::Device::getInstance()) : nullptr;
+            if (texture) {
+                se::HandleObject retObj(se::Object::createPlainObject());
+                se::Value textureVal;
+                native_ptr_to_seval(texture, &textureVal);
+                textureVal.toObject()->getPrivateObject()->tryAllowDestroyInGC();
+                retObj->setProperty("texture", textureVal);
+                retObj->setProperty("width", se::Value(img->getWidth()));
+                retObj->setProperty("height", se::Value(img->getHeight()));
+                retObj->setProperty("format", se::Value(static_cast<uint32_t>(texture->getFormat())));
+                seArgs.push_back(se::Value(retObj));
+            } else {
+                SE_REPORT_ERROR("loadTexture: %s failed!", path.c_str());
+            }
+            callbackPtr->toObject()->call(seArgs, nullptr);
+        });
+    });
     return true;
 }
 
@@ -695,6 +674,26 @@ static bool js_loadImage(se::State &s) { // NOLINT
     return false;
 }
 SE_BIND_FUNC(js_loadImage)
+// path, callback({texture, width, height, format})
+static bool js_loadTexture(se::State &s) { // NOLINT
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 2) {
+        ccstd::string path;
+        ok &= sevalue_to_native(args[0], &path);
+        SE_PRECONDITION2(ok, false, "Error processing arguments");
+
+        const auto &callbackVal = args[1];
+        CC_ASSERT(callbackVal.isObject());
+        CC_ASSERT(callbackVal.toObject()->isFunction());
+
+        return jsb_global_load_texture(path, callbackVal);
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+    return false;
+}
+SE_BIND_FUNC(js_loadTexture)
 // pixels(RGBA), width, height, fullFilePath(*.png/*.jpg)
 static bool js_saveImageData(se::State &s) { // NOLINT
     const auto &args = s.args();
@@ -828,6 +827,33 @@ static bool JSB_setPreferredFramesPerSecond(se::State &s) { // NOLINT
 }
 SE_BIND_FUNC(JSB_setPreferredFramesPerSecond)
 
+#if CC_USE_PROFILER
+static bool JSB_captureProfilerTrace(se::State &s) { // NOLINT
+    const auto &args = s.args();
+    size_t argc = args.size();
+    CC_UNUSED bool ok = true;
+    if (argc == 2) {
+        ccstd::string path;
+        uint32_t frameCount = 0;
+        ok = sevalue_to_native(args[0], &path);
+        SE_PRECONDITION2(ok, false, "path is invalid!");
+        ok = sevalue_to_native(args[1], &frameCount);
+        SE_PRECONDITION2(ok, false, "frameCount is invalid!");
+        auto *fileUtils = FileUtils::getInstance();
+        if (!fileUtils->isAbsolutePath(path)) {
+            path = fileUtils->getWritablePath() + path;
+        }
+        CC_PROFILER->captureTrace(path, frameCount);
+        s.rval().setString(path);
+        return true;
+    }
+
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+    return false;
+}
+SE_BIND_FUNC(JSB_captureProfilerTrace)
+#endif
+
 #if CC_USE_EDITBOX
 static bool JSB_showInputBox(se::State &s) { // NOLINT
     const auto &args = s.args();
@@ -1565,10 +1591,14 @@ bool jsb_register_global_variables(se::Object *global) { // NOLINT
     __jsbObj->defineFunction("dumpNativePtrToSeObjectMap", _SE(jsc_dumpNativePtrToSeObjectMap));
 
     __jsbObj->defineFunction("loadImage", _SE(js_loadImage));
+    __jsbObj->defineFunction("loadTexture", _SE(js_loadTexture));
     __jsbObj->defineFunction("saveImageData", _SE(js_saveImageData));
     __jsbObj->defineFunction("openURL", _SE(JSB_openURL));
     __jsbObj->defineFunction("copyTextToClipboard", _SE(JSB_copyTextToClipboard));
     __jsbObj->defineFunction("setPreferredFramesPerSecond", _SE(JSB_setPreferredFramesPerSecond));
+#if CC_USE_PROFILER
+    __jsbObj->defineFunction("captureProfilerTrace", _SE(JSB_captureProfilerTrace));
+#endif
     __jsbObj->defineFunction("destroyImage", _SE(js_destroyImage));
 
 #if CC_USE_EDITBOX
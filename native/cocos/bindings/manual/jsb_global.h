@@ -81,3 +81,4 @@ bool jsb_run_script(const ccstd::string &filePath, se::Value *rval = nullptr);
 bool jsb_run_script_module(const ccstd::string &filePath, se::Value *rval = nullptr); // NOLINT(readability-identifier-naming)
 
 bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackVal); // NOLINT(readability-identifier-naming)
+bool jsb_global_load_texture(const ccstd::string &path, const se::Value &callbackVal); // NOLINT(readability-identifier-naming)
@@ -49,6 +49,43 @@ static bool JSB_getOrCreatePipelineState(se::State &s) { // NOLINT(readability-i
 }
 SE_BIND_FUNC(JSB_getOrCreatePipelineState);
 
+static bool JSB_setPipelineStateManifestEnabled(se::State &s) { // NOLINT(readability-identifier-naming)
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        cc::pipeline::PipelineStateManager::setManifestEnabled(args[0].toBoolean());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(JSB_setPipelineStateManifestEnabled);
+
+static bool JSB_warmUpPipelineStates(se::State &s) { // NOLINT(readability-identifier-naming)
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        auto remaining = cc::pipeline::PipelineStateManager::warmUp(args[0].toUint32());
+        s.rval().setUint32(remaining);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(JSB_warmUpPipelineStates);
+
+static bool JSB_setPipelineStateCreationBudget(se::State &s) { // NOLINT(readability-identifier-naming)
+    const auto &args = s.args();
+    size_t argc = args.size();
+    if (argc == 1) {
+        cc::pipeline::PipelineStateManager::setCreationBudget(args[0].toUint32());
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(JSB_setPipelineStateCreationBudget);
+
 bool register_all_pipeline_manual(se::Object *obj) { // NOLINT(readability-identifier-naming)
     // Get the ns
     se::Value nrVal;
@@ -64,6 +101,9 @@ bool register_all_pipeline_manual(se::Object *obj) { // NOLINT(readability-ident
     psmVal.setObject(jsobj);
     nr->setProperty("PipelineStateManager", psmVal);
     psmVal.toObject()->defineFunction("getOrCreatePipelineState", _SE(JSB_getOrCreatePipelineState));
+    psmVal.toObject()->defineFunction("setManifestEnabled", _SE(JSB_setPipelineStateManifestEnabled));
+    psmVal.toObject()->defineFunction("warmUp", _SE(JSB_warmUpPipelineStates));
+    psmVal.toObject()->defineFunction("setCreationBudget", _SE(JSB_setPipelineStateCreationBudget));
 
     return true;
 }
@@ -23,6 +23,9 @@
 ****************************************************************************/
 
 #include "core/assets/SimpleTexture.h"
+#include "2d/renderer/Batcher2d.h"
+#include "2d/renderer/DynamicAtlasManager.h"
+#include "core/Root.h"
 #include "core/assets/ImageAsset.h"
 #include "core/platform/Debug.h"
 #include "core/platform/Macro.h"
@@ -48,6 +51,12 @@ bool canGenerateMipmap(uint32_t w, uint32_t h) {
     return isPOT(w) && isPOT(h);
 }
 
+DynamicAtlasManager *getDynamicAtlas() {
+    auto *root = Root::getInstance();
+    auto *batcher = root ? root->getBatcher2D() : nullptr;
+    return batcher ? batcher->getDynamicAtlas() : nullptr;
+}
+
 } // namespace
 
 SimpleTexture::SimpleTexture() = default;
@@ -85,6 +94,13 @@ void SimpleTexture::uploadData(const uint8_t *source, uint32_t level /* = 0 */,
 
     const uint8_t *buffers[1]{source};
     gfxDevice->copyBuffersToTexture(buffers, _gfxTexture, &region, 1);
+
+    if (level == 0) {
+        if (auto *atlas = getDynamicAtlas()) {
+            // sprites sample the view
+            atlas->updateTexture(_gfxTextureView);
+        }
+    }
 }
 
 void SimpleTexture::assignImage(ImageAsset *image, uint32_t level, uint32_t arrayIndex /* = 0 */) {
@@ -144,6 +160,11 @@ void SimpleTexture::createTexture(gfx::Device *device) {
     if (hasFlag(gfx::Device::getInstance()->getFormatFeatures(gfxFormat), gfx::FormatFeatureBit::RENDER_TARGET)) {
         usage |= gfx::TextureUsageBit::COLOR_ATTACHMENT;
     }
+    auto *atlas = getDynamicAtlas();
+    if (atlas && _mipFilter == Filter::NONE && atlas->isCandidate(gfxFormat, _width, _height)) {
+        // copied into the pages of the 2D dynamic atlas
+        usage |= gfx::TextureUsageBit::TRANSFER_SRC;
+    }
 
     auto textureCreateInfo = getGfxTextureCreateInfo(
         usage,
@@ -185,6 +206,9 @@ gfx::Texture *SimpleTexture::createTextureView(gfx::Device *device) {
 
 void SimpleTexture::tryDestroyTexture() {
     if (_gfxTexture != nullptr) {
+        if (auto *atlas = getDynamicAtlas()) {
+            atlas->releaseTexture(_gfxTexture);
+        }
         _gfxTexture->destroy();
         _gfxTexture = nullptr;
 
@@ -194,6 +218,9 @@ void SimpleTexture::tryDestroyTexture() {
 
 void SimpleTexture::tryDestroyTextureView() {
     if (_gfxTextureView != nullptr) {
+        if (auto *atlas = getDynamicAtlas()) {
+            atlas->releaseTexture(_gfxTextureView);
+        }
         _gfxTextureView->destroy();
         _gfxTextureView = nullptr;
 
@@ -1077,4 +1077,8 @@ void Node::_decSkewCompCount() {
     --skewCompCount;
 }
 
+bool Node::_hasSkewComp() {
+    return skewCompCount > 0;
+}
+
 } // namespace cc
@@ -138,6 +138,7 @@ public:
     
     static void _incSkewCompCount(); // NOLINT
     static void _decSkewCompCount(); // NOLINT
+    static bool _hasSkewComp();      // NOLINT
 
     Node();
     explicit Node(const ccstd::string &name);
@@ -731,6 +732,7 @@ private:
 
     friend class NodeActivator;
     friend class Scene;
+    friend class TransformHierarchy;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(Node);
 };
@@ -28,6 +28,7 @@
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 #include "scene/Ambient.h"
+#include "scene/BVH.h"
 #include "scene/Fog.h"
 #include "scene/Octree.h"
 #include "scene/Shadow.h"
@@ -43,6 +44,7 @@ SceneGlobals::SceneGlobals() {
     _skyboxInfo = ccnew scene::SkyboxInfo();
     _fogInfo = ccnew scene::FogInfo();
     _octreeInfo = ccnew scene::OctreeInfo();
+    _bvhInfo = ccnew scene::BVHInfo();
     _lightProbeInfo = ccnew gi::LightProbeInfo();
     _bakedWithStationaryMainLight = false;
     _bakedWithHighpLightmap = false;
@@ -72,6 +74,10 @@ void SceneGlobals::activate(Scene *scene) {
         _octreeInfo->activate(sceneData->getOctree());
     }
 
+    if (_bvhInfo != nullptr) {
+        _bvhInfo->activate(sceneData->getBVH());
+    }
+
     if (_lightProbeInfo != nullptr && sceneData->getLightProbes() != nullptr) {
         _lightProbeInfo->activate(scene, sceneData->getLightProbes());
     }
@@ -107,6 +113,10 @@ void SceneGlobals::setOctreeInfo(scene::OctreeInfo *info) {
     _octreeInfo = info;
 }
 
+void SceneGlobals::setBVHInfo(scene::BVHInfo *info) {
+    _bvhInfo = info;
+}
+
 void SceneGlobals::setLightProbeInfo(gi::LightProbeInfo *info) {
     _lightProbeInfo = info;
 }
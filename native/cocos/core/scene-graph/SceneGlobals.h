@@ -35,6 +35,7 @@ class ShadowsInfo;
 class SkyboxInfo;
 class FogInfo;
 class OctreeInfo;
+class BVHInfo;
 class SkinInfo;
 class PostSettingsInfo;
 } // namespace scene
@@ -55,6 +56,7 @@ public:
     inline scene::SkyboxInfo *getSkyboxInfo() const { return _skyboxInfo.get(); }
     inline scene::FogInfo *getFogInfo() const { return _fogInfo.get(); }
     inline scene::OctreeInfo *getOctreeInfo() const { return _octreeInfo.get(); }
+    inline scene::BVHInfo *getBVHInfo() const { return _bvhInfo.get(); }
     inline gi::LightProbeInfo *getLightProbeInfo() const { return _lightProbeInfo.get(); }
     inline bool getBakedWithStationaryMainLight() const { return _bakedWithStationaryMainLight; }
     inline bool getBakedWithHighpLightmap() const { return _bakedWithHighpLightmap; }
@@ -66,6 +68,7 @@ public:
     void setSkyboxInfo(scene::SkyboxInfo *info);
     void setFogInfo(scene::FogInfo *info);
     void setOctreeInfo(scene::OctreeInfo *info);
+    void setBVHInfo(scene::BVHInfo *info);
     void setLightProbeInfo(gi::LightProbeInfo *info);
     void setBakedWithStationaryMainLight(bool value);
     void setBakedWithHighpLightmap(bool value);
@@ -78,6 +81,7 @@ private:
     IntrusivePtr<scene::SkyboxInfo> _skyboxInfo;
     IntrusivePtr<scene::FogInfo> _fogInfo;
     IntrusivePtr<scene::OctreeInfo> _octreeInfo;
+    IntrusivePtr<scene::BVHInfo> _bvhInfo;
     IntrusivePtr<gi::LightProbeInfo> _lightProbeInfo;
     IntrusivePtr<scene::SkinInfo> _skinInfo;
     IntrusivePtr<scene::PostSettingsInfo> _postSettingsInfo;
@@ -0,0 +1,210 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/scene-graph/TransformHierarchy.h"
+
+#include <algorithm>
+#include "base/job-system/JobSystem.h"
+#include "core/scene-graph/Node.h"
+
+namespace cc {
+
+namespace {
+constexpr uint32_t MIN_CHUNK_SIZE = 256;
+constexpr uint32_t MAX_CHUNK_COUNT = 64;
+constexpr auto POSITION_BIT = static_cast<uint32_t>(TransformBit::POSITION);
+constexpr auto ROTATION_BIT = static_cast<uint32_t>(TransformBit::ROTATION);
+constexpr auto SCALE_BIT = static_cast<uint32_t>(TransformBit::SCALE);
+constexpr auto RSS_BITS = static_cast<uint32_t>(TransformBit::RSS);
+} // namespace
+
+TransformHierarchy::TransformHierarchy(Node *root) {
+    build(root);
+}
+
+void TransformHierarchy::build(Node *root) {
+    // the root may only be referenced by this hierarchy
+    IntrusivePtr<Node> rootRef{root};
+    _nodes.clear();
+    _parents.clear();
+    _childCounts.clear();
+    _chunks.clear();
+    _headEnd = 0;
+    if (!root) {
+        return;
+    }
+
+    // depth-first order, so parents always precede their children
+    ccstd::vector<std::pair<Node *, int32_t>> stack;
+    stack.emplace_back(root, -1);
+    while (!stack.empty()) {
+        const auto entry = stack.back();
+        stack.pop_back();
+        const auto index = static_cast<int32_t>(_nodes.size());
+        _nodes.emplace_back(entry.first);
+        _parents.emplace_back(entry.second);
+        const auto &children = entry.first->_children;
+        _childCounts.emplace_back(static_cast<uint32_t>(children.size()));
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            stack.emplace_back(it->get(), index);
+        }
+    }
+
+    const auto count = size();
+    _transformBits.assign(count, 0);
+    _localPositions.resize(count);
+    _localRotations.resize(count);
+    _localScales.resize(count);
+    _worldMatrices.resize(count);
+    _dirtyMask.assign((count + 63) / 64, 0);
+
+    // Skip the chain of single children below the root, the subtrees of the first node with
+    // several children are independent and grouped into contiguous chunks.
+    uint32_t head = 0;
+    while (head + 1 < count && _childCounts[head] == 1) {
+        ++head;
+    }
+    _headEnd = head + 1;
+    const uint32_t chunkSize = std::max(MIN_CHUNK_SIZE, count / MAX_CHUNK_COUNT);
+    uint32_t begin = _headEnd;
+    for (uint32_t i = _headEnd; i < count; ++i) {
+        if (_parents[i] == static_cast<int32_t>(head) && i - begin >= chunkSize) {
+            _chunks.emplace_back(begin, i);
+            begin = i;
+        }
+    }
+    if (begin < count) {
+        _chunks.emplace_back(begin, count);
+    }
+}
+
+bool TransformHierarchy::gatherDirtyNodes() {
+    std::fill(_dirtyMask.begin(), _dirtyMask.end(), 0);
+    const auto count = size();
+    for (uint32_t i = 0; i < count; ++i) {
+        const Node *node = _nodes[i].get();
+        const auto parent = _parents[i];
+        if ((parent >= 0 && node->_parent != _nodes[parent].get()) || node->_children.size() != _childCounts[i]) {
+            return false;
+        }
+        const auto bits = node->_transformFlags;
+        _transformBits[i] = static_cast<uint8_t>(bits);
+        if (!bits) {
+            continue;
+        }
+        _dirtyMask[i >> 6] |= uint64_t{1} << (i & 63);
+        _localPositions[i] = node->_localPosition;
+        _localRotations[i] = node->_localRotation;
+        _localScales[i] = node->_localScale;
+    }
+    return true;
+}
+
+void TransformHierarchy::update() {
+    if (_nodes.empty()) {
+        return;
+    }
+    // skewed nodes change the world matrix of their descendants, leave them to the node's own update
+    if (Node::_hasSkewComp()) {
+        for (const auto &node : _nodes) {
+            node->updateWorldTransform();
+        }
+        return;
+    }
+    if (!gatherDirtyNodes()) {
+        build(getRoot());
+        gatherDirtyNodes();
+    }
+    if (std::all_of(_dirtyMask.begin(), _dirtyMask.end(), [](uint64_t word) { return word == 0; })) {
+        return;
+    }
+
+    if (Node *parent = getRoot()->_parent) {
+        parent->updateWorldTransform();
+    }
+    updateRange(0, _headEnd);
+    parallelForEachIndex(static_cast<uint32_t>(_chunks.size()), [this](uint32_t chunk) {
+        updateRange(_chunks[chunk].first, _chunks[chunk].second);
+    });
+}
+
+// Same results as Node::updateWorldTransformRecursive, without skew.
+void TransformHierarchy::updateRange(uint32_t begin, uint32_t end) {
+    Mat4 localMatrix;
+    uint32_t i = begin;
+    while (i < end) {
+        const uint64_t bits = _dirtyMask[i >> 6] >> (i & 63);
+        if (!bits) {
+            i = (i | 63) + 1;
+            continue;
+        }
+        if (!(bits & 1)) {
+            ++i;
+            continue;
+        }
+
+        Node *node = _nodes[i].get();
+        const uint32_t dirtyBits = _transformBits[i];
+        Mat4 &worldMatrix = _worldMatrices[i];
+        if (const Node *parent = node->_parent) {
+            // a dirty parent precedes its children, its new world matrix is already in the array
+            const auto parentIndex = _parents[i];
+            const Mat4 &parentWorldMatrix = (parentIndex >= 0 && isDirty(parentIndex)) ? _worldMatrices[parentIndex] : parent->_worldMatrix;
+            if (!(dirtyBits & RSS_BITS)) {
+                node->_worldPosition.transformMat4(_localPositions[i], parentWorldMatrix);
+                worldMatrix = node->_worldMatrix;
+                worldMatrix.m[12] = node->_worldPosition.x;
+                worldMatrix.m[13] = node->_worldPosition.y;
+                worldMatrix.m[14] = node->_worldPosition.z;
+            } else {
+                Mat4::fromRTS(_localRotations[i], _localPositions[i], _localScales[i], &localMatrix);
+                Mat4::multiply(parentWorldMatrix, localMatrix, &worldMatrix);
+                Quaternion *rotation = (dirtyBits & ROTATION_BIT) ? &node->_worldRotation : nullptr;
+                Mat4::toRTS(worldMatrix, rotation, &node->_worldPosition, &node->_worldScale);
+            }
+        } else {
+            worldMatrix = node->_worldMatrix;
+            if (dirtyBits & POSITION_BIT) {
+                node->_worldPosition.set(_localPositions[i]);
+                worldMatrix.m[12] = node->_worldPosition.x;
+                worldMatrix.m[13] = node->_worldPosition.y;
+                worldMatrix.m[14] = node->_worldPosition.z;
+            }
+            if (dirtyBits & RSS_BITS) {
+                if (dirtyBits & ROTATION_BIT) {
+                    node->_worldRotation.set(_localRotations[i]);
+                }
+                if (dirtyBits & SCALE_BIT) {
+                    node->_worldScale.set(_localScales[i]);
+                }
+                Mat4::fromRTS(node->_worldRotation, node->_worldPosition, node->_worldScale, &worldMatrix);
+            }
+        }
+        node->_worldMatrix = worldMatrix;
+        node->_transformFlags = static_cast<uint32_t>(TransformBit::NONE);
+        ++i;
+    }
+}
+
+} // namespace cc
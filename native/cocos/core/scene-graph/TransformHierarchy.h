@@ -0,0 +1,90 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <utility>
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/vector.h"
+#include "math/Mat4.h"
+#include "math/Quaternion.h"
+#include "math/Vec3.h"
+
+namespace cc {
+
+class Node;
+
+/**
+ * @en Flattened view of a node hierarchy for batch world transform updates.
+ * Nodes are stored in depth-first order with their local transforms and world matrices in contiguous arrays,
+ * so the update is a linear sweep over the dirty nodes instead of a recursion per node, and independent
+ * subtrees are updated in parallel on the job system. The results are written back to the nodes.
+ * The hierarchy is rebuilt automatically when a node's parent or child count changes.
+ * @zh 节点树的扁平化视图，用于批量更新世界变换。节点按深度优先顺序存放在连续数组中，更新时线性遍历脏节点，
+ * 独立子树在 JobSystem 上并行更新，结果写回节点。节点的父节点或子节点数量变化时会自动重建。
+ */
+class CC_DLL TransformHierarchy final {
+public:
+    TransformHierarchy() = default;
+    explicit TransformHierarchy(Node *root);
+
+    void build(Node *root);
+
+    /**
+     * @en Updates the world transforms of all dirty nodes under the root, equivalent to calling
+     * Node::updateWorldTransform on each of them.
+     * @zh 更新根节点下所有脏节点的世界变换，等价于对每个节点调用 Node::updateWorldTransform。
+     */
+    void update();
+
+    inline uint32_t size() const { return static_cast<uint32_t>(_nodes.size()); }
+    inline Node *getRoot() const { return _nodes.empty() ? nullptr : _nodes[0].get(); }
+    inline Node *getNode(uint32_t index) const { return _nodes[index].get(); }
+
+private:
+    bool gatherDirtyNodes();
+    void updateRange(uint32_t begin, uint32_t end);
+
+    inline bool isDirty(uint32_t index) const { return (_dirtyMask[index >> 6] >> (index & 63)) & 1; }
+
+    // all arrays are indexed by the depth-first order of the nodes
+    ccstd::vector<IntrusivePtr<Node>> _nodes;
+    ccstd::vector<int32_t> _parents; // -1 for the root
+    ccstd::vector<uint32_t> _childCounts;
+    ccstd::vector<uint8_t> _transformBits;
+    ccstd::vector<Vec3> _localPositions;
+    ccstd::vector<Quaternion> _localRotations;
+    ccstd::vector<Vec3> _localScales;
+    ccstd::vector<Mat4> _worldMatrices;
+    ccstd::vector<uint64_t> _dirtyMask;
+
+    // nodes in [0, _headEnd) are a chain updated first, the chunks hold whole subtrees below it
+    uint32_t _headEnd{0};
+    ccstd::vector<std::pair<uint32_t, uint32_t>> _chunks;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TransformHierarchy);
+};
+
+} // namespace cc
@@ -21,73 +21,41 @@
  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  THE SOFTWARE.
 ****************************************************************************/
-
 #include "core/utils/ImageUtils.h"
 #include "base/Log.h"
+#include "base/PixelConvert.h"
 #include "renderer/gfx-base/GFXDef-common.h"
-namespace {
-uint8_t *convertRGB2RGBA(uint32_t length, uint8_t *src) {
-    auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i] = *src++;
-        dst[i + 1] = *src++;
-        dst[i + 2] = *src++;
-        dst[i + 3] = 255;
-    }
-    return dst;
-}
-
-uint8_t *convertIA2RGBA(uint32_t length, uint8_t *src) {
-    auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i] = *src;
-        dst[i + 1] = *src;
-        dst[i + 2] = *src++;
-        dst[i + 3] = *src++;
-    }
-    return dst;
-}
-
-uint8_t *convertI2RGBA(uint32_t length, uint8_t *src) {
-    auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i] = *src;
-        dst[i + 1] = *src;
-        dst[i + 2] = *src++;
-        dst[i + 3] = 255;
-    }
-    return dst;
-}
-} // namespace
 
 namespace cc {
 void ImageUtils::convert2RGBA(Image *image) {
     if (!image->_isCompressed && image->_renderFormat != gfx::Format::RGBA8) {
-        image->_dataLen = image->_width * image->_height * 4;
-        uint8_t *dst = nullptr;
-        uint32_t length = static_cast<uint32_t>(image->_dataLen);
-        uint8_t *src = image->_data;
+        pixel::Conversion conversion;
         switch (image->_renderFormat) {
             case gfx::Format::A8:
             case gfx::Format::LA8:
-                dst = convertIA2RGBA(length, src);
+                conversion = pixel::Conversion::LA8_TO_RGBA8;
                 break;
             case gfx::Format::L8:
             case gfx::Format::R8:
             case gfx::Format::R8I:
-                dst = convertI2RGBA(length, src);
+                conversion = pixel::Conversion::L8_TO_RGBA8;
                 break;
             case gfx::Format::RGB8:
-                dst = convertRGB2RGBA(length, src);
+                conversion = pixel::Conversion::RGB8_TO_RGBA8;
                 break;
             default:
                 CC_LOG_INFO("cannot convert to RGBA: unknown image format");
-                break;
+                return;
         }
-        if (dst != image->_data) free(image->_data);
+        const auto width = static_cast<uint32_t>(image->_width);
+        const auto height = static_cast<uint32_t>(image->_height);
+        image->_dataLen = width * height * 4;
+        auto *dst = static_cast<uint8_t *>(malloc(image->_dataLen));
+        pixel::convertImage(conversion, image->_data, dst, width, height);
+        free(image->_data);
         image->_data = dst;
         image->_renderFormat = gfx::Format::RGBA8;
     }
 }
 
-} // namespace cc
\ No newline at end of file
+} // namespace cc
@@ -53,6 +53,10 @@ This file was modified to fit the cocos2d-x project
     #define INCLUDE_SSE
 #endif
 
+#include <cmath>
+#include <cstring>
+#include "math/MathUtil.inl"
+
 #ifdef INCLUDE_NEON32
     #include "math/MathUtilNeon.inl"
 #endif
@@ -64,8 +68,6 @@ This file was modified to fit the cocos2d-x project
 #ifdef INCLUDE_SSE
     #include "math/MathUtilSSE.inl"
 #endif
-#include <cstring>
-#include "math/MathUtil.inl"
 
 NS_CC_MATH_BEGIN
 
@@ -279,6 +281,70 @@ void MathUtil::crossVec3(const float *v1, const float *v2, float *dst) {
 #endif
 }
 
+void MathUtil::aabbFrustumSoA(const float *planes, const float *const center[3], const float *const halfExtents[3], uint32_t count, uint8_t *visible) {
+#ifdef USE_NEON32
+    MathUtilNeon::aabbFrustumSoA(planes, center, halfExtents, count, visible);
+#elif defined(USE_NEON64)
+    MathUtilNeon64::aabbFrustumSoA(planes, center, halfExtents, count, visible);
+#elif defined(INCLUDE_NEON32)
+    if (isNeon32Enabled()) {
+        MathUtilNeon::aabbFrustumSoA(planes, center, halfExtents, count, visible);
+    } else {
+        MathUtilC::aabbFrustumSoA(planes, center, halfExtents, 0, count, visible);
+    }
+#elif defined(USE_SSE)
+    __m128 splatPlanes[24];
+    for (uint32_t i = 0; i < 24; ++i) {
+        splatPlanes[i] = _mm_set1_ps(planes[i]);
+    }
+    aabbFrustumSoA(splatPlanes, center, halfExtents, count, visible);
+#else
+    MathUtilC::aabbFrustumSoA(planes, center, halfExtents, 0, count, visible);
+#endif
+}
+
+void MathUtil::multiplyJointMatrix(const float *m1, const float *m2, float *dst) {
+#ifdef USE_NEON32
+    MathUtilNeon::multiplyJointMatrix(m1, m2, dst);
+#elif defined(USE_NEON64)
+    MathUtilNeon64::multiplyJointMatrix(m1, m2, dst);
+#elif defined(INCLUDE_NEON32)
+    if (isNeon32Enabled()) {
+        MathUtilNeon::multiplyJointMatrix(m1, m2, dst);
+    } else {
+        MathUtilC::multiplyJointMatrix(m1, m2, dst);
+    }
+#elif defined(USE_SSE)
+    const __m128 a[4] = {_mm_loadu_ps(m1), _mm_loadu_ps(m1 + 4), _mm_loadu_ps(m1 + 8), _mm_loadu_ps(m1 + 12)};
+    const __m128 b[4] = {_mm_loadu_ps(m2), _mm_loadu_ps(m2 + 4), _mm_loadu_ps(m2 + 8), _mm_loadu_ps(m2 + 12)};
+    multiplyJointMatrix(a, b, dst);
+#else
+    MathUtilC::multiplyJointMatrix(m1, m2, dst);
+#endif
+}
+
+void MathUtil::transformPoints(const float *m, const float *src, float *dst, uint32_t stride, uint32_t count) {
+#ifdef USE_NEON32
+    MathUtilNeon::transformPoints(m, src, dst, stride, count);
+#elif defined(USE_NEON64)
+    MathUtilNeon64::transformPoints(m, src, dst, stride, count);
+#elif defined(INCLUDE_NEON32)
+    if (isNeon32Enabled()) {
+        MathUtilNeon::transformPoints(m, src, dst, stride, count);
+    } else {
+        MathUtilC::transformPoints(m, src, dst, stride, 0, count);
+    }
+#elif defined(USE_SSE)
+    __m128 splatMatrix[16];
+    for (uint32_t i = 0; i < 16; ++i) {
+        splatMatrix[i] = _mm_set1_ps(m[i]);
+    }
+    transformPoints(splatMatrix, src, dst, stride, count);
+#else
+    MathUtilC::transformPoints(m, src, dst, stride, 0, count);
+#endif
+}
+
 void MathUtil::combineHash(size_t &seed, const size_t &v) {
     seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
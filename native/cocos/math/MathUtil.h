@@ -27,6 +27,7 @@
     #include <xmmintrin.h>
 #endif
 
+#include <cstdint>
 #include "math/MathBase.h"
 
 /**
@@ -95,6 +96,41 @@ public:
      */
     static void combineHash(size_t &seed, const size_t &v);
 
+    /**
+     * Tests a batch of AABBs stored as structure of arrays against the 6 planes of a frustum.
+     * Plane normals point to the inside of the frustum, as in geometry::AABB::aabbFrustum.
+     *
+     * @param planes 6 planes packed as (nx, ny, nz, d).
+     * @param center x, y, z arrays of the AABB centers.
+     * @param halfExtents x, y, z arrays of the AABB half extents.
+     * @param count the number of AABBs.
+     * @param visible receives 1 for each AABB intersecting the frustum, 0 otherwise.
+     */
+    static void aabbFrustumSoA(const float *planes, const float *const center[3], const float *const halfExtents[3], uint32_t count, uint8_t *visible);
+
+    /**
+     * Multiplies two column-major 4x4 matrices and writes the product in the packed 4x3 joint layout
+     * used by skinning: for each of the first 3 columns, its x, y, z followed by the matching
+     * component of the translation column.
+     *
+     * @param m1 the first matrix.
+     * @param m2 the second matrix.
+     * @param dst receives 12 floats.
+     */
+    static void multiplyJointMatrix(const float *m1, const float *m2, float *dst);
+
+    /**
+     * Transforms a batch of points stored in interleaved vertex data by a column-major 4x4 matrix,
+     * with the same perspective divide as Vec3::transformMat4. Only the first 3 floats of each vertex are written.
+     *
+     * @param m the matrix.
+     * @param src the first source vertex.
+     * @param dst the first destination vertex, it may be src.
+     * @param stride the vertex stride in floats, at least 3.
+     * @param count the number of vertices.
+     */
+    static void transformPoints(const float *m, const float *src, float *dst, uint32_t stride, uint32_t count);
+
 private:
     //Indicates that if neon is enabled
     static bool isNeon32Enabled();
@@ -117,6 +153,12 @@ private:
     static void transposeMatrix(const __m128 m[4], __m128 dst[4]);
 
     static void transformVec4(const __m128 m[4], const __m128 &v, __m128 &dst);
+
+    static void aabbFrustumSoA(const __m128 planes[24], const float *const center[3], const float *const halfExtents[3], uint32_t count, uint8_t *visible);
+
+    static void multiplyJointMatrix(const __m128 m1[4], const __m128 m2[4], float *dst);
+
+    static void transformPoints(const __m128 m[16], const float *src, float *dst, uint32_t stride, uint32_t count);
 #endif
     static void addMatrix(const float *m, float scalar, float *dst);
 
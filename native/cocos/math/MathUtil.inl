@@ -44,6 +44,12 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void aabbFrustumSoA(const float* planes, const float* const center[3], const float* const halfExtents[3], uint32_t begin, uint32_t count, uint8_t* visible);
+
+    inline static void multiplyJointMatrix(const float* m1, const float* m2, float* dst);
+
+    inline static void transformPoints(const float* m, const float* src, float* dst, uint32_t stride, uint32_t begin, uint32_t count);
 };
 
 inline void MathUtilC::addMatrix(const float* m, float scalar, float* dst)
@@ -217,4 +223,64 @@ inline void MathUtilC::crossVec3(const float* v1, const float* v2, float* dst)
     dst[2] = z;
 }
 
+inline void MathUtilC::aabbFrustumSoA(const float* planes, const float* const center[3], const float* const halfExtents[3], uint32_t begin, uint32_t count, uint8_t* visible)
+{
+    for (uint32_t i = begin; i < count; ++i)
+    {
+        uint8_t inside = 1;
+        for (uint32_t p = 0; p < 6; ++p)
+        {
+            const float* plane = planes + p * 4;
+            const float r = halfExtents[0][i] * std::abs(plane[0]) +
+                            halfExtents[1][i] * std::abs(plane[1]) +
+                            halfExtents[2][i] * std::abs(plane[2]);
+            const float dot = center[0][i] * plane[0] + center[1][i] * plane[1] + center[2][i] * plane[2];
+            if (dot + r < plane[3])
+            {
+                inside = 0;
+                break;
+            }
+        }
+        visible[i] = inside;
+    }
+}
+
+inline void MathUtilC::multiplyJointMatrix(const float* m1, const float* m2, float* dst)
+{
+    // column c of the product is m1 * m2[c], only the x, y, z rows are needed
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        const float* col = m2 + c * 4;
+        for (uint32_t r = 0; r < 3; ++r)
+        {
+            const float v = m1[r] * col[0] + m1[4 + r] * col[1] + m1[8 + r] * col[2] + m1[12 + r] * col[3];
+            if (c < 3)
+            {
+                dst[c * 4 + r] = v;
+            }
+            else
+            {
+                dst[r * 4 + 3] = v;
+            }
+        }
+    }
+}
+
+inline void MathUtilC::transformPoints(const float* m, const float* src, float* dst, uint32_t stride, uint32_t begin, uint32_t count)
+{
+    for (uint32_t i = begin; i < count; ++i)
+    {
+        const float* v = src + i * stride;
+        float* out = dst + i * stride;
+        const float x = v[0];
+        const float y = v[1];
+        const float z = v[2];
+        const float w = m[3] * x + m[7] * y + m[11] * z + m[15];
+        const float rhw = std::fabs(w) > MATH_EPSILON ? 1.0F / w : 1.0F;
+        out[0] = (m[0] * x + m[4] * y + m[8] * z + m[12]) * rhw;
+        out[1] = (m[1] * x + m[5] * y + m[9] * z + m[13]) * rhw;
+        out[2] = (m[2] * x + m[6] * y + m[10] * z + m[14]) * rhw;
+    }
+}
+
 NS_CC_MATH_END
@@ -20,6 +20,8 @@
  This file was modified to fit the cocos2d-x project
  */
 
+#include <arm_neon.h>
+
 NS_CC_MATH_BEGIN
 
 class MathUtilNeon64
@@ -44,6 +46,12 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void aabbFrustumSoA(const float* planes, const float* const center[3], const float* const halfExtents[3], uint32_t count, uint8_t* visible);
+
+    inline static void multiplyJointMatrix(const float* m1, const float* m2, float* dst);
+
+    inline static void transformPoints(const float* m, const float* src, float* dst, uint32_t stride, uint32_t count);
 };
 
 inline void MathUtilNeon64::addMatrix(const float* m, float scalar, float* dst)
@@ -262,4 +270,127 @@ inline void MathUtilNeon64::crossVec3(const float* v1, const float* v2, float* d
     );
 }
 
+inline void MathUtilNeon64::aabbFrustumSoA(const float* planes, const float* const center[3], const float* const halfExtents[3], uint32_t count, uint8_t* visible)
+{
+    float32x4_t splatPlanes[24];
+    float32x4_t absNormals[18];
+    for (uint32_t p = 0; p < 6; ++p)
+    {
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            splatPlanes[p * 4 + k] = vdupq_n_f32(planes[p * 4 + k]);
+        }
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            absNormals[p * 3 + k] = vabsq_f32(splatPlanes[p * 4 + k]);
+        }
+    }
+
+    // 4 AABBs per iteration, each lane is an AABB
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t cx = vld1q_f32(center[0] + i);
+        const float32x4_t cy = vld1q_f32(center[1] + i);
+        const float32x4_t cz = vld1q_f32(center[2] + i);
+        const float32x4_t hx = vld1q_f32(halfExtents[0] + i);
+        const float32x4_t hy = vld1q_f32(halfExtents[1] + i);
+        const float32x4_t hz = vld1q_f32(halfExtents[2] + i);
+
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (uint32_t p = 0; p < 6; ++p)
+        {
+            float32x4_t r = vmulq_f32(hx, absNormals[p * 3 + 0]);
+            r = vmlaq_f32(r, hy, absNormals[p * 3 + 1]);
+            r = vmlaq_f32(r, hz, absNormals[p * 3 + 2]);
+            float32x4_t dot = vmulq_f32(cx, splatPlanes[p * 4 + 0]);
+            dot = vmlaq_f32(dot, cy, splatPlanes[p * 4 + 1]);
+            dot = vmlaq_f32(dot, cz, splatPlanes[p * 4 + 2]);
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(dot, r), splatPlanes[p * 4 + 3]));
+        }
+
+        visible[i + 0] = vgetq_lane_u32(outside, 0) ? 0 : 1;
+        visible[i + 1] = vgetq_lane_u32(outside, 1) ? 0 : 1;
+        visible[i + 2] = vgetq_lane_u32(outside, 2) ? 0 : 1;
+        visible[i + 3] = vgetq_lane_u32(outside, 3) ? 0 : 1;
+    }
+
+    MathUtilC::aabbFrustumSoA(planes, center, halfExtents, i, count, visible);
+}
+
+inline void MathUtilNeon64::multiplyJointMatrix(const float* m1, const float* m2, float* dst)
+{
+    const float32x4_t a0 = vld1q_f32(m1);
+    const float32x4_t a1 = vld1q_f32(m1 + 4);
+    const float32x4_t a2 = vld1q_f32(m1 + 8);
+    const float32x4_t a3 = vld1q_f32(m1 + 12);
+
+    float32x4_t col[4];
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        const float* b = m2 + c * 4;
+        float32x4_t v = vmulq_n_f32(a0, b[0]);
+        v = vmlaq_n_f32(v, a1, b[1]);
+        v = vmlaq_n_f32(v, a2, b[2]);
+        col[c] = vmlaq_n_f32(v, a3, b[3]);
+    }
+
+    // (col.x, col.y, col.z, translation[c])
+    vst1q_f32(dst, vsetq_lane_f32(vgetq_lane_f32(col[3], 0), col[0], 3));
+    vst1q_f32(dst + 4, vsetq_lane_f32(vgetq_lane_f32(col[3], 1), col[1], 3));
+    vst1q_f32(dst + 8, vsetq_lane_f32(vgetq_lane_f32(col[3], 2), col[2], 3));
+}
+
+inline void MathUtilNeon64::transformPoints(const float* m, const float* src, float* dst, uint32_t stride, uint32_t count)
+{
+    float32x4_t splat[16];
+    for (uint32_t k = 0; k < 16; ++k)
+    {
+        splat[k] = vdupq_n_f32(m[k]);
+    }
+    const float32x4_t epsilon = vdupq_n_f32(MATH_EPSILON);
+    const float32x4_t one = vdupq_n_f32(1.0F);
+
+    // 4 points per iteration, each lane is a point
+    float lanes[3][4];
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            const float* v = src + (i + k) * stride;
+            lanes[0][k] = v[0];
+            lanes[1][k] = v[1];
+            lanes[2][k] = v[2];
+        }
+        const float32x4_t x = vld1q_f32(lanes[0]);
+        const float32x4_t y = vld1q_f32(lanes[1]);
+        const float32x4_t z = vld1q_f32(lanes[2]);
+
+        float32x4_t w = vmlaq_f32(splat[15], x, splat[3]);
+        w = vmlaq_f32(w, y, splat[7]);
+        w = vmlaq_f32(w, z, splat[11]);
+        float32x4_t rhw = vdivq_f32(one, w);
+        // 1 / w where |w| > epsilon, 1 elsewhere
+        rhw = vbslq_f32(vcgtq_f32(vabsq_f32(w), epsilon), rhw, one);
+
+        for (uint32_t r = 0; r < 3; ++r)
+        {
+            float32x4_t v = vmlaq_f32(splat[12 + r], x, splat[r]);
+            v = vmlaq_f32(v, y, splat[4 + r]);
+            v = vmlaq_f32(v, z, splat[8 + r]);
+            vst1q_f32(lanes[r], vmulq_f32(v, rhw));
+        }
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            float* out = dst + (i + k) * stride;
+            out[0] = lanes[0][k];
+            out[1] = lanes[1][k];
+            out[2] = lanes[2][k];
+        }
+    }
+
+    MathUtilC::transformPoints(m, src, dst, stride, i, count);
+}
+
 NS_CC_MATH_END
@@ -173,6 +173,134 @@ void MathUtil::transformVec4(const __m128 m[4], const __m128& v, __m128& dst)
                      );
 }
 
+void MathUtil::aabbFrustumSoA(const __m128 planes[24], const float* const center[3], const float* const halfExtents[3], uint32_t count, uint8_t* visible)
+{
+    const __m128 signMask = _mm_set1_ps(-0.0F);
+    __m128 absNormals[18];
+    for (uint32_t p = 0; p < 6; ++p)
+    {
+        absNormals[p * 3 + 0] = _mm_andnot_ps(signMask, planes[p * 4 + 0]);
+        absNormals[p * 3 + 1] = _mm_andnot_ps(signMask, planes[p * 4 + 1]);
+        absNormals[p * 3 + 2] = _mm_andnot_ps(signMask, planes[p * 4 + 2]);
+    }
+
+    // 4 AABBs per iteration, each lane is an AABB
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 cx = _mm_loadu_ps(center[0] + i);
+        const __m128 cy = _mm_loadu_ps(center[1] + i);
+        const __m128 cz = _mm_loadu_ps(center[2] + i);
+        const __m128 hx = _mm_loadu_ps(halfExtents[0] + i);
+        const __m128 hy = _mm_loadu_ps(halfExtents[1] + i);
+        const __m128 hz = _mm_loadu_ps(halfExtents[2] + i);
+
+        __m128 outside = _mm_setzero_ps();
+        for (uint32_t p = 0; p < 6; ++p)
+        {
+            const __m128 r = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(hx, absNormals[p * 3 + 0]), _mm_mul_ps(hy, absNormals[p * 3 + 1])),
+                _mm_mul_ps(hz, absNormals[p * 3 + 2]));
+            const __m128 dot = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(cx, planes[p * 4 + 0]), _mm_mul_ps(cy, planes[p * 4 + 1])),
+                _mm_mul_ps(cz, planes[p * 4 + 2]));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dot, r), planes[p * 4 + 3]));
+        }
+
+        const int mask = _mm_movemask_ps(outside);
+        visible[i + 0] = (mask & 0x1) ? 0 : 1;
+        visible[i + 1] = (mask & 0x2) ? 0 : 1;
+        visible[i + 2] = (mask & 0x4) ? 0 : 1;
+        visible[i + 3] = (mask & 0x8) ? 0 : 1;
+    }
+
+    if (i < count)
+    {
+        float scalarPlanes[24];
+        for (uint32_t p = 0; p < 24; ++p)
+        {
+            scalarPlanes[p] = _mm_cvtss_f32(planes[p]);
+        }
+        MathUtilC::aabbFrustumSoA(scalarPlanes, center, halfExtents, i, count, visible);
+    }
+}
+
+void MathUtil::multiplyJointMatrix(const __m128 m1[4], const __m128 m2[4], float* dst)
+{
+    __m128 col[4];
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        const __m128 e0 = _mm_shuffle_ps(m2[c], m2[c], _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 e1 = _mm_shuffle_ps(m2[c], m2[c], _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 e2 = _mm_shuffle_ps(m2[c], m2[c], _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 e3 = _mm_shuffle_ps(m2[c], m2[c], _MM_SHUFFLE(3, 3, 3, 3));
+        col[c] = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(m1[0], e0), _mm_mul_ps(m1[1], e1)),
+            _mm_add_ps(_mm_mul_ps(m1[2], e2), _mm_mul_ps(m1[3], e3)));
+    }
+
+    // (col.x, col.y, col.z, translation[c])
+    const __m128 t0 = _mm_shuffle_ps(col[0], col[3], _MM_SHUFFLE(0, 0, 2, 2));
+    const __m128 t1 = _mm_shuffle_ps(col[1], col[3], _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 t2 = _mm_shuffle_ps(col[2], col[3], _MM_SHUFFLE(2, 2, 2, 2));
+    _mm_storeu_ps(dst, _mm_shuffle_ps(col[0], t0, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(col[1], t1, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(col[2], t2, _MM_SHUFFLE(2, 0, 1, 0)));
+}
+
+void MathUtil::transformPoints(const __m128 m[16], const float* src, float* dst, uint32_t stride, uint32_t count)
+{
+    const __m128 signMask = _mm_set1_ps(-0.0F);
+    const __m128 epsilon = _mm_set1_ps(MATH_EPSILON);
+    const __m128 one = _mm_set1_ps(1.0F);
+
+    // 4 points per iteration, each lane is a point
+    alignas(16) float lanes[3][4];
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float* v0 = src + i * stride;
+        const float* v1 = v0 + stride;
+        const float* v2 = v1 + stride;
+        const float* v3 = v2 + stride;
+        const __m128 x = _mm_set_ps(v3[0], v2[0], v1[0], v0[0]);
+        const __m128 y = _mm_set_ps(v3[1], v2[1], v1[1], v0[1]);
+        const __m128 z = _mm_set_ps(v3[2], v2[2], v1[2], v0[2]);
+
+        const __m128 w = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(x, m[3]), _mm_mul_ps(y, m[7])),
+            _mm_add_ps(_mm_mul_ps(z, m[11]), m[15]));
+        // 1 / w where |w| > epsilon, 1 elsewhere
+        const __m128 valid = _mm_cmpgt_ps(_mm_andnot_ps(signMask, w), epsilon);
+        const __m128 rhw = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(one, w)), _mm_andnot_ps(valid, one));
+
+        for (uint32_t r = 0; r < 3; ++r)
+        {
+            const __m128 v = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(x, m[r]), _mm_mul_ps(y, m[4 + r])),
+                _mm_add_ps(_mm_mul_ps(z, m[8 + r]), m[12 + r]));
+            _mm_store_ps(lanes[r], _mm_mul_ps(v, rhw));
+        }
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            float* out = dst + (i + k) * stride;
+            out[0] = lanes[0][k];
+            out[1] = lanes[1][k];
+            out[2] = lanes[2][k];
+        }
+    }
+
+    if (i < count)
+    {
+        float scalarMatrix[16];
+        for (uint32_t k = 0; k < 16; ++k)
+        {
+            scalarMatrix[k] = _mm_cvtss_f32(m[k]);
+        }
+        MathUtilC::transformPoints(scalarMatrix, src, dst, stride, i, count);
+    }
+}
+
 #endif
 
 
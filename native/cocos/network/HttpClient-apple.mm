@@ -60,8 +60,8 @@ void HttpClient::networkThread() {
                 while (_requestQueue.empty()) {
                     _sleepCondition.wait(_requestQueueMutex);
                 }
-                request = _requestQueue.at(0);
-                _requestQueue.erase(0);
+                request = _requestQueue.front();
+                _requestQueue.pop_front();
             }
 
             if (request == _requestSentinel) {
@@ -76,7 +76,7 @@ void HttpClient::networkThread() {
 
             // add response packet into queue
             _responseQueueMutex.lock();
-            _responseQueue.pushBack(response);
+            _responseQueue.push_back(response);
             _responseQueueMutex.unlock();
 
             _schedulerMutex.lock();
@@ -308,7 +308,7 @@ void HttpClient::destroyInstance() {
     thiz->_schedulerMutex.unlock();
 
     thiz->_requestQueueMutex.lock();
-    thiz->_requestQueue.pushBack(thiz->_requestSentinel);
+    thiz->_requestQueue.push_back(thiz->_requestSentinel);
     thiz->_requestQueueMutex.unlock();
 
     thiz->_sleepCondition.notify_one();
@@ -339,6 +339,19 @@ void HttpClient::setSSLVerification(const ccstd::string &caFile) {
     _sslCaFilename = caFile;
 }
 
+void HttpClient::setMaxConnectionsPerHost(uint32_t count) {
+    _maxConnectionsPerHost = count;
+}
+
+uint32_t HttpClient::getMaxConnectionsPerHost() const {
+    return _maxConnectionsPerHost;
+}
+
+void HttpClient::setScheduler(const std::shared_ptr<Scheduler> &scheduler) {
+    std::lock_guard<std::mutex> lock(_schedulerMutex);
+    _scheduler = scheduler;
+}
+
 HttpClient::HttpClient()
 : _isInited(false),
   _timeoutForConnect(30),
@@ -391,7 +404,7 @@ void HttpClient::send(HttpRequest *request) {
     request->addRef();
 
     _requestQueueMutex.lock();
-    _requestQueue.pushBack(request);
+    _requestQueue.push_back(request);
     _requestQueueMutex.unlock();
 
     // Notify thread start to work
@@ -418,8 +431,8 @@ void HttpClient::dispatchResponseCallbacks() {
     HttpResponse *response = nullptr;
     _responseQueueMutex.lock();
     if (!_responseQueue.empty()) {
-        response = _responseQueue.at(0);
-        _responseQueue.erase(0);
+        response = _responseQueue.front();
+        _responseQueue.pop_front();
     }
     _responseQueueMutex.unlock();
 
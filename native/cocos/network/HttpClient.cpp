@@ -32,9 +32,17 @@
 #include "base/Log.h"
 #include "base/ThreadPool.h"
 #include "base/memory/Memory.h"
+#include "base/std/container/unordered_set.h"
 #include "platform/FileUtils.h"
 #include "platform/StdC.h"
 
+// curl_multi_poll and curl_multi_wakeup are available since 7.68.0
+#if LIBCURL_VERSION_NUM >= 0x074400
+    #define CC_CURL_MULTI_POLL 1
+#else
+    #define CC_CURL_MULTI_POLL 0
+#endif
+
 namespace cc {
 
 namespace network {
@@ -45,6 +53,8 @@ typedef int int32_t;
 
 static HttpClient *_httpClient = nullptr; // pointer to singleton
 static LegacyThreadPool *gThreadPool = nullptr;
+// Guards the DNS cache, TLS sessions and cookies shared by the network thread and sendImmediate tasks.
+static std::mutex gShareLocks[CURL_LOCK_DATA_LAST];
 
 typedef size_t (*write_callback)(void *ptr, size_t size, size_t nmemb, void *stream);
 
@@ -72,93 +82,21 @@ static size_t writeHeaderData(void *ptr, size_t size, size_t nmemb, void *stream
     return sizes;
 }
 
-static int processGetTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPostTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPutTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processDeleteTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPatchTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-// int processDownloadTask(HttpRequest *task, write_callback callback, void *stream, int32_t *errorCode);
-
-// Worker thread
-void HttpClient::networkThread() {
-    increaseThreadCount();
-
-    while (true) {
-        HttpRequest *request;
-
-        // step 1: send http request if the requestQueue isn't empty
-        {
-            std::lock_guard<std::mutex> lock(_requestQueueMutex);
-            while (_requestQueue.empty()) {
-                _sleepCondition.wait(_requestQueueMutex);
-            }
-            request = _requestQueue.at(0);
-            _requestQueue.erase(0);
-        }
-
-        if (request == _requestSentinel) {
-            break;
-        }
-
-        // step 2: libcurl sync access
-
-        // Create a HttpResponse object, the default setting is http access failed
-        HttpResponse *response = ccnew HttpResponse(request);
-        response->addRef(); // NOTE: RefCounted object's reference count is changed to 0 now. so needs to addRef after ccnew.
-
-        processResponse(response, _responseMessage);
-
-        // add response packet into queue
-        _responseQueueMutex.lock();
-        _responseQueue.pushBack(response);
-        _responseQueueMutex.unlock();
-
-        _schedulerMutex.lock();
-        if (auto sche = _scheduler.lock()) {
-            sche->performFunctionInCocosThread(CC_CALLBACK_0(HttpClient::dispatchResponseCallbacks, this));
-        }
-        _schedulerMutex.unlock();
-    }
-
-    // cleanup: if worker thread received quit signal, clean up un-completed request queue
-    _requestQueueMutex.lock();
-    _requestQueue.clear();
-    _requestQueueMutex.unlock();
-
-    _responseQueueMutex.lock();
-    _responseQueue.clear();
-    _responseQueueMutex.unlock();
-
-    decreaseThreadCountAndMayDeleteThis();
+static void lockShare(CURL * /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void * /*userptr*/) {
+    gShareLocks[data].lock();
 }
 
-// Worker thread
-void HttpClient::networkThreadAlone(HttpRequest *request, HttpResponse *response) {
-    increaseThreadCount();
-
-    char responseMessage[RESPONSE_BUFFER_SIZE] = {0};
-    processResponse(response, responseMessage);
-
-    _schedulerMutex.lock();
-    if (auto sche = _scheduler.lock()) {
-        sche->performFunctionInCocosThread([this, response, request] {
-            const ccHttpRequestCallback &callback = request->getResponseCallback();
-
-            if (callback != nullptr) {
-                callback(this, response);
-            }
-            response->release();
-            // do not release in other thread
-            request->release();
-        });
-    }
-    _schedulerMutex.unlock();
+static void unlockShare(CURL * /*handle*/, curl_lock_data data, void * /*userptr*/) {
+    gShareLocks[data].unlock();
+}
 
-    decreaseThreadCountAndMayDeleteThis();
+static bool isHttp2Supported() {
+    static const bool SUPPORTED = (curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) != 0;
+    return SUPPORTED;
 }
 
 //Configure curl's timeout property
-static bool configureCURL(HttpClient *client, HttpRequest *request, CURL *handle, char *errorBuffer) {
+static bool configureCURL(HttpClient *client, CURLSH *share, HttpRequest *request, CURL *handle, char *errorBuffer) {
     if (!handle) {
         return false;
     }
@@ -195,6 +133,17 @@ static bool configureCURL(HttpClient *client, HttpRequest *request, CURL *handle
 
     curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");
 
+    // Reuse DNS lookups, TLS sessions and cookies of previous requests.
+    curl_easy_setopt(handle, CURLOPT_SHARE, share);
+
+    // Negotiate HTTP/2 over TLS, and wait for a connection that can multiplex instead of opening another one.
+    if (isHttp2Supported()) {
+        curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+        if (request->getUrl() && strncmp(request->getUrl(), "https://", 8) == 0) {
+            curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+        }
+    }
+
     return true;
 }
 
@@ -218,21 +167,22 @@ public:
             curl_slist_free_all(_headers);
     }
 
+    CURL *get() const { return _curl; }
+
     template <class T>
     bool setOption(CURLoption option, T data) {
         return CURLE_OK == curl_easy_setopt(_curl, option, data);
     }
 
     /**
-     * @brief Inits CURL instance for common usage
+     * @brief Inits CURL instance for the request, the response data and headers are written to `response`
      * @param request Null not allowed
-     * @param callback Response write callback
-     * @param stream Response write stream
+     * @param response Null not allowed
      */
-    bool init(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, write_callback headerCallback, void *headerStream, char *errorBuffer) {
+    bool init(HttpClient *client, CURLSH *share, HttpRequest *request, HttpResponse *response, char *errorBuffer) {
         if (!_curl)
             return false;
-        if (!configureCURL(client, request, _curl, errorBuffer))
+        if (!configureCURL(client, share, request, _curl, errorBuffer))
             return false;
 
         /* get custom header data (if set) */
@@ -255,12 +205,34 @@ public:
             }
         }
 
-        return setOption(CURLOPT_URL, request->getUrl()) && setOption(CURLOPT_WRITEFUNCTION, callback) && setOption(CURLOPT_WRITEDATA, stream) && setOption(CURLOPT_HEADERFUNCTION, headerCallback) && setOption(CURLOPT_HEADERDATA, headerStream);
+        bool ok = setOption(CURLOPT_URL, request->getUrl()) && setOption(CURLOPT_WRITEFUNCTION, writeData) && setOption(CURLOPT_WRITEDATA, response->getResponseData()) && setOption(CURLOPT_HEADERFUNCTION, writeHeaderData) && setOption(CURLOPT_HEADERDATA, response->getResponseHeader());
+        if (!ok) {
+            return false;
+        }
+
+        auto dataSize = static_cast<long>(request->getRequestDataSize());
+        switch (request->getRequestType()) {
+            case HttpRequest::Type::GET:
+                return setOption(CURLOPT_FOLLOWLOCATION, 1L);
+            case HttpRequest::Type::POST:
+                return setOption(CURLOPT_POST, 1L) && setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && setOption(CURLOPT_POSTFIELDSIZE, dataSize);
+            case HttpRequest::Type::PUT:
+                return setOption(CURLOPT_CUSTOMREQUEST, "PUT") && setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && setOption(CURLOPT_POSTFIELDSIZE, dataSize);
+            case HttpRequest::Type::HEAD:
+                return setOption(CURLOPT_NOBODY, 1L) && setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && setOption(CURLOPT_POSTFIELDSIZE, dataSize);
+            case HttpRequest::Type::DELETE:
+                return setOption(CURLOPT_CUSTOMREQUEST, "DELETE") && setOption(CURLOPT_FOLLOWLOCATION, 1L);
+            case HttpRequest::Type::PATCH:
+                return setOption(CURLOPT_CUSTOMREQUEST, "PATCH") && setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && setOption(CURLOPT_POSTFIELDSIZE, dataSize);
+            default:
+                CC_ABORT();
+                return false;
+        }
     }
 
     /// @param responseCode Null not allowed
-    bool perform(long *responseCode) {
-        if (CURLE_OK != curl_easy_perform(_curl))
+    bool finish(CURLcode result, long *responseCode) {
+        if (CURLE_OK != result)
             return false;
         CURLcode code = curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, responseCode);
         if (code != CURLE_OK || !(*responseCode >= 200 && *responseCode < 300)) {
@@ -271,48 +243,193 @@ public:
 
         return true;
     }
+
+    /// @param responseCode Null not allowed
+    bool perform(long *responseCode) {
+        return finish(curl_easy_perform(_curl), responseCode);
+    }
 };
 
-//Process Get Request
-static int processGetTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
+// A request running on the multi handle of the network thread.
+struct Transfer {
     CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_FOLLOWLOCATION, true) && curl.perform(responseCode);
-    return ok ? 0 : 1;
-}
+    HttpResponse *response{nullptr};
+    char errorBuffer[CURL_ERROR_SIZE]{};
+};
 
-//Process POST Request
-static int processPostTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_POST, 1) && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+// write the result to HttpResponse
+static void setResponseResult(HttpResponse *response, bool succeed, long responseCode, const char *responseMessage) {
+    response->setResponseCode(responseCode);
+    if (!succeed) {
+        response->setSucceed(false);
+        response->setErrorBuffer(responseMessage);
+    } else {
+        response->setSucceed(true);
+    }
 }
 
-//Process PUT Request
-static int processPutTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "PUT") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+// Wakes the network thread up, call it with _requestQueueMutex locked.
+static void wakeUpMulti(void *multi) {
+#if CC_CURL_MULTI_POLL
+    if (multi) {
+        curl_multi_wakeup(static_cast<CURLM *>(multi));
+    }
+#endif
 }
 
-//Process HEAD Request
-static int processHeadTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_NOBODY, "HEAD") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
-}
+// Worker thread, runs every queued request on one multi handle so they share connections
+void HttpClient::networkThread() {
+    increaseThreadCount();
 
-//Process DELETE Request
-static int processDeleteTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "DELETE") && curl.setOption(CURLOPT_FOLLOWLOCATION, true) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+    CURLM *multi = curl_multi_init();
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    _requestQueueMutex.lock();
+    _multiHandle = multi;
+    _requestQueueMutex.unlock();
+
+    auto *share = static_cast<CURLSH *>(_shareHandle);
+    ccstd::unordered_set<Transfer *> transfers;
+    ccstd::deque<IntrusivePtr<HttpRequest>> requests;
+    uint32_t maxConnectionsPerHost = UINT32_MAX;
+    int running = 0;
+    bool quit = false;
+
+    auto finishTransfer = [&](Transfer *transfer, CURLcode result) {
+        long responseCode = -1;
+        bool succeed = transfer->curl.finish(result, &responseCode);
+        if (!succeed && !transfer->errorBuffer[0]) {
+            strncpy(transfer->errorBuffer, curl_easy_strerror(result), CURL_ERROR_SIZE - 1);
+        }
+        HttpResponse *response = transfer->response;
+        setResponseResult(response, succeed, responseCode, transfer->errorBuffer);
+        transfers.erase(transfer);
+        delete transfer;
+
+        // add response packet into queue
+        _responseQueueMutex.lock();
+        _responseQueue.push_back(response);
+        _responseQueueMutex.unlock();
+
+        _schedulerMutex.lock();
+        if (auto sche = _scheduler.lock()) {
+            sche->performFunctionInCocosThread(CC_CALLBACK_0(HttpClient::dispatchResponseCallbacks, this));
+        }
+        _schedulerMutex.unlock();
+    };
+
+    while (!quit) {
+        // step 1: start the queued requests, sleep while nothing is running
+        {
+            std::unique_lock<std::mutex> lock(_requestQueueMutex);
+            while (running == 0 && _requestQueue.empty()) {
+                _sleepCondition.wait(lock);
+            }
+            requests.swap(_requestQueue);
+        }
+
+        for (auto &queued : requests) {
+            // the response keeps the request alive, once published only the cocos thread may release it
+            IntrusivePtr<HttpRequest> request = std::move(queued);
+            if (request == _requestSentinel) {
+                quit = true;
+                break;
+            }
+
+            // Create a HttpResponse object, the default setting is http access failed
+            auto *transfer = ccnew Transfer();
+            transfer->response = ccnew HttpResponse(request);
+            transfer->response->addRef(); // NOTE: RefCounted object's reference count is changed to 0 now. so needs to addRef after ccnew.
+            transfers.insert(transfer);
+            bool started = transfer->curl.init(this, share, request, transfer->response, transfer->errorBuffer) &&
+                           transfer->curl.setOption(CURLOPT_PRIVATE, transfer) &&
+                           CURLM_OK == curl_multi_add_handle(multi, transfer->curl.get());
+            if (!started) {
+                request = nullptr;
+                finishTransfer(transfer, CURLE_FAILED_INIT);
+            }
+        }
+        requests.clear();
+        if (quit) {
+            break;
+        }
+
+        uint32_t limit = _maxConnectionsPerHost;
+        if (limit != maxConnectionsPerHost) {
+            maxConnectionsPerHost = limit;
+            curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(limit));
+        }
+
+        // step 2: libcurl async access, hand finished responses to the cocos thread
+        curl_multi_perform(multi, &running);
+        int queued = 0;
+        while (CURLMsg *msg = curl_multi_info_read(multi, &queued)) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+            CURL *handle = msg->easy_handle;
+            CURLcode result = msg->data.result;
+            Transfer *transfer = nullptr;
+            curl_easy_getinfo(handle, CURLINFO_PRIVATE, &transfer);
+            curl_multi_remove_handle(multi, handle);
+            finishTransfer(transfer, result);
+        }
+
+        // step 3: wait for socket activity, timeouts or new requests
+        if (running > 0) {
+#if CC_CURL_MULTI_POLL
+            curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+#else
+            int numfds = 0;
+            curl_multi_wait(multi, nullptr, 0, 50, &numfds);
+            if (numfds == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+#endif
+        }
+    }
+
+    // cleanup: if worker thread received quit signal, drop the running transfers,
+    // their requests and responses are not released since callbacks are no longer dispatched.
+    for (auto *transfer : transfers) {
+        curl_multi_remove_handle(multi, transfer->curl.get());
+        delete transfer;
+    }
+    _requestQueueMutex.lock();
+    _multiHandle = nullptr;
+    _requestQueue.clear();
+    _requestQueueMutex.unlock();
+    curl_multi_cleanup(multi);
+
+    _responseQueueMutex.lock();
+    _responseQueue.clear();
+    _responseQueueMutex.unlock();
+
+    decreaseThreadCountAndMayDeleteThis();
 }
 
-//Process PATCH Request
-static int processPatchTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "PATCH") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+// Worker thread
+void HttpClient::networkThreadAlone(HttpRequest *request, HttpResponse *response) {
+    increaseThreadCount();
+
+    char responseMessage[RESPONSE_BUFFER_SIZE] = {0};
+    processResponse(response, responseMessage);
+
+    _schedulerMutex.lock();
+    if (auto sche = _scheduler.lock()) {
+        sche->performFunctionInCocosThread([this, response, request] {
+            const ccHttpRequestCallback &callback = request->getResponseCallback();
+
+            if (callback != nullptr) {
+                callback(this, response);
+            }
+            response->release();
+            // do not release in other thread
+            request->release();
+        });
+    }
+    _schedulerMutex.unlock();
+
+    decreaseThreadCountAndMayDeleteThis();
 }
 
 // HttpClient implementation
@@ -343,7 +460,8 @@ void HttpClient::destroyInstance() {
     thiz->_schedulerMutex.unlock();
 
     thiz->_requestQueueMutex.lock();
-    thiz->_requestQueue.pushBack(thiz->_requestSentinel);
+    thiz->_requestQueue.push_back(thiz->_requestSentinel);
+    wakeUpMulti(thiz->_multiHandle);
     thiz->_requestQueueMutex.unlock();
 
     thiz->_sleepCondition.notify_one();
@@ -366,6 +484,21 @@ void HttpClient::setSSLVerification(const ccstd::string &caFile) {
     _sslCaFilename = caFile;
 }
 
+void HttpClient::setMaxConnectionsPerHost(uint32_t count) {
+    _maxConnectionsPerHost = count;
+    std::lock_guard<std::mutex> lock(_requestQueueMutex);
+    wakeUpMulti(_multiHandle);
+}
+
+uint32_t HttpClient::getMaxConnectionsPerHost() const {
+    return _maxConnectionsPerHost;
+}
+
+void HttpClient::setScheduler(const std::shared_ptr<Scheduler> &scheduler) {
+    std::lock_guard<std::mutex> lock(_schedulerMutex);
+    _scheduler = scheduler;
+}
+
 HttpClient::HttpClient()
 : _isInited(false),
   _timeoutForConnect(30),
@@ -379,12 +512,24 @@ HttpClient::HttpClient()
         gThreadPool = LegacyThreadPool::newFixedThreadPool(4);
     }
     memset(_responseMessage, 0, RESPONSE_BUFFER_SIZE * sizeof(char));
-    _scheduler = CC_CURRENT_ENGINE()->getScheduler();
+
+    CURLSH *share = curl_share_init();
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lockShare);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_COOKIE);
+    _shareHandle = share;
+
+    if (auto app = CC_CURRENT_APPLICATION()) {
+        _scheduler = app->getEngine()->getScheduler();
+    }
     increaseThreadCount();
 }
 
 HttpClient::~HttpClient() {
     CC_SAFE_RELEASE(_requestSentinel);
+    curl_share_cleanup(static_cast<CURLSH *>(_shareHandle));
     CC_LOG_DEBUG("HttpClient destructor");
 }
 
@@ -414,7 +559,8 @@ void HttpClient::send(HttpRequest *request) {
     request->addRef();
 
     _requestQueueMutex.lock();
-    _requestQueue.pushBack(request);
+    _requestQueue.push_back(request);
+    wakeUpMulti(_multiHandle);
     _requestQueueMutex.unlock();
 
     // Notify thread start to work
@@ -442,8 +588,8 @@ void HttpClient::dispatchResponseCallbacks() {
 
     _responseQueueMutex.lock();
     if (!_responseQueue.empty()) {
-        response = _responseQueue.at(0);
-        _responseQueue.erase(0);
+        response = _responseQueue.front();
+        _responseQueue.pop_front();
     }
     _responseQueueMutex.unlock();
 
@@ -465,83 +611,11 @@ void HttpClient::dispatchResponseCallbacks() {
 void HttpClient::processResponse(HttpResponse *response, char *responseMessage) {
     auto request = response->getHttpRequest();
     long responseCode = -1;
-    int retValue = 0;
 
     // Process the request -> get response packet
-    switch (request->getRequestType()) {
-        case HttpRequest::Type::GET: // HTTP GET
-            retValue = processGetTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        case HttpRequest::Type::POST: // HTTP POST
-            retValue = processPostTask(this, request,
-                                       writeData,
-                                       response->getResponseData(),
-                                       &responseCode,
-                                       writeHeaderData,
-                                       response->getResponseHeader(),
-                                       responseMessage);
-            break;
-
-        case HttpRequest::Type::PUT:
-            retValue = processPutTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        case HttpRequest::Type::HEAD:
-            retValue = processHeadTask(this, request,
-                                       writeData,
-                                       response->getResponseData(),
-                                       &responseCode,
-                                       writeHeaderData,
-                                       response->getResponseHeader(),
-                                       responseMessage);
-            break;
-
-        case HttpRequest::Type::DELETE:
-            retValue = processDeleteTask(this, request,
-                                         writeData,
-                                         response->getResponseData(),
-                                         &responseCode,
-                                         writeHeaderData,
-                                         response->getResponseHeader(),
-                                         responseMessage);
-            break;
-
-        case HttpRequest::Type::PATCH:
-            retValue = processPatchTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        default:
-            CC_ABORT();
-            break;
-    }
-
-    // write data to HttpResponse
-    response->setResponseCode(responseCode);
-    if (retValue != 0) {
-        response->setSucceed(false);
-        response->setErrorBuffer(responseMessage);
-    } else {
-        response->setSucceed(true);
-    }
+    CURLRaii curl;
+    bool succeed = curl.init(this, static_cast<CURLSH *>(_shareHandle), request, response, responseMessage) && curl.perform(&responseCode);
+    setResponseResult(response, succeed, responseCode, responseMessage);
 }
 
 void HttpClient::increaseThreadCount() {
@@ -27,9 +27,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <thread>
-#include "base/RefVector.h"
+#include "base/Ptr.h"
+#include "base/std/container/deque.h"
 #include "network/HttpCookie.h"
 #include "network/HttpRequest.h"
 #include "network/HttpResponse.h"
@@ -96,6 +98,28 @@ public:
      */
     const ccstd::string &getSSLVerification();
 
+    /**
+     * Set the maximum number of connections opened to a single host, requests beyond it wait for a free connection.
+     * Requests to an HTTP/2 host are multiplexed over one connection. Only the libcurl implementation uses it.
+     *
+     * @param count the connection limit, 0 means no limit. The default is 6.
+     */
+    void setMaxConnectionsPerHost(uint32_t count);
+
+    /**
+     * Get the maximum number of connections opened to a single host
+     *
+     * @return the connection limit, 0 means no limit
+     */
+    uint32_t getMaxConnectionsPerHost() const;
+
+    /**
+     * Set the scheduler that runs response callbacks, it is the scheduler of the current engine by default.
+     *
+     * @param scheduler the scheduler, the thread updating it receives the callbacks
+     */
+    void setScheduler(const std::shared_ptr<Scheduler> &scheduler);
+
     /**
      * Add a get request to task queue
      *
@@ -152,12 +176,17 @@ private: // NOLINT(readability-redundant-access-specifiers)
     std::weak_ptr<Scheduler> _scheduler;
     std::mutex _schedulerMutex;
 
-    RefVector<HttpRequest *> _requestQueue;
+    ccstd::deque<IntrusivePtr<HttpRequest>> _requestQueue;
     std::mutex _requestQueueMutex;
 
-    RefVector<HttpResponse *> _responseQueue;
+    ccstd::deque<IntrusivePtr<HttpResponse>> _responseQueue;
     std::mutex _responseQueueMutex;
 
+    std::atomic<uint32_t> _maxConnectionsPerHost{6};
+    // libcurl multi handle of the network thread, guarded by _requestQueueMutex, and share handle of all requests.
+    void *_multiHandle{nullptr};
+    void *_shareHandle{nullptr};
+
     ccstd::string _cookieFilename;
     std::mutex _cookieFileMutex;
 
@@ -0,0 +1,332 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/AssetArchive.h"
+
+#include <zlib.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "base/Log.h"
+#include "platform/FileUtils.h"
+
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+#if (CC_PLATFORM == CC_PLATFORM_ANDROID)
+    #include <android/asset_manager.h>
+    #include "platform/android/FileUtils-android.h"
+#endif
+
+namespace cc {
+
+namespace {
+
+constexpr uint64_t alignTo(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+#if (CC_PLATFORM == CC_PLATFORM_ANDROID)
+constexpr char APK_ASSETS_PREFIX[] = "@assets/";
+constexpr size_t APK_ASSETS_PREFIX_LENGTH = sizeof(APK_ASSETS_PREFIX) - 1;
+#endif
+
+} // namespace
+
+uint64_t AssetArchive::hashPath(const char *path, size_t length) {
+    // FNV-1a, stable across platforms since the hashes are stored in the archive.
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(path[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+bool AssetArchive::open(const ccstd::string &path) {
+    close();
+
+    const ccstd::string suitablePath = FileUtils::getInstance()->getSuitableFOpen(path);
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    HANDLE file = ::CreateFileA(suitablePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    if (::GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    const void *view = mapping ? ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            ::CloseHandle(mapping);
+        }
+        ::CloseHandle(file);
+        return false;
+    }
+    _file = file;
+    _mapping = mapping;
+    _size = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+    #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
+    if (suitablePath.compare(0, APK_ASSETS_PREFIX_LENGTH, APK_ASSETS_PREFIX) == 0) {
+        // Files in the apk have no file descriptor of their own. The buffer of an asset stored
+        // uncompressed is mapped from the apk, a compressed one is inflated into memory once.
+        auto *assetManager = FileUtilsAndroid::getAssetManager();
+        AAsset *asset = assetManager ? AAssetManager_open(assetManager, suitablePath.c_str() + APK_ASSETS_PREFIX_LENGTH, AASSET_MODE_BUFFER) : nullptr;
+        const void *buffer = asset ? AAsset_getBuffer(asset) : nullptr;
+        if (!buffer) {
+            if (asset) {
+                AAsset_close(asset);
+            }
+            return false;
+        }
+        _asset = asset;
+        _data = static_cast<const uint8_t *>(buffer);
+        _path = path;
+        _size = static_cast<uint64_t>(AAsset_getLength64(asset));
+        return validate();
+    }
+    #endif
+    int fd = ::open(suitablePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat statBuf;
+    void *view = MAP_FAILED;
+    if (fstat(fd, &statBuf) == 0 && statBuf.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(statBuf.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping keeps the file alive.
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    _size = static_cast<uint64_t>(statBuf.st_size);
+#endif
+    _data = static_cast<const uint8_t *>(view);
+    _path = path;
+    return validate();
+}
+
+bool AssetArchive::validate() {
+    const auto *header = reinterpret_cast<const Header *>(_data);
+    const bool valid = _size >= sizeof(Header) &&
+                       header->magic == MAGIC &&
+                       header->version == VERSION &&
+                       header->entriesOffset % alignof(Entry) == 0 &&
+                       header->entriesOffset + static_cast<uint64_t>(header->entryCount) * sizeof(Entry) <= _size &&
+                       header->namesOffset + header->namesSize <= _size;
+    if (!valid) {
+        CC_LOG_ERROR("AssetArchive: %s is not a valid archive", _path.c_str());
+        close();
+        return false;
+    }
+
+    _header = header;
+    _entries = reinterpret_cast<const Entry *>(_data + header->entriesOffset);
+    _names = reinterpret_cast<const char *>(_data + header->namesOffset);
+    return true;
+}
+
+void AssetArchive::close() {
+    if (_data) {
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+        ::UnmapViewOfFile(_data);
+        ::CloseHandle(static_cast<HANDLE>(_mapping));
+        ::CloseHandle(static_cast<HANDLE>(_file));
+        _mapping = nullptr;
+        _file = nullptr;
+#else
+    #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
+        if (_asset) {
+            AAsset_close(static_cast<AAsset *>(_asset));
+            _asset = nullptr;
+        } else
+    #endif
+        {
+            munmap(const_cast<uint8_t *>(_data), static_cast<size_t>(_size));
+        }
+#endif
+    }
+    _data = nullptr;
+    _size = 0;
+    _header = nullptr;
+    _entries = nullptr;
+    _names = nullptr;
+    _path.clear();
+}
+
+const AssetArchive::Entry *AssetArchive::find(const ccstd::string &name) const {
+    if (!_header) {
+        return nullptr;
+    }
+
+    const uint64_t hash = hashPath(name.data(), name.size());
+    const Entry *end = _entries + _header->entryCount;
+    const Entry *it = std::lower_bound(_entries, end, hash, [](const Entry &entry, uint64_t value) {
+        return entry.hash < value;
+    });
+    for (; it != end && it->hash == hash; ++it) {
+        if (it->nameLength == name.size() &&
+            static_cast<uint64_t>(it->nameOffset) + it->nameLength <= _header->namesSize &&
+            memcmp(_names + it->nameOffset, name.data(), name.size()) == 0) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+const uint8_t *AssetArchive::getStoredData(const Entry &entry) const {
+    if (entry.compression != Compression::STORED || entry.offset + entry.size > _size) {
+        return nullptr;
+    }
+    return _data + entry.offset;
+}
+
+bool AssetArchive::read(const Entry &entry, void *dst) const {
+    if (entry.offset + entry.compressedSize > _size) {
+        return false;
+    }
+
+    const uint8_t *src = _data + entry.offset;
+    switch (entry.compression) {
+        case Compression::STORED:
+            memcpy(dst, src, entry.size);
+            return true;
+        case Compression::DEFLATE: {
+            auto decodedSize = static_cast<uLongf>(entry.size);
+            int ret = uncompress(static_cast<Bytef *>(dst), &decodedSize, src, static_cast<uLong>(entry.compressedSize));
+            return ret == Z_OK && decodedSize == entry.size;
+        }
+        default:
+            return false;
+    }
+}
+
+void AssetArchiveWriter::addFile(const ccstd::string &name, const void *data, uint32_t size, bool compress) {
+    CC_ASSERT(!name.empty() && name[0] != '/' && name.size() <= UINT16_MAX);
+
+    PendingEntry entry;
+    entry.name = name;
+    entry.size = size;
+    if (compress && size > 0) {
+        auto compressedSize = compressBound(static_cast<uLong>(size));
+        entry.data.resize(compressedSize);
+        if (compress2(entry.data.data(), &compressedSize, static_cast<const Bytef *>(data), static_cast<uLong>(size), Z_BEST_COMPRESSION) == Z_OK &&
+            static_cast<float>(compressedSize) < static_cast<float>(size) * COMPRESSION_THRESHOLD) {
+            entry.data.resize(compressedSize);
+            entry.compression = AssetArchive::Compression::DEFLATE;
+        }
+    }
+    if (entry.compression == AssetArchive::Compression::STORED) {
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        entry.data.assign(bytes, bytes + size);
+    }
+
+    auto it = _indices.find(name);
+    if (it != _indices.end()) {
+        _entries[it->second] = std::move(entry);
+    } else {
+        _indices.emplace(name, static_cast<uint32_t>(_entries.size()));
+        _entries.emplace_back(std::move(entry));
+    }
+}
+
+bool AssetArchiveWriter::save(const ccstd::string &path) const {
+    ccstd::vector<AssetArchive::Entry> entries(_entries.size());
+    ccstd::string names;
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        const auto &pending = _entries[i];
+        auto &entry = entries[i];
+        entry.hash = AssetArchive::hashPath(pending.name.data(), pending.name.size());
+        entry.size = pending.size;
+        entry.compressedSize = static_cast<uint32_t>(pending.data.size());
+        entry.nameOffset = static_cast<uint32_t>(names.size());
+        entry.nameLength = static_cast<uint16_t>(pending.name.size());
+        entry.compression = pending.compression;
+        names += pending.name;
+    }
+
+    AssetArchive::Header header;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.namesSize = static_cast<uint32_t>(names.size());
+    header.entriesOffset = alignTo(sizeof(AssetArchive::Header), alignof(AssetArchive::Entry));
+    header.namesOffset = header.entriesOffset + entries.size() * sizeof(AssetArchive::Entry);
+
+    // Data is laid out in insertion order, the table is sorted by hash afterwards.
+    uint64_t offset = header.namesOffset + names.size();
+    for (auto &entry : entries) {
+        offset = alignTo(offset, AssetArchive::DATA_ALIGNMENT);
+        entry.offset = offset;
+        offset += entry.compressedSize;
+    }
+    ccstd::vector<AssetArchive::Entry> sortedEntries(entries);
+    std::sort(sortedEntries.begin(), sortedEntries.end(), [](const AssetArchive::Entry &lhs, const AssetArchive::Entry &rhs) {
+        return lhs.hash < rhs.hash;
+    });
+
+    FILE *fp = fopen(FileUtils::getInstance()->getSuitableFOpen(path).c_str(), "wb");
+    if (!fp) {
+        return false;
+    }
+
+    bool ok = true;
+    auto write = [&](const void *data, size_t size) {
+        ok = ok && (size == 0 || fwrite(data, 1, size, fp) == size);
+    };
+    const uint8_t padding[AssetArchive::DATA_ALIGNMENT] = {};
+    uint64_t written = 0;
+    auto pad = [&](uint64_t target) {
+        write(padding, static_cast<size_t>(target - written));
+        written = target;
+    };
+
+    write(&header, sizeof(header));
+    written = sizeof(header);
+    pad(header.entriesOffset);
+    write(sortedEntries.data(), sortedEntries.size() * sizeof(AssetArchive::Entry));
+    write(names.data(), names.size());
+    written = header.namesOffset + names.size();
+    for (size_t i = 0; i < entries.size(); ++i) {
+        pad(entries[i].offset);
+        write(_entries[i].data.data(), _entries[i].data.size());
+        written += _entries[i].data.size();
+    }
+
+    fclose(fp);
+    return ok;
+}
+
+} // namespace cc
@@ -0,0 +1,141 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+/**
+ * Read-only, memory-mapped asset archive.
+ *
+ * Layout: a fixed header, the entry table sorted by path hash, the path blob, then the entry data.
+ * The table is used in place, so opening an archive costs one mmap and a header check no matter how
+ * many entries it holds, and a lookup is a binary search over the hashes.
+ * Stored entries are served straight from the mapping; compressed entries are deflate streams that
+ * are decoded into the caller's buffer.
+ */
+class CC_DLL AssetArchive final {
+public:
+    static constexpr uint32_t MAGIC = 0x52414343; // "CCAR"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t DATA_ALIGNMENT = 16;
+
+    enum class Compression : uint8_t {
+        STORED,
+        DEFLATE,
+    };
+
+    struct Header {
+        uint32_t magic{MAGIC};
+        uint32_t version{VERSION};
+        uint32_t entryCount{0};
+        uint32_t namesSize{0};
+        uint64_t entriesOffset{0};
+        uint64_t namesOffset{0};
+    };
+
+    struct Entry {
+        uint64_t hash{0};
+        uint64_t offset{0};
+        uint32_t size{0};
+        uint32_t compressedSize{0};
+        uint32_t nameOffset{0};
+        uint16_t nameLength{0};
+        Compression compression{Compression::STORED};
+        uint8_t reserved{0};
+    };
+
+    static uint64_t hashPath(const char *path, size_t length);
+
+    AssetArchive() = default;
+    ~AssetArchive();
+
+    // On Android, "@assets/" paths are opened from the apk. Keep the archive uncompressed in the apk
+    // (noCompress) so that it is mapped like a file instead of inflated into memory.
+    bool open(const ccstd::string &path);
+    void close();
+    inline bool isOpen() const { return _data != nullptr; }
+    inline const ccstd::string &getPath() const { return _path; }
+    inline uint32_t getEntryCount() const { return _header ? _header->entryCount : 0; }
+
+    // `name` is relative to the archive root, '/' separated and without a leading slash.
+    const Entry *find(const ccstd::string &name) const;
+
+    // Returns the entry bytes inside the mapping, only for stored entries. Valid until close().
+    const uint8_t *getStoredData(const Entry &entry) const;
+
+    // Decodes the entry into `dst`, which must hold at least `entry.size` bytes.
+    bool read(const Entry &entry, void *dst) const;
+
+private:
+    // Checks the header of the data just opened, closes the archive if it is invalid.
+    bool validate();
+
+    ccstd::string _path;
+    const uint8_t *_data{nullptr};
+    uint64_t _size{0};
+    const Header *_header{nullptr};
+    const Entry *_entries{nullptr};
+    const char *_names{nullptr};
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    void *_file{nullptr};
+    void *_mapping{nullptr};
+#elif (CC_PLATFORM == CC_PLATFORM_ANDROID)
+    // AAsset holding the data of an archive inside the apk, null if the archive is mapped from a file
+    void *_asset{nullptr};
+#endif
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(AssetArchive);
+};
+
+/**
+ * Builds an AssetArchive file, used by the packing tools and tests.
+ */
+class CC_DLL AssetArchiveWriter final {
+public:
+    // Entries that deflate to less than this ratio of their size are stored compressed.
+    static constexpr float COMPRESSION_THRESHOLD = 0.9F;
+
+    void addFile(const ccstd::string &name, const void *data, uint32_t size, bool compress = true);
+    bool save(const ccstd::string &path) const;
+
+private:
+    struct PendingEntry {
+        ccstd::string name;
+        ccstd::vector<uint8_t> data;
+        uint32_t size{0};
+        AssetArchive::Compression compression{AssetArchive::Compression::STORED};
+    };
+
+    ccstd::vector<PendingEntry> _entries;
+    ccstd::unordered_map<ccstd::string, uint32_t> _indices;
+};
+
+} // namespace cc
@@ -27,6 +27,7 @@
 #include <cstring>
 #include <stack>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <iostream>
@@ -535,12 +536,102 @@ bool FileUtils::writeDataToFile(const Data &data, const ccstd::string &fullPath)
 bool FileUtils::init() {
     addSearchPath("Resources", true);
     addSearchPath("data", true);
-    _searchPathArray.push_back(_defaultResRootPath);
+    _searchPathLock.lockWrite([this]() {
+        _searchPathArray.push_back(_defaultResRootPath);
+        ++_searchPathVersion;
+    });
     return true;
 }
 
 void FileUtils::purgeCachedEntries() {
-    _fullPathCache.clear();
+    clearFullPathCache();
+    _directoryIndex.lock.lockWrite([this]() {
+        _directoryIndex.directories.clear();
+    });
+}
+
+ccstd::unordered_map<ccstd::string, ccstd::string> FileUtils::getFullPathCache() const {
+    ccstd::unordered_map<ccstd::string, ccstd::string> paths;
+    for (auto &shard : _fullPathCache) {
+        shard.lock.lockRead([&]() {
+            paths.insert(shard.paths.begin(), shard.paths.end());
+        });
+    }
+    return paths;
+}
+
+bool FileUtils::findCachedFullPath(const ccstd::string &filename, ccstd::string *fullPath) const {
+    auto &shard = _fullPathCache[std::hash<ccstd::string>{}(filename) % FULL_PATH_CACHE_SHARD_COUNT];
+    return shard.lock.lockRead([&]() {
+        auto iter = shard.paths.find(filename);
+        if (iter == shard.paths.end()) {
+            return false;
+        }
+        *fullPath = iter->second;
+        return true;
+    });
+}
+
+void FileUtils::cacheFullPath(const ccstd::string &filename, const ccstd::string &fullPath, uint32_t searchPathVersion) const {
+    // Holding the read lock keeps the search paths from changing until the result is cached.
+    _searchPathLock.lockRead([&]() {
+        if (searchPathVersion != _searchPathVersion) {
+            return;
+        }
+        auto &shard = _fullPathCache[std::hash<ccstd::string>{}(filename) % FULL_PATH_CACHE_SHARD_COUNT];
+        shard.lock.lockWrite([&]() {
+            shard.paths.emplace(filename, fullPath);
+        });
+    });
+}
+
+void FileUtils::clearFullPathCache() const {
+    for (auto &shard : _fullPathCache) {
+        shard.lock.lockWrite([&]() {
+            shard.paths.clear();
+        });
+    }
+}
+
+void FileUtils::setDirectoryIndexEnabled(bool enabled) {
+    if (_directoryIndexEnabled.exchange(enabled) != enabled) {
+        purgeCachedEntries();
+    }
+}
+
+bool FileUtils::findInDirectoryIndex(const ccstd::string &fullPath, bool *exists) const {
+    size_t pos = fullPath.find_last_of('/');
+    if (!isDirectoryIndexEnabled() || pos == ccstd::string::npos) {
+        return false;
+    }
+
+    const ccstd::string directory = fullPath.substr(0, pos + 1);
+    const ccstd::string name = fullPath.substr(pos + 1);
+    // -1: not listed yet, 0: can't be listed, 1: listed.
+    int state = _directoryIndex.lock.lockRead([&]() {
+        auto iter = _directoryIndex.directories.find(directory);
+        if (iter == _directoryIndex.directories.end()) {
+            return -1;
+        }
+        *exists = iter->second.count(name) != 0;
+        return iter->second.empty() ? 0 : 1;
+    });
+
+    if (state < 0) {
+        // Listed without the lock, two threads may list the same directory once, the result is the same.
+        ccstd::unordered_set<ccstd::string> files;
+        for (const auto &path : listFiles(directory)) {
+            if (!path.empty() && path.back() != '/') {
+                files.emplace(path.substr(path.find_last_of('/') + 1));
+            }
+        }
+        *exists = files.count(name) != 0;
+        state = files.empty() ? 0 : 1;
+        _directoryIndex.lock.lockWrite([&]() {
+            _directoryIndex.directories.emplace(directory, std::move(files));
+        });
+    }
+    return state > 0;
 }
 
 ccstd::string FileUtils::getStringFromFile(const ccstd::string &filename) {
@@ -567,6 +658,16 @@ FileUtils::Status FileUtils::getContents(const ccstd::string &filename, Resizabl
         return Status::NOT_EXISTS;
     }
 
+    std::shared_ptr<const AssetArchive> archive;
+    if (const auto *entry = fs->findArchiveEntry(fullPath, &archive)) {
+        buffer->resize(entry->size);
+        if (entry->size > 0 && !archive->read(*entry, buffer->buffer())) {
+            buffer->resize(0);
+            return Status::READ_FAILED;
+        }
+        return Status::OK;
+    }
+
     FILE *fp = fopen(fs->getSuitableFOpen(fullPath).c_str(), "rb");
     if (!fp) {
         return Status::OPEN_FAILED;
@@ -661,24 +762,58 @@ ccstd::string FileUtils::fullPathForFilename(const ccstd::string &filename) cons
         return normalizePath(filename);
     }
 
+    ccstd::string fullpath;
+
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(filename);
-    if (cacheIter != _fullPathCache.end()) {
-        return cacheIter->second;
+    if (findCachedFullPath(filename, &fullpath)) {
+        return fullpath;
     }
 
-    ccstd::string fullpath;
+    // Probe the file system on copies, so slow lookups don't hold the lock.
+    ccstd::vector<ccstd::string> searchPaths;
+    ccstd::vector<SearchArchive> searchArchives;
+    uint32_t searchPathVersion = 0;
+    _searchPathLock.lockRead([&]() {
+        searchPaths = _searchPathArray;
+        searchArchives = _searchArchives;
+        searchPathVersion = _searchPathVersion;
+    });
+
+    auto findInArchives = [&](bool front) {
+        for (const auto &searchArchive : searchArchives) {
+            if (searchArchive.front != front) {
+                continue;
+            }
+            fullpath = normalizePath(searchArchive.mountPath + filename);
+            if (fullpath.compare(0, searchArchive.mountPath.size(), searchArchive.mountPath) == 0 &&
+                searchArchive.archive->find(fullpath.substr(searchArchive.mountPath.size()))) {
+                return true;
+            }
+        }
+        fullpath.clear();
+        return false;
+    };
+
+    if (findInArchives(true)) {
+        cacheFullPath(filename, fullpath, searchPathVersion);
+        return fullpath;
+    }
 
-    for (const auto &searchIt : _searchPathArray) {
+    for (const auto &searchIt : searchPaths) {
         fullpath = this->getPathForFilename(filename, searchIt);
 
         if (!fullpath.empty()) {
             // Using the filename passed in as key.
-            _fullPathCache.emplace(filename, fullpath);
+            cacheFullPath(filename, fullpath, searchPathVersion);
             return fullpath;
         }
     }
 
+    if (findInArchives(false)) {
+        cacheFullPath(filename, fullpath, searchPathVersion);
+        return fullpath;
+    }
+
     // The file wasn't found, return empty string.
     return "";
 }
@@ -705,22 +840,29 @@ const ccstd::string &FileUtils::getDefaultResourceRootPath() const {
 
 void FileUtils::setDefaultResourceRootPath(const ccstd::string &path) {
     if (_defaultResRootPath != path) {
-        _fullPathCache.clear();
-        _defaultResRootPath = path;
-        if (!_defaultResRootPath.empty() && _defaultResRootPath[_defaultResRootPath.length() - 1] != '/') {
-            _defaultResRootPath += '/';
-        }
+        _searchPathLock.lockWrite([&]() {
+            _defaultResRootPath = path;
+            if (!_defaultResRootPath.empty() && _defaultResRootPath[_defaultResRootPath.length() - 1] != '/') {
+                _defaultResRootPath += '/';
+            }
+        });
 
         // Updates search paths
-        setSearchPaths(_originalSearchPaths);
+        setSearchPaths(ccstd::vector<ccstd::string>{_originalSearchPaths});
     }
 }
 
 void FileUtils::setSearchPaths(const ccstd::vector<ccstd::string> &searchPaths) {
+    _searchPathLock.lockWrite([&]() {
+        setSearchPathsLocked(searchPaths);
+        ++_searchPathVersion;
+        clearFullPathCache();
+    });
+}
+
+void FileUtils::setSearchPathsLocked(const ccstd::vector<ccstd::string> &searchPaths) {
     bool existDefaultRootPath = false;
     _originalSearchPaths = searchPaths;
-
-    _fullPathCache.clear();
     _searchPathArray.clear();
 
     for (const auto &path : _originalSearchPaths) {
@@ -756,13 +898,84 @@ void FileUtils::addSearchPath(const ccstd::string &searchpath, bool front) {
     if (!path.empty() && path[path.length() - 1] != '/') {
         path += "/";
     }
-    if (front) {
-        _originalSearchPaths.insert(_originalSearchPaths.begin(), searchpath);
-        _searchPathArray.insert(_searchPathArray.begin(), path);
-    } else {
-        _originalSearchPaths.push_back(searchpath);
-        _searchPathArray.push_back(path);
+    _searchPathLock.lockWrite([&]() {
+        if (front) {
+            _originalSearchPaths.insert(_originalSearchPaths.begin(), searchpath);
+            _searchPathArray.insert(_searchPathArray.begin(), path);
+        } else {
+            _originalSearchPaths.push_back(searchpath);
+            _searchPathArray.push_back(path);
+        }
+        ++_searchPathVersion;
+    });
+}
+
+bool FileUtils::addSearchArchive(const ccstd::string &archivePath, bool front) {
+    ccstd::string fullPath = fullPathForFilename(archivePath);
+    if (fullPath.empty()) {
+        return false;
+    }
+
+    removeSearchArchive(fullPath);
+    auto archive = std::make_shared<AssetArchive>();
+    if (!archive->open(fullPath)) {
+        CC_LOG_ERROR("Can not open asset archive %s", fullPath.c_str());
+        return false;
     }
+
+    SearchArchive searchArchive{fullPath + "/", std::move(archive), front};
+    _searchPathLock.lockWrite([&]() {
+        if (front) {
+            _searchArchives.insert(_searchArchives.begin(), std::move(searchArchive));
+        } else {
+            _searchArchives.emplace_back(std::move(searchArchive));
+        }
+        ++_searchPathVersion;
+        clearFullPathCache();
+    });
+    return true;
+}
+
+void FileUtils::removeSearchArchive(const ccstd::string &archivePath) {
+    ccstd::string fullPath = fullPathForFilename(archivePath);
+    _searchPathLock.lockWrite([&]() {
+        auto iter = std::remove_if(_searchArchives.begin(), _searchArchives.end(), [&](const SearchArchive &searchArchive) {
+            return searchArchive.archive->getPath() == fullPath;
+        });
+        if (iter != _searchArchives.end()) {
+            _searchArchives.erase(iter, _searchArchives.end());
+            ++_searchPathVersion;
+            clearFullPathCache();
+        }
+    });
+}
+
+bool FileUtils::getMappedContents(const ccstd::string &filename, const uint8_t **data, size_t *size) const {
+    std::shared_ptr<const AssetArchive> archive;
+    const auto *entry = findArchiveEntry(fullPathForFilename(filename), &archive);
+    const uint8_t *bytes = entry ? archive->getStoredData(*entry) : nullptr;
+    if (!bytes) {
+        return false;
+    }
+    *data = bytes;
+    *size = entry->size;
+    return true;
+}
+
+const AssetArchive::Entry *FileUtils::findArchiveEntry(const ccstd::string &fullPath, std::shared_ptr<const AssetArchive> *archive) const {
+    return _searchPathLock.lockRead([&]() -> const AssetArchive::Entry * {
+        for (const auto &searchArchive : _searchArchives) {
+            const auto &mountPath = searchArchive.mountPath;
+            if (fullPath.size() > mountPath.size() && fullPath.compare(0, mountPath.size(), mountPath) == 0) {
+                const auto *entry = searchArchive.archive->find(fullPath.substr(mountPath.size()));
+                if (entry && archive) {
+                    *archive = searchArchive.archive;
+                }
+                return entry;
+            }
+        }
+        return nullptr;
+    });
 }
 
 ccstd::string FileUtils::getFullPathForDirectoryAndFilename(const ccstd::string &directory, const ccstd::string &filename) const {
@@ -775,7 +988,11 @@ ccstd::string FileUtils::getFullPathForDirectoryAndFilename(const ccstd::string
     ret = normalizePath(ret);
 
     // if the file doesn't exist, return an empty string
-    if (!isFileExistInternal(ret)) {
+    bool exists = false;
+    if (!findInDirectoryIndex(ret, &exists)) {
+        exists = isFileExistInternal(ret);
+    }
+    if (!exists) {
         ret = "";
     }
     return ret;
@@ -783,7 +1000,8 @@ ccstd::string FileUtils::getFullPathForDirectoryAndFilename(const ccstd::string
 
 bool FileUtils::isFileExist(const ccstd::string &filename) const {
     if (isAbsolutePath(filename)) {
-        return isFileExistInternal(normalizePath(filename));
+        ccstd::string fullpath = normalizePath(filename);
+        return findArchiveEntry(fullpath, nullptr) || isFileExistInternal(fullpath);
     }
     ccstd::string fullpath = fullPathForFilename(filename);
     return !fullpath.empty();
@@ -800,18 +1018,24 @@ bool FileUtils::isDirectoryExist(const ccstd::string &dirPath) const {
         return isDirectoryExistInternal(normalizePath(dirPath));
     }
 
+    ccstd::string fullpath;
+
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(dirPath);
-    if (cacheIter != _fullPathCache.end()) {
-        return isDirectoryExistInternal(cacheIter->second);
+    if (findCachedFullPath(dirPath, &fullpath)) {
+        return isDirectoryExistInternal(fullpath);
     }
 
-    ccstd::string fullpath;
-    for (const auto &searchIt : _searchPathArray) {
+    ccstd::vector<ccstd::string> searchPaths;
+    uint32_t searchPathVersion = 0;
+    _searchPathLock.lockRead([&]() {
+        searchPaths = _searchPathArray;
+        searchPathVersion = _searchPathVersion;
+    });
+    for (const auto &searchIt : searchPaths) {
         // searchPath + file_path
         fullpath = fullPathForFilename(searchIt + dirPath);
         if (isDirectoryExistInternal(fullpath)) {
-            _fullPathCache.emplace(dirPath, fullpath);
+            cacheFullPath(dirPath, fullpath, searchPathVersion);
             return true;
         }
     }
@@ -1111,6 +1335,10 @@ long FileUtils::getFileSize(const ccstd::string &filepath) { //NOLINT(google-run
         }
     }
 
+    if (const auto *entry = findArchiveEntry(fullpath, nullptr)) {
+        return static_cast<long>(entry->size); // NOLINT(google-runtime-int)
+    }
+
     struct stat info;
     // Get data associated with "crt_stat.c":
     int result = stat(fullpath.c_str(), &info);
@@ -1157,8 +1385,10 @@ ccstd::string FileUtils::getFileDir(const ccstd::string &path) const {
 ccstd::string FileUtils::normalizePath(const ccstd::string &path) const {
     ccstd::string ret;
     // Normalize: remove . and ..
-    ret = std::regex_replace(path, std::regex("/\\./"), "/");
-    ret = std::regex_replace(ret, std::regex("/\\.$"), "");
+    static const std::regex CURRENT_DIR_PATTERN{"/\\./"};
+    static const std::regex TRAILING_CURRENT_DIR_PATTERN{"/\\.$"};
+    ret = std::regex_replace(path, CURRENT_DIR_PATTERN, "/");
+    ret = std::regex_replace(ret, TRAILING_CURRENT_DIR_PATTERN, "");
 
     size_t pos;
     while ((pos = ret.find("..")) != ccstd::string::npos && pos > 2) {
@@ -24,13 +24,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <type_traits>
 #include "base/Data.h"
 #include "base/Macros.h"
 #include "base/Value.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/container/unordered_set.h"
 #include "base/std/container/vector.h"
+#include "base/threading/ReadWriteLock.h"
+#include "platform/AssetArchive.h"
 
 namespace cc {
 
@@ -99,7 +104,11 @@ public:
     }
 };
 
-/** Helper class to handle file operations. */
+/**
+ * Helper class to handle file operations.
+ * Path resolution (fullPathForFilename, isFileExist, getContents) may run on any thread, search paths are
+ * expected to be changed from one thread.
+ */
 class CC_DLL FileUtils {
 public:
     /**
@@ -138,7 +147,7 @@ public:
     virtual ~FileUtils();
 
     /**
-     *  Purges full path caches.
+     *  Purges full path caches and the directory index.
      */
     virtual void purgeCachedEntries();
 
@@ -332,6 +341,28 @@ public:
       */
     void addSearchPath(const ccstd::string &path, bool front = false);
 
+    /**
+     *  Mounts an asset archive as a search path source.
+     *  A file found in the archive resolves to "<archive full path>/<name>", and is read from the mapped archive.
+     *
+     *  @param archivePath The archive file, a relative path is resolved with fullPathForFilename.
+     *  @param front Whether the archive is searched before the search paths, otherwise after them.
+     *  @return True if the archive was opened.
+     */
+    bool addSearchArchive(const ccstd::string &archivePath, bool front = false);
+
+    /**
+     *  Unmounts an archive added by addSearchArchive, pointers returned by getMappedContents for it become invalid.
+     */
+    void removeSearchArchive(const ccstd::string &archivePath);
+
+    /**
+     *  Gets the bytes of a file stored uncompressed in a mounted archive, without copying them.
+     *
+     *  @return False if the file is not a stored archive entry, use getContents for it instead.
+     */
+    bool getMappedContents(const ccstd::string &filename, const uint8_t **data, size_t *size) const;
+
     /**
      *  Gets the array of search paths.
      *
@@ -535,8 +566,17 @@ public:
      */
     virtual long getFileSize(const ccstd::string &filepath); //NOLINT(google-runtime-int)
 
-    /** Returns the full path cache. */
-    const ccstd::unordered_map<ccstd::string, ccstd::string> &getFullPathCache() const { return _fullPathCache; }
+    /** Returns a copy of the full path cache. */
+    ccstd::unordered_map<ccstd::string, ccstd::string> getFullPathCache() const;
+
+    /**
+     *  Enables the directory index. The first lookup in a directory lists it once, later lookups in it
+     *  are answered from the listing instead of a stat call.
+     *  Files added to a search path afterwards are not seen until purgeCachedEntries is called,
+     *  so enable it when the search paths are read-only.
+     */
+    void setDirectoryIndexEnabled(bool enabled);
+    inline bool isDirectoryIndexEnabled() const { return _directoryIndexEnabled.load(std::memory_order_relaxed); }
 
     virtual ccstd::string normalizePath(const ccstd::string &path) const;
     virtual ccstd::string getFileDir(const ccstd::string &path) const;
@@ -587,6 +627,44 @@ protected:
      */
     virtual ccstd::string getFullPathForDirectoryAndFilename(const ccstd::string &directory, const ccstd::string &filename) const;
 
+    /**
+     *  Finds the archive entry a full path resolved to, nullptr if the path is not inside a mounted archive.
+     */
+    const AssetArchive::Entry *findArchiveEntry(const ccstd::string &fullPath, std::shared_ptr<const AssetArchive> *archive) const;
+
+    void setSearchPathsLocked(const ccstd::vector<ccstd::string> &searchPaths);
+    bool findCachedFullPath(const ccstd::string &filename, ccstd::string *fullPath) const;
+    void cacheFullPath(const ccstd::string &filename, const ccstd::string &fullPath, uint32_t searchPathVersion) const;
+    void clearFullPathCache() const;
+
+    /**
+     *  Looks a full path up in the directory index.
+     *  @return False if the index is disabled or can't list the directory, `exists` is only set otherwise.
+     */
+    bool findInDirectoryIndex(const ccstd::string &fullPath, bool *exists) const;
+
+    struct SearchArchive {
+        ccstd::string mountPath;
+        std::shared_ptr<AssetArchive> archive;
+        bool front{false};
+    };
+
+    /**
+     * The archives mounted by addSearchArchive, the front ones first.
+     */
+    ccstd::vector<SearchArchive> _searchArchives;
+
+    /**
+     * Guards the search paths, the archives and the default root path. Lookups copy what they need under
+     * the read lock and probe the file system without holding it.
+     */
+    mutable ReadWriteLock _searchPathLock;
+
+    /**
+     * Bumped whenever the search paths change, so a lookup that raced with the change doesn't cache its result.
+     */
+    uint32_t _searchPathVersion{0};
+
     /**
      * The vector contains search paths.
      * The lower index of the element in this vector, the higher priority for this search path.
@@ -610,8 +688,25 @@ protected:
     /**
      *  The full path cache. When a file is found, it will be added into this cache.
      *  This variable is used for improving the performance of file search.
+     *  It is sharded by file name hash, so lookups from several loader threads rarely wait on each other.
      */
-    mutable ccstd::unordered_map<ccstd::string, ccstd::string> _fullPathCache;
+    static constexpr uint32_t FULL_PATH_CACHE_SHARD_COUNT = 16;
+    struct FullPathCacheShard {
+        ReadWriteLock lock;
+        ccstd::unordered_map<ccstd::string, ccstd::string> paths;
+    };
+    mutable FullPathCacheShard _fullPathCache[FULL_PATH_CACHE_SHARD_COUNT];
+
+    /**
+     *  File names listed per directory when the directory index is enabled, an empty set marks a
+     *  directory that can't be listed.
+     */
+    struct DirectoryIndex {
+        ReadWriteLock lock;
+        ccstd::unordered_map<ccstd::string, ccstd::unordered_set<ccstd::string>> directories;
+    };
+    mutable DirectoryIndex _directoryIndex;
+    std::atomic<bool> _directoryIndexEnabled{false};
 
     /**
      * Writable path.
@@ -37,6 +37,7 @@
 
 #include "base/Data.h"
 #include "base/Log.h"
+#include "base/PixelConvert.h"
 #include "base/Utils.h"
 #include "gfx-base/GFXDef.h"
 
@@ -259,6 +260,11 @@ void pngReadCallback(png_structp pngPtr, png_bytep data, png_size_t length) {
     }
 }
 #endif //CC_USE_PNG
+
+// Expands one decoded L8 (1 component) or RGB8 (3 components) row to RGBA8.
+void expandRowToRGBA8(const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t components) {
+    pixel::convertPixels(components == 1 ? pixel::Conversion::L8_TO_RGBA8 : pixel::Conversion::RGB8_TO_RGBA8, src, dst, width);
+}
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -272,11 +278,18 @@ Image::~Image() {
     CC_SAFE_FREE(_data);
 }
 
+void Image::setExpandToRGBA8(gfx::Format format, bool expand) {
+    _expandToRGBA8.set(static_cast<size_t>(format), expand);
+}
+
+bool Image::isExpandedToRGBA8(gfx::Format format) const {
+    return _expandToRGBA8.test(static_cast<size_t>(format));
+}
+
 bool Image::initWithImageFile(const ccstd::string &path) {
     bool ret = false;
-    //NOTE: fullPathForFilename isn't threadsafe. we should make sure the parameter is a full path.
-    //    _filePath = FileUtils::getInstance()->fullPathForFilename(path);
-    _filePath = path;
+    // fullPathForFilename is thread-safe, images may be loaded from worker threads.
+    _filePath = FileUtils::getInstance()->fullPathForFilename(path);
 
     const Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
 
@@ -527,6 +540,8 @@ bool Image::initWithJpgData(const unsigned char *data, uint32_t dataLen) {
     /* libjpeg data structure for storing one row, that is, scanline of an image */
     JSAMPROW rowPointer[1] = {nullptr};
     uint32_t location = 0;
+    /* a single row of scratch memory for rows expanded to RGBA8, volatile since it is freed after longjmp */
+    unsigned char *volatile scanline = nullptr;
 
     bool ret = false;
     do {
@@ -539,6 +554,7 @@ bool Image::initWithJpgData(const unsigned char *data, uint32_t dataLen) {
              * We need to clean up the JPEG object, close the input file, and return.
              */
             jpeg_destroy_decompress(&cinfo);
+            CC_SAFE_FREE(scanline);
             break;
         }
 
@@ -562,6 +578,17 @@ bool Image::initWithJpgData(const unsigned char *data, uint32_t dataLen) {
             cinfo.out_color_space = JCS_RGB;
             _renderFormat = gfx::Format::RGB8;
         }
+        bool expand = isExpandedToRGBA8(_renderFormat);
+    #ifdef JCS_EXTENSIONS
+        // libjpeg-turbo writes RGBA rows itself.
+        if (expand && _renderFormat == gfx::Format::RGB8) {
+            cinfo.out_color_space = JCS_EXT_RGBA;
+            expand = false;
+        }
+    #endif
+        if (isExpandedToRGBA8(_renderFormat)) {
+            _renderFormat = gfx::Format::RGBA8;
+        }
 
         /* Start decompression jpeg here */
         jpeg_start_decompress(&cinfo);
@@ -570,17 +597,25 @@ bool Image::initWithJpgData(const unsigned char *data, uint32_t dataLen) {
         _isCompressed = false;
         _width = cinfo.output_width;
         _height = cinfo.output_height;
-        _dataLen = cinfo.output_width * cinfo.output_height * cinfo.output_components;
+        const uint32_t dstComponents = expand ? 4 : cinfo.output_components;
+        _dataLen = cinfo.output_width * cinfo.output_height * dstComponents;
         _data = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
         CC_BREAK_IF(!_data);
 
         /* now actually read the jpeg into the raw buffer */
         /* read one scan line at a time */
+        if (expand) {
+            scanline = static_cast<unsigned char *>(malloc(cinfo.output_width * cinfo.output_components));
+        }
         while (cinfo.output_scanline < cinfo.output_height) {
-            rowPointer[0] = _data + location;
-            location += cinfo.output_width * cinfo.output_components;
+            rowPointer[0] = expand ? scanline : _data + location;
             jpeg_read_scanlines(&cinfo, rowPointer, 1);
+            if (expand) {
+                expandRowToRGBA8(scanline, _data + location, cinfo.output_width, cinfo.output_components);
+            }
+            location += cinfo.output_width * dstComponents;
         }
+        CC_SAFE_FREE(scanline);
 
         /* When read image file with broken data, jpeg_finish_decompress() may cause error.
          * Besides, jpeg_destroy_decompress() shall deallocate and release all memory associated
@@ -667,6 +702,18 @@ bool Image::initWithPngData(const unsigned char *data, uint32_t dataLen) {
         if (bitDepth < 8) {
             png_set_packing(pngPtr);
         }
+        // expand to RGBA8 while reading rows if the output format isn't wanted as is
+        const bool isGray = (colorType & PNG_COLOR_MASK_COLOR) == 0;
+        const bool hasAlpha = (colorType & PNG_COLOR_MASK_ALPHA) != 0 || png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS);
+        const gfx::Format decodedFormat = isGray ? (hasAlpha ? gfx::Format::LA8 : gfx::Format::L8) : (hasAlpha ? gfx::Format::RGBA8 : gfx::Format::RGB8);
+        if (isExpandedToRGBA8(decodedFormat)) {
+            if (isGray) {
+                png_set_gray_to_rgb(pngPtr);
+            }
+            if (!hasAlpha) {
+                png_set_add_alpha(pngPtr, 0xFF, PNG_FILLER_AFTER);
+            }
+        }
         // update info
         png_read_update_info(pngPtr, infoPtr);
         colorType = png_get_color_type(pngPtr, infoPtr);
@@ -947,17 +994,19 @@ bool Image::initWithWebpData(const unsigned char *data, uint32_t dataLen) {
         if (WebPGetFeatures(static_cast<const uint8_t *>(data), dataLen, &config.input) != VP8_STATUS_OK) break;
         if (config.input.width == 0 || config.input.height == 0) break;
 
-        config.output.colorspace = config.input.has_alpha ? MODE_rgbA : MODE_RGB;
-        _renderFormat = config.input.has_alpha ? gfx::Format::RGBA8 : gfx::Format::RGB8;
+        const bool expand = !config.input.has_alpha && isExpandedToRGBA8(gfx::Format::RGB8);
+        const int components = config.input.has_alpha || expand ? 4 : 3;
+        config.output.colorspace = config.input.has_alpha ? MODE_rgbA : (expand ? MODE_RGBA : MODE_RGB);
+        _renderFormat = components == 4 ? gfx::Format::RGBA8 : gfx::Format::RGB8;
         _width = config.input.width;
         _height = config.input.height;
         _isCompressed = false;
 
-        _dataLen = _width * _height * (config.input.has_alpha ? 4 : 3);
+        _dataLen = _width * _height * components;
         _data = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
 
         config.output.u.RGBA.rgba = static_cast<uint8_t *>(_data);
-        config.output.u.RGBA.stride = _width * (config.input.has_alpha ? 4 : 3);
+        config.output.u.RGBA.stride = _width * components;
         config.output.u.RGBA.size = _dataLen;
         config.output.is_external_memory = 1;
 
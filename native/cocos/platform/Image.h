@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <bitset>
 #include "base/RefCounted.h"
 #include "base/std/container/string.h"
 #include "gfx-base/GFXDef.h"
@@ -64,6 +65,13 @@ public:
     bool initWithImageFile(const ccstd::string &path);
     bool initWithImageData(const unsigned char *data, uint32_t dataLen);
 
+    /**
+     * Makes the PNG/JPEG/WebP decoders expand `format` output to RGBA8 while decoding rows, e.g. when the
+     * device can't sample it. Only L8, LA8 and RGB8 are affected, call it before the init functions.
+     */
+    void setExpandToRGBA8(gfx::Format format, bool expand);
+    bool isExpandedToRGBA8(gfx::Format format) const;
+
     // @warning kFmtRawData only support RGBA8888
     bool initWithRawData(const unsigned char *data, uint32_t dataLen, int width, int height, int bitsPerComponent, bool preMulti = false);
 
@@ -117,6 +125,7 @@ protected:
     ccstd::string _filePath;
     bool _isCompressed = false;
     ccstd::vector<uint32_t> _mipmapLevelDataSize;
+    std::bitset<static_cast<size_t>(gfx::Format::COUNT)> _expandToRGBA8;
 
     static Format detectFormat(const unsigned char *data, uint32_t dataLen);
     static bool isPng(const unsigned char *data, uint32_t dataLen);
@@ -171,7 +171,8 @@ FileUtils::Status FileUtilsAndroid::getContents(const ccstd::string &filename, R
         return FileUtils::Status::NOT_EXISTS;
     }
 
-    if (fullPath[0] == '/') {
+    // files in archives inside the apk are read from the mounted archive
+    if (fullPath[0] == '/' || findArchiveEntry(fullPath, nullptr)) {
         return FileUtils::getContents(fullPath, buffer);
     }
 
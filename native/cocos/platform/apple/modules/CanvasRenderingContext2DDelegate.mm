@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "platform/apple/modules/CanvasRenderingContext2DDelegate.h"
+#include "base/PixelConvert.h"
 #include "base/UTF8.h"
 #include "base/csscolorparser.h"
 #include "math/Math.h"
@@ -682,17 +683,8 @@ void CanvasRenderingContext2DDelegate::fillImageData(const Data &imageData, floa
 void CanvasRenderingContext2DDelegate::fillData() {
 }
 
-#define CLAMP(V, HI) std::min((V), (HI))
 void CanvasRenderingContext2DDelegate::unMultiplyAlpha(unsigned char *ptr, uint32_t size) const {
-    float alpha;
-    for (int i = 0; i < size; i += 4) {
-        alpha = (float)ptr[i + 3];
-        if (alpha > 0) {
-            ptr[i] = CLAMP((int)((float)ptr[i] / alpha * 255), 255);
-            ptr[i + 1] = CLAMP((int)((float)ptr[i + 1] / alpha * 255), 255);
-            ptr[i + 2] = CLAMP((int)((float)ptr[i + 2] / alpha * 255), 255);
-        }
-    }
+    pixel::convertPixels(pixel::Conversion::UNPREMULTIPLY, ptr, ptr, size / 4);
 }
 
 void CanvasRenderingContext2DDelegate::setShadowBlur(float blur) {
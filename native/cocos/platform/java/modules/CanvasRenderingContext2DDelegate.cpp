@@ -23,6 +23,7 @@
 ****************************************************************************/
 
 #include "platform/java/modules/CanvasRenderingContext2DDelegate.h"
+#include "base/PixelConvert.h"
 
 #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
     #include <android/bitmap.h>
@@ -34,8 +35,6 @@ namespace {
 
 } // namespace
 
-#define CLAMP(V, HI) std::min((V), (HI))
-
 namespace cc {
 CanvasRenderingContext2DDelegate::CanvasRenderingContext2DDelegate() {
     jobject obj = JniHelper::newObject(JCLS_CANVASIMPL);
@@ -293,15 +292,7 @@ void CanvasRenderingContext2DDelegate::unMultiplyAlpha(unsigned char *ptr, uint3
     //        if (getAndroidSDKInt() >= 19)
     //            return;
 
-    float alpha;
-    for (int i = 0; i < size; i += 4) {
-        alpha = static_cast<float>(ptr[i + 3]);
-        if (alpha > 0) {
-            ptr[i] = CLAMP((int)((float)ptr[i] / alpha * 255), 255);
-            ptr[i + 1] = CLAMP((int)((float)ptr[i + 1] / alpha * 255), 255);
-            ptr[i + 2] = CLAMP((int)((float)ptr[i + 2] / alpha * 255), 255);
-        }
-    }
+    pixel::convertPixels(pixel::Conversion::UNPREMULTIPLY, ptr, ptr, size / 4);
 }
 
 void CanvasRenderingContext2DDelegate::setShadowBlur(float blur) {
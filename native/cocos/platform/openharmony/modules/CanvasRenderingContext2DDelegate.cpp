@@ -24,6 +24,7 @@
  ****************************************************************************/
 
 #include "platform/openharmony/modules/CanvasRenderingContext2DDelegate.h"
+#include "base/PixelConvert.h"
 #include <native_drawing/drawing_text_typography.h>
 #include <native_drawing/drawing_canvas.h>
 #include <native_drawing/drawing_font_collection.h>
@@ -33,18 +34,8 @@
 
 namespace cc {
 namespace {
-#define CLAMP(V, HI) std::min((V), (HI))
-
 void unMultiplyAlpha(unsigned char *ptr, ssize_t size) {
-    float alpha;
-    for (int i = 0; i < size; i += 4) {
-        alpha = (float)ptr[i + 3];
-        if (alpha > 0) {
-            ptr[i] = CLAMP((int)((float)ptr[i] / alpha * 255), 255);
-            ptr[i + 1] = CLAMP((int)((float)ptr[i + 1] / alpha * 255), 255);
-            ptr[i + 2] = CLAMP((int)((float)ptr[i + 2] / alpha * 255), 255);
-        }
-    }
+    pixel::convertPixels(pixel::Conversion::UNPREMULTIPLY, ptr, ptr, static_cast<uint32_t>(size / 4));
 }
 }
 enum class TextAlign { LEFT, CENTER, RIGHT };
@@ -105,6 +105,9 @@ ccstd::string FileUtilsWin32::getSuitableFOpen(const ccstd::string &filenameUtf8
 }
 
 long FileUtilsWin32::getFileSize(const ccstd::string &filepath) {
+    if (const auto *entry = findArchiveEntry(filepath, nullptr)) {
+        return static_cast<long>(entry->size);
+    }
     WIN32_FILE_ATTRIBUTE_DATA fad;
     if (!GetFileAttributesEx(StringUtf8ToWideChar(filepath).c_str(), GetFileExInfoStandard, &fad)) {
         return 0; // error condition, could call GetLastError to find out more
@@ -144,6 +147,9 @@ FileUtils::Status FileUtilsWin32::getContents(const ccstd::string &filename, Res
 
     // read the file from hardware
     ccstd::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
+    if (findArchiveEntry(fullPath, nullptr)) {
+        return FileUtils::getContents(filename, buffer);
+    }
 
     HANDLE fileHandle = ::CreateFile(StringUtf8ToWideChar(fullPath).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, NULL, nullptr);
     if (fileHandle == INVALID_HANDLE_VALUE)
@@ -30,6 +30,7 @@
 #include "base/Log.h"
 #include "base/Macros.h"
 #include "base/memory/MemoryHook.h"
+#include "base/threading/ThreadLocalPool.h"
 #include "core/Root.h"
 #include "core/assets/Font.h"
 #include "gfx-base/GFXDevice.h"
@@ -131,6 +132,7 @@ Profiler::Profiler() {
     _mainThreadId = std::this_thread::get_id();
     _root = ccnew ProfilerBlock(nullptr, "MainThread");
     _current = _root;
+    TraceRecorder::setThreadName("MainThread");
 
     Profiler::instance = this;
 }
@@ -156,6 +158,7 @@ bool Profiler::isEnabled(ShowOption option) const {
 }
 
 void Profiler::beginFrame() {
+    TraceRecorder::markFrame();
     _objectStats.onFrameBegin();
 
     _current = _root;
@@ -170,6 +173,21 @@ void Profiler::endFrame() {
     _root->onFrameEnd();
 
     _objectStats.onFrameEnd();
+
+    if (_traceFramesLeft > 0 && --_traceFramesLeft == 0) {
+        TraceRecorder::dump(_tracePath, _traceFrameCount);
+        TraceRecorder::setEnabled(false);
+    }
+}
+
+void Profiler::captureTrace(const ccstd::string &path, uint32_t frameCount) {
+    if (frameCount == 0) {
+        return;
+    }
+    _tracePath = path;
+    _traceFrameCount = frameCount;
+    _traceFramesLeft = frameCount;
+    TraceRecorder::setEnabled(true);
 }
 
 void Profiler::update() {
@@ -213,6 +231,24 @@ void Profiler::doFrameUpdate() {
     CC_PROFILE_RENDER_UPDATE(DrawCalls, device->getNumDrawCalls());
     CC_PROFILE_RENDER_UPDATE(Instances, device->getNumInstances());
     CC_PROFILE_RENDER_UPDATE(Triangles, device->getNumTris());
+    CC_PROFILE_COUNTER(DrawCalls, device->getNumDrawCalls());
+    CC_PROFILE_COUNTER(Instances, device->getNumInstances());
+    CC_PROFILE_COUNTER(Triangles, device->getNumTris());
+
+    // cross-thread payloads, e.g. message queue chunks and gfx uploads
+    static ThreadLocalPool::Stats lastPoolStats;
+    const auto poolStats = ThreadLocalPool::getStats();
+    const auto poolAllocations = poolStats.allocationCount - lastPoolStats.allocationCount;
+    const auto poolAllocatedBytes = poolStats.allocatedBytes - lastPoolStats.allocatedBytes;
+    const auto poolSystemAllocations = poolStats.systemAllocationCount - lastPoolStats.systemAllocationCount;
+    lastPoolStats = poolStats;
+    CC_PROFILE_OBJECT_UPDATE(PoolAllocations, static_cast<uint32_t>(poolAllocations));
+    CC_PROFILE_OBJECT_UPDATE(PoolSystemAllocations, static_cast<uint32_t>(poolSystemAllocations));
+    CC_PROFILE_MEMORY_UPDATE(PoolAllocatedBytes, poolAllocatedBytes);
+    CC_PROFILE_MEMORY_UPDATE(PoolReservedBytes, poolStats.reservedBytes);
+    CC_PROFILE_COUNTER(PoolAllocations, poolAllocations);
+    CC_PROFILE_COUNTER(PoolAllocatedBytes, poolAllocatedBytes);
+    CC_PROFILE_COUNTER(PoolSystemAllocations, poolSystemAllocations);
 
 #if USE_MEMORY_LEAK_DETECTOR
     CC_PROFILE_MEMORY_UPDATE(HeapMemory, GMemoryHook.getTotalSize());
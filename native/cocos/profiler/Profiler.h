@@ -26,6 +26,7 @@
 #include <string_view>
 #include <thread>
 #include "GameStats.h"
+#include "TraceRecorder.h"
 #include "base/Config.h"
 #include "base/Timer.h"
 #include "gfx-base/GFXDef-common.h"
@@ -64,6 +65,12 @@ public:
     void endFrame();
     void update();
 
+    /**
+     * Records the timeline of all threads for the next frameCount frames, then writes it to path
+     * as a Chrome trace and stops recording.
+     */
+    void captureTrace(const ccstd::string &path, uint32_t frameCount);
+
     inline bool isMainThread() const { return _mainThreadId == std::this_thread::get_id(); }
     inline MemoryStats &getMemoryStats() { return _memoryStats; }
     inline ObjectStats &getObjectStats() { return _objectStats; }
@@ -87,26 +94,32 @@ private:
     ProfilerBlock *_root{nullptr};
     ProfilerBlock *_current{nullptr};
     std::thread::id _mainThreadId;
+    ccstd::string _tracePath;
+    uint32_t _traceFrameCount{0};
+    uint32_t _traceFramesLeft{0};
 
     friend class AutoProfiler;
 };
 
 /**
- * AutoProfiler: profile code block automatically
+ * AutoProfiler: profile code block automatically, name must be a string literal
  */
 class AutoProfiler {
 public:
     AutoProfiler(Profiler *profiler, const std::string_view &name)
-    : _profiler(profiler) {
+    : _profiler(profiler), _name(name.data()) {
         _profiler->beginBlock(name);
+        TraceRecorder::begin(_name);
     }
 
     ~AutoProfiler() {
+        TraceRecorder::end(_name);
         _profiler->endBlock();
     }
 
 private:
     Profiler *_profiler{nullptr};
+    const char *_name{nullptr};
 };
 
 } // namespace cc
@@ -136,7 +149,9 @@ private:
         if (CC_PROFILER) {           \
             CC_PROFILER->endFrame(); \
         }
-    #define CC_PROFILE(name) cc::AutoProfiler auto_profiler_##name(CC_PROFILER, #name)
+    #define CC_PROFILE(name)                 cc::AutoProfiler auto_profiler_##name(CC_PROFILER, #name)
+    #define CC_PROFILE_COUNTER(name, value)  cc::TraceRecorder::counter(#name, static_cast<int64_t>(value))
+    #define CC_PROFILE_THREAD_NAME(name)     cc::TraceRecorder::setThreadName(name)
     #define CC_PROFILE_MEMORY_UPDATE(name, count)                 \
         if (CC_PROFILER) {                                        \
             CC_PROFILER->getMemoryStats().update(#name, (count)); \
@@ -181,6 +196,8 @@ private:
     #define CC_PROFILER_BEGIN_FRAME
     #define CC_PROFILER_END_FRAME
     #define CC_PROFILE(name)
+    #define CC_PROFILE_COUNTER(name, value)
+    #define CC_PROFILE_THREAD_NAME(name)
     #define CC_PROFILE_MEMORY_UPDATE(name, count)
     #define CC_PROFILE_MEMORY_INC(name, count)
     #define CC_PROFILE_MEMORY_DEC(name, count)
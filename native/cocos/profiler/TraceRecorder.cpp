@@ -0,0 +1,260 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "base/Log.h"
+#include "base/std/container/array.h"
+#include "base/std/container/vector.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Events of one thread. Only the owning thread writes. `recording` is set while it writes an event,
+ * dump stops recording and waits for it to clear before reading the events.
+ */
+struct ThreadTrace {
+    uint32_t id{0};
+    ccstd::string name;
+    std::atomic<bool> recording{false};
+    std::atomic<uint64_t> writeIndex{0};
+    ccstd::array<TraceRecorder::Event, TraceRecorder::EVENTS_PER_THREAD> events;
+};
+
+struct TraceRegistry {
+    std::mutex mutex;
+    ccstd::vector<std::unique_ptr<ThreadTrace>> threads;
+    Clock::time_point epoch{Clock::now()};
+};
+
+TraceRegistry &getRegistry() {
+    static TraceRegistry registry;
+    return registry;
+}
+
+thread_local ThreadTrace *currentThreadTrace = nullptr;
+thread_local ccstd::string currentThreadName;
+
+// Thread traces stay alive until exit, so events of finished threads can still be dumped.
+ThreadTrace *getThreadTrace() {
+    if (!currentThreadTrace) {
+        auto &registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto trace = std::make_unique<ThreadTrace>();
+        trace->id = static_cast<uint32_t>(registry.threads.size());
+        trace->name = currentThreadName.empty() ? "Thread " + std::to_string(trace->id) : currentThreadName;
+        currentThreadTrace = trace.get();
+        registry.threads.emplace_back(std::move(trace));
+    }
+    return currentThreadTrace;
+}
+
+void appendEscaped(ccstd::string &out, const char *str) {
+    for (; *str; ++str) {
+        if (*str == '"' || *str == '\\') {
+            out += '\\';
+        }
+        out += *str;
+    }
+}
+
+void appendEvent(ccstd::string &out, const char *phase, const char *name, uint32_t tid, uint64_t timestamp) {
+    char buffer[128];
+    out += R"({"name":")";
+    appendEscaped(out, name);
+    snprintf(buffer, sizeof(buffer), R"(","ph":"%s","pid":0,"tid":%u,"ts":%.3f)", phase, tid, static_cast<double>(timestamp) / 1000.0);
+    out += buffer;
+}
+
+} // namespace
+
+std::atomic<bool> TraceRecorder::enabled{false};
+
+void TraceRecorder::setEnabled(bool enable) {
+    // make sure the clock epoch is set before the first event
+    getRegistry();
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+void TraceRecorder::setThreadName(const ccstd::string &name) {
+    currentThreadName = name;
+    if (currentThreadTrace) {
+        std::lock_guard<std::mutex> lock(getRegistry().mutex);
+        currentThreadTrace->name = name;
+    }
+}
+
+void TraceRecorder::record(EventType type, const char *name, int64_t value) {
+    auto *trace = getThreadTrace();
+    // Pairs with the fence in dump: either this thread sees recording stopped, or dump sees the
+    // flag and waits for the event to be written.
+    trace->recording.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // acquire: the slots were last read by a dump that finished before recording was enabled again
+    if (!enabled.load(std::memory_order_acquire)) {
+        trace->recording.store(false, std::memory_order_relaxed);
+        return;
+    }
+    const auto index = trace->writeIndex.load(std::memory_order_relaxed);
+    auto &event = trace->events[index % EVENTS_PER_THREAD];
+    event.name = name;
+    event.timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - getRegistry().epoch).count());
+    event.value = value;
+    event.type = type;
+    trace->writeIndex.store(index + 1, std::memory_order_relaxed);
+    trace->recording.store(false, std::memory_order_release);
+}
+
+bool TraceRecorder::dump(const ccstd::string &path, uint32_t frameCount) {
+    struct ThreadEvents {
+        uint32_t id{0};
+        ccstd::string name;
+        ccstd::vector<Event> events;
+    };
+    ccstd::vector<ThreadEvents> threads;
+    {
+        auto &registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        // Stop recording and wait for the events being written, so the buffers don't change while
+        // they are copied. Events recorded meanwhile are dropped.
+        const bool wasEnabled = enabled.exchange(false, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (const auto &trace : registry.threads) {
+            while (trace->recording.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+
+        threads.reserve(registry.threads.size());
+        for (const auto &trace : registry.threads) {
+            ThreadEvents copy{trace->id, trace->name, {}};
+            const auto end = trace->writeIndex.load(std::memory_order_relaxed);
+            const auto begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+            copy.events.reserve(end - begin);
+            for (auto i = begin; i < end; ++i) {
+                copy.events.emplace_back(trace->events[i % EVENTS_PER_THREAD]);
+            }
+            threads.emplace_back(std::move(copy));
+        }
+        enabled.store(wasEnabled, std::memory_order_release);
+    }
+
+    // start at the frameCount-th last frame mark, frames are marked on the main thread only
+    uint64_t startTime = 0;
+    if (frameCount > 0) {
+        uint32_t frames = 0;
+        for (const auto &thread : threads) {
+            for (auto it = thread.events.rbegin(); it != thread.events.rend() && frames < frameCount; ++it) {
+                if (it->type == EventType::FRAME) {
+                    startTime = it->timestamp;
+                    ++frames;
+                }
+            }
+            if (frames) {
+                break;
+            }
+        }
+    }
+
+    ccstd::string json = R"({"displayTimeUnit":"ms","traceEvents":[)";
+    char buffer[128];
+    bool first = true;
+    const auto separate = [&]() {
+        if (!first) {
+            json += ",\n";
+        }
+        first = false;
+    };
+    for (const auto &thread : threads) {
+        separate();
+        snprintf(buffer, sizeof(buffer), R"({"name":"thread_name","ph":"M","pid":0,"tid":%u,"args":{"name":")", thread.id);
+        json += buffer;
+        appendEscaped(json, thread.name.c_str());
+        json += "\"}}";
+
+        uint32_t depth = 0;
+        uint64_t lastTime = 0;
+        for (const auto &event : thread.events) {
+            if (event.timestamp < startTime) {
+                continue;
+            }
+            lastTime = event.timestamp;
+            switch (event.type) {
+                case EventType::BEGIN:
+                    separate();
+                    appendEvent(json, "B", event.name, thread.id, event.timestamp);
+                    json += "}";
+                    ++depth;
+                    break;
+                case EventType::END:
+                    // the matching begin is older than the dumped range
+                    if (depth == 0) {
+                        break;
+                    }
+                    separate();
+                    appendEvent(json, "E", event.name, thread.id, event.timestamp);
+                    json += "}";
+                    --depth;
+                    break;
+                case EventType::COUNTER:
+                    separate();
+                    appendEvent(json, "C", event.name, thread.id, event.timestamp);
+                    snprintf(buffer, sizeof(buffer), R"(,"args":{"value":%lld}})", static_cast<long long>(event.value));
+                    json += buffer;
+                    break;
+                case EventType::FRAME:
+                    separate();
+                    appendEvent(json, "i", event.name, thread.id, event.timestamp);
+                    json += R"(,"s":"g"})";
+                    break;
+            }
+        }
+        // close the blocks still open when the dump was taken
+        for (; depth > 0; --depth) {
+            separate();
+            snprintf(buffer, sizeof(buffer), R"({"ph":"E","pid":0,"tid":%u,"ts":%.3f})", thread.id, static_cast<double>(lastTime) / 1000.0);
+            json += buffer;
+        }
+    }
+    json += "]}\n";
+
+    if (!FileUtils::getInstance()->writeStringToFile(json, path)) {
+        CC_LOG_ERROR("TraceRecorder: failed to write %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace cc
@@ -0,0 +1,119 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "renderer/core/TextureLoader.h"
+#include <algorithm>
+#include "base/Log.h"
+#include "platform/FileUtils.h"
+#include "renderer/gfx-base/GFXDevice.h"
+
+namespace cc {
+
+namespace {
+
+bool canSample(gfx::Device *device, gfx::Format format) {
+    return hasFlag(device->getFormatFeatures(format), gfx::FormatFeature::SAMPLED_TEXTURE);
+}
+
+} // namespace
+
+IntrusivePtr<Image> TextureLoader::decode(const ccstd::string &path, gfx::Device *device) {
+    IntrusivePtr<Image> image = ccnew Image();
+    setupDecodeFormats(image, device);
+
+    auto *fileUtils = FileUtils::getInstance();
+    const ccstd::string fullPath = fileUtils->fullPathForFilename(path);
+    if (fullPath.empty()) {
+        CC_LOG_ERROR("TextureLoader: can't find %s", path.c_str());
+        return nullptr;
+    }
+
+    bool ok = false;
+    const uint8_t *mapped = nullptr;
+    size_t mappedSize = 0;
+    if (fileUtils->getMappedContents(fullPath, &mapped, &mappedSize)) {
+        ok = image->initWithImageData(mapped, static_cast<uint32_t>(mappedSize));
+    } else {
+        Data data = fileUtils->getDataFromFile(fullPath);
+        ok = !data.isNull() && image->initWithImageData(data.getBytes(), static_cast<uint32_t>(data.getSize()));
+    }
+    if (!ok) {
+        CC_LOG_ERROR("TextureLoader: failed to decode %s", path.c_str());
+        return nullptr;
+    }
+    return image;
+}
+
+gfx::Texture *TextureLoader::upload(Image *image, gfx::Device *device) {
+    CC_ASSERT(image && image->getData());
+    const gfx::Format format = image->getRenderFormat();
+    if (!canSample(device, format)) {
+        CC_LOG_ERROR("TextureLoader: format %u of %s can't be sampled", static_cast<uint32_t>(format), image->getFilePath().c_str());
+        return nullptr;
+    }
+
+    const auto width = static_cast<uint32_t>(image->getWidth());
+    const auto height = static_cast<uint32_t>(image->getHeight());
+    const auto &levelSizes = image->getMipmapLevelDataSize();
+    const auto levelCount = std::max(static_cast<uint32_t>(levelSizes.size()), 1U);
+
+    gfx::TextureInfo info;
+    info.type = gfx::TextureType::TEX2D;
+    info.usage = gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST;
+    info.format = format;
+    info.width = width;
+    info.height = height;
+    info.levelCount = levelCount;
+    auto *texture = device->createTexture(info);
+
+    // The decoded buffer is uploaded in place, mip levels are laid out one after another.
+    gfx::BufferDataList buffers;
+    gfx::BufferTextureCopyList regions;
+    buffers.reserve(levelCount);
+    regions.reserve(levelCount);
+    const uint8_t *data = image->getData();
+    uint32_t offset = 0;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        gfx::BufferTextureCopy region;
+        region.texExtent = {std::max(width >> level, 1U), std::max(height >> level, 1U), 1U};
+        region.texSubres = {level, 0U, 1U};
+        regions.emplace_back(region);
+        buffers.emplace_back(data + offset);
+        offset += levelSizes.empty() ? image->getDataLen() : levelSizes[level];
+    }
+    device->copyBuffersToTexture(buffers, texture, regions);
+
+    unsigned char *pixels = nullptr;
+    image->takeData(&pixels);
+    free(pixels);
+    return texture;
+}
+
+void TextureLoader::setupDecodeFormats(Image *image, gfx::Device *device) {
+    for (const auto format : {gfx::Format::L8, gfx::Format::LA8, gfx::Format::RGB8}) {
+        image->setExpandToRGBA8(format, !canSample(device, format));
+    }
+}
+
+} // namespace cc
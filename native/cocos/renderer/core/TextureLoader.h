@@ -0,0 +1,62 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/Ptr.h"
+#include "base/std/container/string.h"
+#include "platform/Image.h"
+#include "renderer/gfx-base/GFXDef.h"
+
+namespace cc {
+
+namespace gfx {
+class Device;
+class Texture;
+} // namespace gfx
+
+/**
+ * Loads image files into sampled textures without the pixel conversions of the script image path.
+ * Decoders keep L8, LA8 and RGB8 when the device can sample them, otherwise they expand rows to RGBA8
+ * while decoding, and the decoded buffer is handed to the device upload as is.
+ */
+class TextureLoader final {
+public:
+    /**
+     * Reads and decodes a file, safe to call on worker threads.
+     * Files stored uncompressed in a mounted asset archive are decoded straight from the mapping.
+     */
+    static IntrusivePtr<Image> decode(const ccstd::string &path, gfx::Device *device);
+
+    /**
+     * Creates a texture for a decoded image and uploads its pixels, then frees them.
+     * Call it on the thread that owns the device. Returns nullptr if the device can't sample the format.
+     */
+    static gfx::Texture *upload(Image *image, gfx::Device *device);
+
+    // Prepares an image so its decoders only output formats `device` can sample.
+    static void setupDecodeFormats(Image *image, gfx::Device *device);
+};
+
+} // namespace cc
@@ -130,7 +130,7 @@ void BufferAgent::update(const void *buffer, uint32_t size) {
         needFreeing, needFreeing,
         {
             actor->update(buffer, size);
-            if (needFreeing) free(buffer);
+            if (needFreeing) memoryFreeForMultiThread(buffer);
         });
 }
 
@@ -151,7 +151,7 @@ void BufferAgent::getActorBuffer(const BufferAgent *buffer, MessageQueue *mq, ui
         uint32_t frameIndex = DeviceAgent::getInstance()->getCurrentIndex();
         *pActorBuffer = buffer->_stagingBuffer.get() + frameIndex * buffer->_size;
     } else if (size > STAGING_BUFFER_THRESHOLD) { // less frequent updates on big buffers
-        *pActorBuffer = reinterpret_cast<uint8_t *>(malloc(size));
+        *pActorBuffer = memoryAllocateForMultiThread<uint8_t>(size);
         *pNeedFreeing = true;
     } else { // for small enough buffers
         *pActorBuffer = mq->allocate<uint8_t>(size);
@@ -23,6 +23,7 @@
 ****************************************************************************/
 
 #include "CommandBufferAgent.h"
+#include <algorithm>
 #include <cstring>
 #include "BufferAgent.h"
 #include "DescriptorSetAgent.h"
@@ -126,6 +127,12 @@ void CommandBufferAgent::doInit(const CommandBufferInfo &info) {
 }
 
 void CommandBufferAgent::doDestroy() {
+    // primaries executing this one must not flush it after it is gone
+    for (CommandBufferAgent *cmdBuff : DeviceAgent::getInstance()->_cmdBuffRefs) {
+        auto &secondaries = cmdBuff->_secondaryCmdBuffs;
+        secondaries.erase(std::remove(secondaries.begin(), secondaries.end(), this), secondaries.end());
+    }
+
     destroyMessageQueue();
 
     ENQUEUE_MESSAGE_1(
@@ -233,7 +240,12 @@ void CommandBufferAgent::execute(CommandBuffer *const *cmdBuffs, uint32_t count)
 
     auto **actorCmdBuffs = _messageQueue->allocate<CommandBuffer *>(count);
     for (uint32_t i = 0; i < count; ++i) {
-        actorCmdBuffs[i] = static_cast<CommandBufferAgent *>(cmdBuffs[i])->getActor();
+        auto *cmdBuff = static_cast<CommandBufferAgent *>(cmdBuffs[i]);
+        actorCmdBuffs[i] = cmdBuff->getActor();
+        // recorded commands of the secondaries have to reach their actors before this one executes
+        if (!_messageQueue->isImmediateMode() && std::find(_secondaryCmdBuffs.begin(), _secondaryCmdBuffs.end(), cmdBuff) == _secondaryCmdBuffs.end()) {
+            _secondaryCmdBuffs.push_back(cmdBuff);
+        }
     }
 
     ENQUEUE_MESSAGE_3(
@@ -408,7 +420,7 @@ void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint32_t s
         needFreeing, needFreeing,
         {
             actor->updateBuffer(buff, data, size);
-            if (needFreeing) free(data);
+            if (needFreeing) memoryFreeForMultiThread(data);
         });
 }
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "base/Agent.h"
+#include "base/std/container/vector.h"
 #include "gfx-base/GFXCommandBuffer.h"
 
 namespace cc {
@@ -92,6 +93,11 @@ protected:
     void initMessageQueue();
     void destroyMessageQueue();
     MessageQueue *_messageQueue = nullptr;
+
+    // Secondary command buffers executed since the last flush.
+    // They may be recorded on worker threads, each into its own message queue,
+    // and are flushed on the device thread ahead of the primaries executing them.
+    ccstd::vector<CommandBufferAgent *> _secondaryCmdBuffs;
 };
 
 } // namespace gfx
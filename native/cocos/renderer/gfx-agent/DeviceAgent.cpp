@@ -23,12 +23,15 @@
 ****************************************************************************/
 
 #include <boost/align/align_up.hpp>
+#include <algorithm>
 #include <cstring>
 #include "application/ApplicationManager.h"
 #include "base/Log.h"
+#include "base/Utils.h"
 #include "base/threading/MessageQueue.h"
 #include "base/threading/ThreadSafeLinearAllocator.h"
 #include "platform/interfaces/modules/IXRInterface.h"
+#include "profiler/Profiler.h"
 
 #include "BufferAgent.h"
 #include "CommandBufferAgent.h"
@@ -183,6 +186,7 @@ void DeviceAgent::setMultithreaded(bool multithreaded) {
             actor, _actor,
             {
                 actor->bindContext(true);
+                CC_PROFILE_THREAD_NAME("RenderThread");
                 CC_LOG_INFO("Device thread detached.");
             });
         for (CommandBufferAgent *cmdBuff : _cmdBuffRefs) {
@@ -200,6 +204,7 @@ void DeviceAgent::setMultithreaded(bool multithreaded) {
         _actor->bindContext(true);
         for (CommandBufferAgent *cmdBuff : _cmdBuffRefs) {
             cmdBuff->_messageQueue->setImmediateMode(true);
+            cmdBuff->_secondaryCmdBuffs.clear();
         }
         CC_LOG_INFO("Device thread joined.");
     }
@@ -390,6 +395,30 @@ void DeviceAgent::copyTextureToBuffers(Texture *srcTexture, uint8_t *const *buff
 void DeviceAgent::flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count) {
     if (!_multithreaded) return; // all command buffers are immediately executed
 
+    // secondary command buffers are recorded by the time their primaries are flushed,
+    // whichever threads they were recorded on
+    _secondaryCmdBuffs.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        auto *cmdBuff = static_cast<CommandBufferAgent *const>(cmdBuffs[i]);
+        for (CommandBufferAgent *secondaryCmdBuff : cmdBuff->_secondaryCmdBuffs) {
+            if (std::find(_secondaryCmdBuffs.begin(), _secondaryCmdBuffs.end(), secondaryCmdBuff) == _secondaryCmdBuffs.end()) {
+                _secondaryCmdBuffs.push_back(secondaryCmdBuff);
+            }
+        }
+        cmdBuff->_secondaryCmdBuffs.clear();
+    }
+
+    auto secondaryCount = utils::toUint(_secondaryCmdBuffs.size());
+    CommandBufferAgent **agentSecondaryCmdBuffs = nullptr;
+    if (secondaryCount) {
+        agentSecondaryCmdBuffs = _mainMessageQueue->allocate<CommandBufferAgent *>(secondaryCount);
+        for (uint32_t i = 0; i < secondaryCount; ++i) {
+            agentSecondaryCmdBuffs[i] = _secondaryCmdBuffs[i];
+            MessageQueue::freeChunksInFreeQueue(agentSecondaryCmdBuffs[i]->_messageQueue);
+            agentSecondaryCmdBuffs[i]->_messageQueue->finishWriting();
+        }
+    }
+
     auto **agentCmdBuffs = _mainMessageQueue->allocate<CommandBufferAgent *>(count);
 
     for (uint32_t i = 0; i < count; ++i) {
@@ -398,12 +427,18 @@ void DeviceAgent::flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count)
         agentCmdBuffs[i]->_messageQueue->finishWriting();
     }
 
-    ENQUEUE_MESSAGE_3(
+    ENQUEUE_MESSAGE_5(
         _mainMessageQueue, DeviceFlushCommands,
         count, count,
         cmdBuffs, agentCmdBuffs,
+        secondaryCount, secondaryCount,
+        secondaryCmdBuffs, agentSecondaryCmdBuffs,
         multiThreaded, _actor->_multithreadedCommandRecording,
         {
+            // replay the secondaries first, the primaries then execute them in submission order
+            if (secondaryCount) {
+                CommandBufferAgent::flushCommands(secondaryCount, secondaryCmdBuffs, multiThreaded);
+            }
             CommandBufferAgent::flushCommands(count, cmdBuffs, multiThreaded);
         });
 }
@@ -26,6 +26,7 @@
 
 #include "base/Agent.h"
 #include "base/std/container/unordered_set.h"
+#include "base/std/container/vector.h"
 #include "base/threading/Semaphore.h"
 #include "gfx-base/GFXDevice.h"
 
@@ -129,6 +130,7 @@ protected:
 #endif
 
     ccstd::unordered_set<CommandBufferAgent *> _cmdBuffRefs;
+    ccstd::vector<CommandBufferAgent *> _secondaryCmdBuffs;
     IXRInterface *_xr{nullptr};
 };
 
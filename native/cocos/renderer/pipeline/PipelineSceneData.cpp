@@ -33,6 +33,7 @@
 #include "scene/Ambient.h"
 #include "scene/Fog.h"
 #include "scene/Model.h"
+#include "scene/BVH.h"
 #include "scene/Octree.h"
 #include "scene/Pass.h"
 #include "scene/Shadow.h"
@@ -51,6 +52,7 @@ PipelineSceneData::PipelineSceneData() {
     _shadow = ccnew scene::Shadows();
     _csmLayers = ccnew CSMLayers();
     _octree = ccnew scene::Octree();
+    _bvh = ccnew scene::BVH();
     _lightProbes = ccnew gi::LightProbes();
     _skin = ccnew scene::Skin();
     _postSettings = ccnew scene ::PostSettings();
@@ -62,6 +64,7 @@ PipelineSceneData::~PipelineSceneData() {
     CC_SAFE_DELETE(_skybox);
     CC_SAFE_DELETE(_shadow);
     CC_SAFE_DELETE(_octree);
+    CC_SAFE_DELETE(_bvh);
     CC_SAFE_DELETE(_csmLayers);
     CC_SAFE_DELETE(_lightProbes);
     CC_SAFE_DELETE(_skin);
@@ -42,6 +42,7 @@ class Shadows;
 class Skybox;
 class Fog;
 class Octree;
+class BVH;
 class Light;
 class Skin;
 class PostSettings;
@@ -75,6 +76,7 @@ public:
     inline scene::Skybox *getSkybox() const { return _skybox; }
     inline scene::Fog *getFog() const { return _fog; }
     inline scene::Octree *getOctree() const { return _octree; }
+    inline scene::BVH *getBVH() const { return _bvh; }
     inline gi::LightProbes *getLightProbes() const { return _lightProbes; }
     inline scene::Skin *getSkin() const { return _skin; }
     inline scene::PostSettings *getPostSettings() const { return _postSettings; }
@@ -131,6 +133,8 @@ protected:
     // manage memory manually
     scene::Octree *_octree{nullptr};
     // manage memory manually
+    scene::BVH *_bvh{nullptr};
+    // manage memory manually
     gi::LightProbes *_lightProbes{nullptr};
     // manage memory manually
     scene::Skin *_skin{nullptr};
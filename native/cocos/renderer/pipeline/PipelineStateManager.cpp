@@ -23,30 +23,55 @@
 ****************************************************************************/
 
 #include "PipelineStateManager.h"
+#include "core/Root.h"
 #include "gfx-base/GFXDef-common.h"
 #include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXUtil.h"
+#include "renderer/core/ProgramLib.h"
+#include "renderer/pipeline/custom/RenderingModule.h"
+#include "renderer/pipeline/custom/PrivateTypes.h"
 #include "scene/Pass.h"
 
 namespace cc {
 namespace pipeline {
 
+namespace {
+const char *manifestFileName = "/pipeline_state_manifest.bin";
+
+ccstd::string getManifestPath() {
+    return gfx::getPipelineCacheFolder() + manifestFileName;
+}
+} // namespace
+
 ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::PipelineState>> PipelineStateManager::psoHashMap;
+ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::RenderPass>> PipelineStateManager::warmUpRenderPasses;
+PipelineStateManifest PipelineStateManager::manifest;
+bool PipelineStateManager::manifestEnabled{false};
+uint32_t PipelineStateManager::warmUpCursor{0};
+uint32_t PipelineStateManager::warmUpEnd{0};
+uint32_t PipelineStateManager::creationBudget{0};
+uint32_t PipelineStateManager::creationCount{0};
+uint32_t PipelineStateManager::creationFrame{0};
 
-gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::Pass *pass,
-                                                                   gfx::Shader *shader,
-                                                                   gfx::InputAssembler *inputAssembler,
-                                                                   gfx::RenderPass *renderPass,
-                                                                   uint32_t subpass) {
-    const auto passHash = pass->getHash();
-    const auto renderPassHash = renderPass->getHash();
-    const auto iaHash = inputAssembler->getAttributesHash();
+ccstd::hash_t PipelineStateManager::getPipelineStateHash(ccstd::hash_t passHash, ccstd::hash_t renderPassHash,
+                                                         ccstd::hash_t iaHash, gfx::Shader *shader, uint32_t subpass) {
     const auto shaderID = shader->getTypedID();
     auto hash = passHash ^ renderPassHash ^ iaHash ^ shaderID;
     if (subpass != 0) {
         hash = hash << subpass;
     }
+    return static_cast<ccstd::hash_t>(hash);
+}
 
-    auto *pso = psoHashMap[static_cast<ccstd::hash_t>(hash)].get();
+gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::Pass *pass,
+                                                                   gfx::Shader *shader,
+                                                                   gfx::InputAssembler *inputAssembler,
+                                                                   gfx::RenderPass *renderPass,
+                                                                   uint32_t subpass) {
+    const auto hash = getPipelineStateHash(pass->getHash(), renderPass->getHash(),
+                                           inputAssembler->getAttributesHash(), shader, subpass);
+
+    auto *pso = psoHashMap[hash].get();
     if (!pso) {
         auto *pipelineLayout = pass->getPipelineLayout();
 
@@ -62,17 +87,193 @@ gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::
                                                                gfx::PipelineBindPoint::GRAPHICS,
                                                                subpass});
 
-        psoHashMap[static_cast<ccstd::hash_t>(hash)] = pso;
+        psoHashMap[hash] = pso;
+        ++creationCount;
+
+        if (manifestEnabled) {
+            record(pass, shader, inputAssembler, renderPass, subpass);
+        }
     }
 
     return pso;
 }
 
+gfx::PipelineState *PipelineStateManager::tryGetOrCreatePipelineState(const scene::Pass *pass,
+                                                                      gfx::Shader *shader,
+                                                                      gfx::InputAssembler *inputAssembler,
+                                                                      gfx::RenderPass *renderPass,
+                                                                      uint32_t subpass) {
+    if (!creationBudget) {
+        return getOrCreatePipelineState(pass, shader, inputAssembler, renderPass, subpass);
+    }
+
+    const auto frame = Root::getInstance()->getFrameCount();
+    if (frame != creationFrame) {
+        creationFrame = frame;
+        creationCount = 0;
+    }
+
+    if (creationCount >= creationBudget) {
+        const auto hash = getPipelineStateHash(pass->getHash(), renderPass->getHash(),
+                                               inputAssembler->getAttributesHash(), shader, subpass);
+        const auto iter = psoHashMap.find(hash);
+        return iter != psoHashMap.end() ? iter->second.get() : nullptr;
+    }
+    return getOrCreatePipelineState(pass, shader, inputAssembler, renderPass, subpass);
+}
+
+void PipelineStateManager::setCreationBudget(uint32_t maxCountPerFrame) {
+    creationBudget = maxCountPerFrame;
+}
+
+void PipelineStateManager::record(const scene::Pass *pass, gfx::Shader *shader,
+                                  gfx::InputAssembler *inputAssembler, gfx::RenderPass *renderPass, uint32_t subpass) {
+    PipelineStateRecord rec;
+    rec.programName = pass->getProgram();
+    rec.shaderName = shader->getName();
+    rec.phaseID = pass->getPhaseID();
+    rec.defines = pass->getDefines();
+    rec.passHash = pass->getHash();
+    rec.attributesHash = inputAssembler->getAttributesHash();
+    rec.attributes = inputAssembler->getAttributes();
+
+    const auto getBarrier = [](const gfx::GeneralBarrier *barrier) -> ccstd::optional<gfx::GeneralBarrierInfo> {
+        if (barrier) {
+            return barrier->getInfo();
+        }
+        return ccstd::nullopt;
+    };
+    rec.renderPass.colorAttachments = renderPass->getColorAttachments();
+    for (auto &color : rec.renderPass.colorAttachments) {
+        rec.barriers.emplace_back(getBarrier(color.barrier));
+        color.barrier = nullptr;
+    }
+    rec.renderPass.depthStencilAttachment = renderPass->getDepthStencilAttachment();
+    rec.barriers.emplace_back(getBarrier(rec.renderPass.depthStencilAttachment.barrier));
+    rec.renderPass.depthStencilAttachment.barrier = nullptr;
+    rec.renderPass.depthStencilResolveAttachment = renderPass->getDepthStencilResolveAttachment();
+    rec.barriers.emplace_back(getBarrier(rec.renderPass.depthStencilResolveAttachment.barrier));
+    rec.renderPass.depthStencilResolveAttachment.barrier = nullptr;
+    // dependencies do not affect render pass compatibility, nor the render pass hash.
+    rec.renderPass.subpasses = renderPass->getSubpasses();
+    rec.subpass = subpass;
+
+    rec.rasterizerState = *pass->getRasterizerState();
+    rec.depthStencilState = *pass->getDepthStencilState();
+    rec.blendState = *pass->getBlendState();
+    rec.primitive = pass->getPrimitive();
+    rec.dynamicStates = pass->getDynamicStates();
+
+    manifest.add(std::move(rec));
+}
+
+void PipelineStateManager::setManifestEnabled(bool enabled) {
+    if (manifestEnabled == enabled) {
+        return;
+    }
+    manifestEnabled = enabled;
+    if (enabled) {
+        manifest.clear();
+        manifest.load(getManifestPath());
+        warmUpCursor = 0;
+        warmUpEnd = static_cast<uint32_t>(manifest.getRecords().size());
+    } else {
+        saveManifest();
+    }
+}
+
+void PipelineStateManager::saveManifest() {
+    if (manifest.isDirty()) {
+        manifest.save(getManifestPath());
+    }
+}
+
+bool PipelineStateManager::warmUp(const PipelineStateRecord &record) {
+    auto *device = gfx::Device::getInstance();
+
+    // resolve the shader the same way Pass::tryCompile does.
+    gfx::Shader *shader = nullptr;
+    gfx::PipelineLayout *pipelineLayout = nullptr;
+    auto defines = record.defines;
+    auto *programLib = render::getProgramLibrary();
+    if (programLib) {
+        auto *shaderProxy = programLib->getProgramVariant(device, record.phaseID, record.programName, defines);
+        if (shaderProxy) {
+            shader = shaderProxy->getShader();
+            pipelineLayout = programLib->getPipelineLayout(device, record.phaseID, record.programName).get();
+        }
+    } else {
+        auto *lib = ProgramLib::getInstance();
+        auto *pipeline = Root::getInstance()->getPipeline();
+        if (pipeline && lib->getTemplate(record.programName)) {
+            shader = lib->getGFXShader(device, record.programName, defines, pipeline);
+            pipelineLayout = lib->getTemplateInfo(record.programName)->pipelineLayout;
+        }
+    }
+    // the effect is not loaded, or the recorded shader was a patched variant.
+    if (!shader || !pipelineLayout || shader->getName() != record.shaderName) {
+        return false;
+    }
+
+    auto renderPassInfo = record.renderPass;
+    const auto getBarrier = [&](uint32_t index) -> gfx::GeneralBarrier * {
+        if (index >= record.barriers.size() || !record.barriers[index].has_value()) {
+            return nullptr;
+        }
+        return device->getGeneralBarrier(*record.barriers[index]);
+    };
+    uint32_t barrierIndex = 0;
+    for (auto &color : renderPassInfo.colorAttachments) {
+        color.barrier = getBarrier(barrierIndex++);
+    }
+    renderPassInfo.depthStencilAttachment.barrier = getBarrier(barrierIndex++);
+    renderPassInfo.depthStencilResolveAttachment.barrier = getBarrier(barrierIndex++);
+
+    // any compatible render pass will do, share them between records.
+    auto &renderPass = warmUpRenderPasses[gfx::RenderPass::computeHash(renderPassInfo)];
+    if (!renderPass) {
+        renderPass = device->createRenderPass(renderPassInfo);
+    }
+
+    const auto hash = getPipelineStateHash(record.passHash, renderPass->getHash(),
+                                           record.attributesHash, shader, record.subpass);
+    auto &pso = psoHashMap[hash];
+    if (pso) {
+        return false;
+    }
+    pso = device->createPipelineState({shader,
+                                       pipelineLayout,
+                                       renderPass,
+                                       {record.attributes},
+                                       record.rasterizerState,
+                                       record.depthStencilState,
+                                       record.blendState,
+                                       record.primitive,
+                                       record.dynamicStates,
+                                       gfx::PipelineBindPoint::GRAPHICS,
+                                       record.subpass});
+    return true;
+}
+
+uint32_t PipelineStateManager::warmUp(uint32_t maxCount) {
+    const auto &records = manifest.getRecords();
+    for (uint32_t count = 0; warmUpCursor < warmUpEnd && count < maxCount; ++warmUpCursor) {
+        if (warmUp(records[warmUpCursor])) {
+            ++count;
+        }
+    }
+    return warmUpEnd - warmUpCursor;
+}
+
 void PipelineStateManager::destroyAll() {
     for (auto &pair : psoHashMap) {
         CC_SAFE_DESTROY_NULL(pair.second);
     }
     psoHashMap.clear();
+    warmUpRenderPasses.clear();
+    if (manifestEnabled) {
+        saveManifest();
+    }
 }
 
 } // namespace pipeline
@@ -26,6 +26,7 @@
 
 #include "cocos/base/Ptr.h"
 #include "gfx-base/GFXDef.h"
+#include "renderer/pipeline/PipelineStateManifest.h"
 
 namespace cc {
 namespace scene {
@@ -40,10 +41,49 @@ public:
                                                         gfx::InputAssembler *inputAssembler,
                                                         gfx::RenderPass *renderPass,
                                                         uint32_t subpass = 0);
+    /**
+     * Same as getOrCreatePipelineState, but returns nullptr instead of creating
+     * the pipeline state once this frame's creation budget is spent.
+     * Callers skip the draw, it is created in one of the following frames.
+     */
+    static gfx::PipelineState *tryGetOrCreatePipelineState(const scene::Pass *pass,
+                                                           gfx::Shader *shader,
+                                                           gfx::InputAssembler *inputAssembler,
+                                                           gfx::RenderPass *renderPass,
+                                                           uint32_t subpass = 0);
+    // 0 means unlimited
+    static void setCreationBudget(uint32_t maxCountPerFrame);
+
+    /**
+     * Records every created pipeline state into the manifest in the pipeline cache folder.
+     * Enabling loads the manifest written by the previous run, so it can be warmed up.
+     */
+    static void setManifestEnabled(bool enabled);
+    static void saveManifest();
+    /**
+     * Creates at most maxCount pipeline states of the loaded manifest.
+     * Meant to be called every frame while loading, returns the number of records left.
+     */
+    static uint32_t warmUp(uint32_t maxCount);
+
     static void destroyAll();
 
 private:
+    static ccstd::hash_t getPipelineStateHash(ccstd::hash_t passHash, ccstd::hash_t renderPassHash,
+                                              ccstd::hash_t iaHash, gfx::Shader *shader, uint32_t subpass);
+    static void record(const scene::Pass *pass, gfx::Shader *shader,
+                       gfx::InputAssembler *inputAssembler, gfx::RenderPass *renderPass, uint32_t subpass);
+    static bool warmUp(const PipelineStateRecord &record);
+
     static ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::PipelineState>> psoHashMap;
+    static ccstd::unordered_map<ccstd::hash_t, IntrusivePtr<gfx::RenderPass>> warmUpRenderPasses;
+    static PipelineStateManifest manifest;
+    static bool manifestEnabled;
+    static uint32_t warmUpCursor;
+    static uint32_t warmUpEnd;
+    static uint32_t creationBudget;
+    static uint32_t creationCount;
+    static uint32_t creationFrame;
 };
 
 } // namespace pipeline
@@ -0,0 +1,418 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "PipelineStateManifest.h"
+
+#include <fstream>
+#include <type_traits>
+
+#include "base/BinaryArchive.h"
+#include "base/Log.h"
+#include "base/std/hash/hash.h"
+
+namespace cc {
+namespace pipeline {
+
+namespace {
+const uint32_t MAGIC = 0x43435053; // "CCPS"
+const uint32_t VERSION = 1;
+
+// guards against corrupted files
+const uint32_t MAX_STRING_LENGTH = 4096;
+const uint32_t MAX_LIST_SIZE = 256;
+
+template <typename T>
+void saveValue(BinaryOutputArchive &archive, const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>, "value must be trivially copyable");
+    archive.save(reinterpret_cast<const char *>(&value), static_cast<uint32_t>(sizeof(T)));
+}
+
+template <typename T>
+bool loadValue(BinaryInputArchive &archive, T &value) {
+    static_assert(std::is_trivially_copyable_v<T>, "value must be trivially copyable");
+    return archive.load(reinterpret_cast<char *>(&value), static_cast<uint32_t>(sizeof(T)));
+}
+
+void saveString(BinaryOutputArchive &archive, const ccstd::string &str) {
+    archive.save(static_cast<uint32_t>(str.size()));
+    archive.save(str.data(), static_cast<uint32_t>(str.size()));
+}
+
+bool loadString(BinaryInputArchive &archive, ccstd::string &str) {
+    uint32_t length = 0;
+    if (!archive.load(length) || length > MAX_STRING_LENGTH) {
+        return false;
+    }
+    str.resize(length);
+    return archive.load(str.data(), length);
+}
+
+template <typename T>
+void saveTrivialList(BinaryOutputArchive &archive, const ccstd::vector<T> &list) {
+    archive.save(static_cast<uint32_t>(list.size()));
+    for (const auto &value : list) {
+        saveValue(archive, value);
+    }
+}
+
+template <typename T>
+bool loadTrivialList(BinaryInputArchive &archive, ccstd::vector<T> &list) {
+    uint32_t size = 0;
+    if (!archive.load(size) || size > MAX_LIST_SIZE) {
+        return false;
+    }
+    list.resize(size);
+    bool result = true;
+    for (auto &value : list) {
+        result &= loadValue(archive, value);
+    }
+    return result;
+}
+
+void saveDefines(BinaryOutputArchive &archive, const MacroRecord &defines) {
+    archive.save(static_cast<uint32_t>(defines.size()));
+    for (const auto &[name, value] : defines) {
+        saveString(archive, name);
+        archive.save(static_cast<uint32_t>(value.index()));
+        if (const auto *i = ccstd::get_if<int32_t>(&value)) {
+            archive.save(*i);
+        } else if (const auto *b = ccstd::get_if<bool>(&value)) {
+            archive.save(static_cast<uint32_t>(*b));
+        } else if (const auto *s = ccstd::get_if<ccstd::string>(&value)) {
+            saveString(archive, *s);
+        }
+    }
+}
+
+bool loadDefines(BinaryInputArchive &archive, MacroRecord &defines) {
+    uint32_t size = 0;
+    if (!archive.load(size) || size > MAX_LIST_SIZE) {
+        return false;
+    }
+    for (uint32_t i = 0; i != size; ++i) {
+        ccstd::string name;
+        uint32_t index = 0;
+        if (!loadString(archive, name) || !archive.load(index)) {
+            return false;
+        }
+        auto &value = defines[name];
+        bool result = true;
+        switch (index) {
+            case 0:
+                break;
+            case 1: {
+                int32_t v = 0;
+                result = archive.load(v);
+                value = v;
+            } break;
+            case 2: {
+                uint32_t v = 0;
+                result = archive.load(v);
+                value = v != 0;
+            } break;
+            case 3: {
+                ccstd::string v;
+                result = loadString(archive, v);
+                value = std::move(v);
+            } break;
+            default:
+                return false;
+        }
+        if (!result) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void saveAttributes(BinaryOutputArchive &archive, const gfx::AttributeList &attributes) {
+    archive.save(static_cast<uint32_t>(attributes.size()));
+    for (const auto &attr : attributes) {
+        saveString(archive, attr.name);
+        saveValue(archive, attr.format);
+        saveValue(archive, attr.isNormalized);
+        archive.save(attr.stream);
+        saveValue(archive, attr.isInstanced);
+        archive.save(attr.location);
+    }
+}
+
+bool loadAttributes(BinaryInputArchive &archive, gfx::AttributeList &attributes) {
+    uint32_t size = 0;
+    if (!archive.load(size) || size > MAX_LIST_SIZE) {
+        return false;
+    }
+    attributes.resize(size);
+    bool result = true;
+    for (auto &attr : attributes) {
+        result &= loadString(archive, attr.name);
+        result &= loadValue(archive, attr.format);
+        result &= loadValue(archive, attr.isNormalized);
+        result &= archive.load(attr.stream);
+        result &= loadValue(archive, attr.isInstanced);
+        result &= archive.load(attr.location);
+    }
+    return result;
+}
+
+void saveDepthStencilAttachment(BinaryOutputArchive &archive, const gfx::DepthStencilAttachment &ds) {
+    saveValue(archive, ds.format);
+    saveValue(archive, ds.sampleCount);
+    saveValue(archive, ds.depthLoadOp);
+    saveValue(archive, ds.depthStoreOp);
+    saveValue(archive, ds.stencilLoadOp);
+    saveValue(archive, ds.stencilStoreOp);
+}
+
+bool loadDepthStencilAttachment(BinaryInputArchive &archive, gfx::DepthStencilAttachment &ds) {
+    bool result = true;
+    result &= loadValue(archive, ds.format);
+    result &= loadValue(archive, ds.sampleCount);
+    result &= loadValue(archive, ds.depthLoadOp);
+    result &= loadValue(archive, ds.depthStoreOp);
+    result &= loadValue(archive, ds.stencilLoadOp);
+    result &= loadValue(archive, ds.stencilStoreOp);
+    return result;
+}
+
+void saveRenderPass(BinaryOutputArchive &archive, const gfx::RenderPassInfo &info) {
+    archive.save(static_cast<uint32_t>(info.colorAttachments.size()));
+    for (const auto &color : info.colorAttachments) {
+        saveValue(archive, color.format);
+        saveValue(archive, color.sampleCount);
+        saveValue(archive, color.loadOp);
+        saveValue(archive, color.storeOp);
+    }
+    saveDepthStencilAttachment(archive, info.depthStencilAttachment);
+    saveDepthStencilAttachment(archive, info.depthStencilResolveAttachment);
+
+    archive.save(static_cast<uint32_t>(info.subpasses.size()));
+    for (const auto &subpass : info.subpasses) {
+        saveTrivialList(archive, subpass.inputs);
+        saveTrivialList(archive, subpass.colors);
+        saveTrivialList(archive, subpass.resolves);
+        saveTrivialList(archive, subpass.preserves);
+        archive.save(subpass.depthStencil);
+        archive.save(subpass.depthStencilResolve);
+        archive.save(subpass.shadingRate);
+        saveValue(archive, subpass.depthResolveMode);
+        saveValue(archive, subpass.stencilResolveMode);
+    }
+}
+
+bool loadRenderPass(BinaryInputArchive &archive, gfx::RenderPassInfo &info) {
+    uint32_t size = 0;
+    if (!archive.load(size) || size > MAX_LIST_SIZE) {
+        return false;
+    }
+    bool result = true;
+    info.colorAttachments.resize(size);
+    for (auto &color : info.colorAttachments) {
+        result &= loadValue(archive, color.format);
+        result &= loadValue(archive, color.sampleCount);
+        result &= loadValue(archive, color.loadOp);
+        result &= loadValue(archive, color.storeOp);
+    }
+    result &= loadDepthStencilAttachment(archive, info.depthStencilAttachment);
+    result &= loadDepthStencilAttachment(archive, info.depthStencilResolveAttachment);
+
+    if (!result || !archive.load(size) || size > MAX_LIST_SIZE) {
+        return false;
+    }
+    info.subpasses.resize(size);
+    for (auto &subpass : info.subpasses) {
+        result &= loadTrivialList(archive, subpass.inputs);
+        result &= loadTrivialList(archive, subpass.colors);
+        result &= loadTrivialList(archive, subpass.resolves);
+        result &= loadTrivialList(archive, subpass.preserves);
+        result &= archive.load(subpass.depthStencil);
+        result &= archive.load(subpass.depthStencilResolve);
+        result &= archive.load(subpass.shadingRate);
+        result &= loadValue(archive, subpass.depthResolveMode);
+        result &= loadValue(archive, subpass.stencilResolveMode);
+    }
+    return result;
+}
+
+void saveBarriers(BinaryOutputArchive &archive, const ccstd::vector<ccstd::optional<gfx::GeneralBarrierInfo>> &barriers) {
+    archive.save(static_cast<uint32_t>(barriers.size()));
+    for (const auto &barrier : barriers) {
+        archive.save(static_cast<uint32_t>(barrier.has_value()));
+        if (barrier.has_value()) {
+            saveValue(archive, barrier->prevAccesses);
+            saveValue(archive, barrier->nextAccesses);
+            saveValue(archive, barrier->type);
+        }
+    }
+}
+
+bool loadBarriers(BinaryInputArchive &archive, ccstd::vector<ccstd::optional<gfx::GeneralBarrierInfo>> &barriers) {
+    uint32_t size = 0;
+    if (!archive.load(size) || size > MAX_LIST_SIZE) {
+        return false;
+    }
+    barriers.resize(size);
+    for (auto &barrier : barriers) {
+        uint32_t hasValue = 0;
+        if (!archive.load(hasValue)) {
+            return false;
+        }
+        if (hasValue) {
+            gfx::GeneralBarrierInfo info;
+            bool result = true;
+            result &= loadValue(archive, info.prevAccesses);
+            result &= loadValue(archive, info.nextAccesses);
+            result &= loadValue(archive, info.type);
+            if (!result) {
+                return false;
+            }
+            barrier = info;
+        }
+    }
+    return true;
+}
+
+void saveRecord(BinaryOutputArchive &archive, const PipelineStateRecord &record) {
+    saveString(archive, record.programName);
+    saveString(archive, record.shaderName);
+    archive.save(record.phaseID);
+    saveDefines(archive, record.defines);
+    archive.save(record.passHash);
+    archive.save(record.attributesHash);
+    saveAttributes(archive, record.attributes);
+    saveRenderPass(archive, record.renderPass);
+    saveBarriers(archive, record.barriers);
+    archive.save(record.subpass);
+    saveValue(archive, record.rasterizerState);
+    saveValue(archive, record.depthStencilState);
+    archive.save(record.blendState.isA2C);
+    archive.save(record.blendState.isIndepend);
+    saveValue(archive, record.blendState.blendColor);
+    saveTrivialList(archive, record.blendState.targets);
+    saveValue(archive, record.primitive);
+    saveValue(archive, record.dynamicStates);
+}
+
+bool loadRecord(BinaryInputArchive &archive, PipelineStateRecord &record) {
+    bool result = loadString(archive, record.programName);
+    result = result && loadString(archive, record.shaderName);
+    result = result && archive.load(record.phaseID);
+    result = result && loadDefines(archive, record.defines);
+    result = result && archive.load(record.passHash);
+    result = result && archive.load(record.attributesHash);
+    result = result && loadAttributes(archive, record.attributes);
+    result = result && loadRenderPass(archive, record.renderPass);
+    result = result && loadBarriers(archive, record.barriers);
+    result = result && archive.load(record.subpass);
+    result = result && loadValue(archive, record.rasterizerState);
+    result = result && loadValue(archive, record.depthStencilState);
+    result = result && archive.load(record.blendState.isA2C);
+    result = result && archive.load(record.blendState.isIndepend);
+    result = result && loadValue(archive, record.blendState.blendColor);
+    result = result && loadTrivialList(archive, record.blendState.targets);
+    result = result && loadValue(archive, record.primitive);
+    result = result && loadValue(archive, record.dynamicStates);
+    return result;
+}
+
+} // namespace
+
+ccstd::hash_t PipelineStateManifest::getRecordHash(const PipelineStateRecord &record) {
+    ccstd::hash_t seed = 0;
+    ccstd::hash_combine(seed, record.shaderName);
+    ccstd::hash_combine(seed, record.phaseID);
+    ccstd::hash_combine(seed, record.passHash);
+    ccstd::hash_combine(seed, record.attributesHash);
+    ccstd::hash_combine(seed, gfx::Hasher<gfx::RenderPassInfo>()(record.renderPass));
+    for (const auto &barrier : record.barriers) {
+        ccstd::hash_combine(seed, barrier.has_value() ? gfx::Hasher<gfx::GeneralBarrierInfo>()(*barrier) : 0);
+    }
+    ccstd::hash_combine(seed, record.subpass);
+    return seed;
+}
+
+bool PipelineStateManifest::add(PipelineStateRecord &&record) {
+    if (!_hashes.emplace(getRecordHash(record)).second) {
+        return false;
+    }
+    _records.emplace_back(std::move(record));
+    _dirty = true;
+    return true;
+}
+
+void PipelineStateManifest::clear() {
+    _records.clear();
+    _hashes.clear();
+    _dirty = false;
+}
+
+bool PipelineStateManifest::load(const ccstd::string &path) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open()) {
+        CC_LOG_INFO("Load pipeline state manifest, no cached files.");
+        return false;
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+
+    BinaryInputArchive archive(stream);
+    auto loadResult = archive.load(magic);
+    loadResult &= archive.load(version);
+
+    if (!loadResult || magic != MAGIC || version != VERSION) {
+        return false;
+    }
+
+    uint32_t recordCount = 0;
+    PipelineStateRecord record;
+    while (loadRecord(archive, record)) {
+        ++recordCount;
+        add(std::move(record));
+        record = {};
+    }
+    // a truncated record at the end of the file is dropped.
+    _dirty = false;
+    CC_LOG_INFO("Load pipeline state manifest success. records %u", recordCount);
+    return true;
+}
+
+bool PipelineStateManifest::save(const ccstd::string &path) {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open()) {
+        CC_LOG_INFO("Save pipeline state manifest failed.");
+        return false;
+    }
+    BinaryOutputArchive archive(stream);
+    archive.save(MAGIC);
+    archive.save(VERSION);
+    for (const auto &record : _records) {
+        saveRecord(archive, record);
+    }
+    _dirty = false;
+    return true;
+}
+
+} // namespace pipeline
+} // namespace cc
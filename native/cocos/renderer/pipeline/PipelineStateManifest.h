@@ -0,0 +1,88 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_set.h"
+#include "base/std/container/vector.h"
+#include "base/std/optional.h"
+#include "gfx-base/GFXDef.h"
+#include "renderer/core/PassUtils.h"
+
+namespace cc {
+namespace pipeline {
+
+/**
+ * Everything needed to recreate a pipeline state object on a later run.
+ * Barriers are kept by value, the render pass info holds no barrier pointers.
+ */
+struct PipelineStateRecord {
+    ccstd::string programName;
+    ccstd::string shaderName;
+    uint32_t phaseID{0};
+    MacroRecord defines;
+
+    ccstd::hash_t passHash{0};
+    ccstd::hash_t attributesHash{0};
+    gfx::AttributeList attributes;
+
+    gfx::RenderPassInfo renderPass;
+    // color attachments first, then depth stencil and depth stencil resolve
+    ccstd::vector<ccstd::optional<gfx::GeneralBarrierInfo>> barriers;
+    uint32_t subpass{0};
+
+    gfx::RasterizerState rasterizerState;
+    gfx::DepthStencilState depthStencilState;
+    gfx::BlendState blendState;
+    gfx::PrimitiveMode primitive{gfx::PrimitiveMode::TRIANGLE_LIST};
+    gfx::DynamicStateFlags dynamicStates{gfx::DynamicStateFlagBit::NONE};
+};
+
+/**
+ * The list of pipeline states created while the application runs,
+ * persisted so that the next start can create them ahead of time.
+ */
+class CC_DLL PipelineStateManifest {
+public:
+    static ccstd::hash_t getRecordHash(const PipelineStateRecord &record);
+
+    // returns false if the record is already in the manifest
+    bool add(PipelineStateRecord &&record);
+    void clear();
+
+    bool load(const ccstd::string &path);
+    bool save(const ccstd::string &path);
+
+    inline const ccstd::vector<PipelineStateRecord> &getRecords() const { return _records; }
+    inline bool isDirty() const { return _dirty; }
+
+private:
+    ccstd::vector<PipelineStateRecord> _records;
+    ccstd::unordered_set<ccstd::hash_t> _hashes;
+    bool _dirty{false};
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -76,7 +76,10 @@ void RenderInstancedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::Re
                 if (!instance.drawInfo.instanceCount) {
                     continue;
                 }
-                auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, instance.shader, instance.ia, renderPass);
+                auto *pso = PipelineStateManager::tryGetOrCreatePipelineState(pass, instance.shader, instance.ia, renderPass);
+                if (!pso) {
+                    continue;
+                }
                 if (lastPSO != pso) {
                     cmdBuffer->bindPipelineState(pso);
                     lastPSO = pso;
@@ -103,13 +103,18 @@ void RenderQueue::recordCommandBuffer(gfx::Device * /*device*/, scene::Camera *c
             auto *inputAssembler = subModel->getInputAssembler();
             const auto *pass = subModel->getPass(passIdx);
             auto *shader = subModel->getShader(passIdx);
-            auto *pso = PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass, subpassIndex);
-
-            cmdBuff->bindPipelineState(pso);
-            cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
-            cmdBuff->bindDescriptorSet(localSet, subModel->getDescriptorSet());
-            cmdBuff->bindInputAssembler(inputAssembler);
-            cmdBuff->draw(inputAssembler);
+            // skip the draw until its pipeline state is created, unless it is queried:
+            // an empty query would report the model as occluded in the next frame
+            auto *pso = enableOcclusionQuery
+                            ? PipelineStateManager::getOrCreatePipelineState(pass, shader, inputAssembler, renderPass, subpassIndex)
+                            : PipelineStateManager::tryGetOrCreatePipelineState(pass, shader, inputAssembler, renderPass, subpassIndex);
+            if (pso) {
+                cmdBuff->bindPipelineState(pso);
+                cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
+                cmdBuff->bindDescriptorSet(localSet, subModel->getDescriptorSet());
+                cmdBuff->bindInputAssembler(inputAssembler);
+                cmdBuff->draw(inputAssembler);
+            }
         }
 
         if (enableOcclusionQuery) {
@@ -22,12 +22,14 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include <algorithm>
 #include "base/std/container/array.h"
 
 #include "Define.h"
 #include "PipelineSceneData.h"
 #include "RenderPipeline.h"
 #include "SceneCulling.h"
+#include "base/job-system/JobSystem.h"
 #include "base/std/container/map.h"
 #include "core/geometry/AABB.h"
 #include "core/geometry/Frustum.h"
@@ -41,12 +43,14 @@
 #include "scene/DirectionalLight.h"
 #include "scene/LODGroup.h"
 #include "scene/Light.h"
+#include "scene/BVH.h"
 #include "scene/Octree.h"
 #include "scene/RangedDirectionalLight.h"
 #include "scene/RenderScene.h"
 #include "scene/Shadow.h"
 #include "scene/Skybox.h"
 #include "scene/SpotLight.h"
+#include "scene/WorldBoundsSoA.h"
 #include "shadow/CSMLayers.h"
 
 namespace cc {
@@ -122,50 +126,95 @@ void validPunctualLightsCulling(const RenderPipeline *pipeline, const scene::Cam
     }
 }
 
-// Todo If you want to optimize the cutting efficiency, you can get it from the octree
-void shadowCulling(const RenderPipeline *pipeline, const scene::Camera *camera, ShadowTransformInfo *layer) {
+void shadowCulling(const RenderPipeline *pipeline, const scene::Camera *camera) {
+    CC_PROFILE(ShadowCulling);
     const auto *sceneData = pipeline->getPipelineSceneData();
     auto *csmLayers = sceneData->getCSMLayers();
     const auto *const scene = camera->getScene();
     const auto *mainLight = scene->getMainLight();
-    const uint32_t visibility = camera->getVisibility();
+    if (!mainLight) {
+        return;
+    }
 
-    layer->clearShadowObjects();
+    ccstd::array<ShadowTransformInfo *, 4> layers{};
+    uint32_t layerCount = 1;
+    if (mainLight->isShadowFixedArea()) {
+        layers[0] = csmLayers->getSpecialLayer();
+    } else {
+        layerCount = sceneData->getCSMSupported() ? static_cast<uint32_t>(mainLight->getCSMLevel()) : 1U;
+        for (uint32_t i = 0; i < layerCount; ++i) {
+            layers[i] = csmLayers->getLayers()[i];
+        }
+    }
+    const bool removeDuplicates = mainLight->getCSMOptimizationMode() == scene::CSMOptimizationMode::REMOVE_DUPLICATES;
+    shadowCulling(camera, csmLayers->getLayerObjects(), layers.data(), layerCount, removeDuplicates, static_cast<uint32_t>(mainLight->getCSMLevel()));
+}
 
-    if (csmLayers->getLayerObjects().empty()) return;
+void shadowCulling(const scene::Camera *camera, RenderObjectList &objects, ShadowTransformInfo *const *layers, uint32_t layerCount, bool removeDuplicates, uint32_t csmLevel) {
+    CC_ASSERT(layerCount <= 4);
+    for (uint32_t i = 0; i < layerCount; ++i) {
+        layers[i]->clearShadowObjects();
+    }
 
-    for (auto it = csmLayers->getLayerObjects().begin(); it != csmLayers->getLayerObjects().end();) {
-        const auto *model = it->model;
-        if (!model || !model->isEnabled() || !model->getNode()) {
-            it = csmLayers->getLayerObjects().erase(it);
-            continue;
-        }
-        const auto *node = model->getNode();
-        if (((visibility & node->getLayer()) != node->getLayer()) && !(visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-            it = csmLayers->getLayerObjects().erase(it);
-            continue;
+    // drop objects that can't cast into any cascade, keeping the order stable
+    const uint32_t visibility = camera->getVisibility();
+    objects.erase(std::remove_if(objects.begin(), objects.end(), [visibility](const RenderObject &ro) {
+                      const auto *model = ro.model;
+                      if (!model || !model->isEnabled() || !model->getNode()) {
+                          return true;
+                      }
+                      const auto *node = model->getNode();
+                      if (((visibility & node->getLayer()) != node->getLayer()) && !(visibility & static_cast<uint32_t>(model->getVisFlags()))) {
+                          return true;
+                      }
+                      return !model->getWorldBounds() || !model->isCastShadow();
+                  }),
+                  objects.end());
+    if (objects.empty()) {
+        return;
+    }
+
+    const auto count = static_cast<uint32_t>(objects.size());
+    thread_local ccstd::vector<const scene::Model *> models;
+    thread_local ccstd::array<ccstd::vector<uint8_t>, 4> cascadeFlags;
+    models.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        models[i] = objects[i].model;
+    }
+
+    // Each cascade writes its own flag array: bit 0 marks the object as intersecting the
+    // cascade, bit 1 as completely inside it, so the cascades are culled independently.
+    constexpr uint8_t INTERSECTS = 1;
+    constexpr uint8_t COMPLETELY_INSIDE = 2;
+    // thread_local storage must be reached through pointers inside the jobs
+    const auto *const *modelData = models.data();
+    auto *flagArrays = cascadeFlags.data();
+    parallelForEachIndex(layerCount, [&](uint32_t l) {
+        auto &flags = flagArrays[l];
+        flags.resize(count);
+        const auto &frustum = layers[l]->getValidFrustum();
+        scene::WorldBoundsSoA::cullFrustum(frustum, modelData, count, flags.data());
+        if (!removeDuplicates || layers[l]->getLevel() >= csmLevel) {
+            return;
         }
-        if (!model->getWorldBounds() || !model->isCastShadow()) {
-            it = csmLayers->getLayerObjects().erase(it);
-            continue;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (flags[i] && aabbFrustumCompletelyInside(*modelData[i]->getWorldBounds(), frustum)) {
+                flags[i] |= COMPLETELY_INSIDE;
+            }
         }
+    });
 
-        // frustum culling
-        const bool accurate = model->getWorldBounds()->aabbFrustum(layer->getValidFrustum());
-        if (!accurate) {
-            ++it;
-            continue;
-        }
-        layer->addShadowObject(genRenderObject(model, camera));
-        if (layer->getLevel() < static_cast<uint32_t>(mainLight->getCSMLevel())) {
-            if (mainLight->getCSMOptimizationMode() == scene::CSMOptimizationMode::REMOVE_DUPLICATES &&
-                aabbFrustumCompletelyInside(*model->getWorldBounds(), layer->getValidFrustum())) {
-                it = csmLayers->getLayerObjects().erase(it);
-            } else {
-                ++it;
+    // An object completely inside a cascade is not drawn again into the following ones.
+    for (uint32_t i = 0; i < count; ++i) {
+        for (uint32_t l = 0; l < layerCount; ++l) {
+            const auto flag = cascadeFlags[l][i];
+            if (!(flag & INTERSECTS)) {
+                continue;
+            }
+            layers[l]->addShadowObject(genRenderObject(models[i], camera));
+            if (flag & COMPLETELY_INSIDE) {
+                break;
             }
-        } else {
-            ++it;
         }
     }
 }
@@ -200,7 +249,9 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
     }
 
     const scene::Octree *octree = scene->getOctree();
-    if (octree && octree->isEnabled()) {
+    const scene::BVH *bvh = scene->getBVH();
+    const bool useBVH = bvh && bvh->isEnabled();
+    if (useBVH || (octree && octree->isEnabled())) {
         for (const auto &model : scene->getModels()) {
             // filter model by view visibility
             if (model->isEnabled()) {
@@ -229,7 +280,11 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
 
         ccstd::vector<const scene::Model *> models;
         models.reserve(scene->getModels().size() / 4);
-        octree->queryVisibility(camera, camera->getFrustum(), false, models);
+        if (useBVH) {
+            bvh->queryVisibility(camera, camera->getFrustum(), false, models);
+        } else {
+            octree->queryVisibility(camera, camera->getFrustum(), false, models);
+        }
         for (const auto &model : models) {
             if (scene->isCulledByLod(camera, model)) {
                 continue;
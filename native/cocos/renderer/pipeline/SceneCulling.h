@@ -46,7 +46,11 @@ class ShadowTransformInfo;
 
 RenderObject genRenderObject(const scene::Model *, const scene::Camera *);
 void validPunctualLightsCulling(const RenderPipeline *pipeline, const scene::Camera *camera);
-void shadowCulling(const RenderPipeline *, const scene::Camera *, ShadowTransformInfo *);
+// Culls the layer objects against all cascades of the main light in a single pass.
+void shadowCulling(const RenderPipeline *, const scene::Camera *);
+// The pipeline independent part of shadowCulling: culls `objects` against `layerCount` cascades
+// and fills their shadow objects. Objects that can't cast a shadow are removed from `objects`.
+void shadowCulling(const scene::Camera *camera, RenderObjectList &objects, ShadowTransformInfo *const *layers, uint32_t layerCount, bool removeDuplicates, uint32_t csmLevel);
 void sceneCulling(const RenderPipeline *, scene::Camera *);
 } // namespace pipeline
 } // namespace cc
@@ -67,10 +67,6 @@ void ShadowMapBatchedQueue::gatherLightPasses(const scene::Camera *camera, const
                         } else {
                             layer = csmLayers->getLayers()[level];
                         }
-                        bool isCullingEnable = camera->isCullingEnabled();
-                        if (isCullingEnable) {
-                            shadowCulling(_pipeline, camera, layer);
-                        }
                         const RenderObjectList &dirShadowObjects = layer->getShadowObjects();
                         for (const auto &ro : dirShadowObjects) {
                             add(ro.model);
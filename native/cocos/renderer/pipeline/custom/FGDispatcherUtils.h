@@ -0,0 +1,82 @@
+/****************************************************************************
+ Copyright (c) 2021-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+#include "cocos/base/std/hash/hash.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherTypes.h"
+#include "cocos/renderer/pipeline/custom/NativePipelineFwd.h"
+#include "gfx-base/GFXDevice.h"
+
+namespace cc {
+
+namespace render {
+
+// results of a dispatch that are consumed by the executor
+struct FrameGraphDispatchResult {
+    using allocator_type = boost::container::pmr::polymorphic_allocator<char>;
+    allocator_type get_allocator() const noexcept { // NOLINT
+        return {aliasedResources.get_allocator().resource()};
+    }
+
+    explicit FrameGraphDispatchResult(const allocator_type& alloc) noexcept
+    : aliasedResources(alloc),
+      parallelGroups(alloc),
+      finalStates(alloc) {}
+
+    // transient resource -> resource whose memory it shares
+    PmrFlatMap<ResourceGraph::vertex_descriptor, ResourceGraph::vertex_descriptor> aliasedResources;
+    uint64_t transientMemorySize{0};
+    uint64_t aliasedTransientMemorySize{0};
+    // parallel group of topologicalOrder[i], adjacent passes of the same group are independent
+    ccstd::pmr::vector<uint32_t> parallelGroups;
+    // side-effect resource -> state it is left in at the end of the frame
+    PmrFlatMap<ResourceGraph::vertex_descriptor, gfx::AccessFlagBit> finalStates;
+};
+
+// same as FrameGraphDispatcher::run(), keeping the results
+void dispatchFrameGraph(FrameGraphDispatcher& fgd, FrameGraphDispatchResult& result);
+
+// apply the resource states of a dispatch again, when it is reused for another frame
+void replayResourceStates(ResourceGraph& resg, const FrameGraphDispatchResult& result);
+
+// hash of everything a dispatch depends on, per-frame constants such as clear values are excluded
+ccstd::hash_t getFrameGraphStructureHash(
+    const RenderGraph& renderGraph,
+    const ResourceGraph& resourceGraph,
+    const LayoutGraphData& layoutGraph);
+
+// the resource shares the gfx object of its owner until the end of the frame
+void mountAliasedResource(
+    gfx::Device* device, ResourceGraph& resg,
+    ResourceGraph::vertex_descriptor resID, ResourceGraph::vertex_descriptor ownerID);
+
+// aliased resources give their borrowed gfx objects back, the owners keep them alive
+void unmountAliasedResources(ResourceGraph& resg, const FrameGraphDispatchResult& result);
+
+// drop the dispatch reused by NativePipeline::executeRenderGraph
+void releaseFrameGraphDispatchCache(const NativePipeline& ppl) noexcept;
+
+} // namespace render
+
+} // namespace cc
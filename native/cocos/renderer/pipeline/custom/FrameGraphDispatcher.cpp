@@ -28,14 +28,15 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/breadth_first_search.hpp>
 #include <boost/graph/filtered_graph.hpp>
-#include <boost/graph/transitive_closure.hpp>
 #include <boost/range/algorithm.hpp>
 #include <iterator>
 #include <limits>
 #include <numeric>
+#include <stack>
 #include <vector>
 #include "FGDispatcherGraphs.h"
 #include "FGDispatcherTypes.h"
+#include "FGDispatcherUtils.h"
 #include "LayoutGraphGraphs.h"
 #include "LayoutGraphTypes.h"
 #include "NativeRenderGraphUtils.h"
@@ -71,18 +72,37 @@ namespace render {
 
 static constexpr bool ENABLE_BRANCH_CULLING = BRANCH_CULLING;
 
-void passReorder(FrameGraphDispatcher &fgDispatcher);
-void memoryAliasing(FrameGraphDispatcher &fgDispatcher);
-void buildBarriers(FrameGraphDispatcher &fgDispatcher);
+void passReorder(FrameGraphDispatcher &fgDispatcher, FrameGraphDispatchResult &result);
+void memoryAliasing(FrameGraphDispatcher &fgDispatcher, FrameGraphDispatchResult &result);
+void buildBarriers(FrameGraphDispatcher &fgDispatcher, FrameGraphDispatchResult &result);
 
 void FrameGraphDispatcher::run() {
-    if (_enablePassReorder) {
-        passReorder(*this);
+    FrameGraphDispatchResult result(scratch);
+    dispatchFrameGraph(*this, result);
+}
+
+void dispatchFrameGraph(FrameGraphDispatcher &fgd, FrameGraphDispatchResult &result) {
+    result.parallelGroups.clear();
+    if (fgd._enablePassReorder) {
+        passReorder(fgd, result);
+    }
+    if (fgd._enableMemoryAliasing) {
+        memoryAliasing(fgd, result);
     }
-    if (_enableMemoryAliasing) {
-        memoryAliasing(*this);
+    buildBarriers(fgd, result);
+
+    const auto &topologicalOrder = fgd.resourceAccessGraph.topologicalOrder;
+    if (result.parallelGroups.empty()) {
+        // passes in declaration order, each one is a group of its own
+        result.parallelGroups.resize(topologicalOrder.size());
+        std::iota(result.parallelGroups.begin(), result.parallelGroups.end(), 0U);
+    }
+}
+
+void replayResourceStates(ResourceGraph &resg, const FrameGraphDispatchResult &result) {
+    for (const auto &[resID, accessFlag] : result.finalStates) {
+        get(ResourceGraph::StatesTag{}, resg, resID).states = accessFlag;
     }
-    buildBarriers(*this);
 }
 
 void FrameGraphDispatcher::enablePassReorder(bool enable) {
@@ -410,14 +430,6 @@ LayoutAccess FrameGraphDispatcher::getResourceAccess(
 
 //---------------------------------------------------------------predefine------------------------------------------------------------------
 using PmrString = ccstd::pmr::string;
-using EdgeList = std::pair<RelationGraph::edge_descriptor, RelationGraph::edge_descriptor>;
-using CloseCircuit = std::pair<EdgeList, EdgeList>;
-using CloseCircuits = ccstd::vector<CloseCircuit>;
-using RelationVert = RelationGraph::vertex_descriptor;
-using RelationVerts = ccstd::vector<RelationVert>;
-using RelationEdge = RelationGraph::edge_descriptor;
-using RelationEdges = ccstd::vector<RelationEdge>;
-using ScoreMap = std::map<RelationVert, std::pair<int64_t /*backward*/, int64_t /*forward*/>>;
 using RasterViewsMap = PmrTransparentMap<ccstd::pmr::string, RasterView>;
 using ComputeViewsMap = PmrTransparentMap<ccstd::pmr::string, ccstd::pmr::vector<ComputeView>>;
 using ResourceLifeRecordMap = PmrFlatMap<PmrString, ResourceLifeRecord>;
@@ -461,6 +473,15 @@ bool isPassExecAdjecent(uint32_t passLID, uint32_t passRID) {
     return std::abs(static_cast<int>(passLID) - static_cast<int>(passRID)) <= 1;
 }
 
+// position of every access node in topologicalOrder, culled nodes are INVALID_ID
+ccstd::pmr::vector<uint32_t> getExecutionOrder(const ResourceAccessGraph &rag, boost::container::pmr::memory_resource *scratch) {
+    ccstd::pmr::vector<uint32_t> execOrder(num_vertices(rag), INVALID_ID, scratch);
+    for (uint32_t i = 0; i != rag.topologicalOrder.size(); ++i) {
+        execOrder[rag.topologicalOrder[i]] = i;
+    }
+    return execOrder;
+}
+
 template <uint32_t N>
 constexpr uint8_t highestBitPos() {
     return highestBitPos<(N >> 1)>() + 1;
@@ -508,12 +529,6 @@ bool accessDependent(const gfx::AccessFlagBit lhs, const gfx::AccessFlagBit &rhs
 template <typename Graph>
 bool tryAddEdge(uint32_t srcVertex, uint32_t dstVertex, Graph &graph);
 
-// for transive_closure.hpp line 231
-inline RelationGraph::vertex_descriptor add_vertex(RelationGraph &g) { // NOLINT
-    thread_local uint32_t count = 0;                                   // unused
-    return add_vertex(g, count++);
-}
-
 bool isResourceView(const ResourceGraph::vertex_descriptor v, const ResourceGraph &resg) {
     return resg.isTextureView(v); // || isBufferView
 }
@@ -1905,7 +1920,7 @@ gfx::ResourceRange getOriginRange(ResourceGraph::vertex_descriptor v, const gfx:
     return ret;
 }
 
-void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
+void buildBarriers(FrameGraphDispatcher &fgDispatcher, FrameGraphDispatchResult &result) {
     auto *scratch = fgDispatcher.scratch;
     const auto &renderGraph = fgDispatcher.renderGraph;
     const auto &layoutGraph = fgDispatcher.layoutGraph;
@@ -1919,6 +1934,7 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
         buildAccessGraph(graphs);
         fgDispatcher._accessGraphBuilt = true;
     }
+    result.finalStates.clear();
 
     auto getGFXBarrier = [&resourceGraph](const Barrier &barrier) {
         gfx::GFXObject *gfxBarrier{nullptr};
@@ -1944,6 +1960,8 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
         return gfxBarrier;
     };
 
+    const auto execOrder = getExecutionOrder(rag, scratch);
+
     // found pass id in this map ? barriers you should commit when run into this pass
     // : or no extra barrier needed.
     for (auto &accessPair : rag.resourceAccess) {
@@ -2030,7 +2048,7 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
                 beginBarrier.endVert = dstPassID;
                 beginBarrier.beginStatus = iter->second;
                 beginBarrier.endStatus = nextIter->second;
-                if (isPassExecAdjecent(iter->first, nextIter->first)) {
+                if (isPassExecAdjecent(execOrder[iter->first], execOrder[nextIter->first])) {
                     beginBarrier.type = gfx::BarrierType::FULL;
                 } else {
                     beginBarrier.type = gfx::BarrierType::SPLIT_BEGIN;
@@ -2066,6 +2084,7 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
 
                 states.states = gfx::AccessFlagBit::NONE;
             }
+            result.finalStates[realResourceID] = states.states;
         }
     }
 
@@ -2100,409 +2119,322 @@ void buildBarriers(FrameGraphDispatcher &fgDispatcher) {
 #pragma endregion BUILD_BARRIERS
 
 #pragma region PASS_REORDER
+namespace {
 
-struct PassVisitor : boost::dfs_visitor<> {
-    using RLGVertex = RelationGraph::vertex_descriptor;
-    using RLGEdge = RelationGraph::edge_descriptor;
-    using InEdgeRange = std::pair<RelationGraph::in_edge_iterator, RelationGraph::in_edge_iterator>;
-    using OutEdgeRange = std::pair<RelationGraph::out_edge_iterator, RelationGraph::out_edge_iterator>;
-
-    PassVisitor(RelationGraph &tcIn, CloseCircuits &circuitsIn) : _relationGraph(tcIn), _circuits(circuitsIn) {}
-
-    void start_vertex(RLGVertex u, const RelationGraph &g) {}
+struct ScheduleUnit {
+    // top-level pass first, followed by its subpasses
+    ccstd::pmr::vector<ResourceAccessGraph::vertex_descriptor> ragVerts;
+    ccstd::pmr::vector<uint32_t> successors;
+    uint32_t numPredecessors{0};
+    uint32_t level{0};
+    int64_t memoryDelta{0};
+};
 
-    void discover_vertex(RLGVertex u, const RelationGraph &g) {}
+bool isTransientResource(ResourceGraph::vertex_descriptor resID, const ResourceGraph &resg) {
+    const auto &traits = get(ResourceGraph::TraitsTag{}, resg, resID);
+    return traits.residency == ResourceResidency::MANAGED;
+}
 
-    void examine_edge(RLGEdge e, const RelationGraph &g) {
+int64_t getResourceMemorySize(const ResourceDesc &desc) {
+    if (desc.dimension == ResourceDimension::BUFFER) {
+        return desc.width;
     }
+    return gfx::formatSize(desc.format, desc.width, desc.height, desc.depthOrArraySize);
+}
 
-    void tree_edge(RLGEdge e, const RelationGraph &g) {}
-
-    void back_edge(RLGEdge e, const RelationGraph &g) {}
-
-    void forward_or_cross_edge(RLGEdge e, const RelationGraph &g) {
-        // the vertex which:
-        // 1. is ancestor of targetID;
-        // 2. sourceID is reachable at this specific vert;
-        // is where the closed-path started.
-        // note that `reachable` may results to multiple paths, choose the shortest one.
-        auto sourceID = source(e, g);
-        auto targetID = target(e, g);
-
-        using RhsRangePair = std::pair<RelationGraph::in_edge_iterator, InEdgeRange>;
-
-        bool foundIntersect = false;
-        std::queue<RhsRangePair> vertQ;
-        auto iterPair = in_edges(targetID, g);
-        vertQ.emplace(RhsRangePair{iterPair.first, iterPair});
-
-        // from source vertex on this edge back to branch point
-        EdgeList rhsPath;
-        bool rootEdge = true;
-        while (!foundIntersect && !vertQ.empty()) {
-            auto rangePair = vertQ.front();
-            vertQ.pop();
-            auto range = rangePair.second;
-            for (auto iter = range.first; iter != range.second; ++iter) {
-                auto srcID = source((*iter), g);
-                if (sourceID == srcID) {
-                    continue;
-                }
-                auto e = edge(srcID, sourceID, _relationGraph);
-                auto recordIter = rootEdge ? iter : rangePair.first;
-                if (!e.second) {
-                    vertQ.emplace(RhsRangePair{recordIter, in_edges(srcID, g)});
-                } else {
-                    rhsPath = {(*iter), *recordIter};
-                    foundIntersect = true;
-                    break;
-                }
-            }
-            rootEdge = false;
-        }
-        assert(foundIntersect);
-
-        using LhsRangePair = std::pair<RelationGraph::out_edge_iterator, OutEdgeRange>;
-        auto branchVert = source(rhsPath.first, g);
-        bool found = false;
-        std::queue<LhsRangePair> forwardVertQ;
-        auto forwardIterPair = out_edges(branchVert, g);
-        forwardVertQ.emplace(LhsRangePair{forwardIterPair.first, forwardIterPair});
-        EdgeList lhsPath;
-        rootEdge = true;
-        while (!found && !forwardVertQ.empty()) {
-            auto rangePair = forwardVertQ.front();
-            forwardVertQ.pop();
-            auto range = rangePair.second;
-            for (auto iter = range.first; iter != range.second; ++iter) {
-                if ((*iter) == rhsPath.first) {
-                    continue;
-                }
-                auto dstID = target((*iter), g);
-                auto e = edge(dstID, sourceID, _relationGraph);
-                auto recordIter = rootEdge ? iter : rangePair.first;
-                if (!e.second) {
-                    forwardVertQ.emplace(LhsRangePair{recordIter, out_edges(dstID, g)});
-                } else {
-                    found = true;
-                    lhsPath = {*recordIter, (*iter)};
-                    break;
-                }
-            }
-            rootEdge = true;
-        }
-        assert(found);
-        lhsPath.second = e;
+} // namespace
 
-        _circuits.emplace_back(CloseCircuit{lhsPath, rhsPath});
-    };
+void passReorder(FrameGraphDispatcher &fgDispatcher, FrameGraphDispatchResult &result) {
+    auto *scratch = fgDispatcher.scratch;
+    const auto &renderGraph = fgDispatcher.renderGraph;
+    const auto &layoutGraph = fgDispatcher.layoutGraph;
+    auto &resourceGraph = fgDispatcher.resourceGraph;
+    auto &relationGraph = fgDispatcher.relationGraph;
+    auto &rag = fgDispatcher.resourceAccessGraph;
 
-private:
-    RelationGraph &_relationGraph;
-    CloseCircuits &_circuits;
-};
+    if (!fgDispatcher._accessGraphBuilt) {
+        Graphs graphs{renderGraph, layoutGraph, resourceGraph, rag, relationGraph};
+        buildAccessGraph(graphs);
+        fgDispatcher._accessGraphBuilt = true;
+    }
 
-// forward (vertex ascending):
-// -- true: how much resource this pass writes to, which has an effect of later passes;
-// -- false: how much resource this pass reads from, which is dependent from former passes.
-auto evaluateHeaviness(const ResourceAccessGraph &rag, const ResourceGraph &rescGraph, ResourceAccessGraph::vertex_descriptor vert, bool forward) {
-    const ResourceAccessNode &accessNode = get(ResourceAccessGraph::PassNodeTag{}, rag, vert);
-    int64_t score = 0;
-    bool forceAdjacent = false;
-    for (const auto &pair : accessNode.resourceStatus) {
-        int64_t eval = 0;
-        auto rescID = rag.resourceIndex.at(pair.first);
-        const ResourceDesc &desc = get(ResourceGraph::DescTag{}, rescGraph, rescID);
-        const ResourceTraits &traits = get(ResourceGraph::TraitsTag{}, rescGraph, rescID);
-
-        const auto &resc = pair.second;
-        if (!(isReadOnlyAccess(resc.accessFlag) ^ forward)) {
-            // forward calculate write(s), backward calculate read(s).
+    // subpasses are scheduled together with their render pass
+    const auto numVerts = static_cast<uint32_t>(num_vertices(rag));
+    ccstd::pmr::vector<uint32_t> unitIndex(numVerts, INVALID_ID, scratch);
+    ccstd::pmr::vector<ScheduleUnit> units(scratch);
+    for (auto ragVertID : makeRange(vertices(rag))) {
+        if (ragVertID == EXPECT_START_ID || ragVertID == rag.presentPassID || rag.culledPasses.count(ragVertID)) {
             continue;
         }
-
-        switch (desc.dimension) {
-            case ResourceDimension::BUFFER:
-                eval = desc.width;
-                break;
-            case ResourceDimension::TEXTURE1D:
-            case ResourceDimension::TEXTURE2D:
-            case ResourceDimension::TEXTURE3D:
-                eval = gfx::formatSize(desc.format, desc.width, desc.height, desc.depthOrArraySize);
-                break;
+        const auto passID = get(ResourceAccessGraph::PassIDTag{}, rag, ragVertID);
+        if (passID == RenderGraph::null_vertex()) {
+            continue;
         }
-
-        if (traits.residency == ResourceResidency::MEMORYLESS) {
-            forceAdjacent = true;
-            score = forward ? std::numeric_limits<int64_t>::lowest() : std::numeric_limits<int64_t>::max();
-            break;
+        if (holds<RasterSubpassTag>(passID, renderGraph) || holds<ComputeSubpassTag>(passID, renderGraph)) {
+            const auto parentVertID = rag.passIndex.at(parent(passID, renderGraph));
+            CC_EXPECTS(unitIndex[parentVertID] != INVALID_ID);
+            unitIndex[ragVertID] = unitIndex[parentVertID];
+        } else {
+            unitIndex[ragVertID] = static_cast<uint32_t>(units.size());
+            units.emplace_back(ScheduleUnit{
+                ccstd::pmr::vector<ResourceAccessGraph::vertex_descriptor>(scratch),
+                ccstd::pmr::vector<uint32_t>(scratch)});
         }
+        units[unitIndex[ragVertID]].ragVerts.emplace_back(ragVertID);
     }
-    return std::make_tuple(forceAdjacent, score);
-};
-
-void evaluateAndTryMerge(const ResourceAccessGraph &rag, const ResourceGraph &rescGraph, RelationGraph &relationGraph, const RelationGraph &relationGraphTc, const RelationVerts &lhsVerts, const RelationVerts &rhsVerts) {
-    assert(lhsVerts.size() >= 2);
-    assert(rhsVerts.size() >= 2);
 
-    auto evaluate = [&rag, &rescGraph, &relationGraph](RelationVert vert, bool forward) {
-        auto ragVert = get(RelationGraph::DescIDTag{}, relationGraph, vert);
-        return evaluateHeaviness(rag, rescGraph, ragVert, forward);
+    // dependencies between units, edges always point to a later declared unit
+    ccstd::pmr::vector<std::pair<uint32_t, uint32_t>> dependencies(scratch);
+    auto addDependency = [&](ResourceAccessGraph::vertex_descriptor src, ResourceAccessGraph::vertex_descriptor dst) {
+        if (src >= numVerts || dst >= numVerts) {
+            return;
+        }
+        const auto srcUnit = unitIndex[src];
+        const auto dstUnit = unitIndex[dst];
+        if (srcUnit != INVALID_ID && dstUnit != INVALID_ID && srcUnit != dstUnit) {
+            CC_EXPECTS(srcUnit < dstUnit);
+            dependencies.emplace_back(srcUnit, dstUnit);
+        }
     };
-
-    if (lhsVerts.size() == 2 || rhsVerts.size() == 2) {
-        /*
-               1 ----------- 2
-                \       __--/
-                 3 --``
-            no extra choice, only 1 - 3 - 2
-        */
-        const RelationVerts *shorterPath = lhsVerts.size() == 2 ? &lhsVerts : &rhsVerts;
-        remove_edge((*shorterPath)[0], (*shorterPath)[1], relationGraph);
-    } else {
-        // fist and last joint pass in this circuit don't get involved in reorder.
-        auto firstLhsNode = lhsVerts[1];
-        auto lastLhsNode = lhsVerts[lhsVerts.size() - 2];
-
-        const auto &lhsBackwardStatus = evaluate(firstLhsNode, false);
-        bool lhsAdjacentToStart = std::get<0>(lhsBackwardStatus);
-        const auto &lhsForwardStatus = evaluate(lastLhsNode, true);
-        bool lhsAdjacentToEnd = std::get<0>(lhsForwardStatus);
-
-        auto firstRhsNode = rhsVerts[1];
-        auto lastRhsNode = rhsVerts[rhsVerts.size() - 2];
-
-        const auto &rhsBackwardStatus = evaluate(firstRhsNode, true);
-        bool rhsAdjacentToStart = std::get<0>(rhsBackwardStatus);
-        const auto &rhsForwardStatus = evaluate(lastRhsNode, false);
-        bool rhsAdjacentToEnd = std::get<0>(rhsForwardStatus);
-
-        if (lhsAdjacentToStart || rhsAdjacentToEnd || lhsAdjacentToEnd || rhsAdjacentToStart) {
-            const RelationVerts *formerPath = &lhsVerts;
-            const RelationVerts *latterPath = &rhsVerts;
-            if (rhsAdjacentToStart || lhsAdjacentToEnd) {
-                swap(formerPath, latterPath);
-            }
-
-            remove_edge((*latterPath)[0], (*latterPath)[1], relationGraph);
-            remove_edge((*formerPath)[formerPath->size() - 2], (*formerPath)[formerPath->size() - 1], relationGraph);
-
-            tryAddEdge((*formerPath)[formerPath->size() - 2], (*latterPath)[1], relationGraph);
+    for (auto ragVertID : makeRange(vertices(rag))) {
+        for (const auto e : makeRange(out_edges(ragVertID, rag))) {
+            addDependency(ragVertID, target(e, rag));
         }
-
-        assert(lhsVerts.size() >= 3 && rhsVerts.size() >= 3);
-        constexpr int64_t score = std::numeric_limits<int64_t>::lowest();
-        ccstd::vector<std::queue<RelationEdge>> candidateSections;
-        std::queue<RelationEdge> lhsSection;
-        for (size_t i = 1; i < lhsVerts.size(); ++i) {
-            auto tryE = edge(lhsVerts[i], lhsVerts[i - 1], relationGraphTc);
-            auto tryRE = edge(lhsVerts[i - 1], lhsVerts[i], relationGraphTc);
-            // check if original reachable
-            if (!tryE.second && !tryRE.second) {
-                remove_edge(lhsVerts[i - 1], lhsVerts[i], relationGraph);
-                candidateSections.emplace_back(lhsSection);
-                std::queue<RelationEdge> clearQ;
-                lhsSection.swap(clearQ);
+    }
+    // barriers are built between adjacent accesses of each resource in declaration order,
+    // so every access keeps its place relative to the other accesses of the same resource.
+    // shared resources are also the only thing linking two branches, so independent branches
+    // (shadow maps, reflection probes, bloom chains) stay free to move.
+    for (const auto &[resName, accessRecord] : rag.resourceAccess) {
+        auto last = EXPECT_START_ID;
+        for (const auto &[ragVertID, status] : accessRecord) {
+            if (ragVertID == EXPECT_START_ID || unitIndex[ragVertID] == INVALID_ID) {
+                continue;
             }
-            auto e = edge(lhsVerts[i], lhsVerts[i - 1], relationGraph);
-            // verts comes in order, so either real edge exist or logic edge is added.
-            CC_ASSERT(e.second);
-
-            lhsSection.emplace(e.first);
+            if (last != EXPECT_START_ID) {
+                addDependency(last, ragVertID);
+            }
+            last = ragVertID;
         }
-        if (candidateSections.empty()) {
-            // if this one is a tight edge(no logic edge, dependent from one to its next),
-            // keep this whole chain as a candidate.
-            remove_edge(lhsVerts[0], lhsVerts[1], relationGraph);
-            remove_edge(lhsVerts[lhsVerts.size() - 2], lhsVerts[lhsVerts.size() - 1], relationGraph);
-            candidateSections.emplace_back(std::move(lhsSection));
+    }
+    std::sort(dependencies.begin(), dependencies.end());
+    dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+    for (const auto &[src, dst] : dependencies) {
+        units[src].successors.emplace_back(dst);
+        ++units[dst].numPredecessors;
+    }
+
+    // level: longest path from a root, units of the same level never depend on each other
+    uint32_t maxLevel = 0;
+    for (auto &unit : units) {
+        for (const auto succ : unit.successors) {
+            units[succ].level = std::max(units[succ].level, unit.level + 1);
         }
+        maxLevel = std::max(maxLevel, unit.level);
+    }
 
-        std::queue<RelationEdge> rhsSection;
-        for (size_t i = 1; i < rhsVerts.size(); ++i) {
-            auto tryE = edge(rhsVerts[i], rhsVerts[i - 1], relationGraphTc);
-            auto tryRE = edge(rhsVerts[i - 1], rhsVerts[i], relationGraphTc);
-            if (!tryE.second && !tryRE.second) {
-                remove_edge(rhsVerts[i - 1], rhsVerts[i], relationGraph);
-                candidateSections.emplace_back(rhsSection);
-                std::queue<RelationEdge> clearQ;
-                rhsSection.swap(clearQ);
+    // transient memory allocated (first access) minus released (last access) by each unit
+    int64_t minDelta = 0;
+    int64_t maxDelta = 0;
+    for (const auto &[resName, accessRecord] : rag.resourceAccess) {
+        const auto resID = findVertex(resName, resourceGraph);
+        if (resID == ResourceGraph::null_vertex() ||
+            parent(resID, resourceGraph) != ResourceGraph::null_vertex() ||
+            !isTransientResource(resID, resourceGraph)) {
+            continue;
+        }
+        auto first = INVALID_ID;
+        auto last = INVALID_ID;
+        for (const auto &[ragVertID, status] : accessRecord) {
+            if (ragVertID == EXPECT_START_ID || unitIndex[ragVertID] == INVALID_ID) {
+                continue;
             }
-            auto e = edge(rhsVerts[i], rhsVerts[i - 1], relationGraph);
-            // verts comes in order, so either real edge exist or logic edge is added.
-            CC_ASSERT(e.second);
-            rhsSection.emplace(e.first);
+            if (first == INVALID_ID) {
+                first = unitIndex[ragVertID];
+            }
+            last = unitIndex[ragVertID];
         }
-
-        // lhs verts already put in.
-        if (candidateSections.size() == 1) {
-            remove_edge(rhsVerts[0], rhsVerts[1], relationGraph);
-            remove_edge(rhsVerts[rhsVerts.size() - 2], rhsVerts[rhsVerts.size() - 1], relationGraph);
-            candidateSections.emplace_back(std::move(rhsSection));
+        if (first == INVALID_ID) {
+            continue;
         }
+        const auto size = getResourceMemorySize(get(ResourceGraph::DescTag{}, resourceGraph, resID));
+        units[first].memoryDelta += size;
+        units[last].memoryDelta -= size;
+    }
+    for (const auto &unit : units) {
+        minDelta = std::min(minDelta, unit.memoryDelta);
+        maxDelta = std::max(maxDelta, unit.memoryDelta);
+    }
+
+    // list scheduling, _paralellExecWeight trades memory against overlap:
+    //  - 0: run the unit releasing most memory first, branches are finished one by one.
+    //  - 1: run level by level, independent branches are interleaved and can overlap.
+    const float weight = fgDispatcher._paralellExecWeight;
+    auto getCost = [&](uint32_t unitID) {
+        const auto &unit = units[unitID];
+        const float levelCost = maxLevel ? static_cast<float>(unit.level) / static_cast<float>(maxLevel) : 0.0F;
+        const float memoryCost = maxDelta != minDelta
+                                     ? static_cast<float>(unit.memoryDelta - minDelta) / static_cast<float>(maxDelta - minDelta)
+                                     : 0.0F;
+        return weight * levelCost + (1.0F - weight) * memoryCost;
+    };
 
-        assert(candidateSections.size() >= 2);
-
-        ScoreMap scMap;
-        auto tailVert = lhsVerts[0];
-        while (!candidateSections.empty()) {
-            int64_t lightest = std::numeric_limits<int64_t>::max();
-            uint32_t index = 0;
-            for (size_t i = 0; i < candidateSections.size(); ++i) {
-                auto e = candidateSections[i].front();
-                auto srcVert = source(e, relationGraph);
-                auto dstVert = target(e, relationGraph);
-                int64_t srcBackwardScore = 0;
-                int64_t dstForwardScore = 0;
-                if (scMap.find(srcVert) == scMap.end()) {
-                    auto res = evaluate(srcVert, false);
-                    srcBackwardScore = std::get<1>(res);
-                    res = evaluate(srcVert, true);
-                    auto srcForwardScore = std::get<1>(res);
-                    scMap.emplace(srcVert, std::pair<int64_t, int64_t>(srcBackwardScore, srcForwardScore));
-                } else {
-                    srcBackwardScore = std::get<0>(scMap.at(srcVert));
-                }
-                if (scMap.find(dstVert) == scMap.end()) {
-                    auto res = evaluate(dstVert, false);
-                    dstForwardScore = std::get<1>(res);
-                    res = evaluate(dstVert, true);
-                    auto dstBackwardScore = std::get<1>(res);
-                    scMap.emplace(dstVert, std::pair<int64_t, int64_t>(dstBackwardScore, dstForwardScore));
-                } else {
-                    dstForwardScore = std::get<1>(scMap.at(dstVert));
-                }
+    rag.topologicalOrder.clear();
+    result.parallelGroups.clear();
+    rag.topologicalOrder.emplace_back(EXPECT_START_ID);
+    result.parallelGroups.emplace_back(0);
 
-                // we are in a simple path, so all the "input(this path)" resource of this path come from the first vertex,
-                // all the "output(this path)" come to the last vertex, other resources are "internally(this path)" produced and destroyed.
-                // so only input of first vertex and output of last vertex are taken into account.
-                // [simple path]: path without diverged edges.
-                auto score = dstForwardScore - srcBackwardScore;
-                if (lightest > score) {
-                    lightest = score;
-                    index = i;
-                }
+    ccstd::pmr::vector<uint32_t> candidates(scratch);
+    for (uint32_t unitID = 0; unitID != units.size(); ++unitID) {
+        if (!units[unitID].numPredecessors) {
+            candidates.emplace_back(unitID);
+        }
+    }
+    uint32_t group = 0;
+    uint32_t groupLevel = INVALID_ID;
+    uint32_t numScheduled = 0;
+    while (!candidates.empty()) {
+        auto best = candidates.begin();
+        auto bestCost = getCost(*best);
+        for (auto iter = std::next(candidates.begin()); iter != candidates.end(); ++iter) {
+            const auto cost = getCost(*iter);
+            // ties are broken by declaration order
+            if (cost < bestCost || (cost == bestCost && *iter < *best)) {
+                best = iter;
+                bestCost = cost;
             }
-            auto e = candidateSections[index].front();
-            candidateSections[index].pop();
-            if (candidateSections[index].empty()) {
-                auto iter = candidateSections.begin();
-                std::advance(iter, index);
-                candidateSections.erase(iter);
+        }
+        const auto unitID = *best;
+        candidates.erase(best);
+
+        const auto &unit = units[unitID];
+        // adjacent units of the same level are independent, they form a parallel group
+        if (unit.level != groupLevel) {
+            ++group;
+            groupLevel = unit.level;
+        }
+        for (const auto ragVertID : unit.ragVerts) {
+            rag.topologicalOrder.emplace_back(ragVertID);
+            result.parallelGroups.emplace_back(group);
+        }
+        for (const auto succ : unit.successors) {
+            if (--units[succ].numPredecessors == 0) {
+                candidates.emplace_back(succ);
             }
-            auto srcVert = source(e, relationGraph);
-            auto dstVert = target(e, relationGraph);
-            // NOLINTNEXTLINE(readability-suspicious-call-argument)
-            tryAddEdge(tailVert, srcVert, relationGraph);
-            tailVert = dstVert;
         }
+        ++numScheduled;
+    }
+    CC_ENSURES(numScheduled == units.size());
 
-        tryAddEdge(tailVert, lhsVerts.back(), relationGraph);
+    if (rag.presentPassID < numVerts && !rag.culledPasses.count(rag.presentPassID)) {
+        rag.topologicalOrder.emplace_back(rag.presentPassID);
+        result.parallelGroups.emplace_back(group + 1);
     }
 }
 
-// return : can be further reduced?
-bool reduce(const ResourceAccessGraph &rag, const ResourceGraph &rescGraph, RelationGraph &relationGraph, RelationGraph &relationGraphTc, const CloseCircuit &circuit) {
-    auto checkPath = [&relationGraph](std::stack<RelationGraph::vertex_descriptor> &vertices, RelationGraph::vertex_descriptor endVert, RelationVerts &stackTrace) {
-        bool simpleGraph = true;
-        while (!vertices.empty()) {
-            auto vert = vertices.top();
-            vertices.pop();
-            stackTrace.emplace_back(vert);
-
-            if (endVert == vert) {
-                break;
-            }
+#pragma endregion PASS_REORDER
 
-            if (out_degree(vert, relationGraph) > 1) {
-                simpleGraph = false;
-                break;
-            }
-            auto r = out_edges(vert, relationGraph);
-            for (auto rIter = r.first; rIter != r.second; ++rIter) {
-                auto dstID = target(*rIter, relationGraph);
-                vertices.push(dstID);
-            }
-            if (r.first == r.second) {
-                stackTrace.pop_back();
-            }
-        }
-        return simpleGraph;
-    };
+#pragma region MEMORY_ALIASING
+namespace {
 
-    // check if there is a sub branch on lhs
-    auto lhsEdges = circuit.first;
-    auto startVert = target(lhsEdges.first, relationGraph);
-    auto endVert = source(lhsEdges.second, relationGraph);
+struct TransientResource {
+    ResourceGraph::vertex_descriptor resID{ResourceGraph::null_vertex()};
+    const ccstd::pmr::string *name{nullptr};
+    ResourceLifeRecord life;
+    gfx::AccessFlagBit lastAccess{gfx::AccessFlagBit::NONE};
+    uint64_t size{0};
+};
 
-    std::stack<RelationGraph::vertex_descriptor> vertices;
-    vertices.emplace(startVert);
+struct AliasSlot {
+    ResourceGraph::vertex_descriptor ownerID{ResourceGraph::null_vertex()};
+    const TransientResource *occupant{nullptr};
+};
 
-    RelationVerts lhsVisited;
-    auto branchStartVert = source(lhsEdges.first, relationGraph);
-    auto branchEndVert = target(lhsEdges.second, relationGraph);
-    lhsVisited.push_back(branchStartVert);
-    // check if there is a branch on lhs path
-    if (!checkPath(vertices, endVert, lhsVisited)) {
+bool isAliasingCandidate(ResourceGraph::vertex_descriptor resID, const ResourceGraph &resg) {
+    // subresource views are not aliased themselves, neither are their parents
+    if (parent(resID, resg) != ResourceGraph::null_vertex()) {
         return false;
     }
-    lhsVisited.push_back(branchEndVert);
-    // if it's a simple graph, lhs path must can be dfs to the end at the first time.
-    assert(vertices.empty());
-
-    auto rhsEdges = circuit.second;
-    startVert = target(rhsEdges.first, relationGraph);
-    endVert = source(rhsEdges.second, relationGraph);
-    vertices.emplace(startVert);
-
-    RelationVerts rhsVisited;
-    rhsVisited.push_back(branchStartVert);
-    if (!checkPath(vertices, endVert, rhsVisited)) {
+    const auto childRange = children(resID, resg);
+    if (childRange.first != childRange.second) {
         return false;
     }
-    rhsVisited.push_back(branchEndVert);
-
-    // merge this circuit
-    // from
-    /*          2 - 3 - 4
-              /           \
-            1               8
-              \           /
-                5 - 6 - 7
-
-        to
-            1 - A - B - 8 or 1 - B - A -8 depends on algorithm
-
-            ${A} : 2 - 3 - 4
-            ${B} : 5 - 6 - 7
-        */
-
-    evaluateAndTryMerge(rag, rescGraph, relationGraph, relationGraphTc, lhsVisited, rhsVisited);
+    if (!holds<ManagedTextureTag>(resID, resg) && !holds<ManagedBufferTag>(resID, resg)) {
+        return false;
+    }
+    // persistent, external and memoryless resources keep their own memory
+    const auto &traits = get(ResourceGraph::TraitsTag{}, resg, resID);
+    return traits.residency == ResourceResidency::MANAGED;
+}
 
-    return true;
+bool isAliasCompatible(const ResourceDesc &lhs, const ResourceDesc &rhs) {
+    return lhs.dimension == rhs.dimension &&
+           lhs.width == rhs.width &&
+           lhs.height == rhs.height &&
+           lhs.depthOrArraySize == rhs.depthOrArraySize &&
+           lhs.mipLevels == rhs.mipLevels &&
+           lhs.format == rhs.format &&
+           lhs.sampleCount == rhs.sampleCount &&
+           lhs.textureFlags == rhs.textureFlags &&
+           lhs.flags == rhs.flags &&
+           lhs.viewType == rhs.viewType;
 }
 
-template <typename RelationGraph, typename TargetGraph>
-void applyRelation(RelationGraph &relationGraph, const TargetGraph &targetGraph) {
-    CC_EXPECTS(relationGraph.vertices.size() == targetGraph.vertices.size());
+uint64_t estimateMemorySize(const ResourceDesc &desc) {
+    if (desc.dimension == ResourceDimension::BUFFER) {
+        return desc.width;
+    }
+    uint64_t size = 0;
+    const auto mipLevels = std::max<uint32_t>(desc.mipLevels, 1);
+    for (uint32_t mip = 0; mip != mipLevels; ++mip) {
+        size += gfx::formatSize(desc.format, std::max(desc.width >> mip, 1U), std::max(desc.height >> mip, 1U), 1);
+    }
+    return size * std::max<uint32_t>(desc.depthOrArraySize, 1) * static_cast<uint32_t>(desc.sampleCount);
+}
 
-    // remove all edges
-    for (auto vert : targetGraph.vertices) {
-        clear_in_edges(vert, targetGraph);
-        clear_out_edges(vert, targetGraph);
+// the first access of the new occupant has to wait for the last access of the previous one
+void handOverAccess(ResourceAccessGraph &rag, const RenderGraph &rg,
+                    const TransientResource &prev, const TransientResource &next) {
+    auto &accessRecord = rag.resourceAccess.at(*next.name);
+    CC_EXPECTS(accessRecord.size() > 1 && accessRecord.begin()->first == 0);
+    auto &initialStatus = accessRecord.begin()->second;
+    if (initialStatus.accessFlag != gfx::AccessFlagBit::NONE) {
+        return;
     }
+    initialStatus.accessFlag = prev.lastAccess;
 
-    for (auto vert : relationGraph.vertices) {
-        auto inEdges = in_edges(vert, relationGraph);
-        for (auto e : makeRange(inEdges)) {
-            auto srcVert = source(e, relationGraph);
-            // auto checkEdge = edge(srcVert, vert, targetGraph);
-            add_edge(srcVert, vert, targetGraph);
-        }
+    // attachments are transitioned by the render pass instead of general barriers
+    auto firstVertID = std::next(accessRecord.begin())->first;
+    auto passID = get(ResourceAccessGraph::PassIDTag{}, rag, firstVertID);
+    if (!holds<RasterPassTag>(passID, rg) && !holds<RasterSubpassTag>(passID, rg)) {
+        return;
+    }
+    auto ragVertID = firstVertID;
+    if (holds<RasterSubpassTag>(passID, rg)) {
+        ragVertID = rag.passIndex.at(parent(passID, rg));
+    }
+    auto &fgRenderPassInfo = get(ResourceAccessGraph::RenderPassInfoTag{}, rag, ragVertID);
+    if (fgRenderPassInfo.viewIndex.find(*next.name) == fgRenderPassInfo.viewIndex.end()) {
+        return;
+    }
+    auto colorIter = std::find(fgRenderPassInfo.orderedViews.begin(), fgRenderPassInfo.orderedViews.end(), *next.name);
+    auto colorIndex = static_cast<size_t>(std::distance(fgRenderPassInfo.orderedViews.begin(), colorIter));
+    LayoutAccess *access = nullptr;
+    if (colorIndex < fgRenderPassInfo.colorAccesses.size()) {
+        access = &fgRenderPassInfo.colorAccesses[colorIndex];
+    } else if (colorIndex == fgRenderPassInfo.colorAccesses.size()) {
+        access = &fgRenderPassInfo.dsAccess;
+    } else if (colorIndex == fgRenderPassInfo.colorAccesses.size() + 1) {
+        access = &fgRenderPassInfo.dsResolveAccess;
+    }
+    if (access && access->prevAccess == gfx::AccessFlagBit::NONE) {
+        access->prevAccess = prev.lastAccess;
     }
 }
 
-void passReorder(FrameGraphDispatcher &fgDispatcher) {
+} // namespace
+
+void memoryAliasing(FrameGraphDispatcher &fgDispatcher, FrameGraphDispatchResult &result) {
     auto *scratch = fgDispatcher.scratch;
     const auto &renderGraph = fgDispatcher.renderGraph;
     const auto &layoutGraph = fgDispatcher.layoutGraph;
@@ -2516,130 +2448,242 @@ void passReorder(FrameGraphDispatcher &fgDispatcher) {
         fgDispatcher._accessGraphBuilt = true;
     }
 
-    {
-        // determine do mem saving how many times
-        RelationGraph relationGraphTc(fgDispatcher.get_allocator());
-        boost::transitive_closure(relationGraph, relationGraphTc);
-
-        CloseCircuits circuits;
-        ccstd::vector<ResourceAccessGraph::edge_descriptor> crossEdges;
-        PassVisitor visitor(relationGraphTc, circuits);
-        auto colors = relationGraph.colors(scratch);
-        boost::depth_first_search(relationGraph, visitor, get(colors, relationGraph));
-
-        float percent = 0.0F;
-        uint32_t count = 0;
-        auto total = circuits.size();
-
-        float memsavePercent = 1.0F - fgDispatcher._paralellExecWeight;
-        for (auto iter = circuits.begin(); (iter != circuits.end()) && (percent < memsavePercent);) {
-            bool reduced = reduce(rag, resourceGraph, relationGraph, relationGraphTc, (*iter));
-            if (reduced) {
-                ++count;
-                iter = circuits.erase(iter);
-                percent = static_cast<float>(count) / static_cast<float>(total);
-            } else {
-                ++iter;
-            }
-        }
+    rag.resourceLifeRecord.clear();
+    result.aliasedResources.clear();
+    result.transientMemorySize = 0;
+    result.aliasedTransientMemorySize = 0;
 
-        // topological sort
-        rag.topologicalOrder.clear();
-        bool empty = relationGraph._vertices.empty();
-        ScoreMap scoreMap;
-        RelationVerts candidates;
-        candidates.push_back(EXPECT_START_ID);
-
-        ccstd::vector<RelationVert> candidateBuffer;
-        uint32_t coloredVerts = 0;
-        while (coloredVerts < relationGraph._vertices.size()) {
-            // decreasing order, pop back from vector, push into queue, then it's ascending order.
-            std::sort(candidates.begin(), candidates.end(), [&](RelationVert lhsVert, RelationVert rhsVert) {
-                int64_t lhsForwardScore{0};
-                int64_t rhsForwardScore{0};
-                int64_t lhsBackwardScore{0};
-                int64_t rhsBackwardScore{0};
-                if (scoreMap.find(lhsVert) == scoreMap.end()) {
-                    auto lhsRagVert = get(RelationGraph::DescIDTag{}, relationGraph, lhsVert);
-                    const auto &lhsForwardStatus = evaluateHeaviness(rag, resourceGraph, lhsRagVert, true);
-                    lhsForwardScore = get<1>(lhsForwardStatus);
-                    const auto &lhsBackwardStatus = evaluateHeaviness(rag, resourceGraph, lhsRagVert, false);
-                    lhsBackwardScore = get<1>(lhsBackwardStatus);
-                    scoreMap.emplace(lhsVert, std::pair<int64_t, int64_t>{lhsBackwardScore, lhsForwardScore});
-                } else {
-                    lhsBackwardScore = scoreMap[lhsVert].first;
-                    lhsForwardScore = scoreMap[lhsVert].second;
-                }
+    // reordered passes follow the topological order
+    const auto passOrder = getExecutionOrder(rag, scratch);
 
-                if (scoreMap.find(rhsVert) == scoreMap.end()) {
-                    auto rhsRagVert = get(RelationGraph::DescIDTag{}, relationGraph, rhsVert);
-                    const auto &rhsForwardStatus = evaluateHeaviness(rag, resourceGraph, rhsRagVert, true);
-                    rhsForwardScore = get<1>(rhsForwardStatus);
-                    const auto &rhsBackwardStatus = evaluateHeaviness(rag, resourceGraph, rhsRagVert, false);
-                    rhsBackwardScore = get<1>(rhsBackwardStatus);
-                    scoreMap.emplace(rhsVert, std::pair<int64_t, int64_t>{rhsBackwardScore, rhsForwardScore});
-                } else {
-                    rhsBackwardScore = scoreMap[rhsVert].first;
-                    rhsForwardScore = scoreMap[rhsVert].second;
-                }
-                return lhsBackwardScore - lhsForwardScore > rhsBackwardScore - rhsForwardScore;
-            });
-
-            const auto vert = candidates.back();
-            candidates.pop_back();
+    // lifetime of transient resources
+    ccstd::pmr::vector<TransientResource> transients(scratch);
+    for (const auto &[resName, accessRecord] : rag.resourceAccess) {
+        if (accessRecord.size() < 2 || accessRecord.begin()->first != 0) {
+            continue;
+        }
+        auto resID = findVertex(resName, resourceGraph);
+        if (resID == ResourceGraph::null_vertex() || !isAliasingCandidate(resID, resourceGraph)) {
+            continue;
+        }
+        if (rag.movedTarget.count(resName) || rag.movedSourceStatus.count(resName) || rag.movedTargetStatus.count(resName)) {
+            continue;
+        }
 
-            auto ragVert = get(RelationGraph::DescIDTag{}, relationGraph, vert);
-            rag.topologicalOrder.emplace_back(ragVert);
-            if (!candidateBuffer.empty()) {
-                candidates.insert(candidates.end(), candidateBuffer.begin(), candidateBuffer.end());
-                candidateBuffer.clear();
+        TransientResource res;
+        res.resID = resID;
+        res.name = &resName;
+        res.life.start = INVALID_ID;
+        for (const auto &[ragVertID, status] : accessRecord) {
+            if (ragVertID == 0 || rag.culledPasses.count(ragVertID)) {
+                continue;
             }
-
-            for (const auto nextGeneration : makeRange(out_edges(vert, relationGraph))) {
-                auto targetID = target(nextGeneration, relationGraph);
-                if (in_degree(targetID, relationGraph) == 1) {
-                    candidateBuffer.emplace_back(targetID);
-                }
+            const auto order = passOrder[ragVertID];
+            if (order == INVALID_ID) {
+                continue;
             }
-
-            auto deprecatedEdges = out_edges(vert, relationGraph);
-            for (auto iter = deprecatedEdges.first; iter < deprecatedEdges.second;) {
-                remove_edge(*iter, relationGraph);
-                deprecatedEdges = out_edges(vert, relationGraph);
-                iter = deprecatedEdges.first;
+            res.life.start = std::min(res.life.start, order);
+            if (order >= res.life.end) {
+                res.life.end = order;
+                res.lastAccess = status.accessFlag;
             }
+        }
+        if (res.life.start == INVALID_ID) {
+            continue;
+        }
+        res.size = estimateMemorySize(get(ResourceGraph::DescTag{}, resourceGraph, resID));
+        rag.resourceLifeRecord.emplace(resName, res.life);
+        result.transientMemorySize += res.size;
+        transients.emplace_back(res);
+    }
 
-            if (candidates.empty()) {
-                candidates.insert(candidates.end(), candidateBuffer.begin(), candidateBuffer.end());
-                candidateBuffer.clear();
-            }
+    std::sort(transients.begin(), transients.end(), [](const TransientResource &lhs, const TransientResource &rhs) {
+        return lhs.life.start < rhs.life.start;
+    });
 
-            coloredVerts++;
+    // greedy interval assignment, reuse the compatible slot which was released most recently
+    ccstd::pmr::vector<AliasSlot> slots(scratch);
+    for (const auto &res : transients) {
+        const auto &desc = get(ResourceGraph::DescTag{}, resourceGraph, res.resID);
+        AliasSlot *bestSlot = nullptr;
+        for (auto &slot : slots) {
+            if (slot.occupant->life.end >= res.life.start) {
+                continue;
+            }
+            if (!isAliasCompatible(get(ResourceGraph::DescTag{}, resourceGraph, slot.ownerID), desc)) {
+                continue;
+            }
+            if (!bestSlot || slot.occupant->life.end > bestSlot->occupant->life.end) {
+                bestSlot = &slot;
+            }
         }
-
-        // remove all edges
-        for (auto vert : makeRange(vertices(rag))) {
-            clear_in_edges(vert, rag);
-            clear_out_edges(vert, rag);
+        if (!bestSlot) {
+            slots.emplace_back(AliasSlot{res.resID, &res});
+            result.aliasedTransientMemorySize += res.size;
+            continue;
         }
+        result.aliasedResources.emplace(res.resID, bestSlot->ownerID);
+        handOverAccess(rag, renderGraph, *bestSlot->occupant, res);
+        bestSlot->occupant = &res;
+    }
+}
+#pragma endregion MEMORY_ALIASING
+
+#pragma region STRUCTURE_HASH
+namespace {
 
-        // apply relation
-        for (auto rlgVert : makeRange(vertices(relationGraph))) {
-            auto ragVert = get(RelationGraph::DescIDTag{}, relationGraph, rlgVert);
-            auto inEdges = in_edges(rlgVert, relationGraph);
-            for (auto e : makeRange(inEdges)) {
-                auto srcRlgVert = source(e, relationGraph);
-                auto srcRagVert = get(RelationGraph::DescIDTag{}, relationGraph, srcRlgVert);
-                add_edge(srcRagVert, ragVert, rag);
+// clear colors are read from the render graph when the pass is recorded, so they are not hashed
+void hashRasterViews(ccstd::hash_t &seed, const PmrTransparentMap<ccstd::pmr::string, RasterView> &rasterViews) {
+    ccstd::hash_combine(seed, rasterViews.size());
+    for (const auto &[name, view] : rasterViews) {
+        ccstd::hash_combine(seed, name);
+        ccstd::hash_combine(seed, view.slotName);
+        ccstd::hash_combine(seed, view.slotName1);
+        ccstd::hash_combine(seed, view.accessType);
+        ccstd::hash_combine(seed, view.attachmentType);
+        ccstd::hash_combine(seed, view.loadOp);
+        ccstd::hash_combine(seed, view.storeOp);
+        ccstd::hash_combine(seed, view.clearFlags);
+        ccstd::hash_combine(seed, view.slotID);
+        ccstd::hash_combine(seed, view.shaderStageFlags);
+    }
+}
+
+// ComputeView's hash already leaves out the clear value
+void hashComputeViews(ccstd::hash_t &seed, const PmrTransparentMap<ccstd::pmr::string, ccstd::pmr::vector<ComputeView>> &computeViews) {
+    ccstd::hash_combine(seed, computeViews);
+}
+
+template <class Pair>
+void hashTransferTarget(ccstd::hash_t &seed, const Pair &pair) {
+    ccstd::hash_combine(seed, pair.target);
+    ccstd::hash_combine(seed, pair.mipLevels);
+    ccstd::hash_combine(seed, pair.numSlices);
+    ccstd::hash_combine(seed, pair.targetMostDetailedMip);
+    ccstd::hash_combine(seed, pair.targetFirstSlice);
+    ccstd::hash_combine(seed, pair.targetPlaneSlice);
+}
+
+void hashPass(ccstd::hash_t &seed, RenderGraph::vertex_descriptor passID, const RenderGraph &rg) {
+    visitObject(
+        passID, rg,
+        [&](const RasterPass &pass) {
+            hashRasterViews(seed, pass.rasterViews);
+            hashComputeViews(seed, pass.computeViews);
+            ccstd::hash_combine(seed, pass.subpassGraph.names);
+            for (const auto &subpass : pass.subpassGraph.subpasses) {
+                hashRasterViews(seed, subpass.rasterViews);
+                hashComputeViews(seed, subpass.computeViews);
+                ccstd::hash_combine(seed, subpass.resolvePairs);
             }
-        }
+            ccstd::hash_combine(seed, pass.width);
+            ccstd::hash_combine(seed, pass.height);
+            ccstd::hash_combine(seed, pass.count);
+            ccstd::hash_combine(seed, pass.quality);
+        },
+        [&](const RasterSubpass &subpass) {
+            hashRasterViews(seed, subpass.rasterViews);
+            hashComputeViews(seed, subpass.computeViews);
+            ccstd::hash_combine(seed, subpass.resolvePairs);
+            ccstd::hash_combine(seed, subpass.subpassID);
+            ccstd::hash_combine(seed, subpass.count);
+            ccstd::hash_combine(seed, subpass.quality);
+        },
+        [&](const ComputeSubpass &subpass) {
+            hashRasterViews(seed, subpass.rasterViews);
+            hashComputeViews(seed, subpass.computeViews);
+            ccstd::hash_combine(seed, subpass.subpassID);
+        },
+        [&](const ComputePass &pass) {
+            hashComputeViews(seed, pass.computeViews);
+        },
+        [&](const CopyPass &pass) {
+            for (const auto &pair : pass.copyPairs) {
+                ccstd::hash_combine(seed, pair.source);
+                ccstd::hash_combine(seed, pair.sourceMostDetailedMip);
+                ccstd::hash_combine(seed, pair.sourceFirstSlice);
+                ccstd::hash_combine(seed, pair.sourcePlaneSlice);
+                hashTransferTarget(seed, pair);
+            }
+            // upload contents change every frame, only the destination matters
+            for (const auto &pair : pass.uploadPairs) {
+                hashTransferTarget(seed, pair);
+            }
+        },
+        [&](const MovePass &pass) {
+            for (const auto &pair : pass.movePairs) {
+                ccstd::hash_combine(seed, pair.source);
+                hashTransferTarget(seed, pair);
+            }
+        },
+        [&](const RaytracePass &pass) {
+            hashComputeViews(seed, pass.computeViews);
+        },
+        [&](const auto & /*node*/) {
+            // queues, scenes and commands are recorded from the render graph directly
+        });
+}
+
+void hashResource(ccstd::hash_t &seed, ResourceGraph::vertex_descriptor resID, const ResourceGraph &resg) {
+    const auto &desc = get(ResourceGraph::DescTag{}, resg, resID);
+    const auto &traits = get(ResourceGraph::TraitsTag{}, resg, resID);
+    ccstd::hash_combine(seed, tag(resID, resg).index());
+    ccstd::hash_combine(seed, get(ResourceGraph::NameTag{}, resg, resID));
+    ccstd::hash_combine(seed, parent(resID, resg));
+    ccstd::hash_combine(seed, desc.dimension);
+    ccstd::hash_combine(seed, desc.alignment);
+    ccstd::hash_combine(seed, desc.width);
+    ccstd::hash_combine(seed, desc.height);
+    ccstd::hash_combine(seed, desc.depthOrArraySize);
+    ccstd::hash_combine(seed, desc.mipLevels);
+    ccstd::hash_combine(seed, desc.format);
+    ccstd::hash_combine(seed, desc.sampleCount);
+    ccstd::hash_combine(seed, desc.textureFlags);
+    ccstd::hash_combine(seed, desc.flags);
+    ccstd::hash_combine(seed, desc.viewType);
+    ccstd::hash_combine(seed, traits.residency);
+    // the first access of a side-effect resource transitions from its current state
+    if (traits.hasSideEffects()) {
+        ccstd::hash_combine(seed, get(ResourceGraph::StatesTag{}, resg, resID).states);
+    }
+    if (holds<SubresourceViewTag>(resID, resg)) {
+        const auto &view = get(SubresourceViewTag{}, resID, resg);
+        ccstd::hash_combine(seed, view.format);
+        ccstd::hash_combine(seed, view.indexOrFirstMipLevel);
+        ccstd::hash_combine(seed, view.numMipLevels);
+        ccstd::hash_combine(seed, view.firstArraySlice);
+        ccstd::hash_combine(seed, view.numArraySlices);
+        ccstd::hash_combine(seed, view.firstPlane);
+        ccstd::hash_combine(seed, view.numPlanes);
     }
 }
 
-#pragma endregion PASS_REORDER
+} // namespace
+
+ccstd::hash_t getFrameGraphStructureHash(
+    const RenderGraph &renderGraph,
+    const ResourceGraph &resourceGraph,
+    const LayoutGraphData &layoutGraph) {
+    ccstd::hash_t seed = 0;
+    ccstd::hash_combine(seed, &layoutGraph);
+    ccstd::hash_combine(seed, num_vertices(layoutGraph));
 
-void memoryAliasing(FrameGraphDispatcher &fgDispatcher) {
+    ccstd::hash_combine(seed, num_vertices(renderGraph));
+    ccstd::hash_combine(seed, renderGraph.sortedVertices);
+    for (const auto vertID : makeRange(vertices(renderGraph))) {
+        ccstd::hash_combine(seed, tag(vertID, renderGraph).index());
+        ccstd::hash_combine(seed, parent(vertID, renderGraph));
+        ccstd::hash_combine(seed, get(RenderGraph::LayoutTag{}, renderGraph, vertID));
+        hashPass(seed, vertID, renderGraph);
+    }
+
+    ccstd::hash_combine(seed, num_vertices(resourceGraph));
+    for (const auto resID : makeRange(vertices(resourceGraph))) {
+        hashResource(seed, resID, resourceGraph);
+    }
+    return seed;
 }
+#pragma endregion STRUCTURE_HASH
 
 #pragma region assisstantFuncDefinition
 template <typename Graph>
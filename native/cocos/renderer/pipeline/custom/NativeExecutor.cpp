@@ -25,12 +25,14 @@
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/filtered_graph.hpp>
 #include "FGDispatcherGraphs.h"
+#include "FGDispatcherUtils.h"
 #include "NativeBuiltinUtils.h"
 #include "NativeExecutorRenderGraph.h"
 #include "NativePipelineTypes.h"
 #include "PrivateTypes.h"
 #include "RenderGraphGraphs.h"
 #include "RenderGraphTypes.h"
+#include "cocos/base/std/container/unordered_map.h"
 #include "cocos/renderer/gfx-base/GFXDef-common.h"
 #include "cocos/renderer/gfx-base/GFXDevice.h"
 #include "cocos/renderer/pipeline/Define.h"
@@ -44,6 +46,7 @@
 #include "details/GraphView.h"
 #include "details/GslUtils.h"
 #include "details/Range.h"
+#include "profiler/Profiler.h"
 
 #if CC_USE_GEOMETRY_RENDERER
     #include "cocos/renderer/pipeline/GeometryRenderer.h"
@@ -982,7 +985,13 @@ struct RenderGraphVisitor : boost::dfs_visitor<> {
         if (resIter != ctx.fgd.resourceAccessGraph.resourceIndex.end()) {
             auto resID = resIter->second;
             auto& resg = ctx.resourceGraph;
-            resg.mount(ctx.device, resID);
+            const auto& aliasedResources = ctx.dispatchResult.aliasedResources;
+            auto aliasIter = aliasedResources.find(resID);
+            if (aliasIter != aliasedResources.end()) {
+                mountAliasedResource(ctx.device, resg, resID, aliasIter->second);
+            } else {
+                resg.mount(ctx.device, resID);
+            }
             for (const auto& subres : makeRange(children(resID, resg))) {
                 const auto& subresName = get(ResourceGraph::NameTag{}, resg, subres.target);
                 mountResource(subresName);
@@ -1295,8 +1304,28 @@ void collectStatistics(const NativePipeline& ppl, PipelineStatistics& stats) {
     }
 }
 
+struct FrameGraphDispatchCache {
+    explicit FrameGraphDispatchCache(const FrameGraphDispatchResult::allocator_type& alloc) noexcept
+    : result(alloc) {}
+
+    std::unique_ptr<FrameGraphDispatcher> dispatcher;
+    FrameGraphDispatchResult result;
+    ccstd::hash_t structureHash{0};
+};
+
+// dispatch of NativePipeline::renderGraph, reused while its structure hash is unchanged
+ccstd::unordered_map<const NativePipeline*, FrameGraphDispatchCache> sDispatchCaches;
+
+FrameGraphDispatchCache& getDispatchCache(NativePipeline& ppl) {
+    return sDispatchCaches.try_emplace(&ppl, &ppl.unsyncPool).first->second;
+}
+
 } // namespace
 
+void releaseFrameGraphDispatchCache(const NativePipeline& ppl) noexcept {
+    sDispatchCaches.erase(&ppl);
+}
+
 void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
     auto& ppl = *this;
     auto* scratch = &ppl.unsyncPool;
@@ -1307,13 +1336,37 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
     ResourceCleaner cleaner(ppl.resourceGraph);
 
     auto& lg = ppl.programLibrary->layoutGraph;
-    FrameGraphDispatcher fgd(
-        ppl.resourceGraph, rg,
-        lg, &ppl.unsyncPool, scratch);
-    fgd.enableMemoryAliasing(false);
-    fgd.enablePassReorder(false);
-    fgd.setParalellWeight(0);
-    fgd.run();
+
+    // only the pipeline's own render graph outlives this frame, others are dispatched from scratch
+    const bool cacheable = &rg == &ppl.renderGraph;
+    const auto structureHash = getFrameGraphStructureHash(rg, ppl.resourceGraph, lg);
+    FrameGraphDispatchCache transientDispatch(scratch);
+    auto& dispatch = cacheable ? getDispatchCache(ppl) : transientDispatch;
+    const bool reused = cacheable && dispatch.dispatcher && dispatch.structureHash == structureHash;
+    if (reused) {
+        replayResourceStates(ppl.resourceGraph, dispatch.result);
+    } else {
+        dispatch.dispatcher.reset();
+        dispatch.dispatcher = std::make_unique<FrameGraphDispatcher>(
+            ppl.resourceGraph, rg,
+            lg, &ppl.unsyncPool, scratch);
+        dispatch.dispatcher->enableMemoryAliasing(true);
+        dispatch.dispatcher->enablePassReorder(true);
+        dispatch.dispatcher->setParalellWeight(0.5F);
+        dispatchFrameGraph(*dispatch.dispatcher, dispatch.result);
+        dispatch.structureHash = structureHash;
+    }
+    const auto& fgd = *dispatch.dispatcher;
+    CC_PROFILE_COUNTER(RenderGraphDispatchReused, reused ? 1 : 0);
+
+    {
+        const auto& result = dispatch.result;
+        const auto savedBytes = result.transientMemorySize - result.aliasedTransientMemorySize;
+        CC_PROFILE_MEMORY_UPDATE(TransientMemory, result.aliasedTransientMemorySize);
+        CC_PROFILE_MEMORY_UPDATE(TransientMemorySaved, savedBytes);
+        CC_PROFILE_COUNTER(TransientMemory, result.aliasedTransientMemorySize);
+        CC_PROFILE_COUNTER(TransientMemorySaved, savedBytes);
+    }
 
     AddressableView<RenderGraph> graphView(rg);
     ccstd::pmr::vector<bool> validPasses(num_vertices(rg), true, scratch);
@@ -1397,6 +1450,7 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
             ppl.nativeContext,
             lg, rg, ppl.resourceGraph,
             fgd,
+            dispatch.result,
             validPasses,
             ppl.device, submit.primaryCommandBuffer,
             &ppl,
@@ -1412,15 +1466,31 @@ void NativePipeline::executeRenderGraph(const RenderGraph& rg) {
 
         RenderGraphVisitor visitor{{}, ctx};
         auto colors = rg.colors(scratch);
+        auto isTopLevelPass = [&](RenderGraph::vertex_descriptor vertID) {
+            return holds<RasterPassTag>(vertID, ctx.g) ||
+                   holds<ComputeTag>(vertID, ctx.g) ||
+                   holds<CopyTag>(vertID, ctx.g);
+        };
+        // passes are submitted in the order scheduled by the dispatcher
+        const auto& rag = fgd.resourceAccessGraph;
+        for (const auto ragVertID : rag.topologicalOrder) {
+            const auto vertID = get(ResourceAccessGraph::PassIDTag{}, rag, ragVertID);
+            if (vertID < num_vertices(ctx.g) && isTopLevelPass(vertID) &&
+                get(colors, ctx.g)[vertID] == boost::white_color) {
+                boost::depth_first_visit(fg, vertID, visitor, get(colors, ctx.g));
+            }
+        }
+        // passes without access nodes
         for (const auto vertID : ctx.g.sortedVertices) {
-            if (holds<RasterPassTag>(vertID, ctx.g) ||
-                holds<ComputeTag>(vertID, ctx.g) ||
-                holds<CopyTag>(vertID, ctx.g)) {
+            if (isTopLevelPass(vertID) && get(colors, ctx.g)[vertID] == boost::white_color) {
                 boost::depth_first_visit(fg, vertID, visitor, get(colors, ctx.g));
             }
         }
     }
 
+    // aliased resources are mounted again by the next frame
+    unmountAliasedResources(ppl.resourceGraph, dispatch.result);
+
     // collect statistics
     collectStatistics(*this, statistics);
 }
@@ -24,6 +24,7 @@
 
 #pragma once
 #include "FGDispatcherTypes.h"
+#include "FGDispatcherUtils.h"
 #include "LayoutGraphTypes.h"
 #include "NativePipelineTypes.h"
 #include "RenderGraphTypes.h"
@@ -54,6 +55,7 @@ struct RenderGraphVisitorContext {
     const RenderGraph& g;
     ResourceGraph& resourceGraph;
     const FrameGraphDispatcher& fgd;
+    const FrameGraphDispatchResult& dispatchResult;
     const ccstd::pmr::vector<bool>& validPasses;
     gfx::Device* device = nullptr;
     gfx::CommandBuffer* cmdBuff = nullptr;
@@ -25,6 +25,7 @@
 #include "cocos/renderer/pipeline/Define.h"
 #include "cocos/renderer/pipeline/PipelineSceneData.h"
 #include "cocos/renderer/pipeline/PipelineStateManager.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherUtils.h"
 #include "cocos/renderer/pipeline/custom/LayoutGraphTypes.h"
 #include "cocos/renderer/pipeline/custom/LayoutGraphUtils.h"
 #include "cocos/renderer/pipeline/custom/NativeBuiltinUtils.h"
@@ -1504,6 +1505,7 @@ bool NativePipeline::destroy() noexcept {
         pipelineSceneData = {};
     }
     pipeline::PipelineStateManager::destroyAll();
+    releaseFrameGraphDispatchCache(*this);
     return true;
 }
 
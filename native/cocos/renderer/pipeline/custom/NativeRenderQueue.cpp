@@ -141,8 +141,11 @@ void RenderDrawQueue::recordCommandBuffer(
         auto *inputAssembler = subModel->getInputAssembler();
         const auto *pass = subModel->getPass(passIdx);
         auto *shader = subModel->getShader(passIdx);
-        auto *pso = pipeline::PipelineStateManager::getOrCreatePipelineState(
+        auto *pso = pipeline::PipelineStateManager::tryGetOrCreatePipelineState(
             pass, shader, inputAssembler, renderPass, subpassIndex);
+        if (!pso) {
+            continue;
+        }
 
         cmdBuff->bindPipelineState(pso);
         cmdBuff->bindDescriptorSet(pipeline::materialSet, pass->getDescriptorSet());
@@ -239,8 +242,11 @@ void RenderInstancingQueue::recordCommandBuffer(
             if (!instance.drawInfo.instanceCount) {
                 continue;
             }
-            auto *pso = pipeline::PipelineStateManager::getOrCreatePipelineState(
+            auto *pso = pipeline::PipelineStateManager::tryGetOrCreatePipelineState(
                 drawPass, instance.shader, instance.ia, renderPass, subpassIndex);
+            if (!pso) {
+                continue;
+            }
             if (lastPSO != pso) {
                 cmdBuffer->bindPipelineState(pso);
                 lastPSO = pso;
@@ -23,6 +23,7 @@
 ****************************************************************************/
 
 #include <boost/graph/depth_first_search.hpp>
+#include "FGDispatcherUtils.h"
 #include "NativePipelineTypes.h"
 #include "RenderGraphGraphs.h"
 #include "RenderGraphTypes.h"
@@ -467,6 +468,53 @@ void ResourceGraph::invalidatePersistentRenderPassAndFramebuffer(gfx::Texture* p
     }
 }
 
+void mountAliasedResource(
+    gfx::Device* device, ResourceGraph& resg,
+    ResourceGraph::vertex_descriptor resID, ResourceGraph::vertex_descriptor ownerID) {
+    // the owner is mounted by an earlier pass already, lifetimes of both never overlap
+    resg.mount(device, ownerID);
+    visitObject(
+        resID, resg,
+        [&](ManagedBuffer& buffer) {
+            const auto& owner = get(ManagedBufferTag{}, ownerID, resg);
+            CC_EXPECTS(owner.buffer);
+            buffer.buffer = owner.buffer;
+            buffer.fenceValue = resg.nextFenceValue;
+        },
+        [&](ManagedTexture& texture) {
+            const auto& owner = get(ManagedTextureTag{}, ownerID, resg);
+            CC_EXPECTS(owner.texture);
+            if (texture.texture && texture.texture != owner.texture) {
+                // framebuffers of this resource still refer to its own texture
+                resg.invalidatePersistentRenderPassAndFramebuffer(texture.texture.get());
+            }
+            texture.texture = owner.texture;
+            texture.fenceValue = resg.nextFenceValue;
+        },
+        [&](const auto& res) {
+            // only managed resources are aliased
+            std::ignore = res;
+            CC_EXPECTS(false);
+        });
+}
+
+void unmountAliasedResources(ResourceGraph& resg, const FrameGraphDispatchResult& result) {
+    // framebuffers of the shared texture are invalidated when its owner is unmounted
+    for (const auto& [resID, ownerID] : result.aliasedResources) {
+        visitObject(
+            resID, resg,
+            [&](ManagedBuffer& buffer) {
+                buffer.buffer = nullptr;
+            },
+            [&](ManagedTexture& texture) {
+                texture.texture = nullptr;
+            },
+            [&](const auto& res) {
+                std::ignore = res;
+            });
+    }
+}
+
 } // namespace render
 
 } // namespace cc
@@ -1,3 +1,4 @@
+#include "cocos/base/job-system/JobSystem.h"
 #include "cocos/renderer/pipeline/Define.h"
 #include "cocos/renderer/pipeline/custom/LayoutGraphUtils.h"
 #include "cocos/renderer/pipeline/custom/NativeBuiltinUtils.h"
@@ -5,11 +6,13 @@
 #include "cocos/renderer/pipeline/custom/RenderGraphGraphs.h"
 #include "cocos/renderer/pipeline/custom/details/GslUtils.h"
 #include "cocos/renderer/pipeline/custom/details/Range.h"
+#include "cocos/scene/BVH.h"
 #include "cocos/scene/Octree.h"
 #include "cocos/scene/ReflectionProbe.h"
 #include "cocos/scene/RenderScene.h"
 #include "cocos/scene/Skybox.h"
 #include "cocos/scene/SpotLight.h"
+#include "cocos/scene/WorldBoundsSoA.h"
 
 #include <boost/align/align_up.hpp>
 
@@ -247,8 +250,10 @@ bool isFrustumCulled(const scene::Model& model, const geometry::Frustum& frustum
     return !transWorldBounds.aabbFrustum(frustum);
 }
 
-void octreeCulling(
-    const scene::Octree& octree,
+// SpatialIndex is scene::Octree or scene::BVH
+template <class SpatialIndex>
+void spatialIndexCulling(
+    const SpatialIndex& spatialIndex,
     const scene::Model* skyboxModel,
     const scene::RenderScene& scene,
     const scene::Camera& camera,
@@ -273,7 +278,7 @@ void octreeCulling(
         }
     }
     // add instances with world bounds
-    octree.queryVisibility(&camera, cameraOrLightFrustum, bCastShadow, models);
+    spatialIndex.queryVisibility(&camera, cameraOrLightFrustum, bCastShadow, models);
 
     // TODO(zhouzhenglong): move lod culling into octree query
     auto iter = std::remove_if(
@@ -298,7 +303,21 @@ void bruteForceCulling(
     if (!bCastShadow && skyboxModel && camSkyboxFlag) {
         models.emplace_back(skyboxModel);
     }
-    for (const auto& pModel : scene.getModels()) {
+
+    // batch frustum culling, planar shadow casters are transformed by the light matrix and tested one by one
+    const auto& sceneModels = scene.getModels();
+    const auto& worldBounds = scene.getWorldBoundsSoA();
+    CC_EXPECTS(worldBounds.size() == sceneModels.size());
+    const bool bPlanarShadow = bCastShadow && kPipelineSceneData->getShadows()->getType() == scene::ShadowType::PLANAR;
+    const bool bBatchCulling = !probe && !bPlanarShadow;
+    thread_local ccstd::vector<uint8_t> visible;
+    if (bBatchCulling) {
+        visible.resize(sceneModels.size());
+        worldBounds.cullFrustum(cameraOrLightFrustum, visible.data());
+    }
+
+    for (uint32_t modelID = 0; modelID != sceneModels.size(); ++modelID) {
+        const auto& pModel = sceneModels[modelID];
         CC_EXPECTS(pModel);
         const auto& model = *pModel;
         if (!model.isEnabled() || !model.getNode() || (bCastShadow && !model.isCastShadow())) {
@@ -313,8 +332,12 @@ void bruteForceCulling(
             if (isNodeVisible(model.getNode(), visibility) || isModelVisible(model, visibility)) {
                 const auto* const wBounds = model.getWorldBounds();
                 // frustum culling
-                if (wBounds && ((!probe && isFrustumCulled(model, cameraOrLightFrustum, bCastShadow)) ||
-                                (probe && isIntersectAABB(*wBounds, *probe->getBoundingBox())))) {
+                if (wBounds && bBatchCulling && !visible[modelID]) {
+                    continue;
+                }
+                if (wBounds && !bBatchCulling &&
+                    ((!probe && isFrustumCulled(model, cameraOrLightFrustum, bCastShadow)) ||
+                     (probe && isIntersectAABB(*wBounds, *probe->getBoundingBox())))) {
                     continue;
                 }
 
@@ -336,9 +359,14 @@ void sceneCulling(
     const scene::ReflectionProbe* probe,
     ccstd::vector<const scene::Model*>& models) {
     CC_EXPECTS(bProbePass || !probe);
+    const auto* const bvh = scene.getBVH();
     const auto* const octree = scene.getOctree();
-    if (octree && octree->isEnabled() && !probe) {
-        octreeCulling(
+    if (bvh && bvh->isEnabled() && !probe) {
+        spatialIndexCulling(
+            *bvh, skyboxModel,
+            scene, camera, cameraOrLightFrustum, bCastShadow, models);
+    } else if (octree && octree->isEnabled() && !probe) {
+        spatialIndexCulling(
             *octree, skyboxModel,
             scene, camera, cameraOrLightFrustum, bCastShadow, models);
     } else {
@@ -355,74 +383,83 @@ void SceneCulling::batchFrustumCulling(const NativePipeline& ppl) {
     const auto* const skybox = pplSceneData.getSkybox();
     const auto* const skyboxModel = skybox && skybox->isEnabled() ? skybox->getModel() : nullptr;
 
+    // queries are independent and each writes to its own result, collect them and cull in parallel
+    ccstd::vector<std::tuple<const scene::RenderScene*, const FrustumCullingKey*, FrustumCullingID>> tasks;
+    tasks.reserve(numFrustumCulling);
     for (const auto& [scene, queries] : frustumCullings) {
         CC_ENSURES(scene);
         for (const auto& [key, frustomCulledResultID] : queries.resultIndex) {
-            CC_EXPECTS(key.camera);
-            CC_EXPECTS(key.camera->getScene() == nullptr || key.camera->getScene() == scene);
-            const auto* light = key.light;
-            const auto level = key.lightLevel;
-            const auto bCastShadow = key.castShadow;
-            const auto bProbePass = key.probePass;
-            const auto* probe = key.probe;
-            const auto& camera = probe ? *probe->getCamera() : *key.camera;
-            CC_EXPECTS(frustomCulledResultID.value < frustumCullingResults.size());
-            auto& models = frustumCullingResults[frustomCulledResultID.value];
-
-            if (probe) {
-                sceneCulling(
-                    skyboxModel,
-                    *scene, camera,
-                    camera.getFrustum(),
-                    bCastShadow,
-                    bProbePass,
-                    probe,
-                    models);
-                continue;
-            }
+            tasks.emplace_back(scene, &key, frustomCulledResultID);
+        }
+    }
+
+    parallelForEachIndex(static_cast<uint32_t>(tasks.size()), [&](uint32_t taskID) {
+        const auto& [scene, pKey, frustomCulledResultID] = tasks[taskID];
+        const auto& key = *pKey;
+        CC_EXPECTS(key.camera);
+        CC_EXPECTS(key.camera->getScene() == nullptr || key.camera->getScene() == scene);
+        const auto* light = key.light;
+        const auto level = key.lightLevel;
+        const auto bCastShadow = key.castShadow;
+        const auto bProbePass = key.probePass;
+        const auto* probe = key.probe;
+        const auto& camera = probe ? *probe->getCamera() : *key.camera;
+        CC_EXPECTS(frustomCulledResultID.value < frustumCullingResults.size());
+        auto& models = frustumCullingResults[frustomCulledResultID.value];
+
+        if (probe) {
+            sceneCulling(
+                skyboxModel,
+                *scene, camera,
+                camera.getFrustum(),
+                bCastShadow,
+                bProbePass,
+                probe,
+                models);
+            return;
+        }
 
-            if (light) {
-                switch (light->getType()) {
-                    case scene::LightType::SPOT:
+        if (light) {
+            switch (light->getType()) {
+                case scene::LightType::SPOT:
+                    sceneCulling(
+                        skyboxModel,
+                        *scene, camera,
+                        dynamic_cast<const scene::SpotLight*>(light)->getFrustum(),
+                        bCastShadow,
+                        bProbePass,
+                        nullptr,
+                        models);
+                    break;
+                case scene::LightType::DIRECTIONAL: {
+                    const auto* mainLight = dynamic_cast<const scene::DirectionalLight*>(light);
+                    const auto* frustum = getBuiltinShadowFrustum(ppl, camera, mainLight, level);
+                    if (frustum) {
                         sceneCulling(
                             skyboxModel,
                             *scene, camera,
-                            dynamic_cast<const scene::SpotLight*>(light)->getFrustum(),
+                            *frustum,
                             bCastShadow,
                             bProbePass,
                             nullptr,
                             models);
-                        break;
-                    case scene::LightType::DIRECTIONAL: {
-                        const auto* mainLight = dynamic_cast<const scene::DirectionalLight*>(light);
-                        const auto* frustum = getBuiltinShadowFrustum(ppl, camera, mainLight, level);
-                        if (frustum) {
-                            sceneCulling(
-                                skyboxModel,
-                                *scene, camera,
-                                *frustum,
-                                bCastShadow,
-                                bProbePass,
-                                nullptr,
-                                models);
-                        }
-                    } break;
-                    default:
-                        // noop
-                        break;
-                }
-            } else {
-                sceneCulling(
-                    skyboxModel,
-                    *scene, camera,
-                    camera.getFrustum(),
-                    bCastShadow,
-                    bProbePass,
-                    nullptr,
-                    models);
+                    }
+                } break;
+                default:
+                    // noop
+                    break;
             }
+        } else {
+            sceneCulling(
+                skyboxModel,
+                *scene, camera,
+                camera.getFrustum(),
+                bCastShadow,
+                bProbePass,
+                nullptr,
+                models);
         }
-    }
+    });
 }
 
 namespace {
@@ -491,43 +528,55 @@ void executeRangedDirectionalLightCulling(
 } // namespace
 
 void SceneCulling::batchLightBoundsCulling() {
+    ccstd::vector<std::tuple<const scene::RenderScene*, const LightBoundsCullingKey*, LightBoundsCullingID>> tasks;
+    tasks.reserve(numLightBoundsCulling);
     for (const auto& [scene, queries] : lightBoundsCullings) {
         CC_ENSURES(scene);
         for (const auto& [key, cullingID] : queries.resultIndex) {
-            CC_EXPECTS(key.camera);
-            CC_EXPECTS(key.camera->getScene() == scene);
-            const auto& frustumCullingResult = frustumCullingResults.at(key.frustumCullingID.value);
-            auto& lightBoundsCullingResult = lightBoundsCullingResults.at(cullingID.value);
-            CC_EXPECTS(lightBoundsCullingResult.instances.empty());
-            switch (key.cullingLight->getType()) {
-                case scene::LightType::SPHERE: {
-                    const auto* light = dynamic_cast<const scene::SphereLight*>(key.cullingLight);
-                    CC_ENSURES(light);
-                    executeSphereLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
-                } break;
-                case scene::LightType::SPOT: {
-                    const auto* light = dynamic_cast<const scene::SpotLight*>(key.cullingLight);
-                    CC_ENSURES(light);
-                    executeSpotLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
-                } break;
-                case scene::LightType::POINT: {
-                    const auto* light = dynamic_cast<const scene::PointLight*>(key.cullingLight);
-                    CC_ENSURES(light);
-                    executePointLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
-                } break;
-                case scene::LightType::RANGED_DIRECTIONAL: {
-                    const auto* light = dynamic_cast<const scene::RangedDirectionalLight*>(key.cullingLight);
-                    CC_ENSURES(light);
-                    executeRangedDirectionalLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
-                } break;
-                case scene::LightType::DIRECTIONAL:
-                case scene::LightType::UNKNOWN:
-                default:
-                    // noop
-                    break;
+            if (key.cullingLight->getType() == scene::LightType::RANGED_DIRECTIONAL) {
+                // world matrix is updated lazily, make sure it is clean before culling in parallel
+                key.cullingLight->getNode()->updateWorldTransform();
             }
+            tasks.emplace_back(scene, &key, cullingID);
         }
     }
+
+    parallelForEachIndex(static_cast<uint32_t>(tasks.size()), [&](uint32_t taskID) {
+        const auto& [scene, pKey, cullingID] = tasks[taskID];
+        const auto& key = *pKey;
+        CC_EXPECTS(key.camera);
+        CC_EXPECTS(key.camera->getScene() == scene);
+        const auto& frustumCullingResult = frustumCullingResults.at(key.frustumCullingID.value);
+        auto& lightBoundsCullingResult = lightBoundsCullingResults.at(cullingID.value);
+        CC_EXPECTS(lightBoundsCullingResult.instances.empty());
+        switch (key.cullingLight->getType()) {
+            case scene::LightType::SPHERE: {
+                const auto* light = dynamic_cast<const scene::SphereLight*>(key.cullingLight);
+                CC_ENSURES(light);
+                executeSphereLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
+            } break;
+            case scene::LightType::SPOT: {
+                const auto* light = dynamic_cast<const scene::SpotLight*>(key.cullingLight);
+                CC_ENSURES(light);
+                executeSpotLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
+            } break;
+            case scene::LightType::POINT: {
+                const auto* light = dynamic_cast<const scene::PointLight*>(key.cullingLight);
+                CC_ENSURES(light);
+                executePointLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
+            } break;
+            case scene::LightType::RANGED_DIRECTIONAL: {
+                const auto* light = dynamic_cast<const scene::RangedDirectionalLight*>(key.cullingLight);
+                CC_ENSURES(light);
+                executeRangedDirectionalLightCulling(*light, frustumCullingResult, lightBoundsCullingResult.instances);
+            } break;
+            case scene::LightType::DIRECTIONAL:
+            case scene::LightType::UNKNOWN:
+            default:
+                // noop
+                break;
+        }
+    });
 }
 
 namespace {
@@ -554,6 +603,14 @@ float computeSortingDepth(const scene::Camera& camera, const scene::Model& model
     return depth;
 }
 
+// instancing queues create gfx objects when merging, which must stay on the calling thread
+struct DeferredInstance {
+    const scene::Pass* pass{nullptr};
+    scene::SubModel* subModel{nullptr};
+    uint32_t passIdx{0};
+    bool bBlend{false};
+};
+
 void addRenderObject(
     LayoutGraphData::vertex_descriptor phaseLayoutID,
     const bool bDrawOpaqueOrMask,
@@ -561,7 +618,8 @@ void addRenderObject(
     const bool bDrawProbe,
     const scene::Camera& camera,
     const scene::Model& model,
-    NativeRenderQueue& queue) {
+    NativeRenderQueue& queue,
+    ccstd::vector<DeferredInstance>* deferredInstances) {
     if (bDrawProbe) {
         queue.probeQueue.applyMacro(*kLayoutGraph, model, phaseLayoutID);
     }
@@ -597,7 +655,9 @@ void addRenderObject(
 
             // add object to queue
             if (pass.getBatchingScheme() == scene::BatchingSchemes::INSTANCING) {
-                if (bBlend) {
+                if (deferredInstances) {
+                    deferredInstances->emplace_back(DeferredInstance{&pass, subModel.get(), passIdx, bBlend});
+                } else if (bBlend) {
                     queue.transparentInstancingQueue.add(pass, *subModel, passIdx);
                 } else {
                     queue.opaqueInstancingQueue.add(pass, *subModel, passIdx);
@@ -617,55 +677,110 @@ void addRenderObject(
 
 } // namespace
 
+namespace {
+
+void fillRenderQueue(
+    SceneCulling& sceneCulling,
+    const NativeRenderQueueKey& key, NativeRenderQueueID targetID,
+    ccstd::vector<DeferredInstance>* deferredInstances) {
+    // native queue target
+    CC_EXPECTS(targetID.value < sceneCulling.renderQueues.size());
+    auto& nativeQueue = sceneCulling.renderQueues[targetID.value];
+    CC_EXPECTS(nativeQueue.empty());
+
+    const auto frustomCulledResultID = key.frustumCulledResultID;
+    const auto lightBoundsCullingID = key.lightBoundsCulledResultID;
+
+    // check scene flags
+    const bool bDrawBlend = any(nativeQueue.sceneFlags & SceneFlags::BLEND);
+    const bool bDrawOpaqueOrMask = any(nativeQueue.sceneFlags & (SceneFlags::OPAQUE | SceneFlags::MASK));
+    const bool bDrawShadowCaster = any(nativeQueue.sceneFlags & SceneFlags::SHADOW_CASTER);
+    const bool bDrawProbe = any(nativeQueue.sceneFlags & SceneFlags::REFLECTION_PROBE);
+    if (!bDrawShadowCaster && !bDrawBlend && !bDrawOpaqueOrMask && !bDrawProbe) {
+        // nothing to draw
+        return;
+    }
+
+    // render queue info
+    const auto phaseLayoutID = key.queueLayoutID;
+    CC_EXPECTS(phaseLayoutID != LayoutGraphData::null_vertex());
+
+    // culling source
+    CC_EXPECTS(frustomCulledResultID.value < sceneCulling.frustumCullingResults.size());
+    const auto& sourceModels = [&]() -> const auto& {
+        // is culled by light bounds
+        if (lightBoundsCullingID.value != 0xFFFFFFFF) {
+            CC_EXPECTS(lightBoundsCullingID.value < sceneCulling.lightBoundsCullingResults.size());
+            return sceneCulling.lightBoundsCullingResults.at(lightBoundsCullingID.value).instances;
+        }
+        // not culled by light bounds
+        return sceneCulling.frustumCullingResults.at(frustomCulledResultID.value);
+    }();
+
+    // skybox
+    const auto* camera = nativeQueue.camera;
+    CC_EXPECTS(camera);
+
+    // fill native queue
+    for (const auto* const model : sourceModels) {
+        addRenderObject(
+            phaseLayoutID, bDrawOpaqueOrMask, bDrawBlend,
+            bDrawProbe, *camera, *model, nativeQueue, deferredInstances);
+    }
+
+    // post-processing
+    nativeQueue.opaqueQueue.sortOpaqueOrCutout();
+    nativeQueue.transparentQueue.sortTransparent();
+    if (!deferredInstances) {
+        nativeQueue.opaqueInstancingQueue.sort();
+        nativeQueue.transparentInstancingQueue.sort();
+    }
+}
+
+} // namespace
+
 void SceneCulling::fillRenderQueues() {
+    // sorting depth of models without bounds reads the node's world position,
+    // which is updated lazily, make sure it is clean before filling in parallel
+    for (uint32_t i = 0; i != numFrustumCulling; ++i) {
+        for (const auto* const model : frustumCullingResults[i]) {
+            if (!model->getWorldBounds() && model->getNode()) {
+                model->getTransform()->updateWorldTransform();
+            }
+        }
+    }
+
+    // probe queues patch sub-model macros, fill them sequentially first
+    ccstd::vector<std::pair<const NativeRenderQueueKey*, NativeRenderQueueID>> tasks;
+    tasks.reserve(numRenderQueues);
     for (const auto& [key, targetID] : renderQueueIndex) {
-        // native queue target
         CC_EXPECTS(targetID.value < renderQueues.size());
-        auto& nativeQueue = renderQueues[targetID.value];
-        CC_EXPECTS(nativeQueue.empty());
-
-        const auto frustomCulledResultID = key.frustumCulledResultID;
-        const auto lightBoundsCullingID = key.lightBoundsCulledResultID;
-
-        // check scene flags
-        const bool bDrawBlend = any(nativeQueue.sceneFlags & SceneFlags::BLEND);
-        const bool bDrawOpaqueOrMask = any(nativeQueue.sceneFlags & (SceneFlags::OPAQUE | SceneFlags::MASK));
-        const bool bDrawShadowCaster = any(nativeQueue.sceneFlags & SceneFlags::SHADOW_CASTER);
-        const bool bDrawProbe = any(nativeQueue.sceneFlags & SceneFlags::REFLECTION_PROBE);
-        if (!bDrawShadowCaster && !bDrawBlend && !bDrawOpaqueOrMask && !bDrawProbe) {
-            // nothing to draw
+        if (any(renderQueues[targetID.value].sceneFlags & SceneFlags::REFLECTION_PROBE)) {
+            fillRenderQueue(*this, key, targetID, nullptr);
             continue;
         }
+        tasks.emplace_back(&key, targetID);
+    }
 
-        // render queue info
-        const auto phaseLayoutID = key.queueLayoutID;
-        CC_EXPECTS(phaseLayoutID != LayoutGraphData::null_vertex());
+    // other queues only write to themselves
+    ccstd::vector<ccstd::vector<DeferredInstance>> deferredInstances(tasks.size());
+    parallelForEachIndex(static_cast<uint32_t>(tasks.size()), [&](uint32_t taskID) {
+        const auto& [key, targetID] = tasks[taskID];
+        fillRenderQueue(*this, *key, targetID, &deferredInstances[taskID]);
+    });
 
-        // culling source
-        CC_EXPECTS(frustomCulledResultID.value < frustumCullingResults.size());
-        const auto& sourceModels = [&]() -> const auto& {
-            // is culled by light bounds
-            if (lightBoundsCullingID.value != 0xFFFFFFFF) {
-                CC_EXPECTS(lightBoundsCullingID.value < lightBoundsCullingResults.size());
-                return lightBoundsCullingResults.at(lightBoundsCullingID.value).instances;
+    // merge instances on the calling thread
+    for (uint32_t taskID = 0; taskID != tasks.size(); ++taskID) {
+        auto& nativeQueue = renderQueues[tasks[taskID].second.value];
+        for (const auto& item : deferredInstances[taskID]) {
+            if (item.bBlend) {
+                nativeQueue.transparentInstancingQueue.add(*item.pass, *item.subModel, item.passIdx);
+            } else {
+                nativeQueue.opaqueInstancingQueue.add(*item.pass, *item.subModel, item.passIdx);
             }
-            // not culled by light bounds
-            return frustumCullingResults.at(frustomCulledResultID.value);
-        }();
-
-        // skybox
-        const auto* camera = nativeQueue.camera;
-        CC_EXPECTS(camera);
-
-        // fill native queue
-        for (const auto* const model : sourceModels) {
-            addRenderObject(
-                phaseLayoutID, bDrawOpaqueOrMask, bDrawBlend,
-                bDrawProbe, *camera, *model, nativeQueue);
         }
-
-        // post-processing
-        nativeQueue.sort();
+        nativeQueue.opaqueInstancingQueue.sort();
+        nativeQueue.transparentInstancingQueue.sort();
     }
 }
 
@@ -198,6 +198,7 @@ static void fillTestGraph(const ViewInfo &rasterData, const ResourceInfo &rescIn
 
                 const ccstd::string name = "pass" + std::to_string(passCount++);
                 const auto vertexID = add_vertex(renderGraph, ComputeTag{}, name.c_str());
+                get(RenderGraph::LayoutTag{}, renderGraph, vertexID) = "default";
                 renderGraph.sortedVertices.emplace_back(vertexID);
 
                 assert(subpasses.back().size() == 2); // inputs and outputs
@@ -799,5 +800,66 @@ static void fillTestGraph(const ViewInfo &rasterData, const ResourceInfo &rescIn
             {"22", 22, cc::gfx::ShaderStageFlagBit::FRAGMENT}, \
         },                                                     \
     };
+
+// two independent branches joined by the last pass
+#define TEST_CASE_5                                            \
+    TEST_CASE_DEFINE                                           \
+                                                               \
+    ViewInfo rasterData = {                                    \
+        {                                                      \
+            PassType::COMPUTE,                                 \
+            {                                                  \
+                {{"19"}, {"0"}},                               \
+            },                                                 \
+        },                                                     \
+        {                                                      \
+            PassType::COMPUTE,                                 \
+            {                                                  \
+                {{"20"}, {"1"}},                               \
+            },                                                 \
+        },                                                     \
+        {                                                      \
+            PassType::COMPUTE,                                 \
+            {                                                  \
+                {{"0"}, {"2"}},                                \
+            },                                                 \
+        },                                                     \
+        {                                                      \
+            PassType::COMPUTE,                                 \
+            {                                                  \
+                {{"1"}, {"3"}},                                \
+            },                                                 \
+        },                                                     \
+        {                                                      \
+            PassType::RASTER,                                  \
+            {                                                  \
+                {{"2", "3"}, {"22"}},                          \
+            },                                                 \
+        },                                                     \
+    };                                                         \
+                                                               \
+    LayoutInfo layoutInfo = {                                  \
+        {                                                      \
+            {"19", 19, cc::gfx::ShaderStageFlagBit::COMPUTE},  \
+            {"0", 0, cc::gfx::ShaderStageFlagBit::COMPUTE},    \
+        },                                                     \
+        {                                                      \
+            {"20", 20, cc::gfx::ShaderStageFlagBit::COMPUTE},  \
+            {"1", 1, cc::gfx::ShaderStageFlagBit::COMPUTE},    \
+        },                                                     \
+        {                                                      \
+            {"0", 0, cc::gfx::ShaderStageFlagBit::COMPUTE},    \
+            {"2", 2, cc::gfx::ShaderStageFlagBit::COMPUTE},    \
+        },                                                     \
+        {                                                      \
+            {"1", 1, cc::gfx::ShaderStageFlagBit::COMPUTE},    \
+            {"3", 3, cc::gfx::ShaderStageFlagBit::COMPUTE},    \
+        },                                                     \
+        {                                                      \
+            {"2", 2, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+            {"3", 3, cc::gfx::ShaderStageFlagBit::FRAGMENT},   \
+            {"22", 22, cc::gfx::ShaderStageFlagBit::FRAGMENT}, \
+        },                                                     \
+    };
 } // namespace render
 } // namespace cc
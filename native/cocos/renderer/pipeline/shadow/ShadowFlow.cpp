@@ -133,6 +133,9 @@ void ShadowFlow::render(scene::Camera *camera) {
         }
 
         gfx::Framebuffer *shadowFrameBuffer = shadowFramebufferMap.at(mainLight);
+        if (mainLight->isShadowEnabled() && camera->isCullingEnabled()) {
+            shadowCulling(_pipeline, camera);
+        }
         if (mainLight->isShadowFixedArea()) {
             renderStage(globalDS, camera, mainLight, shadowFrameBuffer);
         } else {
@@ -0,0 +1,412 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "scene/BVH.h"
+#include <algorithm>
+#include <limits>
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "scene/Camera.h"
+#include "scene/Model.h"
+#include "scene/WorldBoundsSoA.h"
+
+namespace cc {
+namespace scene {
+
+namespace {
+
+constexpr uint32_t MIN_PENDING_MODELS = 32; // inserted models tested linearly before forcing a rebuild
+constexpr uint32_t MORTON_BITS = 10;        // per axis, 30 bits in total
+
+// spreads the lower 10 bits of v so that there are two zero bits between each of them
+uint32_t expandBits(uint32_t v) {
+    v = (v * 0x00010001U) & 0xFF0000FFU;
+    v = (v * 0x00000101U) & 0x0F00F00FU;
+    v = (v * 0x00000011U) & 0xC30C30C3U;
+    v = (v * 0x00000005U) & 0x49249249U;
+    return v;
+}
+
+uint32_t quantize(float value, float minValue, float invExtent) {
+    constexpr auto MAX_VALUE = static_cast<float>((1U << MORTON_BITS) - 1);
+    return static_cast<uint32_t>(std::clamp((value - minValue) * invExtent, 0.F, 1.F) * MAX_VALUE);
+}
+
+uint32_t highestBit(uint32_t v) {
+    uint32_t bit = 0;
+    while (v >>= 1) {
+        ++bit;
+    }
+    return bit;
+}
+
+float surfaceArea(const BBox &box) {
+    const auto size = box.max - box.min;
+    return 2.F * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+BBox merge(const BBox &lhs, const BBox &rhs) {
+    return {Vec3{std::min(lhs.min.x, rhs.min.x), std::min(lhs.min.y, rhs.min.y), std::min(lhs.min.z, rhs.min.z)},
+            Vec3{std::max(lhs.max.x, rhs.max.x), std::max(lhs.max.y, rhs.max.y), std::max(lhs.max.z, rhs.max.z)}};
+}
+
+bool isQueryCandidate(const Model *model, uint32_t visibility, bool isShadow) {
+    if (!model->isEnabled() || !model->getWorldBounds()) {
+        return false;
+    }
+    if (isShadow && !model->isCastShadow()) {
+        return false;
+    }
+    const Node *node = model->getNode();
+    return (node && ((visibility & node->getLayer()) == node->getLayer())) ||
+           (visibility & static_cast<uint32_t>(model->getVisFlags()));
+}
+
+} // namespace
+
+void BVHInfo::setEnabled(bool val) {
+    if (_enabled == val) {
+        return;
+    }
+    _enabled = val;
+    if (_resource) {
+        _resource->setEnabled(val);
+    }
+}
+
+void BVHInfo::setLeafSize(uint32_t val) {
+    _leafSize = val;
+    if (_resource) {
+        _resource->setLeafSize(val);
+    }
+}
+
+void BVHInfo::setRebuildThreshold(float val) {
+    _rebuildThreshold = val;
+    if (_resource) {
+        _resource->setRebuildThreshold(val);
+    }
+}
+
+void BVHInfo::activate(BVH *resource) {
+    _resource = resource;
+    _resource->initialize(*this);
+}
+
+void BVH::initialize(const BVHInfo &info) {
+    setLeafSize(info.getLeafSize());
+    setRebuildThreshold(info.getRebuildThreshold());
+    setEnabled(info.isEnabled());
+}
+
+void BVH::setEnabled(bool val) {
+    if (_enabled == val) {
+        return;
+    }
+    _enabled = val;
+    if (_enabled) {
+        ++_generation;
+    } else {
+        // models are not removed from a disabled tree, forget them now
+        for (const auto &entry : _models) {
+            entry.model->setBVHIndex(INVALID_INDEX);
+        }
+        _models.clear();
+        rebuild();
+    }
+}
+
+void BVH::setLeafSize(uint32_t val) {
+    val = std::max(val, 1U);
+    if (_leafSize == val) {
+        return;
+    }
+    _leafSize = val;
+    if (!_models.empty()) {
+        rebuild();
+    }
+}
+
+void BVH::setRebuildThreshold(float val) {
+    _rebuildThreshold = std::max(val, 1.F);
+}
+
+void BVH::insert(Model *model) {
+    CC_ASSERT(model);
+    if (!model->getWorldBounds()) {
+        return;
+    }
+    if (model->getBVHIndex() != INVALID_INDEX) {
+        update(model);
+        return;
+    }
+    model->setBVHIndex(static_cast<uint32_t>(_models.size()));
+    _models.push_back({model, INVALID_INDEX, static_cast<uint32_t>(_pendingModels.size())});
+    _pendingModels.emplace_back(model);
+}
+
+void BVH::remove(Model *model) {
+    CC_ASSERT(model);
+    const auto index = model->getBVHIndex();
+    if (index == INVALID_INDEX) {
+        return;
+    }
+    CC_ASSERT(index < _models.size() && _models[index].model == model);
+    const auto &entry = _models[index];
+    if (entry.leafSlot != INVALID_INDEX) {
+        // the slot stays empty until the next rebuild
+        _leafModels[entry.leafSlot] = nullptr;
+        ++_removedCount;
+    }
+    if (entry.pendingSlot != INVALID_INDEX) {
+        const auto *last = _pendingModels.back();
+        _pendingModels[entry.pendingSlot] = last;
+        _models[last->getBVHIndex()].pendingSlot = entry.pendingSlot;
+        _pendingModels.pop_back();
+    }
+    auto &last = _models.back();
+    last.model->setBVHIndex(index);
+    _models[index] = last;
+    _models.pop_back();
+    model->setBVHIndex(INVALID_INDEX);
+}
+
+void BVH::update(Model *model) {
+    CC_ASSERT(model);
+    const auto index = model->getBVHIndex();
+    if (index == INVALID_INDEX) {
+        insert(model);
+        return;
+    }
+    auto &entry = _models[index];
+    if (entry.leafSlot != INVALID_INDEX) {
+        _nodes[_leafNodes[entry.leafSlot]].dirty = true;
+        _refitPending = true;
+    } else if (entry.pendingSlot == INVALID_INDEX && model->getWorldBounds()) {
+        // had no bounds when the tree was built
+        entry.pendingSlot = static_cast<uint32_t>(_pendingModels.size());
+        _pendingModels.emplace_back(model);
+    }
+}
+
+void BVH::commit() {
+    const auto numModels = static_cast<uint32_t>(_models.size());
+    if (_pendingModels.size() > std::max(MIN_PENDING_MODELS, numModels / 16) ||
+        _removedCount > _leafModels.size() / 4) {
+        rebuild();
+        return;
+    }
+    if (_refitPending) {
+        refit();
+        if (_cost > _builtCost * _rebuildThreshold) {
+            rebuild();
+        }
+    }
+}
+
+void BVH::rebuild() {
+    _nodes.clear();
+    _leafModels.clear();
+    _leafNodes.clear();
+    _pendingModels.clear();
+    _mortonCodes.clear();
+    _removedCount = 0;
+    _refitPending = false;
+
+    // Morton codes are relative to the bounds of all centers, there is no fixed world box
+    constexpr auto MAX_FLOAT = std::numeric_limits<float>::max();
+    BBox centerBounds{Vec3{MAX_FLOAT, MAX_FLOAT, MAX_FLOAT}, Vec3{-MAX_FLOAT, -MAX_FLOAT, -MAX_FLOAT}};
+    for (auto &entry : _models) {
+        entry.leafSlot = INVALID_INDEX;
+        entry.pendingSlot = INVALID_INDEX;
+        const auto *bounds = entry.model->getWorldBounds();
+        if (bounds) {
+            const auto &center = bounds->getCenter();
+            centerBounds = merge(centerBounds, BBox{center, center});
+        }
+    }
+    const auto extent = centerBounds.max - centerBounds.min;
+    const Vec3 invExtent{
+        extent.x > 0.F ? 1.F / extent.x : 0.F,
+        extent.y > 0.F ? 1.F / extent.y : 0.F,
+        extent.z > 0.F ? 1.F / extent.z : 0.F};
+    for (uint32_t i = 0; i < _models.size(); ++i) {
+        const auto *bounds = _models[i].model->getWorldBounds();
+        if (!bounds) {
+            continue;
+        }
+        const auto &center = bounds->getCenter();
+        const auto code = (expandBits(quantize(center.x, centerBounds.min.x, invExtent.x)) << 2) |
+                          (expandBits(quantize(center.y, centerBounds.min.y, invExtent.y)) << 1) |
+                          expandBits(quantize(center.z, centerBounds.min.z, invExtent.z));
+        _mortonCodes.emplace_back(code, i);
+    }
+    std::sort(_mortonCodes.begin(), _mortonCodes.end());
+
+    const auto count = static_cast<uint32_t>(_mortonCodes.size());
+    _cost = 0.F;
+    _builtCost = 0.F;
+    if (!count) {
+        return;
+    }
+    _leafModels.resize(count);
+    _leafNodes.resize(count);
+    _nodes.reserve(2 * (count / _leafSize + 1));
+    _nodes.emplace_back();
+    buildNode(0, 0, count);
+    for (const auto &node : _nodes) {
+        _cost += surfaceArea(node.box);
+    }
+    _builtCost = _cost;
+}
+
+// splits at the highest bit where the Morton codes of the range differ, or in the middle if they are equal
+void BVH::buildNode(uint32_t nodeIndex, uint32_t begin, uint32_t end) { // NOLINT(misc-no-recursion)
+    if (end - begin <= _leafSize) {
+        auto &node = _nodes[nodeIndex];
+        node.first = begin;
+        node.count = end - begin;
+        for (uint32_t i = begin; i < end; ++i) {
+            auto &entry = _models[_mortonCodes[i].second];
+            entry.leafSlot = i;
+            _leafModels[i] = entry.model;
+            _leafNodes[i] = nodeIndex;
+        }
+        node.box = BBox{*_leafModels[begin]->getWorldBounds()};
+        updateLeafBox(node);
+        return;
+    }
+
+    const auto firstCode = _mortonCodes[begin].first;
+    const auto lastCode = _mortonCodes[end - 1].first;
+    auto split = begin + (end - begin) / 2;
+    if (firstCode != lastCode) {
+        const auto mask = ~((1U << highestBit(firstCode ^ lastCode)) - 1U);
+        const auto splitCode = (lastCode & mask);
+        split = static_cast<uint32_t>(std::lower_bound(
+                                          _mortonCodes.begin() + begin, _mortonCodes.begin() + end,
+                                          std::make_pair(splitCode, 0U)) -
+                                      _mortonCodes.begin());
+    }
+
+    const auto first = static_cast<uint32_t>(_nodes.size());
+    _nodes[nodeIndex].first = first;
+    _nodes[nodeIndex].count = 0;
+    _nodes.emplace_back().parent = nodeIndex;
+    _nodes.emplace_back().parent = nodeIndex;
+    buildNode(first, begin, split);
+    buildNode(first + 1, split, end);
+    _nodes[nodeIndex].box = merge(_nodes[first].box, _nodes[first + 1].box);
+}
+
+void BVH::updateLeafBox(Node &node) const {
+    // keeps the old box if every model of the leaf was removed
+    bool empty = true;
+    for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        const auto *model = _leafModels[i];
+        if (!model || !model->getWorldBounds()) {
+            continue;
+        }
+        const BBox box{*model->getWorldBounds()};
+        node.box = empty ? box : merge(node.box, box);
+        empty = false;
+    }
+}
+
+// children always follow their parent in _nodes, a reverse scan refits bottom-up
+void BVH::refit() {
+    _refitPending = false;
+    for (auto i = static_cast<uint32_t>(_nodes.size()); i-- > 0;) {
+        auto &node = _nodes[i];
+        if (!node.dirty) {
+            continue;
+        }
+        node.dirty = false;
+        const auto oldArea = surfaceArea(node.box);
+        const auto oldBox = node.box;
+        if (node.count) {
+            updateLeafBox(node);
+        } else {
+            node.box = merge(_nodes[node.first].box, _nodes[node.first + 1].box);
+        }
+        if (node.box == oldBox) {
+            continue;
+        }
+        _cost += surfaceArea(node.box) - oldArea;
+        if (node.parent != INVALID_INDEX) {
+            _nodes[node.parent].dirty = true;
+        }
+    }
+}
+
+void BVH::queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const {
+    const auto visibility = camera->getVisibility();
+
+    // gather candidates from the intersected leaves, then test their bounds in batch
+    thread_local ccstd::vector<const Model *> candidates;
+    thread_local ccstd::vector<uint8_t> visible;
+    thread_local ccstd::vector<uint32_t> stack;
+    candidates.clear();
+    stack.clear();
+    if (!_nodes.empty()) {
+        stack.emplace_back(0);
+    }
+    geometry::AABB box;
+    while (!stack.empty()) {
+        const auto &node = _nodes[stack.back()];
+        stack.pop_back();
+        geometry::AABB::fromPoints(node.box.min, node.box.max, &box);
+        if (!box.aabbFrustum(frustum)) {
+            continue;
+        }
+        if (!node.count) {
+            stack.emplace_back(node.first + 1);
+            stack.emplace_back(node.first);
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            const auto *model = _leafModels[i];
+            if (model && isQueryCandidate(model, visibility, isShadow)) {
+                candidates.emplace_back(model);
+            }
+        }
+    }
+    for (const auto *model : _pendingModels) {
+        if (isQueryCandidate(model, visibility, isShadow)) {
+            candidates.emplace_back(model);
+        }
+    }
+
+    const auto count = static_cast<uint32_t>(candidates.size());
+    visible.resize(count);
+    WorldBoundsSoA::cullFrustum(frustum, candidates.data(), count, visible.data());
+    for (uint32_t i = 0; i < count; ++i) {
+        if (visible[i]) {
+            results.push_back(candidates[i]);
+        }
+    }
+}
+
+} // namespace scene
+} // namespace cc
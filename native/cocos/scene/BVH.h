@@ -0,0 +1,170 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <utility>
+#include "base/Macros.h"
+#include "base/RefCounted.h"
+#include "base/std/container/vector.h"
+#include "scene/Octree.h"
+
+namespace cc {
+
+namespace geometry {
+class Frustum;
+} // namespace geometry
+
+namespace scene {
+
+class Camera;
+class Model;
+class BVH;
+
+constexpr uint32_t DEFAULT_BVH_LEAF_SIZE = 4;
+constexpr float DEFAULT_BVH_REBUILD_THRESHOLD = 1.5F; // rebuild when refitting made the tree this much more expensive
+
+class CC_DLL BVHInfo final : public RefCounted {
+public:
+    BVHInfo() = default;
+    ~BVHInfo() override = default;
+    /**
+     * @en Whether activate the bounding volume hierarchy
+     * @zh 是否启用层次包围盒加速剔除？
+     */
+    void setEnabled(bool val);
+    inline bool isEnabled() const { return _enabled; }
+
+    /**
+     * @en max model count of a leaf node
+     * @zh 叶节点包含的最大模型数量
+     */
+    void setLeafSize(uint32_t val);
+    inline uint32_t getLeafSize() const { return _leafSize; }
+
+    /**
+     * @en The tree is rebuilt when refitting grows its total surface area by this ratio
+     * @zh 重新拟合使节点总表面积增长到该倍数时重建
+     */
+    void setRebuildThreshold(float val);
+    inline float getRebuildThreshold() const { return _rebuildThreshold; }
+
+    void activate(BVH *resource);
+
+    // JS deserialization require the properties to be public
+    // private:
+    bool _enabled{false};
+    uint32_t _leafSize{DEFAULT_BVH_LEAF_SIZE};
+    float _rebuildThreshold{DEFAULT_BVH_REBUILD_THRESHOLD};
+
+private:
+    BVH *_resource{nullptr};
+};
+
+/**
+ * @en Bounding volume hierarchy of the models in the scene, an alternative to Octree without fixed world bounds.
+ * Nodes live in a flat array built from the Morton codes of model centers. Moved models only refit
+ * the boxes on their path to the root, inserted models are tested linearly until the next rebuild.
+ * @zh 场景模型的层次包围盒，可替代没有固定世界范围限制的八叉树。节点以 Morton 码构建在连续数组中，
+ * 移动的模型只重新拟合到根节点路径上的包围盒，新加入的模型在下次重建前线性测试。
+ */
+class CC_DLL BVH final {
+public:
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+    BVH() = default;
+    ~BVH() = default;
+
+    void initialize(const BVHInfo &info);
+
+    // models added while disabled are not in the tree, scenes insert them again when the generation changes
+    void setEnabled(bool val);
+    inline bool isEnabled() const { return _enabled; }
+    inline uint32_t getGeneration() const { return _generation; }
+
+    void setLeafSize(uint32_t val);
+    inline uint32_t getLeafSize() const { return _leafSize; }
+
+    void setRebuildThreshold(float val);
+    inline float getRebuildThreshold() const { return _rebuildThreshold; }
+
+    // insert a model to tree.
+    void insert(Model *model);
+
+    // remove a model from tree.
+    void remove(Model *model);
+
+    // mark a model whose world bounds changed, its leaf is refitted in commit().
+    void update(Model *model);
+
+    // refit moved models and rebuild when the tree degraded, call once per frame before culling.
+    void commit();
+
+    // view frustum culling, safe to call from several threads between commits
+    void queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
+
+    inline uint32_t getModelCount() const { return static_cast<uint32_t>(_models.size()); }
+    inline uint32_t getNodeCount() const { return static_cast<uint32_t>(_nodes.size()); }
+
+private:
+    // inner nodes keep their children at first and first + 1, leaves own _leafModels[first, first + count)
+    struct Node {
+        BBox box;
+        uint32_t first{0};
+        uint32_t count{0};
+        uint32_t parent{INVALID_INDEX};
+        bool dirty{false};
+    };
+
+    // a model and where it lives: its slot in _leafModels, or in _pendingModels if not built yet
+    struct Entry {
+        Model *model{nullptr};
+        uint32_t leafSlot{INVALID_INDEX};
+        uint32_t pendingSlot{INVALID_INDEX};
+    };
+
+    void rebuild();
+    void buildNode(uint32_t nodeIndex, uint32_t begin, uint32_t end);
+    void refit();
+    void updateLeafBox(Node &node) const;
+
+    ccstd::vector<Node> _nodes;
+    ccstd::vector<Entry> _models;            // indexed by Model::getBVHIndex()
+    ccstd::vector<const Model *> _leafModels; // null for models removed since the last rebuild
+    ccstd::vector<uint32_t> _leafNodes;       // leaf node of every slot in _leafModels
+    ccstd::vector<const Model *> _pendingModels;
+    // scratch of rebuild
+    ccstd::vector<std::pair<uint32_t, uint32_t>> _mortonCodes;
+    float _builtCost{0.F};
+    float _cost{0.F};
+    uint32_t _removedCount{0};
+    uint32_t _generation{0}; // bumped every time the tree is enabled
+    uint32_t _leafSize{DEFAULT_BVH_LEAF_SIZE};
+    float _rebuildThreshold{DEFAULT_BVH_REBUILD_THRESHOLD};
+    bool _refitPending{false};
+    bool _enabled{false};
+};
+
+} // namespace scene
+} // namespace cc
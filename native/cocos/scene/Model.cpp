@@ -139,6 +139,9 @@ void Model::updateWorldBound() {
         if (_modelBounds != nullptr && _modelBounds->isValid() && _worldBounds != nullptr) {
             _modelBounds->transform(node->getWorldMatrix(), _worldBounds);
             _worldBoundsDirty = true;
+            if (_scene) {
+                _scene->updateWorldBounds(this);
+            }
         }
     }
 }
@@ -170,28 +173,28 @@ void Model::updateUBOs(uint32_t stamp) {
         }
     }
 
-    for (SubModel *subModel : _subModels) {
-        subModel->update();
-    }
+    prepareUBOs(stamp);
+    uploadUBOs(stamp);
+}
+
+void Model::prepareUBOs(uint32_t stamp) {
     _updateStamp = stamp;
 
-    updateSHUBOs();
+    if (!_localDataUpdated) {
+        return;
+    }
+    _localDataUpdated = false;
 
     const auto *pipeline = Root::getInstance()->getPipeline();
     const auto *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
     const auto forceUpdateUBO = shadowInfo->isEnabled() && shadowInfo->getType() == ShadowType::PLANAR;
 
-    if (!_localDataUpdated) {
-        return;
-    }
-    _localDataUpdated = false;
     getTransform()->updateWorldTransform();
     const auto &worldMatrix = getTransform()->getWorldMatrix();
     bool hasNonInstancingPass = false;
     for (const auto &subModel : _subModels) {
         const auto idx = subModel->getInstancedWorldMatrixIndex();
         if (idx >= 0) {
-            const ccstd::vector<TypedArray> &attrs = subModel->getInstancedAttributeBlock().views;
             subModel->updateInstancedWorldMatrix(worldMatrix, idx);
         } else {
             hasNonInstancingPass = true;
@@ -206,45 +209,60 @@ void Model::updateUBOs(uint32_t stamp) {
         _localBuffer->write(mat4, sizeof(float) * pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
         _localBuffer->write(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
         _localBuffer->write(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
+        _localBufferDirty = true;
+    }
+}
 
-        auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeId);
-        auto *blendProbe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeBlendId);
-        if (probe) {
-            if (probe->getProbeType() == scene::ReflectionProbe::ProbeType::PLANAR) {
-                const Vec4 plane = {probe->getNode()->getUp().x, probe->getNode()->getUp().y, probe->getNode()->getUp().z, 1.F};
-                _localBuffer->write(plane, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
-                const Vec4 depthScale = {1.F, 0.F, 0.F, 1.F};
-                _localBuffer->write(depthScale, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
-            } else {
-                const uint16_t mipAndUseRGBE = probe->isRGBE() ? 1000 : 0;
-                const Vec4 pos = {probe->getNode()->getWorldPosition().x, probe->getNode()->getWorldPosition().y, probe->getNode()->getWorldPosition().z, 0.F};
-                _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
-                const Vec4 boxSize = {probe->getBoudingSize().x, probe->getBoudingSize().y, probe->getBoudingSize().z, static_cast<float>(probe->getCubeMap() ? probe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
-                _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
-            }
-            if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES ||
-                _reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
-                if (blendProbe) {
-                    const uint16_t mipAndUseRGBE = blendProbe->isRGBE() ? 1000 : 0;
-                    const Vec3 worldPos = blendProbe->getNode()->getWorldPosition();
-                    const Vec3 boudingBox = blendProbe->getBoudingSize();
-                    const Vec4 pos = {worldPos.x, worldPos.y, worldPos.z, _reflectionProbeBlendWeight};
-                    _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
-                    const Vec4 boxSize = {boudingBox.x, boudingBox.y, boudingBox.z, static_cast<float>(blendProbe->getCubeMap() ? blendProbe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
-                    _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA2));
-                } else if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
-                    // blend with skybox
-                    const Vec4 pos = {0.F, 0.F, 0.F, _reflectionProbeBlendWeight};
-                    _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
-                }
+void Model::uploadUBOs(uint32_t /*stamp*/) {
+    for (SubModel *subModel : _subModels) {
+        subModel->update();
+    }
+
+    updateSHUBOs();
+
+    if (!_localBufferDirty) {
+        return;
+    }
+    _localBufferDirty = false;
+
+    // reflection probe nodes update their world transform lazily, so the probe data is written here
+    auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeId);
+    auto *blendProbe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeBlendId);
+    if (probe) {
+        if (probe->getProbeType() == scene::ReflectionProbe::ProbeType::PLANAR) {
+            const Vec4 plane = {probe->getNode()->getUp().x, probe->getNode()->getUp().y, probe->getNode()->getUp().z, 1.F};
+            _localBuffer->write(plane, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
+            const Vec4 depthScale = {1.F, 0.F, 0.F, 1.F};
+            _localBuffer->write(depthScale, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
+        } else {
+            const uint16_t mipAndUseRGBE = probe->isRGBE() ? 1000 : 0;
+            const Vec4 pos = {probe->getNode()->getWorldPosition().x, probe->getNode()->getWorldPosition().y, probe->getNode()->getWorldPosition().z, 0.F};
+            _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
+            const Vec4 boxSize = {probe->getBoudingSize().x, probe->getBoudingSize().y, probe->getBoudingSize().z, static_cast<float>(probe->getCubeMap() ? probe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
+            _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
+        }
+        if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES ||
+            _reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
+            if (blendProbe) {
+                const uint16_t mipAndUseRGBE = blendProbe->isRGBE() ? 1000 : 0;
+                const Vec3 worldPos = blendProbe->getNode()->getWorldPosition();
+                const Vec3 boudingBox = blendProbe->getBoudingSize();
+                const Vec4 pos = {worldPos.x, worldPos.y, worldPos.z, _reflectionProbeBlendWeight};
+                _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
+                const Vec4 boxSize = {boudingBox.x, boudingBox.y, boudingBox.z, static_cast<float>(blendProbe->getCubeMap() ? blendProbe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
+                _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA2));
+            } else if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
+                // blend with skybox
+                const Vec4 pos = {0.F, 0.F, 0.F, _reflectionProbeBlendWeight};
+                _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
             }
         }
+    }
 
-        _localBuffer->update();
-        const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
-        if (enableOcclusionQuery) {
-            updateWorldBoundUBOs();
-        }
+    _localBuffer->update();
+    const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
+    if (enableOcclusionQuery) {
+        updateWorldBoundUBOs();
     }
 }
 
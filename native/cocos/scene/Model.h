@@ -121,6 +121,10 @@ public:
     virtual void updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attributes, SubModel *subModel);
     virtual void updateTransform(uint32_t stamp);
     virtual void updateUBOs(uint32_t stamp);
+    // updateUBOs() in two steps for the batched RenderScene::update: prepareUBOs() only writes
+    // memory owned by the model and may run on worker threads, uploadUBOs() issues the gfx calls.
+    virtual void prepareUBOs(uint32_t stamp);
+    virtual void uploadUBOs(uint32_t stamp);
     virtual void updateLocalDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet);
     virtual void updateLocalSHDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet);
     virtual void updateWorldBoundDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet);
@@ -227,6 +231,10 @@ public:
     inline Type getType() const { return _type; };
     inline void setType(Type type) { _type = type; }
     inline OctreeNode *getOctreeNode() const { return _octreeNode; }
+    inline void setWorldBoundsIndex(uint32_t index) { _worldBoundsIndex = index; }
+    inline uint32_t getWorldBoundsIndex() const { return _worldBoundsIndex; }
+    inline void setBVHIndex(uint32_t index) { _bvhIndex = index; }
+    inline uint32_t getBVHIndex() const { return _bvhIndex; }
     inline RenderScene *getScene() const { return _scene; }
     inline void setDynamicBatching(bool val) { _isDynamicBatching = val; }
     inline bool isDynamicBatching() const { return _isDynamicBatching; }
@@ -267,6 +275,8 @@ protected:
     uint32_t _descriptorSetCount{1};
     uint32_t _priority{0};
     uint32_t _updateStamp{0};
+    uint32_t _worldBoundsIndex{0xFFFFFFFF}; // index in RenderScene::getWorldBoundsSoA()
+    uint32_t _bvhIndex{0xFFFFFFFF};         // index in the BVH of the scene
     int32_t _reflectionProbeId{-1};
     int32_t _reflectionProbeBlendId{ -1 };
     float _reflectionProbeBlendWeight{0.F};
@@ -290,6 +300,7 @@ protected:
     bool _isDynamicBatching{false};
     bool _inited{false};
     bool _localDataUpdated{false};
+    bool _localBufferDirty{false};
     bool _worldBoundsDirty{true};
     bool _useLightProbe = false;
     bool _bakeToReflectionProbe{true};
@@ -23,10 +23,12 @@
 ****************************************************************************/
 
 #include "Octree.h"
-#include <future>
+#include <algorithm>
 #include <utility>
+#include "base/job-system/JobSystem.h"
 #include "scene/Camera.h"
 #include "scene/Model.h"
+#include "scene/WorldBoundsSoA.h"
 
 namespace cc {
 namespace scene {
@@ -223,6 +225,11 @@ void OctreeNode::gatherModels(ccstd::vector<Model *> &results) const { // NOLINT
 
 void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const {
     const auto visibility = camera->getVisibility();
+
+    // gather candidates, then test their bounds in batch
+    thread_local ccstd::vector<const Model *> candidates;
+    thread_local ccstd::vector<uint8_t> visible;
+    candidates.clear();
     for (auto *model : _models) {
         if (!model->isEnabled()) {
             continue;
@@ -231,48 +238,45 @@ void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum
         const Node *node = model->getNode();
         if ((node && ((visibility & node->getLayer()) == node->getLayer())) ||
             (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-            const geometry::AABB *modelWorldBounds = model->getWorldBounds();
-            if (!modelWorldBounds) {
+            if (!model->getWorldBounds()) {
                 continue;
             }
-
-            if (isShadow) {
-                if (model->isCastShadow() && modelWorldBounds->aabbFrustum(frustum)) {
-                    results.push_back(model);
-                }
-            } else {
-                if (modelWorldBounds->aabbFrustum(frustum)) {
-                    results.push_back(model);
-                }
+            if (isShadow && !model->isCastShadow()) {
+                continue;
             }
+            candidates.emplace_back(model);
+        }
+    }
+
+    const auto count = static_cast<uint32_t>(candidates.size());
+    visible.resize(count);
+    WorldBoundsSoA::cullFrustum(frustum, candidates.data(), count, visible.data());
+    for (uint32_t i = 0; i < count; ++i) {
+        if (visible[i]) {
+            results.push_back(candidates[i]);
         }
     }
 }
 
-void OctreeNode::queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const {
+// tasks are collected in pre-order, so concatenating their results keeps the sequential order
+void OctreeNode::collectQueryTasks(const geometry::Frustum &frustum, uint32_t splitDepth, ccstd::vector<OctreeQueryTask> &tasks) const { // NOLINT(misc-no-recursion)
     geometry::AABB box;
     geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
     if (!box.aabbFrustum(frustum)) {
         return;
     }
 
-    ccstd::array<std::future<ccstd::vector<const Model *>>, OCTREE_CHILDREN_NUM> futures{};
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
-        if (_children[i]) {
-            futures[i] = std::async(std::launch::async, [=, &frustum] {
-                ccstd::vector<const Model *> models;
-                _children[i]->queryVisibilitySequentially(camera, frustum, isShadow, models);
-                return models;
-            });
-        }
+    if (_depth >= splitDepth) {
+        tasks.push_back({this, true});
+        return;
     }
 
-    doQueryVisibility(camera, frustum, isShadow, results);
-
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
-        if (_children[i]) {
-            auto models = futures[i].get();
-            results.insert(results.end(), models.begin(), models.end());
+    if (!_models.empty()) {
+        tasks.push_back({this, false});
+    }
+    for (auto *child : _children) {
+        if (child) {
+            child->collectQueryTasks(frustum, splitDepth, tasks);
         }
     }
 }
@@ -394,13 +398,53 @@ void Octree::update(Model *model) {
 }
 
 void Octree::queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const {
-    if (_totalCount > USE_MULTI_THRESHOLD) {
-        _root->queryVisibilityParallelly(camera, frustum, isShadow, results);
+    if (_totalCount > USE_MULTI_THRESHOLD && JobSystem::getInstance()->threadCount() > 1) {
+        queryVisibilityParallelly(camera, frustum, isShadow, results);
     } else {
         _root->queryVisibilitySequentially(camera, frustum, isShadow, results);
     }
 }
 
+void Octree::queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const {
+    // owned by the querying thread and reused across frames, jobs only touch their own slot
+    thread_local ccstd::vector<OctreeQueryTask> queryTasks;
+    thread_local ccstd::vector<ccstd::vector<const Model *>> queryResults;
+    auto &tasks = queryTasks;
+    auto &taskResults = queryResults;
+
+    // split deeper until every worker has a few subtrees to steal from
+    const auto targetCount = JobSystem::getInstance()->threadCount() * QUERY_TASKS_PER_WORKER;
+    for (uint32_t splitDepth = 1;; ++splitDepth) {
+        tasks.clear();
+        _root->collectQueryTasks(frustum, splitDepth, tasks);
+        const auto numSubtrees = std::count_if(tasks.begin(), tasks.end(), [](const OctreeQueryTask &task) {
+            return task.subtree;
+        });
+        if (static_cast<uint32_t>(numSubtrees) >= targetCount || splitDepth + 1 >= _maxDepth) {
+            break;
+        }
+    }
+
+    const auto taskCount = static_cast<uint32_t>(tasks.size());
+    if (taskResults.size() < taskCount) {
+        taskResults.resize(taskCount);
+    }
+    parallelForEachIndex(taskCount, [&](uint32_t i) {
+        const auto &task = tasks[i];
+        auto &models = taskResults[i];
+        models.clear();
+        if (task.subtree) {
+            task.node->queryVisibilitySequentially(camera, frustum, isShadow, models);
+        } else {
+            task.node->doQueryVisibility(camera, frustum, isShadow, models);
+        }
+    });
+
+    for (uint32_t i = 0; i < taskCount; ++i) {
+        results.insert(results.end(), taskResults[i].begin(), taskResults[i].end());
+    }
+}
+
 bool Octree::isInside(Model *model) const {
     const BBox &rootBox = _root->getBox();
     BBox modelBox = BBox(*model->getWorldBounds());
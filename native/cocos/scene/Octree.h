@@ -36,6 +36,7 @@ namespace scene {
 class Camera;
 class Model;
 class Octree;
+class OctreeNode;
 
 constexpr int OCTREE_CHILDREN_NUM = 8;
 constexpr int DEFAULT_OCTREE_DEPTH = 8;
@@ -43,6 +44,13 @@ const Vec3 DEFAULT_WORLD_MIN_POS = {-1024.0F, -1024.0F, -1024.0F};
 const Vec3 DEFAULT_WORLD_MAX_POS = {1024.0F, 1024.0F, 1024.0F};
 const float OCTREE_BOX_EXPAND_SIZE = 10.0F;
 constexpr int USE_MULTI_THRESHOLD = 1024; // use parallel culling if greater than this value
+constexpr int QUERY_TASKS_PER_WORKER = 4;  // split parallel culling until every worker has this many subtrees
+
+// a node queried by one job, with all of its descendants if subtree is true
+struct OctreeQueryTask {
+    const OctreeNode *node{nullptr};
+    bool subtree{false};
+};
 
 class CC_DLL OctreeInfo final : public RefCounted {
 public:
@@ -152,7 +160,7 @@ private:
     void onRemoved();
     void gatherModels(ccstd::vector<Model *> &results) const;
     void doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
-    void queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
+    void collectQueryTasks(const geometry::Frustum &frustum, uint32_t splitDepth, ccstd::vector<OctreeQueryTask> &tasks) const;
     void queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
 
     Octree *_owner{nullptr};
@@ -223,6 +231,7 @@ public:
 private:
     bool isInside(Model *model) const;
     bool isOutside(Model *model) const;
+    void queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
 
     OctreeNode *_root{nullptr};
     uint32_t _maxDepth{DEFAULT_OCTREE_DEPTH};
@@ -25,10 +25,12 @@
 #include "scene/RenderScene.h"
 #include "scene/Camera.h"
 
+#include <algorithm>
 #include <utility>
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/models/SkinningModel.h"
 #include "base/Log.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
 #include "profiler/Profiler.h"
@@ -39,6 +41,7 @@
 #include "scene/DrawBatch2D.h"
 #include "scene/LODGroup.h"
 #include "scene/Model.h"
+#include "scene/BVH.h"
 #include "scene/Octree.h"
 #include "scene/PointLight.h"
 #include "scene/RangedDirectionalLight.h"
@@ -48,6 +51,25 @@
 namespace cc {
 namespace scene {
 
+namespace {
+
+constexpr uint32_t MODEL_UPDATE_CHUNK_SIZE = 64;
+
+template <typename Function>
+void forEachModelChunk(const ccstd::vector<Model *> &models, const Function &func) {
+    const auto count = static_cast<uint32_t>(models.size());
+    const auto chunkCount = (count + MODEL_UPDATE_CHUNK_SIZE - 1) / MODEL_UPDATE_CHUNK_SIZE;
+    parallelForEachIndex(chunkCount, [&](uint32_t chunk) {
+        const auto begin = chunk * MODEL_UPDATE_CHUNK_SIZE;
+        const auto end = std::min(begin + MODEL_UPDATE_CHUNK_SIZE, count);
+        for (auto i = begin; i < end; ++i) {
+            func(models[i]);
+        }
+    });
+}
+
+} // namespace
+
 /**
  * @zh 管理LODGroup的使用状态，包含使用层级及其上的model可见相机列表；便于判断当前model是否被LODGroup裁剪
  * @en Manage the usage status of LODGroup, including the usage level and the list of visible cameras on its models; easy to determine whether the current mod is cropped by LODGroup。
@@ -118,6 +140,7 @@ RenderScene::~RenderScene() = default;
 void RenderScene::activate() {
     const auto *sceneData = Root::getInstance()->getPipeline()->getPipelineSceneData();
     _octree = sceneData->getOctree();
+    _bvh = sceneData->getBVH();
 }
 
 bool RenderScene::initialize(const IRenderSceneInfo &info) {
@@ -178,19 +201,90 @@ void RenderScene::update(uint32_t stamp) {
     for (const auto &light : _rangedDirLights) {
         light->update();
     }
+    updateModels(stamp);
+
+    CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
+    CC_PROFILE_OBJECT_UPDATE(Cameras, _cameras.size());
+    CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
+
+    _lodStateCache->updateLodState();
+}
+
+void RenderScene::updateModels(uint32_t stamp) {
+    CC_PROFILE(RenderSceneUpdateModels);
+
+    auto &defaultModels = _modelUpdateGroups[static_cast<uint32_t>(ModelUpdateGroup::DEFAULT)];
+    auto &skinningModels = _modelUpdateGroups[static_cast<uint32_t>(ModelUpdateGroup::SKINNING)];
+    auto &bakedSkinningModels = _modelUpdateGroups[static_cast<uint32_t>(ModelUpdateGroup::BAKED_SKINNING)];
+    for (auto &group : _modelUpdateGroups) {
+        group.clear();
+    }
+
     for (const auto &model : _models) {
-        if (model->isEnabled()) {
+        if (!model->isEnabled()) {
+            continue;
+        }
+        // models implemented in JS dispatch their updates to the script engine
+        if (model->isModelImplementedInJS()) {
             model->updateTransform(stamp);
             model->updateUBOs(stamp);
             model->updateOctree();
+            continue;
+        }
+        // updating a world transform also updates the dirty ancestors, which may be shared between models
+        auto *node = model->getTransform();
+        if (node && node->isTransformDirty()) {
+            node->updateWorldTransform();
+        }
+        switch (model->getType()) {
+            case Model::Type::SKINNING:
+                skinningModels.emplace_back(model);
+                break;
+            case Model::Type::BAKED_SKINNING:
+                bakedSkinningModels.emplace_back(model);
+                break;
+            default:
+                defaultModels.emplace_back(model);
+                break;
         }
     }
 
-    CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
-    CC_PROFILE_OBJECT_UPDATE(Cameras, _cameras.size());
-    CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
+    // Joint transforms are cached globally and shared between skinning models, so the hierarchies are
+    // evaluated on this thread, the joint bounds and palettes are then computed in parallel.
+    for (auto *model : skinningModels) {
+        static_cast<SkinningModel *>(model)->updateJointTransforms(stamp);
+    }
+    const auto updateTransform = [stamp](Model *model) { model->updateTransform(stamp); };
+    for (const auto &group : _modelUpdateGroups) {
+        forEachModelChunk(group, updateTransform);
+    }
 
-    _lodStateCache->updateLodState();
+    const auto prepareUBOs = [stamp](Model *model) { model->prepareUBOs(stamp); };
+    for (const auto &group : _modelUpdateGroups) {
+        forEachModelChunk(group, prepareUBOs);
+    }
+
+    // gfx calls and octree updates are not thread safe
+    for (const auto &group : _modelUpdateGroups) {
+        for (auto *model : group) {
+            model->uploadUBOs(stamp);
+        }
+    }
+    for (const auto &group : _modelUpdateGroups) {
+        for (auto *model : group) {
+            model->updateOctree();
+        }
+    }
+    if (_bvh && _bvh->isEnabled()) {
+        // the tree was enabled after models were added
+        if (_bvhGeneration != _bvh->getGeneration()) {
+            _bvhGeneration = _bvh->getGeneration();
+            for (const auto &model : _models) {
+                _bvh->insert(model);
+            }
+        }
+        _bvh->commit();
+    }
 }
 
 void RenderScene::destroy() {
@@ -342,10 +436,15 @@ void RenderScene::removeRangedDirLights() {
 
 void RenderScene::addModel(Model *model) {
     model->attachToScene(this);
+    model->setWorldBoundsIndex(static_cast<uint32_t>(_models.size()));
     _models.emplace_back(model);
+    _worldBoundsSoA.add(model);
     if (_octree && _octree->isEnabled()) {
         _octree->insert(model);
     }
+    if (_bvh && _bvh->isEnabled()) {
+        _bvh->insert(model);
+    }
 }
 
 void RenderScene::removeModel(Model *model) {
@@ -354,9 +453,20 @@ void RenderScene::removeModel(Model *model) {
         if (_octree && _octree->isEnabled()) {
             _octree->remove(*iter);
         }
+        if (_bvh && _bvh->isEnabled()) {
+            _bvh->remove(*iter);
+        }
         _lodStateCache->removeModel(model);
         model->detachFromScene();
-        _models.erase(iter);
+        const auto index = static_cast<uint32_t>(iter - _models.begin());
+        CC_ASSERT(model->getWorldBoundsIndex() == index);
+        _worldBoundsSoA.remove(index);
+        model->setWorldBoundsIndex(WorldBoundsSoA::INVALID_INDEX);
+        iter = _models.erase(iter);
+        // entries after the removed one are shifted by one
+        for (; iter != _models.end(); ++iter) {
+            (*iter)->setWorldBoundsIndex((*iter)->getWorldBoundsIndex() - 1);
+        }
     } else {
         CC_LOG_WARNING("Try to remove invalid model.");
     }
@@ -367,11 +477,16 @@ void RenderScene::removeModels() {
         if (_octree && _octree->isEnabled()) {
             _octree->remove(model);
         }
+        if (_bvh && _bvh->isEnabled()) {
+            _bvh->remove(model);
+        }
         _lodStateCache->removeModel(model);
         model->detachFromScene();
+        model->setWorldBoundsIndex(WorldBoundsSoA::INVALID_INDEX);
         CC_SAFE_DESTROY(model);
     }
     _models.clear();
+    _worldBoundsSoA.clear();
 }
 void RenderScene::addBatch(DrawBatch2D *drawBatch2D) {
     _batches.emplace_back(drawBatch2D);
@@ -390,10 +505,22 @@ void RenderScene::removeBatches() {
     _batches.clear();
 }
 
+void RenderScene::updateWorldBounds(Model *model) {
+    const auto index = model->getWorldBoundsIndex();
+    if (index < _worldBoundsSoA.size()) {
+        CC_ASSERT(_worldBoundsSoA.getModel(index) == model);
+        _worldBoundsSoA.update(index, model->getWorldBounds());
+    }
+}
+
 void RenderScene::updateOctree(Model *model) {
+    updateWorldBounds(model);
     if (_octree && _octree->isEnabled()) {
         _octree->update(model);
     }
+    if (_bvh && _bvh->isEnabled()) {
+        _bvh->update(model);
+    }
 }
 
 void RenderScene::onGlobalPipelineStateChanged() {
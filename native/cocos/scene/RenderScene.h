@@ -27,9 +27,11 @@
 #include "base/Macros.h"
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
+#include "base/std/container/array.h"
 #include "base/std/container/string.h"
 #include "base/std/container/vector.h"
 #include <cocos/scene/raytracing/RayTracing.h>
+#include "scene/WorldBoundsSoA.h"
 
 namespace cc {
 
@@ -42,6 +44,7 @@ namespace scene {
 class Model;
 class Camera;
 class Octree;
+class BVH;
 class DrawBatch2D;
 class DirectionalLight;
 class LODGroup;
@@ -123,10 +126,22 @@ public:
     inline const ccstd::vector<IntrusivePtr<RangedDirectionalLight>> &getRangedDirLights() const { return _rangedDirLights; }
     inline const ccstd::vector<IntrusivePtr<Model>> &getModels() const { return _models; }
     inline Octree *getOctree() const { return _octree; }
+    inline BVH *getBVH() const { return _bvh; }
     void updateOctree(Model *model);
+    inline const WorldBoundsSoA &getWorldBoundsSoA() const { return _worldBoundsSoA; }
+    void updateWorldBounds(Model *model);
     inline const ccstd::vector<DrawBatch2D *> &getBatches() const { return _batches; }
 
 private:
+    enum class ModelUpdateGroup {
+        DEFAULT,
+        SKINNING,
+        BAKED_SKINNING,
+        COUNT,
+    };
+
+    void updateModels(uint32_t stamp);
+
     ccstd::string _name;
     uint64_t _modelId{0};
     IntrusivePtr<DirectionalLight> _mainLight;
@@ -140,7 +155,12 @@ private:
     ccstd::vector<IntrusivePtr<PointLight>> _pointLights;
     ccstd::vector<IntrusivePtr<RangedDirectionalLight>> _rangedDirLights;
     ccstd::vector<DrawBatch2D *> _batches;
+    WorldBoundsSoA _worldBoundsSoA;
     Octree *_octree{nullptr};
+    BVH *_bvh{nullptr};
+    uint32_t _bvhGeneration{0}; // generation of _bvh the models were inserted in
+    // enabled native models of the current update, grouped by type
+    ccstd::array<ccstd::vector<Model *>, static_cast<size_t>(ModelUpdateGroup::COUNT)> _modelUpdateGroups;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(RenderScene);
 };
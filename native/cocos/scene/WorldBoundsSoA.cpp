@@ -0,0 +1,156 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "scene/WorldBoundsSoA.h"
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "math/MathUtil.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
+
+namespace cc {
+namespace scene {
+
+void WorldBoundsSoA::add(const Model *model) {
+    CC_ASSERT(model);
+    _models.emplace_back(model);
+    for (uint32_t i = 0; i < 3; ++i) {
+        _center[i].emplace_back(0.0F);
+        _halfExtents[i].emplace_back(0.0F);
+    }
+    _hasBounds.emplace_back(0);
+    update(size() - 1, model->getWorldBounds());
+}
+
+void WorldBoundsSoA::remove(uint32_t index) {
+    CC_ASSERT(index < size());
+    // keep the order of RenderScene::getModels()
+    _models.erase(_models.begin() + index);
+    for (uint32_t i = 0; i < 3; ++i) {
+        _center[i].erase(_center[i].begin() + index);
+        _halfExtents[i].erase(_halfExtents[i].begin() + index);
+    }
+    _hasBounds.erase(_hasBounds.begin() + index);
+}
+
+void WorldBoundsSoA::update(uint32_t index, const geometry::AABB *bounds) {
+    CC_ASSERT(index < size());
+    if (!bounds) {
+        _hasBounds[index] = 0;
+        return;
+    }
+    const auto &center = bounds->getCenter();
+    const auto &halfExtents = bounds->getHalfExtents();
+    _center[0][index] = center.x;
+    _center[1][index] = center.y;
+    _center[2][index] = center.z;
+    _halfExtents[0][index] = halfExtents.x;
+    _halfExtents[1][index] = halfExtents.y;
+    _halfExtents[2][index] = halfExtents.z;
+    _hasBounds[index] = 1;
+}
+
+void WorldBoundsSoA::clear() {
+    _models.clear();
+    for (uint32_t i = 0; i < 3; ++i) {
+        _center[i].clear();
+        _halfExtents[i].clear();
+    }
+    _hasBounds.clear();
+}
+
+void WorldBoundsSoA::packPlanes(const geometry::Frustum &frustum, ccstd::array<float, 24> &planes) {
+    for (uint32_t i = 0; i < 6; ++i) {
+        const auto &plane = *frustum.planes[i];
+        planes[i * 4 + 0] = plane.n.x;
+        planes[i * 4 + 1] = plane.n.y;
+        planes[i * 4 + 2] = plane.n.z;
+        planes[i * 4 + 3] = plane.d;
+    }
+}
+
+void WorldBoundsSoA::cullFrustum(const geometry::Frustum &frustum, uint8_t *visible) const {
+    const auto count = size();
+    if (!count) {
+        return;
+    }
+    ccstd::array<float, 24> planes{};
+    packPlanes(frustum, planes);
+
+    const float *const center[3] = {_center[0].data(), _center[1].data(), _center[2].data()};
+    const float *const halfExtents[3] = {_halfExtents[0].data(), _halfExtents[1].data(), _halfExtents[2].data()};
+    MathUtil::aabbFrustumSoA(planes.data(), center, halfExtents, count, visible);
+
+    // models without bounds are never frustum culled
+    for (uint32_t i = 0; i < count; ++i) {
+        visible[i] |= static_cast<uint8_t>(!_hasBounds[i]);
+    }
+}
+
+void WorldBoundsSoA::cullFrustum(const geometry::Frustum &frustum, const Model *const *models, uint32_t count, uint8_t *visible) {
+    if (!count) {
+        return;
+    }
+    // scratch buffers are per thread, octree queries may run in parallel
+    thread_local ccstd::array<ccstd::vector<float>, 6> scratch;
+    for (auto &v : scratch) {
+        v.resize(count);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto *model = models[i];
+        const auto *scene = model->getScene();
+        const auto index = model->getWorldBoundsIndex();
+        if (scene && index < scene->getWorldBoundsSoA().size()) {
+            const auto &soa = scene->getWorldBoundsSoA();
+            CC_ASSERT(soa.getModel(index) == model);
+            for (uint32_t k = 0; k < 3; ++k) {
+                scratch[k][i] = soa._center[k][index];
+                scratch[3 + k][i] = soa._halfExtents[k][index];
+            }
+        } else {
+            // not attached to a scene, read the bounds directly
+            const auto *bounds = model->getWorldBounds();
+            CC_ASSERT(bounds);
+            const auto &center = bounds->getCenter();
+            const auto &halfExtents = bounds->getHalfExtents();
+            scratch[0][i] = center.x;
+            scratch[1][i] = center.y;
+            scratch[2][i] = center.z;
+            scratch[3][i] = halfExtents.x;
+            scratch[4][i] = halfExtents.y;
+            scratch[5][i] = halfExtents.z;
+        }
+    }
+
+    ccstd::array<float, 24> planes{};
+    packPlanes(frustum, planes);
+
+    const float *const center[3] = {scratch[0].data(), scratch[1].data(), scratch[2].data()};
+    const float *const halfExtents[3] = {scratch[3].data(), scratch[4].data(), scratch[5].data()};
+    MathUtil::aabbFrustumSoA(planes.data(), center, halfExtents, count, visible);
+}
+
+} // namespace scene
+} // namespace cc
@@ -0,0 +1,85 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/array.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+namespace geometry {
+class AABB;
+class Frustum;
+} // namespace geometry
+
+namespace scene {
+
+class Model;
+
+/**
+ * @en Structure-of-arrays copy of the world bounds of all models in a RenderScene.
+ * Entries are kept in the same order as RenderScene::getModels(), and are refreshed
+ * whenever a model's world bounds change, so culling can test several AABBs per SIMD instruction.
+ * @zh 场景内所有模型世界包围盒的 SoA 副本，顺序与 RenderScene::getModels() 一致，用于批量视锥剔除。
+ */
+class CC_DLL WorldBoundsSoA final {
+public:
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+    void add(const Model *model);
+    void remove(uint32_t index);
+    void update(uint32_t index, const geometry::AABB *bounds);
+    void clear();
+
+    /**
+     * @en Tests all entries against the frustum, visible[i] is set to 1 if entry i is inside or has no bounds.
+     * @zh 测试所有包围盒，在视锥内或没有包围盒的模型 visible[i] 为 1。
+     */
+    void cullFrustum(const geometry::Frustum &frustum, uint8_t *visible) const;
+
+    /**
+     * @en Tests the world bounds of arbitrary models, gathered from the stores of their scenes.
+     * Used by the octree, whose nodes hold models in spatial rather than scene order.
+     * @zh 测试任意模型的包围盒（从其所在场景的 SoA 中收集），用于八叉树查询。
+     */
+    static void cullFrustum(const geometry::Frustum &frustum, const Model *const *models, uint32_t count, uint8_t *visible);
+
+    static void packPlanes(const geometry::Frustum &frustum, ccstd::array<float, 24> &planes);
+
+    inline uint32_t size() const { return static_cast<uint32_t>(_models.size()); }
+    inline const Model *getModel(uint32_t index) const { return _models[index]; }
+    inline bool hasBounds(uint32_t index) const { return _hasBounds[index] != 0; }
+
+private:
+    ccstd::vector<const Model *> _models;
+    ccstd::array<ccstd::vector<float>, 3> _center;
+    ccstd::array<ccstd::vector<float>, 3> _halfExtents;
+    ccstd::vector<uint8_t> _hasBounds;
+};
+
+} // namespace scene
+} // namespace cc
@@ -0,0 +1,237 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <zlib.h>
+#include <cstdio>
+#include "base/Data.h"
+#include "benchmark/benchmark.h"
+#include "platform/AssetArchive.h"
+#include "platform/FileUtils.h"
+#include "utils.h"
+
+namespace {
+
+// Small JSON-like assets, the shape of what a build ships in bulk.
+struct AssetSet {
+    ccstd::string root;
+    ccstd::vector<ccstd::string> names;
+    ccstd::vector<ccstd::string> contents;
+};
+
+AssetSet createAssetSet(uint32_t count) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    std::uniform_int_distribution<uint32_t> fieldCount{16, 128};
+    std::uniform_int_distribution<uint32_t> value{0, 1000000};
+
+    AssetSet set;
+    set.root = cc::FileUtils::getInstance()->getWritablePath() + "benchmark-assets/";
+    for (uint32_t i = 0; i < count; ++i) {
+        set.names.emplace_back("assets/" + std::to_string(i % 32) + "/" + std::to_string(i) + ".json");
+        ccstd::string content = "{";
+        const uint32_t fields = fieldCount(rng);
+        for (uint32_t f = 0; f < fields; ++f) {
+            content += "\"field" + std::to_string(f) + "\":" + std::to_string(value(rng)) + ",";
+        }
+        content.back() = '}';
+        set.contents.emplace_back(std::move(content));
+    }
+    return set;
+}
+
+void writeLooseFiles(const AssetSet &set) {
+    auto *fileUtils = cc::FileUtils::getInstance();
+    for (size_t i = 0; i < set.names.size(); ++i) {
+        const ccstd::string path = set.root + "loose/" + set.names[i];
+        fileUtils->createDirectory(fileUtils->getFileDir(path));
+        fileUtils->writeStringToFile(set.contents[i], path);
+    }
+}
+
+void writeArchive(const AssetSet &set, bool compress) {
+    cc::AssetArchiveWriter writer;
+    for (size_t i = 0; i < set.names.size(); ++i) {
+        writer.addFile(set.names[i], set.contents[i].data(), static_cast<uint32_t>(set.contents[i].size()), compress);
+    }
+    writer.save(set.root + "assets.ccar");
+}
+
+// Writes a plain deflated zip, the same layout getFileDataFromZip reads from a build.
+void writeZip(const AssetSet &set) {
+    ccstd::vector<uint8_t> local;
+    ccstd::vector<uint8_t> central;
+    auto put = [](ccstd::vector<uint8_t> &out, uint32_t value, uint32_t bytes) {
+        for (uint32_t i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    };
+
+    for (size_t i = 0; i < set.names.size(); ++i) {
+        const auto &name = set.names[i];
+        const auto &content = set.contents[i];
+        const auto *bytes = reinterpret_cast<const Bytef *>(content.data());
+        const auto size = static_cast<uLong>(content.size());
+        uLongf compressedSize = compressBound(size);
+        ccstd::vector<uint8_t> compressed(compressedSize);
+        compress2(compressed.data(), &compressedSize, bytes, size, Z_DEFAULT_COMPRESSION);
+        // Zip entries hold raw deflate, drop the zlib header and adler32 trailer.
+        const uint8_t *deflated = compressed.data() + 2;
+        const auto deflatedSize = static_cast<uint32_t>(compressedSize - 6);
+        const auto crc = static_cast<uint32_t>(crc32(0, bytes, size));
+        const auto offset = static_cast<uint32_t>(local.size());
+
+        put(local, 0x04034b50, 4);
+        put(local, 20, 2);
+        put(local, 0, 2);
+        put(local, 8, 2);
+        put(local, 0, 4);
+        put(local, crc, 4);
+        put(local, deflatedSize, 4);
+        put(local, static_cast<uint32_t>(size), 4);
+        put(local, static_cast<uint32_t>(name.size()), 2);
+        put(local, 0, 2);
+        local.insert(local.end(), name.begin(), name.end());
+        local.insert(local.end(), deflated, deflated + deflatedSize);
+
+        put(central, 0x02014b50, 4);
+        put(central, 20, 2);
+        put(central, 20, 2);
+        put(central, 0, 2);
+        put(central, 8, 2);
+        put(central, 0, 4);
+        put(central, crc, 4);
+        put(central, deflatedSize, 4);
+        put(central, static_cast<uint32_t>(size), 4);
+        put(central, static_cast<uint32_t>(name.size()), 2);
+        put(central, 0, 2);
+        put(central, 0, 2);
+        put(central, 0, 2);
+        put(central, 0, 2);
+        put(central, 0, 4);
+        put(central, offset, 4);
+        central.insert(central.end(), name.begin(), name.end());
+    }
+
+    const auto centralOffset = static_cast<uint32_t>(local.size());
+    const auto centralSize = static_cast<uint32_t>(central.size());
+    local.insert(local.end(), central.begin(), central.end());
+    put(local, 0x06054b50, 4);
+    put(local, 0, 2);
+    put(local, 0, 2);
+    put(local, static_cast<uint32_t>(set.names.size()), 2);
+    put(local, static_cast<uint32_t>(set.names.size()), 2);
+    put(local, centralSize, 4);
+    put(local, centralOffset, 4);
+    put(local, 0, 2);
+
+    cc::Data data;
+    data.fastSet(local.data(), static_cast<uint32_t>(local.size()));
+    cc::FileUtils::getInstance()->writeDataToFile(data, set.root + "assets.zip");
+    data.takeBuffer();
+}
+
+void assetLooseFiles(benchmark::State &state) {
+    auto *fileUtils = cc::FileUtils::getInstance();
+    const AssetSet set = createAssetSet(static_cast<uint32_t>(state.range(0)));
+    writeLooseFiles(set);
+    const auto searchPaths = fileUtils->getOriginalSearchPaths();
+    fileUtils->addSearchPath(set.root + "loose/", true);
+    for (auto _ : state) {
+        for (const auto &name : set.names) {
+            benchmark::DoNotOptimize(fileUtils->getDataFromFile(name));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(set.names.size()));
+    fileUtils->setSearchPaths(searchPaths);
+    fileUtils->removeDirectory(set.root);
+}
+
+void assetZip(benchmark::State &state) {
+    auto *fileUtils = cc::FileUtils::getInstance();
+    const AssetSet set = createAssetSet(static_cast<uint32_t>(state.range(0)));
+    fileUtils->createDirectory(set.root);
+    writeZip(set);
+    const ccstd::string zipPath = set.root + "assets.zip";
+    for (auto _ : state) {
+        for (const auto &name : set.names) {
+            uint32_t size = 0;
+            unsigned char *bytes = fileUtils->getFileDataFromZip(zipPath, name, &size);
+            benchmark::DoNotOptimize(bytes);
+            free(bytes);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(set.names.size()));
+    fileUtils->removeDirectory(set.root);
+}
+
+void assetArchive(benchmark::State &state) {
+    auto *fileUtils = cc::FileUtils::getInstance();
+    const bool compress = state.range(1) != 0;
+    const AssetSet set = createAssetSet(static_cast<uint32_t>(state.range(0)));
+    fileUtils->createDirectory(set.root);
+    writeArchive(set, compress);
+    const ccstd::string archivePath = set.root + "assets.ccar";
+    if (!fileUtils->addSearchArchive(archivePath, true)) {
+        state.SkipWithError("failed to mount the archive");
+        return;
+    }
+    for (auto _ : state) {
+        for (const auto &name : set.names) {
+            benchmark::DoNotOptimize(fileUtils->getDataFromFile(name));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(set.names.size()));
+    fileUtils->removeSearchArchive(archivePath);
+    fileUtils->removeDirectory(set.root);
+}
+
+// Stored entries read without a copy, the best case for assets consumed in place.
+void assetArchiveMapped(benchmark::State &state) {
+    auto *fileUtils = cc::FileUtils::getInstance();
+    const AssetSet set = createAssetSet(static_cast<uint32_t>(state.range(0)));
+    fileUtils->createDirectory(set.root);
+    writeArchive(set, false);
+    const ccstd::string archivePath = set.root + "assets.ccar";
+    if (!fileUtils->addSearchArchive(archivePath, true)) {
+        state.SkipWithError("failed to mount the archive");
+        return;
+    }
+    for (auto _ : state) {
+        for (const auto &name : set.names) {
+            const uint8_t *data = nullptr;
+            size_t size = 0;
+            fileUtils->getMappedContents(name, &data, &size);
+            benchmark::DoNotOptimize(data);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(set.names.size()));
+    fileUtils->removeSearchArchive(archivePath);
+    fileUtils->removeDirectory(set.root);
+}
+
+} // namespace
+
+BENCHMARK(assetLooseFiles)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(assetZip)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(assetArchive)->ArgsProduct({{1000, 10000}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK(assetArchiveMapped)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
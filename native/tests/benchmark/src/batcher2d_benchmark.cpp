@@ -0,0 +1,60 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "2d/renderer/Batcher2d.h"
+#include "benchmark/benchmark.h"
+#include "core/scene-graph/Scene.h"
+#include "utils.h"
+
+// Render entities and their draw infos are created and synced by the JS side, so this measures
+// the traversal of a UI tree by Batcher2d::walk, opacity propagation included.
+
+namespace {
+
+void batcher2dWalk(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    cc::IntrusivePtr<cc::Scene> scene = ccnew cc::Scene("benchmark");
+    const auto nodes = bench::createNodeTree(static_cast<uint32_t>(state.range(0)), 8, rng);
+    scene->addChild(nodes[0]);
+    scene->load();
+    for (const auto &node : nodes) {
+        node->setActiveInHierarchy(true);
+    }
+
+    cc::Batcher2d batcher;
+    batcher.initialize();
+    for (auto _ : state) {
+        // a colour change at the root is propagated to the whole tree
+        nodes[0]->_setColorDirty(true);
+        batcher.syncRootNodesToNative({nodes[0]});
+        batcher.update();
+        batcher.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    scene->removeAllChildren();
+}
+
+} // namespace
+
+BENCHMARK(batcher2dWalk)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,168 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "benchmark/benchmark.h"
+#include "core/Root.h"
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "math/Math.h"
+#include "scene/BVH.h"
+#include "scene/Camera.h"
+#include "scene/Model.h"
+#include "scene/Octree.h"
+#include "utils.h"
+
+namespace {
+
+// wider than the default octree bounds on purpose, the BVH has no fixed world box
+constexpr float SCENE_EXTENT = 4000.F;
+constexpr float MOVE_DISTANCE = 2.F;
+constexpr uint32_t MOVING_RATIO = 4; // one model in four moves every frame
+
+void initBVH(cc::scene::BVH &bvh) {
+    cc::scene::BVHInfo info;
+    info.setEnabled(true);
+    bvh.initialize(info);
+}
+
+void moveModels(const ccstd::vector<cc::IntrusivePtr<cc::scene::Model>> &models, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> offset{-MOVE_DISTANCE, MOVE_DISTANCE};
+    for (uint32_t i = 0; i < models.size(); i += MOVING_RATIO) {
+        auto *bounds = models[i]->getWorldBounds();
+        bounds->setCenter(bounds->getCenter() + cc::Vec3{offset(rng), offset(rng), offset(rng)});
+    }
+}
+
+void bvhBuild(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto models = bench::createModels(static_cast<uint32_t>(state.range(0)), SCENE_EXTENT, rng);
+    for (auto _ : state) {
+        cc::scene::BVH bvh;
+        initBVH(bvh);
+        for (const auto &model : models) {
+            bvh.insert(model);
+        }
+        bvh.commit();
+        state.PauseTiming();
+        for (const auto &model : models) {
+            bvh.remove(model);
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bvhQuery(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto models = bench::createModels(static_cast<uint32_t>(state.range(0)), SCENE_EXTENT, rng);
+    cc::scene::BVH bvh;
+    initBVH(bvh);
+    for (const auto &model : models) {
+        // disabled models are skipped before their bounds are tested
+        model->setEnabled(true);
+        bvh.insert(model);
+    }
+    bvh.commit();
+
+    cc::IntrusivePtr<cc::scene::Camera> camera = ccnew cc::scene::Camera(cc::Root::getInstance()->getDevice());
+    cc::geometry::Frustum frustum;
+    frustum.setAccurate(true);
+    cc::geometry::Frustum::createPerspective(&frustum, cc::math::PI / 3.F, 16.F / 9.F, 1.F, SCENE_EXTENT, cc::Mat4::IDENTITY);
+
+    ccstd::vector<const cc::scene::Model *> results;
+    for (auto _ : state) {
+        results.clear();
+        bvh.queryVisibility(camera, frustum, false, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.counters["visible"] = static_cast<double>(results.size());
+    state.counters["nodes"] = static_cast<double>(bvh.getNodeCount());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    for (const auto &model : models) {
+        bvh.remove(model);
+    }
+}
+
+// a frame of moving models: refit in the BVH against reinsertion in the octree
+void bvhMove(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto models = bench::createModels(static_cast<uint32_t>(state.range(0)), SCENE_EXTENT, rng);
+    cc::scene::BVH bvh;
+    initBVH(bvh);
+    for (const auto &model : models) {
+        bvh.insert(model);
+    }
+    bvh.commit();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        moveModels(models, rng);
+        state.ResumeTiming();
+        for (uint32_t i = 0; i < models.size(); i += MOVING_RATIO) {
+            bvh.update(models[i]);
+        }
+        bvh.commit();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) / MOVING_RATIO);
+
+    for (const auto &model : models) {
+        bvh.remove(model);
+    }
+}
+
+void octreeMove(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto models = bench::createModels(static_cast<uint32_t>(state.range(0)), SCENE_EXTENT, rng);
+    cc::scene::OctreeInfo info;
+    info.setEnabled(true);
+    info.setMinPos(cc::Vec3{-SCENE_EXTENT, -SCENE_EXTENT, -SCENE_EXTENT});
+    info.setMaxPos(cc::Vec3{SCENE_EXTENT, SCENE_EXTENT, SCENE_EXTENT});
+    cc::scene::Octree octree;
+    octree.initialize(info);
+    for (const auto &model : models) {
+        octree.insert(model);
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        moveModels(models, rng);
+        state.ResumeTiming();
+        for (uint32_t i = 0; i < models.size(); i += MOVING_RATIO) {
+            octree.update(models[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) / MOVING_RATIO);
+
+    for (const auto &model : models) {
+        octree.remove(model);
+    }
+}
+
+} // namespace
+
+BENCHMARK(bvhBuild)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bvhQuery)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bvhMove)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(octreeMove)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
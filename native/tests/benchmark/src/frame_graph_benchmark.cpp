@@ -0,0 +1,102 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "benchmark/benchmark.h"
+#include "renderer/frame-graph/FrameGraph.h"
+#include "renderer/gfx-base/GFXDevice.h"
+
+namespace {
+
+using cc::framegraph::FrameGraph;
+using cc::framegraph::PassNodeBuilder;
+using cc::framegraph::RenderTargetAttachment;
+using cc::framegraph::TextureHandle;
+
+constexpr uint32_t WIDTH = 1920;
+constexpr uint32_t HEIGHT = 1080;
+
+struct PassData {
+    TextureHandle input;
+    TextureHandle output;
+};
+
+// A chain of full screen passes like a post-process stack. Every fourth pass renders into a
+// texture nobody reads, so culling has something to remove.
+TextureHandle addPasses(FrameGraph &graph, uint32_t passCount) {
+    static const cc::framegraph::StringHandle COLOR_NAME = FrameGraph::stringToHandle("benchmarkColor");
+    static const cc::framegraph::StringHandle UNUSED_NAME = FrameGraph::stringToHandle("benchmarkUnused");
+    static const cc::framegraph::StringHandle PASS_NAME = FrameGraph::stringToHandle("benchmarkPass");
+
+    cc::gfx::TextureInfo colorInfo;
+    colorInfo.usage = cc::gfx::TextureUsageBit::COLOR_ATTACHMENT | cc::gfx::TextureUsageBit::SAMPLED;
+    colorInfo.format = cc::gfx::Format::RGBA8;
+    colorInfo.width = WIDTH;
+    colorInfo.height = HEIGHT;
+
+    RenderTargetAttachment::Descriptor attachment;
+    attachment.usage = RenderTargetAttachment::Usage::COLOR;
+    attachment.loadOp = cc::gfx::LoadOp::CLEAR;
+    attachment.endAccesses = cc::gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE;
+
+    TextureHandle color;
+    for (uint32_t i = 0; i < passCount; ++i) {
+        const bool unused = i % 4 == 3;
+        auto setup = [&](PassNodeBuilder &builder, PassData &data) {
+            if (color.isValid()) {
+                data.input = builder.read(color);
+            }
+            data.output = builder.create(unused ? UNUSED_NAME : COLOR_NAME, colorInfo);
+            data.output = builder.write(data.output, attachment);
+            if (!unused) {
+                color = data.output;
+            }
+        };
+        auto execute = [](const PassData & /*data*/, const cc::framegraph::DevicePassResourceTable & /*table*/) {};
+        graph.addPass<PassData>(static_cast<cc::framegraph::PassInsertPoint>(i), PASS_NAME, setup, execute);
+    }
+    return color;
+}
+
+void frameGraphCompile(benchmark::State &state) {
+    auto *device = cc::gfx::Device::getInstance();
+    cc::gfx::TextureInfo backBufferInfo;
+    backBufferInfo.usage = cc::gfx::TextureUsageBit::COLOR_ATTACHMENT;
+    backBufferInfo.format = cc::gfx::Format::RGBA8;
+    backBufferInfo.width = WIDTH;
+    backBufferInfo.height = HEIGHT;
+    cc::IntrusivePtr<cc::gfx::Texture> backBuffer = device->createTexture(backBufferInfo);
+
+    const auto passCount = static_cast<uint32_t>(state.range(0));
+    FrameGraph graph;
+    for (auto _ : state) {
+        graph.present(addPasses(graph, passCount), backBuffer, false);
+        graph.compile();
+        graph.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * passCount);
+}
+
+} // namespace
+
+BENCHMARK(frameGraphCompile)->Arg(8)->Arg(32)->Arg(128)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,101 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/job-system/JobSystem.h"
+#include "base/memory/Memory.h"
+#include "base/std/container/vector.h"
+#include "base/threading/MessageQueue.h"
+#include "benchmark/benchmark.h"
+#include "renderer/gfx-agent/DeviceAgent.h"
+#include "renderer/gfx-base/GFXCommandBuffer.h"
+#include "renderer/gfx-base/GFXDevice.h"
+
+namespace {
+
+constexpr uint32_t COMMANDS_PER_STREAM = 4096;
+
+void recordStream(cc::gfx::CommandBuffer *cmdBuff, uint32_t seed) {
+    cmdBuff->begin();
+    for (uint32_t i = 0; i < COMMANDS_PER_STREAM; ++i) {
+        const auto offset = static_cast<int32_t>((seed + i) & 0xFF);
+        cmdBuff->setViewport({offset, offset, 256, 256, 0.F, 1.F});
+        cmdBuff->setScissor({offset, offset, 256, 256});
+        cmdBuff->setBlendConstants({1.F, 1.F, 1.F, 1.F});
+    }
+    cmdBuff->end();
+}
+
+// Every stream is recorded into its own secondary command buffer, either in turn on the
+// benchmark thread or in parallel on the job system, then executed by the device primary
+// command buffer and replayed on the device thread.
+void gfxAgentRecordSecondaries(benchmark::State &state) {
+    auto *agent = cc::gfx::DeviceAgent::getInstance();
+    if (!agent) {
+        state.SkipWithError("gfx agent is not enabled");
+        return;
+    }
+    const auto streamCount = static_cast<uint32_t>(state.range(0));
+    const bool parallel = state.range(1) != 0;
+
+    auto *device = cc::gfx::Device::getInstance();
+    auto *queue = device->getQueue();
+    auto *primary = device->getCommandBuffer();
+    ccstd::vector<cc::gfx::CommandBuffer *> secondaries(streamCount);
+    for (auto &secondary : secondaries) {
+        secondary = device->createCommandBuffer({queue, cc::gfx::CommandBufferType::SECONDARY});
+    }
+
+    for (auto _ : state) {
+        if (parallel) {
+            cc::parallelForEachIndex(streamCount, [&](uint32_t i) {
+                recordStream(secondaries[i], i);
+            });
+        } else {
+            for (uint32_t i = 0; i < streamCount; ++i) {
+                recordStream(secondaries[i], i);
+            }
+        }
+
+        primary->begin();
+        primary->execute(secondaries.data(), streamCount);
+        primary->end();
+        device->flushCommands(&primary, 1);
+        queue->submit(&primary, 1);
+        agent->getMessageQueue()->kickAndWait();
+    }
+
+    for (auto *secondary : secondaries) {
+        CC_SAFE_DESTROY_AND_DELETE(secondary);
+    }
+
+    state.SetItemsProcessed(state.iterations() * streamCount * COMMANDS_PER_STREAM * 3);
+}
+
+} // namespace
+
+BENCHMARK(gfxAgentRecordSecondaries)
+    ->ArgNames({"streams", "parallel"})
+    ->ArgsProduct({{1, 4, 8}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
@@ -0,0 +1,211 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/Macros.h"
+
+#if CC_PLATFORM == CC_PLATFORM_LINUX || CC_PLATFORM == CC_PLATFORM_MACOS
+
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    #include <atomic>
+    #include <chrono>
+    #include <mutex>
+    #include <thread>
+    #include "base/memory/Memory.h"
+    #include "base/Scheduler.h"
+    #include "base/std/container/string.h"
+    #include "base/std/container/vector.h"
+    #include "benchmark/benchmark.h"
+    #include "network/HttpClient.h"
+
+namespace {
+
+    #ifdef __APPLE__
+constexpr int SEND_FLAGS = 0; // SIGPIPE is disabled per socket with SO_NOSIGPIPE
+    #else
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+    #endif
+
+// A keep-alive HTTP/1.1 server on a loopback port, it answers every request after `delay`.
+class LocalHttpServer {
+public:
+    explicit LocalHttpServer(std::chrono::microseconds delay) : _delay(delay) {
+        _listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addrLen = sizeof(addr);
+        bind(_listenFd, reinterpret_cast<sockaddr *>(&addr), addrLen);
+        listen(_listenFd, 128);
+        getsockname(_listenFd, reinterpret_cast<sockaddr *>(&addr), &addrLen);
+        _port = ntohs(addr.sin_port);
+        _acceptThread = std::thread([this] { acceptLoop(); });
+    }
+
+    ~LocalHttpServer() {
+        _stopped = true;
+        shutdown(_listenFd, SHUT_RDWR);
+        _acceptThread.join();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (int fd : _connectionFds) {
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+        for (auto &thread : _connectionThreads) {
+            thread.join();
+        }
+        close(_listenFd);
+    }
+
+    uint16_t getPort() const { return _port; }
+    uint32_t getConnectionCount() const { return _accepted; }
+    uint32_t getMaxOpenConnections() const { return _maxOpen; }
+
+private:
+    void acceptLoop() {
+        while (!_stopped) {
+            const int fd = accept(_listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                break;
+            }
+    #ifdef __APPLE__
+            int noSigPipe = 1;
+            setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+    #endif
+            ++_accepted;
+            const uint32_t open = ++_open;
+            uint32_t maxOpen = _maxOpen;
+            while (open > maxOpen && !_maxOpen.compare_exchange_weak(maxOpen, open)) {
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            _connectionFds.push_back(fd);
+            _connectionThreads.emplace_back([this, fd] { serve(fd); });
+        }
+    }
+
+    void serve(int fd) {
+        static const ccstd::string RESPONSE = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 11\r\n\r\n{\"ok\":true}";
+        ccstd::string buffer;
+        char chunk[4096];
+        const auto receive = [&]() {
+            const auto n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n > 0) {
+                buffer.append(chunk, n);
+            }
+            return n > 0;
+        };
+        while (true) {
+            size_t headerEnd = ccstd::string::npos;
+            while ((headerEnd = buffer.find("\r\n\r\n")) == ccstd::string::npos) {
+                if (!receive()) {
+                    --_open;
+                    return;
+                }
+            }
+            size_t contentLength = 0;
+            const size_t lengthPos = buffer.find("Content-Length: ");
+            if (lengthPos < headerEnd) {
+                contentLength = std::stoul(buffer.substr(lengthPos + 16));
+            }
+            const size_t requestEnd = headerEnd + 4 + contentLength;
+            while (buffer.size() < requestEnd) {
+                if (!receive()) {
+                    --_open;
+                    return;
+                }
+            }
+            buffer.erase(0, requestEnd);
+            std::this_thread::sleep_for(_delay);
+            send(fd, RESPONSE.data(), RESPONSE.size(), SEND_FLAGS);
+        }
+    }
+
+    std::chrono::microseconds _delay;
+    int _listenFd{-1};
+    uint16_t _port{0};
+    std::atomic<bool> _stopped{false};
+    std::atomic<uint32_t> _accepted{0};
+    std::atomic<uint32_t> _open{0};
+    std::atomic<uint32_t> _maxOpen{0};
+    std::thread _acceptThread;
+    std::mutex _mutex;
+    ccstd::vector<int> _connectionFds;
+    ccstd::vector<std::thread> _connectionThreads;
+};
+
+// Sends bursts of GET requests, like the REST calls a game makes at login, to a server taking 2ms per request.
+// Range 0 is the burst size, range 1 the per host connection limit (0 for no limit).
+void httpClientBurst(benchmark::State &state) {
+    using Clock = std::chrono::steady_clock;
+    const auto burst = static_cast<uint32_t>(state.range(0));
+
+    LocalHttpServer server{std::chrono::milliseconds(2)};
+    auto scheduler = std::make_shared<cc::Scheduler>();
+    auto *client = cc::network::HttpClient::getInstance();
+    client->setScheduler(scheduler);
+    client->setMaxConnectionsPerHost(static_cast<uint32_t>(state.range(1)));
+
+    const ccstd::string url = "http://127.0.0.1:" + std::to_string(server.getPort()) + "/api";
+    uint32_t failed = 0;
+    double latency = 0;
+    for (auto _ : state) {
+        uint32_t done = 0;
+        for (uint32_t i = 0; i < burst; ++i) {
+            auto *request = ccnew cc::network::HttpRequest();
+            request->setUrl(url);
+            request->setRequestType(cc::network::HttpRequest::Type::GET);
+            const auto start = Clock::now();
+            request->setResponseCallback([&, start](cc::network::HttpClient * /*client*/, cc::network::HttpResponse *response) {
+                ++done;
+                failed += response->isSucceed() ? 0 : 1;
+                latency += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            });
+            client->send(request);
+        }
+        while (done < burst) {
+            scheduler->update(0.F);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    cc::network::HttpClient::destroyInstance();
+
+    if (failed > 0) {
+        state.SkipWithError("some requests failed");
+        return;
+    }
+    const auto requests = static_cast<double>(state.iterations() * burst);
+    state.counters["latencyMs"] = latency / requests;
+    state.counters["connections"] = benchmark::Counter(server.getConnectionCount(), benchmark::Counter::kAvgIterations);
+    state.counters["maxOpenConnections"] = server.getMaxOpenConnections();
+    state.SetItemsProcessed(static_cast<int64_t>(requests));
+}
+
+} // namespace
+
+BENCHMARK(httpClientBurst)->Args({50, 1})->Args({50, 6})->Args({50, 0})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+#endif
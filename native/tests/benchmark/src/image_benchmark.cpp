@@ -0,0 +1,81 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include "base/Data.h"
+#include "benchmark/benchmark.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+#include "utils.h"
+
+namespace {
+
+// Encodes a size x size RGBA picture with the encoder matching the extension. The picture is a
+// gradient with some noise, so it neither compresses trivially nor is pure noise.
+cc::Data encodeImage(uint32_t size, const char *extension) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    std::uniform_int_distribution<int> noise{-8, 8};
+    ccstd::vector<uint8_t> pixels(size * size * 4);
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            uint8_t *pixel = &pixels[(y * size + x) * 4];
+            pixel[0] = static_cast<uint8_t>(std::clamp(static_cast<int>(x * 255 / size) + noise(rng), 0, 255));
+            pixel[1] = static_cast<uint8_t>(std::clamp(static_cast<int>(y * 255 / size) + noise(rng), 0, 255));
+            pixel[2] = static_cast<uint8_t>((x ^ y) & 0xFF);
+            pixel[3] = 255;
+        }
+    }
+
+    cc::IntrusivePtr<cc::Image> image = ccnew cc::Image();
+    image->initWithRawData(pixels.data(), static_cast<uint32_t>(pixels.size()), static_cast<int>(size), static_cast<int>(size), 8);
+    auto *fileUtils = cc::FileUtils::getInstance();
+    const ccstd::string path = fileUtils->getWritablePath() + "benchmark-image" + extension;
+    image->saveToFile(path, false);
+    cc::Data data = fileUtils->getDataFromFile(path);
+    fileUtils->removeFile(path);
+    return data;
+}
+
+void imageDecode(benchmark::State &state, const char *extension) {
+    const auto size = static_cast<uint32_t>(state.range(0));
+    const cc::Data data = encodeImage(size, extension);
+    if (data.isNull()) {
+        state.SkipWithError("failed to encode the source image");
+        return;
+    }
+    for (auto _ : state) {
+        cc::IntrusivePtr<cc::Image> image = ccnew cc::Image();
+        if (!image->initWithImageData(data.getBytes(), data.getSize())) {
+            state.SkipWithError("failed to decode the image");
+            break;
+        }
+        benchmark::DoNotOptimize(image->getData());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(imageDecode, png, ".png")->Arg(256)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(imageDecode, jpg, ".jpg")->Arg(256)->Arg(1024)->Unit(benchmark::kMicrosecond);
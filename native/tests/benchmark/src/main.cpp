@@ -0,0 +1,59 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "benchmark/benchmark.h"
+#include "bindings/jswrapper/SeApi.h"
+#include "core/Root.h"
+#include "platform/FileUtils.h"
+#include "renderer/GFXDeviceManager.h"
+
+// Fix linking error of undefined symbol cocos_main
+int cocos_main(int argc, const char **argv) {
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    // The benchmark target is built without any real gfx backend, so this is an EmptyDevice.
+    auto *root = new cc::Root(cc::gfx::DeviceManager::create());
+    // No Engine is created here, so create the FileUtils it would own.
+    auto *fileUtils = cc::createFileUtils();
+    auto *scriptEngine = new se::ScriptEngine();
+    scriptEngine->start();
+    {
+        se::AutoHandleScope hs;
+        ::benchmark::AddCustomContext("gfx", cc::gfx::DeviceManager::getGFXName());
+        ::benchmark::RunSpecifiedBenchmarks();
+        ::benchmark::Shutdown();
+    }
+    scriptEngine->cleanup();
+    delete root;
+    delete scriptEngine;
+    delete fileUtils;
+    return 0;
+}
@@ -0,0 +1,161 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "benchmark/benchmark.h"
+#include "core/geometry/AABB.h"
+#include "math/Mat4.h"
+#include "math/MathUtil.h"
+#include "math/Quaternion.h"
+#include "math/Vec3.h"
+#include "utils.h"
+
+namespace {
+
+// Every kernel runs over an array of inputs, so the numbers include the memory traffic
+// of a realistic batch rather than a single value sitting in registers.
+constexpr uint32_t BATCH_SIZE = 1024;
+
+ccstd::vector<cc::Mat4> createMatrices(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> value{-10.F, 10.F};
+    ccstd::vector<cc::Mat4> matrices(BATCH_SIZE);
+    for (auto &matrix : matrices) {
+        const cc::Quaternion rotation{cc::Vec3{value(rng), value(rng), value(rng)}.getNormalized(), value(rng)};
+        cc::Mat4::fromRTS(rotation, cc::Vec3{value(rng), value(rng), value(rng)}, cc::Vec3{1.F, 2.F, 3.F}, &matrix);
+    }
+    return matrices;
+}
+
+void mathMat4Multiply(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto lhs = createMatrices(rng);
+    const auto rhs = createMatrices(rng);
+    ccstd::vector<cc::Mat4> out(BATCH_SIZE);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+            cc::Mat4::multiply(lhs[i], rhs[i], &out[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+void mathMat4Inverse(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto matrices = createMatrices(rng);
+    ccstd::vector<cc::Mat4> out(BATCH_SIZE);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+            out[i] = matrices[i].getInversed();
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+void mathMat4FromRTS(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto matrices = createMatrices(rng);
+    ccstd::vector<cc::Quaternion> rotations(BATCH_SIZE);
+    ccstd::vector<cc::Vec3> translations(BATCH_SIZE);
+    ccstd::vector<cc::Vec3> scales(BATCH_SIZE);
+    for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+        cc::Mat4::toRTS(matrices[i], &rotations[i], &translations[i], &scales[i]);
+    }
+    ccstd::vector<cc::Mat4> out(BATCH_SIZE);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+            cc::Mat4::fromRTS(rotations[i], translations[i], scales[i], &out[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+void mathMat4ToRTS(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto matrices = createMatrices(rng);
+    ccstd::vector<cc::Quaternion> rotations(BATCH_SIZE);
+    ccstd::vector<cc::Vec3> translations(BATCH_SIZE);
+    ccstd::vector<cc::Vec3> scales(BATCH_SIZE);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+            cc::Mat4::toRTS(matrices[i], &rotations[i], &translations[i], &scales[i]);
+        }
+        benchmark::DoNotOptimize(rotations.data());
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+// Skinning: joint world matrix times bind pose, written out in the packed 4x3 texture layout.
+void mathMultiplyJointMatrix(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto lhs = createMatrices(rng);
+    const auto rhs = createMatrices(rng);
+    ccstd::vector<float> out(BATCH_SIZE * 12);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+            cc::MathUtil::multiplyJointMatrix(lhs[i].m, rhs[i].m, &out[i * 12]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+void mathVec3TransformMat4(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto matrices = createMatrices(rng);
+    ccstd::vector<cc::Vec3> points(BATCH_SIZE, cc::Vec3{1.F, 2.F, 3.F});
+    ccstd::vector<cc::Vec3> out(BATCH_SIZE);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+            out[i].transformMat4(points[i], matrices[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+void mathAABBTransform(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto matrices = createMatrices(rng);
+    const cc::geometry::AABB bounds{0.F, 0.F, 0.F, 0.5F, 1.F, 2.F};
+    ccstd::vector<cc::geometry::AABB> out(BATCH_SIZE);
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < BATCH_SIZE; ++i) {
+            bounds.transform(matrices[i], &out[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+} // namespace
+
+BENCHMARK(mathMat4Multiply);
+BENCHMARK(mathMat4Inverse);
+BENCHMARK(mathMat4FromRTS);
+BENCHMARK(mathMat4ToRTS);
+BENCHMARK(mathMultiplyJointMatrix);
+BENCHMARK(mathVec3TransformMat4);
+BENCHMARK(mathAABBTransform);
@@ -0,0 +1,73 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "3d/assets/Mesh.h"
+#include "3d/misc/CreateMesh.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "benchmark/benchmark.h"
+#include "primitive/Sphere.h"
+
+namespace {
+
+cc::Mesh::ICreateInfo createSphereInfo(uint32_t segments) {
+    cc::ISphereOptions options;
+    options.segments = segments;
+    return cc::MeshUtils::createMeshInfo(cc::sphere(0.5F, options));
+}
+
+// Parses the mesh struct and creates the rendering sub meshes and their buffers.
+void meshInitialize(benchmark::State &state) {
+    const auto info = createSphereInfo(static_cast<uint32_t>(state.range(0)));
+    for (auto _ : state) {
+        cc::IntrusivePtr<cc::Mesh> mesh = ccnew cc::Mesh();
+        auto copy = info;
+        mesh->reset(std::move(copy));
+        mesh->initialize();
+        benchmark::DoNotOptimize(mesh->getRenderingSubMeshes().data());
+        mesh->destroy();
+    }
+    state.SetBytesProcessed(state.iterations() * info.data.byteLength());
+}
+
+// Reads the vertex attributes and indices back out of the interleaved mesh data.
+void meshReadAttributes(benchmark::State &state) {
+    auto info = createSphereInfo(static_cast<uint32_t>(state.range(0)));
+    const uint32_t byteLength = info.data.byteLength();
+    cc::IntrusivePtr<cc::Mesh> mesh = ccnew cc::Mesh();
+    mesh->reset(std::move(info));
+    mesh->initialize();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mesh->readAttribute(0, cc::gfx::ATTR_NAME_POSITION));
+        benchmark::DoNotOptimize(mesh->readAttribute(0, cc::gfx::ATTR_NAME_NORMAL));
+        benchmark::DoNotOptimize(mesh->readAttribute(0, cc::gfx::ATTR_NAME_TEX_COORD));
+        benchmark::DoNotOptimize(mesh->readIndices(0));
+    }
+    state.SetBytesProcessed(state.iterations() * byteLength);
+    mesh->destroy();
+}
+
+} // namespace
+
+BENCHMARK(meshInitialize)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+BENCHMARK(meshReadAttributes)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
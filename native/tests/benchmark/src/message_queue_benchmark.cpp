@@ -0,0 +1,73 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/std/container/vector.h"
+#include "base/threading/MessageQueue.h"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+using cc::Message;
+
+constexpr uint32_t MESSAGES_PER_FRAME = 10000;
+
+// Messages are recorded on the benchmark thread and executed on the consumer thread,
+// the way the gfx agents use the queue. Every frame is kicked and waited for.
+void messageQueueThroughput(benchmark::State &state) {
+    const auto payloadSize = static_cast<uint32_t>(state.range(0));
+    ccstd::vector<uint8_t> payload(payloadSize, 0xA5);
+
+    auto *queue = ccnew cc::MessageQueue;
+    queue->setImmediateMode(false);
+    queue->runConsumerThread();
+
+    uint64_t checksum = 0;
+    uint64_t *sum = &checksum;
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < MESSAGES_PER_FRAME; ++i) {
+            uint8_t *data = payloadSize ? queue->allocateAndCopy<uint8_t>(payloadSize, payload.data()) : nullptr;
+            ENQUEUE_MESSAGE_3(
+                queue, BenchmarkMessage,
+                sum, sum,
+                data, data,
+                size, payloadSize,
+                {
+                    *sum += size ? data[size - 1] : 1;
+                });
+        }
+        cc::MessageQueue::freeChunksInFreeQueue(queue);
+        queue->kickAndWait();
+    }
+    benchmark::DoNotOptimize(checksum);
+
+    queue->terminateConsumerThread();
+    delete queue;
+
+    state.SetItemsProcessed(state.iterations() * MESSAGES_PER_FRAME);
+    state.SetBytesProcessed(state.iterations() * MESSAGES_PER_FRAME * payloadSize);
+}
+
+} // namespace
+
+BENCHMARK(messageQueueThroughput)->Arg(0)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond)->UseRealTime();
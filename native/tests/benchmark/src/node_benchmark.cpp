@@ -0,0 +1,86 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "benchmark/benchmark.h"
+#include "core/scene-graph/TransformHierarchy.h"
+#include "utils.h"
+
+namespace {
+
+// Dirties the whole tree through the root, or every `stride`-th node when stride > 1.
+void dirtyNodes(const ccstd::vector<cc::IntrusivePtr<cc::Node>> &nodes, uint32_t stride, float angle) {
+    if (stride <= 1) {
+        nodes[0]->setRotationFromEuler(0.F, angle, 0.F);
+        return;
+    }
+    for (size_t i = 0; i < nodes.size(); i += stride) {
+        nodes[i]->setPosition(angle, 0.F, 0.F);
+    }
+}
+
+// Every node pulls its own world transform, which is what models and UI do every frame.
+void nodeUpdateWorldTransform(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto nodes = bench::createNodeTree(static_cast<uint32_t>(state.range(0)), static_cast<uint32_t>(state.range(1)), rng);
+    const auto stride = static_cast<uint32_t>(state.range(2));
+    float angle = 0.F;
+    for (auto _ : state) {
+        dirtyNodes(nodes, stride, angle += 1.F);
+        for (const auto &node : nodes) {
+            node->updateWorldTransform();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(nodes.size()));
+}
+
+void nodeTransformHierarchyUpdate(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto nodes = bench::createNodeTree(static_cast<uint32_t>(state.range(0)), static_cast<uint32_t>(state.range(1)), rng);
+    const auto stride = static_cast<uint32_t>(state.range(2));
+    cc::TransformHierarchy hierarchy{nodes[0]};
+    float angle = 0.F;
+    for (auto _ : state) {
+        dirtyNodes(nodes, stride, angle += 1.F);
+        hierarchy.update();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(nodes.size()));
+}
+
+// {node count, branching factor, dirty stride}
+void transformArgs(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"nodes", "branching", "dirtyStride"});
+    for (const int64_t count : {10000, 100000}) {
+        for (const int64_t branching : {2, 8}) {
+            for (const int64_t stride : {1, 64}) {
+                b->Args({count, branching, stride});
+            }
+        }
+    }
+    b->Unit(benchmark::kMicrosecond);
+}
+
+} // namespace
+
+BENCHMARK(nodeUpdateWorldTransform)->Apply(transformArgs);
+BENCHMARK(nodeTransformHierarchyUpdate)->Apply(transformArgs);
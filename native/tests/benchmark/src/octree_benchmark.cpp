@@ -0,0 +1,132 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "benchmark/benchmark.h"
+#include "core/Root.h"
+#include "core/geometry/Frustum.h"
+#include "math/Math.h"
+#include "scene/Camera.h"
+#include "scene/Octree.h"
+#include "utils.h"
+
+namespace {
+
+constexpr float SCENE_EXTENT = 500.F;
+constexpr uint32_t OCTREE_DEPTH = 8;
+
+void initOctree(cc::scene::Octree &octree) {
+    cc::scene::OctreeInfo info;
+    info.setEnabled(true);
+    info.setMinPos(cc::Vec3{-SCENE_EXTENT, -SCENE_EXTENT, -SCENE_EXTENT});
+    info.setMaxPos(cc::Vec3{SCENE_EXTENT, SCENE_EXTENT, SCENE_EXTENT});
+    info.setDepth(OCTREE_DEPTH);
+    octree.initialize(info);
+}
+
+void octreeInsert(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto models = bench::createModels(static_cast<uint32_t>(state.range(0)), SCENE_EXTENT, rng);
+    for (auto _ : state) {
+        cc::scene::Octree octree;
+        initOctree(octree);
+        for (const auto &model : models) {
+            octree.insert(model);
+        }
+        state.PauseTiming();
+        for (const auto &model : models) {
+            octree.remove(model);
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void octreeQuery(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto models = bench::createModels(static_cast<uint32_t>(state.range(0)), SCENE_EXTENT, rng);
+    cc::scene::Octree octree;
+    initOctree(octree);
+    for (const auto &model : models) {
+        octree.insert(model);
+    }
+
+    cc::IntrusivePtr<cc::scene::Camera> camera = ccnew cc::scene::Camera(cc::Root::getInstance()->getDevice());
+    cc::geometry::Frustum frustum;
+    frustum.setAccurate(true);
+    cc::geometry::Frustum::createPerspective(&frustum, cc::math::PI / 3.F, 16.F / 9.F, 1.F, SCENE_EXTENT, cc::Mat4::IDENTITY);
+
+    ccstd::vector<const cc::scene::Model *> results;
+    for (auto _ : state) {
+        results.clear();
+        octree.queryVisibility(camera, frustum, false, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.counters["visible"] = static_cast<double>(results.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    for (const auto &model : models) {
+        octree.remove(model);
+    }
+}
+
+// one camera and four shadow cascades, queried one after another like a frame does
+void octreeQueryFrustums(benchmark::State &state) {
+    constexpr uint32_t FRUSTUM_COUNT = 5;
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto models = bench::createModels(static_cast<uint32_t>(state.range(0)), SCENE_EXTENT, rng);
+    cc::scene::Octree octree;
+    initOctree(octree);
+    for (const auto &model : models) {
+        octree.insert(model);
+    }
+
+    cc::IntrusivePtr<cc::scene::Camera> camera = ccnew cc::scene::Camera(cc::Root::getInstance()->getDevice());
+    ccstd::vector<cc::geometry::Frustum> frustums(FRUSTUM_COUNT);
+    for (uint32_t i = 0; i < FRUSTUM_COUNT; ++i) {
+        cc::Mat4 view;
+        cc::Mat4::createRotationY(cc::math::PI * 0.4F * static_cast<float>(i), &view);
+        frustums[i].setAccurate(true);
+        cc::geometry::Frustum::createPerspective(&frustums[i], cc::math::PI / 3.F, 16.F / 9.F, 1.F, SCENE_EXTENT, view);
+    }
+
+    ccstd::vector<const cc::scene::Model *> results;
+    for (auto _ : state) {
+        for (const auto &frustum : frustums) {
+            results.clear();
+            octree.queryVisibility(camera, frustum, false, results);
+            benchmark::DoNotOptimize(results.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * FRUSTUM_COUNT);
+
+    for (const auto &model : models) {
+        octree.remove(model);
+    }
+}
+
+} // namespace
+
+BENCHMARK(octreeInsert)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(octreeQuery)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(octreeQueryFrustums)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,91 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "base/PixelConvert.h"
+#include "base/std/container/vector.h"
+#include "benchmark/benchmark.h"
+#include "utils.h"
+
+namespace {
+
+using cc::pixel::Conversion;
+
+// The per pixel loop the image loaders used before, as a baseline for RGB8 to RGBA8.
+void expandRGB8Scalar(const uint8_t *src, uint8_t *dst, uint32_t count) {
+    for (uint32_t i = 0; i < count * 4; i += 4) {
+        dst[i] = *src++;
+        dst[i + 1] = *src++;
+        dst[i + 2] = *src++;
+        dst[i + 3] = 255;
+    }
+}
+
+template <typename ConvertFn>
+void runConversion(benchmark::State &state, Conversion conversion, ConvertFn convert) {
+    const auto size = static_cast<uint32_t>(state.range(0));
+    const uint32_t srcBytes = size * size * cc::pixel::getSourceBytesPerPixel(conversion);
+    std::mt19937 rng{bench::RANDOM_SEED};
+    ccstd::vector<uint8_t> src(srcBytes);
+    for (auto &byte : src) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    ccstd::vector<uint8_t> dst(size * size * 4);
+    for (auto _ : state) {
+        convert(src.data(), dst.data(), size);
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    // Throughput counts the bytes read and written.
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * (srcBytes + dst.size())));
+}
+
+void pixelConvert(benchmark::State &state, Conversion conversion) {
+    runConversion(state, conversion, [conversion](const uint8_t *src, uint8_t *dst, uint32_t size) {
+        cc::pixel::convertPixels(conversion, src, dst, size * size);
+    });
+}
+
+void pixelConvertImage(benchmark::State &state, Conversion conversion) {
+    runConversion(state, conversion, [conversion](const uint8_t *src, uint8_t *dst, uint32_t size) {
+        cc::pixel::convertImage(conversion, src, dst, size, size);
+    });
+}
+
+void pixelConvertScalarRGB8(benchmark::State &state) {
+    runConversion(state, Conversion::RGB8_TO_RGBA8, [](const uint8_t *src, uint8_t *dst, uint32_t size) {
+        expandRGB8Scalar(src, dst, size * size);
+    });
+}
+
+} // namespace
+
+BENCHMARK(pixelConvertScalarRGB8)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(pixelConvert, l8, Conversion::L8_TO_RGBA8)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(pixelConvert, la8, Conversion::LA8_TO_RGBA8)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(pixelConvert, rgb8, Conversion::RGB8_TO_RGBA8)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(pixelConvert, swapRB, Conversion::SWAP_RB)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(pixelConvert, premultiply, Conversion::PREMULTIPLY)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(pixelConvert, unpremultiply, Conversion::UNPREMULTIPLY)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(pixelConvertImage, rgb8, Conversion::RGB8_TO_RGBA8)->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK_CAPTURE(pixelConvertImage, premultiply, Conversion::PREMULTIPLY)->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond)->UseRealTime();
@@ -0,0 +1,226 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <memory>
+#include "benchmark/benchmark.h"
+#include "base/std/container/array.h"
+#include "core/geometry/Frustum.h"
+#include "core/geometry/Intersect.h"
+#include "math/Math.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/SceneCulling.h"
+#include "renderer/pipeline/shadow/CSMLayers.h"
+#include "scene/Camera.h"
+#include "scene/WorldBoundsSoA.h"
+#include "utils.h"
+
+// The render queue building in SceneCulling is dominated by the frustum tests of the models,
+// these cases measure that kernel without a pipeline or render graph.
+
+namespace {
+
+constexpr float SCENE_EXTENT = 500.F;
+constexpr uint32_t CASCADE_COUNT = 4;
+
+void createCameraFrustum(cc::geometry::Frustum &frustum) {
+    frustum.setAccurate(true);
+    cc::geometry::Frustum::createPerspective(&frustum, cc::math::PI / 3.F, 16.F / 9.F, 1.F, SCENE_EXTENT, cc::Mat4::IDENTITY);
+}
+
+// Shadow cascades split the view depth, each one is an orthographic box looking down.
+void createCascadeFrusta(ccstd::array<cc::geometry::Frustum, CASCADE_COUNT> &frusta) {
+    cc::Mat4 lightView;
+    cc::Mat4::fromRT(cc::Quaternion{cc::Vec3::UNIT_X, -cc::math::PI / 2.F}, cc::Vec3{0.F, SCENE_EXTENT, 0.F}, &lightView);
+    float size = SCENE_EXTENT / 8.F;
+    for (auto &frustum : frusta) {
+        frustum.setAccurate(true);
+        cc::geometry::Frustum::createOrthographic(&frustum, size, size, 0.1F, SCENE_EXTENT * 2.F, lightView);
+        size *= 2.F;
+    }
+}
+
+void cullingPerModel(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto models = bench::createModels(static_cast<uint32_t>(state.range(0)), SCENE_EXTENT, rng);
+    cc::geometry::Frustum frustum;
+    createCameraFrustum(frustum);
+
+    ccstd::vector<uint8_t> visible(models.size());
+    for (auto _ : state) {
+        for (size_t i = 0; i < models.size(); ++i) {
+            visible[i] = cc::geometry::aabbFrustum(*models[i]->getWorldBounds(), frustum) != 0;
+        }
+        benchmark::DoNotOptimize(visible.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void cullingWorldBoundsSoA(benchmark::State &state) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    const auto models = bench::createModels(static_cast<uint32_t>(state.range(0)), SCENE_EXTENT, rng);
+    cc::scene::WorldBoundsSoA bounds;
+    for (const auto &model : models) {
+        bounds.add(model);
+    }
+    cc::geometry::Frustum frustum;
+    createCameraFrustum(frustum);
+
+    ccstd::vector<uint8_t> visible(models.size());
+    for (auto _ : state) {
+        bounds.cullFrustum(frustum, visible.data());
+        benchmark::DoNotOptimize(visible.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The culling shadowCulling replaced: ShadowMapBatchedQueue ran it once per cascade, erasing the
+// casters completely inside a cascade from the shared list so the following cascades skip them.
+void shadowCullingPerCascade(const cc::scene::Camera *camera, cc::pipeline::RenderObjectList &objects, cc::pipeline::ShadowTransformInfo *layer, bool removeDuplicates, uint32_t csmLevel) {
+    const uint32_t visibility = camera->getVisibility();
+    layer->clearShadowObjects();
+    for (auto it = objects.begin(); it != objects.end();) {
+        const auto *model = it->model;
+        if (!model || !model->isEnabled() || !model->getNode()) {
+            it = objects.erase(it);
+            continue;
+        }
+        const auto *node = model->getNode();
+        if (((visibility & node->getLayer()) != node->getLayer()) && !(visibility & static_cast<uint32_t>(model->getVisFlags()))) {
+            it = objects.erase(it);
+            continue;
+        }
+        if (!model->getWorldBounds() || !model->isCastShadow()) {
+            it = objects.erase(it);
+            continue;
+        }
+        if (!model->getWorldBounds()->aabbFrustum(layer->getValidFrustum())) {
+            ++it;
+            continue;
+        }
+        layer->addShadowObject(cc::pipeline::genRenderObject(model, camera));
+        if (layer->getLevel() < csmLevel && removeDuplicates &&
+            cc::geometry::aabbFrustumCompletelyInside(*model->getWorldBounds(), layer->getValidFrustum())) {
+            it = objects.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+struct ShadowCullingScene {
+    explicit ShadowCullingScene(uint32_t count) {
+        std::mt19937 rng{bench::RANDOM_SEED};
+        models = bench::createModels(count, SCENE_EXTENT, rng);
+        for (const auto &model : models) {
+            model->setEnabled(true);
+            model->setCastShadow(true);
+            objects.push_back({0.F, model});
+        }
+        camera = ccnew cc::scene::Camera(cc::gfx::Device::getInstance());
+        camera->setVisibility(0xFFFFFFFF);
+        camera->setPosition(cc::Vec3{0.F, 10.F, 0.F});
+        camera->setForward(cc::Vec3{0.F, 0.F, -1.F});
+
+        ccstd::array<cc::geometry::Frustum, CASCADE_COUNT> frusta;
+        createCascadeFrusta(frusta);
+        for (uint32_t level = 0; level < CASCADE_COUNT; ++level) {
+            cascades[level] = std::make_unique<cc::pipeline::ShadowTransformInfo>(level);
+            cascades[level]->copyToValidFrustum(frusta[level]);
+            layers[level] = cascades[level].get();
+        }
+    }
+
+    ccstd::vector<cc::IntrusivePtr<cc::scene::Model>> models;
+    cc::pipeline::RenderObjectList objects;
+    cc::IntrusivePtr<cc::scene::Camera> camera;
+    ccstd::array<std::unique_ptr<cc::pipeline::ShadowTransformInfo>, CASCADE_COUNT> cascades;
+    ccstd::array<cc::pipeline::ShadowTransformInfo *, CASCADE_COUNT> layers{};
+};
+
+bool sameShadowObjects(ccstd::array<cc::pipeline::RenderObjectList, CASCADE_COUNT> &expected, const ShadowCullingScene &scene) {
+    for (uint32_t level = 0; level < CASCADE_COUNT; ++level) {
+        const auto &actual = scene.layers[level]->getShadowObjects();
+        if (actual.size() != expected[level].size()) {
+            return false;
+        }
+        for (size_t i = 0; i < actual.size(); ++i) {
+            if (actual[i].model != expected[level][i].model || actual[i].depth != expected[level][i].depth) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Cost of culling the shadow casters against all CSM cascades one cascade at a time, as a function of the caster count.
+void cullingShadowCascadesPerCascade(benchmark::State &state) {
+    ShadowCullingScene scene{static_cast<uint32_t>(state.range(0))};
+    cc::pipeline::RenderObjectList objects;
+    for (auto _ : state) {
+        objects = scene.objects;
+        for (auto *layer : scene.layers) {
+            shadowCullingPerCascade(scene.camera, objects, layer, true, CASCADE_COUNT);
+        }
+        benchmark::DoNotOptimize(scene.layers[0]->getShadowObjects().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Same as above through pipeline::shadowCulling, which culls all cascades in one pass.
+void cullingShadowCascades(benchmark::State &state) {
+    ShadowCullingScene scene{static_cast<uint32_t>(state.range(0))};
+
+    // The single pass must fill every cascade exactly like the per cascade culling.
+    ccstd::array<cc::pipeline::RenderObjectList, CASCADE_COUNT> expected;
+    cc::pipeline::RenderObjectList objects = scene.objects;
+    for (uint32_t level = 0; level < CASCADE_COUNT; ++level) {
+        shadowCullingPerCascade(scene.camera, objects, scene.layers[level], true, CASCADE_COUNT);
+        expected[level] = scene.layers[level]->getShadowObjects();
+    }
+    objects = scene.objects;
+    cc::pipeline::shadowCulling(scene.camera, objects, scene.layers.data(), CASCADE_COUNT, true, CASCADE_COUNT);
+    if (!sameShadowObjects(expected, scene)) {
+        state.SkipWithError("shadowCulling differs from the per cascade culling");
+        return;
+    }
+    size_t casters = 0;
+    for (const auto &list : expected) {
+        casters += list.size();
+    }
+    state.counters["casters"] = static_cast<double>(casters);
+
+    for (auto _ : state) {
+        objects = scene.objects;
+        cc::pipeline::shadowCulling(scene.camera, objects, scene.layers.data(), CASCADE_COUNT, true, CASCADE_COUNT);
+        benchmark::DoNotOptimize(scene.layers[0]->getShadowObjects().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(cullingPerModel)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cullingWorldBoundsSoA)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cullingShadowCascadesPerCascade)->RangeMultiplier(10)->Range(100, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(cullingShadowCascades)->RangeMultiplier(10)->Range(100, 100000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,125 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include "base/Data.h"
+#include "benchmark/benchmark.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+#include "renderer/core/TextureLoader.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/gfx-base/GFXTexture.h"
+#include "utils.h"
+
+namespace {
+
+// Writes a size x size RGB picture with the encoder matching the extension and returns its path.
+ccstd::string writeImage(uint32_t size, const char *extension) {
+    std::mt19937 rng{bench::RANDOM_SEED};
+    std::uniform_int_distribution<int> noise{-8, 8};
+    ccstd::vector<uint8_t> pixels(size * size * 4);
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            uint8_t *pixel = &pixels[(y * size + x) * 4];
+            pixel[0] = static_cast<uint8_t>(std::clamp(static_cast<int>(x * 255 / size) + noise(rng), 0, 255));
+            pixel[1] = static_cast<uint8_t>(std::clamp(static_cast<int>(y * 255 / size) + noise(rng), 0, 255));
+            pixel[2] = static_cast<uint8_t>((x ^ y) & 0xFF);
+            pixel[3] = 255;
+        }
+    }
+
+    cc::IntrusivePtr<cc::Image> image = ccnew cc::Image();
+    image->initWithRawData(pixels.data(), static_cast<uint32_t>(pixels.size()), static_cast<int>(size), static_cast<int>(size), 8);
+    const ccstd::string path = cc::FileUtils::getInstance()->getWritablePath() + "benchmark-texture" + extension;
+    return image->saveToFile(path, true) ? path : "";
+}
+
+// The script image path: decode, expand the whole image to RGBA8 in a second buffer, then upload that.
+cc::gfx::Texture *loadLegacy(const ccstd::string &path, cc::gfx::Device *device, uint32_t *peakBytes) {
+    cc::IntrusivePtr<cc::Image> image = ccnew cc::Image();
+    if (!image->initWithImageFile(path)) {
+        return nullptr;
+    }
+    const auto width = static_cast<uint32_t>(image->getWidth());
+    const auto height = static_cast<uint32_t>(image->getHeight());
+    const uint32_t components = image->getDataLen() / (width * height);
+    const uint32_t length = width * height * 4;
+    const uint8_t *src = image->getData();
+    auto *dst = static_cast<uint8_t *>(malloc(length));
+    for (uint32_t i = 0, j = 0; i < length; i += 4, j += components) {
+        dst[i] = src[j];
+        dst[i + 1] = src[j + std::min(1U, components - 1)];
+        dst[i + 2] = src[j + std::min(2U, components - 1)];
+        dst[i + 3] = components == 4 || components == 2 ? src[j + components - 1] : 255;
+    }
+    *peakBytes = image->getDataLen() + length;
+
+    auto *texture = device->createTexture({cc::gfx::TextureType::TEX2D, cc::gfx::TextureUsageBit::SAMPLED | cc::gfx::TextureUsageBit::TRANSFER_DST,
+                                           cc::gfx::Format::RGBA8, width, height});
+    cc::gfx::BufferDataList buffers{dst};
+    cc::gfx::BufferTextureCopyList regions = {{0U, 0U, 0U, {0U, 0U, 0U}, {width, height, 1U}, {0U, 0U, 1U}}};
+    device->copyBuffersToTexture(buffers, texture, regions);
+    free(dst);
+    return texture;
+}
+
+cc::gfx::Texture *loadStreaming(const ccstd::string &path, cc::gfx::Device *device, uint32_t *peakBytes) {
+    cc::IntrusivePtr<cc::Image> image = cc::TextureLoader::decode(path, device);
+    if (!image) {
+        return nullptr;
+    }
+    *peakBytes = image->getDataLen();
+    return cc::TextureLoader::upload(image, device);
+}
+
+// Loads a file into a sampled texture, `peakPixelBytes` counts the pixel buffers alive at once on the CPU.
+template <typename LoadFn>
+void textureLoad(benchmark::State &state, const char *extension, LoadFn load) {
+    const auto size = static_cast<uint32_t>(state.range(0));
+    const ccstd::string path = writeImage(size, extension);
+    if (path.empty()) {
+        state.SkipWithError("failed to encode the source image");
+        return;
+    }
+    auto *device = cc::gfx::Device::getInstance();
+    uint32_t peakBytes = 0;
+    for (auto _ : state) {
+        cc::gfx::Texture *texture = load(path, device, &peakBytes);
+        if (!texture) {
+            state.SkipWithError("failed to load the texture");
+            break;
+        }
+        CC_SAFE_DESTROY_AND_DELETE(texture);
+    }
+    cc::FileUtils::getInstance()->removeFile(path);
+    state.counters["peakPixelBytes"] = peakBytes;
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(textureLoad, pngLegacy, ".png", loadLegacy)->Arg(256)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(textureLoad, pngStreaming, ".png", loadStreaming)->Arg(256)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(textureLoad, jpgLegacy, ".jpg", loadLegacy)->Arg(256)->Arg(1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(textureLoad, jpgStreaming, ".jpg", loadStreaming)->Arg(256)->Arg(1024)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,111 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "base/std/container/vector.h"
+#include "base/threading/MessageQueue.h"
+#include "benchmark/benchmark.h"
+#include "utils.h"
+
+namespace {
+
+using cc::Message;
+
+// larger than BufferAgent::STAGING_BUFFER_THRESHOLD, the payloads that don't fit in queue chunks
+constexpr uint32_t MIN_UPLOAD_SIZE = cc::MessageQueue::MEMORY_CHUNK_SIZE / 2 + 1;
+constexpr uint32_t MAX_UPLOAD_SIZE = 512 * 1024;
+
+struct SystemAllocator {
+    static uint8_t *allocate(uint32_t size) { return static_cast<uint8_t *>(malloc(size)); }
+    static void deallocate(uint8_t *ptr) { free(ptr); }
+};
+
+struct PoolAllocator {
+    static uint8_t *allocate(uint32_t size) { return cc::memoryAllocateForMultiThread<uint8_t>(size); }
+    static void deallocate(uint8_t *ptr) { cc::memoryFreeForMultiThread(ptr); }
+};
+
+// A buffer-upload heavy frame: every payload is allocated and filled on the benchmark thread
+// and released on the consumer thread after being "uploaded", like BufferAgent::update does.
+template <typename Allocator>
+void uploadPayloads(benchmark::State &state) {
+    const auto uploadsPerFrame = static_cast<uint32_t>(state.range(0));
+
+    std::mt19937 rng(bench::RANDOM_SEED);
+    std::uniform_int_distribution<uint32_t> sizeDist(MIN_UPLOAD_SIZE, MAX_UPLOAD_SIZE);
+    ccstd::vector<uint32_t> sizes(uploadsPerFrame);
+    uint64_t bytesPerFrame = 0;
+    for (auto &size : sizes) {
+        size = sizeDist(rng);
+        bytesPerFrame += size;
+    }
+
+    auto *queue = ccnew cc::MessageQueue;
+    queue->setImmediateMode(false);
+    queue->runConsumerThread();
+
+    uint64_t checksum = 0;
+    uint64_t *sum = &checksum;
+    for (auto _ : state) {
+        for (uint32_t size : sizes) {
+            uint8_t *data = Allocator::allocate(size);
+            // touch the first and last page only, the copy itself is not what's measured
+            data[0] = 1;
+            data[size - 1] = 1;
+            ENQUEUE_MESSAGE_3(
+                queue, BenchmarkUpload,
+                sum, sum,
+                data, data,
+                size, size,
+                {
+                    *sum += data[0] + data[size - 1];
+                    Allocator::deallocate(data);
+                });
+        }
+        cc::MessageQueue::freeChunksInFreeQueue(queue);
+        queue->kickAndWait();
+    }
+    benchmark::DoNotOptimize(checksum);
+
+    queue->terminateConsumerThread();
+    delete queue;
+
+    state.SetItemsProcessed(state.iterations() * uploadsPerFrame);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytesPerFrame));
+}
+
+void uploadPayloadsMalloc(benchmark::State &state) {
+    uploadPayloads<SystemAllocator>(state);
+}
+
+void uploadPayloadsThreadLocalPool(benchmark::State &state) {
+    uploadPayloads<PoolAllocator>(state);
+}
+
+} // namespace
+
+BENCHMARK(uploadPayloadsMalloc)->Arg(64)->Arg(512)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(uploadPayloadsThreadLocalPool)->Arg(64)->Arg(512)->Unit(benchmark::kMicrosecond)->UseRealTime();
@@ -0,0 +1,111 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <cstring>
+#include "2d/renderer/UIVertexLayout.h"
+#include "base/std/container/vector.h"
+#include "benchmark/benchmark.h"
+#include "math/Mat4.h"
+#include "math/Quaternion.h"
+#include "math/MathUtil.h"
+#include "math/Vec3.h"
+#include "utils.h"
+
+// Fills the colour of every UI vertex and copies the vertex data out, like Batcher2d::fillColor
+// followed by UIMeshBuffer::uploadBuffers. The argument selects the vertex format:
+// 0 is vfmtPosUvColor with an RGBA32F colour, 1 is vfmtPosUvColor4B with the colour packed as RGBA8.
+
+namespace {
+
+ccstd::vector<cc::gfx::Attribute> getAttributes(int64_t format) {
+    return {
+        cc::gfx::Attribute{cc::gfx::ATTR_NAME_POSITION, cc::gfx::Format::RGB32F},
+        cc::gfx::Attribute{cc::gfx::ATTR_NAME_TEX_COORD, cc::gfx::Format::RG32F},
+        format == 0 ? cc::gfx::Attribute{cc::gfx::ATTR_NAME_COLOR, cc::gfx::Format::RGBA32F}
+                    : cc::gfx::Attribute{cc::gfx::ATTR_NAME_COLOR, cc::gfx::Format::RGBA8, true},
+    };
+}
+
+void uiVertexFillAndUpload(benchmark::State &state) {
+    constexpr uint32_t VERTEX_COUNT = 50000;
+    constexpr uint32_t QUAD_VERTEX_COUNT = 4;
+
+    const auto layout = cc::getUIVertexLayout(getAttributes(state.range(0)));
+    ccstd::vector<float> vertices(VERTEX_COUNT * layout.stride);
+    ccstd::vector<float> uploaded(vertices.size());
+    const uint32_t bytesPerFrame = VERTEX_COUNT * layout.stride * sizeof(float);
+
+    std::mt19937 rng{bench::RANDOM_SEED};
+    std::uniform_int_distribution<uint32_t> channel{0, 255};
+    for (auto _ : state) {
+        // one colour per quad, as every sprite has its own entity colour
+        for (uint32_t i = 0; i < VERTEX_COUNT; i += QUAD_VERTEX_COUNT) {
+            const cc::Color color{static_cast<uint8_t>(channel(rng)), 128, 64, 255};
+            cc::fillUIVertexColor(vertices.data() + i * layout.stride, QUAD_VERTEX_COUNT, layout.stride, layout, color, 1.0F);
+        }
+        memcpy(uploaded.data(), vertices.data(), bytesPerFrame);
+        benchmark::DoNotOptimize(uploaded.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * VERTEX_COUNT);
+    state.SetBytesProcessed(state.iterations() * bytesPerFrame);
+    state.counters["bytesPerFrame"] = bytesPerFrame;
+}
+
+// Transforms the local positions of 50k glyph-like vertices to world space, like Batcher2d::fillVertexBuffers.
+// The argument selects the kernel: 0 is the former per vertex Vec3::transformMat4, 1 is MathUtil::transformPoints.
+void uiVertexTransform(benchmark::State &state) {
+    constexpr uint32_t VERTEX_COUNT = 50000;
+    constexpr uint32_t STRIDE = 9;
+
+    std::mt19937 rng{bench::RANDOM_SEED};
+    std::uniform_real_distribution<float> coord{-500.F, 500.F};
+    ccstd::vector<float> local(VERTEX_COUNT * STRIDE);
+    for (auto &value : local) {
+        value = coord(rng);
+    }
+    ccstd::vector<float> world(local.size());
+
+    cc::Mat4 matrix;
+    cc::Mat4::fromRTS(cc::Quaternion(0.F, 0.F, 0.38F, 0.92F).getNormalized(), cc::Vec3(480.F, 320.F, 0.F), cc::Vec3(2.F, 2.F, 1.F), &matrix);
+
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            for (uint32_t i = 0; i < local.size(); i += STRIDE) {
+                const cc::Vec3 position{local[i], local[i + 1], local[i + 2]};
+                reinterpret_cast<cc::Vec3 *>(world.data() + i)->transformMat4(position, matrix);
+            }
+        } else {
+            cc::MathUtil::transformPoints(matrix.m, local.data(), world.data(), STRIDE, VERTEX_COUNT);
+        }
+        benchmark::DoNotOptimize(world.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * VERTEX_COUNT);
+}
+
+} // namespace
+
+BENCHMARK(uiVertexFillAndUpload)->DenseRange(0, 1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(uiVertexTransform)->DenseRange(0, 1)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,68 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "utils.h"
+
+namespace bench {
+
+ccstd::vector<cc::IntrusivePtr<cc::Node>> createNodeTree(uint32_t count, uint32_t branching, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position{-10.F, 10.F};
+    std::uniform_real_distribution<float> angle{-180.F, 180.F};
+    std::uniform_real_distribution<float> scale{0.5F, 2.F};
+
+    ccstd::vector<cc::IntrusivePtr<cc::Node>> nodes;
+    nodes.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto *node = ccnew cc::Node();
+        node->setPosition(position(rng), position(rng), position(rng));
+        node->setRotationFromEuler(angle(rng), angle(rng), angle(rng));
+        const float s = scale(rng);
+        node->setScale(s, s, s);
+        if (i > 0) {
+            nodes[(i - 1) / branching]->addChild(node);
+        }
+        nodes.emplace_back(node);
+    }
+    return nodes;
+}
+
+ccstd::vector<cc::IntrusivePtr<cc::scene::Model>> createModels(uint32_t count, float extent, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position{-extent, extent};
+
+    ccstd::vector<cc::IntrusivePtr<cc::scene::Model>> models;
+    models.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto *node = ccnew cc::Node();
+        node->setPosition(position(rng), position(rng), position(rng));
+        auto *model = ccnew cc::scene::Model();
+        model->setNode(node);
+        model->setTransform(node);
+        model->createBoundingShape(cc::Vec3{-0.5F, -0.5F, -0.5F}, cc::Vec3{0.5F, 0.5F, 0.5F});
+        model->updateTransform(0);
+        models.emplace_back(model);
+    }
+    return models;
+}
+
+} // namespace bench
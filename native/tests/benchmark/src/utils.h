@@ -0,0 +1,46 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <random>
+#include "base/Ptr.h"
+#include "base/std/container/vector.h"
+#include "core/scene-graph/Node.h"
+#include "scene/Model.h"
+
+namespace bench {
+
+// Fixed seed so every run works on the same data.
+constexpr uint32_t RANDOM_SEED = 20240601;
+
+// Builds a tree of `count` nodes in breadth-first order, every node has at most `branching` children
+// and a random local transform. The nodes are returned in creation order, index 0 is the root.
+ccstd::vector<cc::IntrusivePtr<cc::Node>> createNodeTree(uint32_t count, uint32_t branching, std::mt19937 &rng);
+
+// Creates `count` unit-sized models scattered uniformly in a cube of half size `extent`,
+// each with its own node and up to date world bounds.
+ccstd::vector<cc::IntrusivePtr<cc::scene::Model>> createModels(uint32_t count, float extent, std::mt19937 &rng);
+
+} // namespace bench
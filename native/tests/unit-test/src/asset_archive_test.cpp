@@ -0,0 +1,131 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "utils.h"
+
+#include "platform/AssetArchive.h"
+#include "platform/FileUtils.h"
+
+using namespace cc;
+
+namespace {
+
+ccstd::string archivePath() {
+    return FileUtils::getInstance()->getWritablePath() + "asset-archive-test.ccar";
+}
+
+ccstd::vector<uint8_t> noise(uint32_t size) {
+    ccstd::vector<uint8_t> bytes(size);
+    uint32_t state = 0x12345678;
+    for (auto &byte : bytes) {
+        state = state * 1664525 + 1013904223;
+        byte = static_cast<uint8_t>(state >> 24);
+    }
+    return bytes;
+}
+
+} // namespace
+
+TEST(assetArchiveTest, readsStoredAndCompressedEntries) {
+    const ccstd::string text(4096, 'a');
+    const auto binary = noise(1000);
+
+    AssetArchiveWriter writer;
+    writer.addFile("text/a.txt", text.data(), static_cast<uint32_t>(text.size()));
+    writer.addFile("bin/noise.bin", binary.data(), static_cast<uint32_t>(binary.size()));
+    writer.addFile("empty", nullptr, 0);
+    ASSERT_TRUE(writer.save(archivePath()));
+
+    AssetArchive archive;
+    ASSERT_TRUE(archive.open(archivePath()));
+    EXPECT_EQ(archive.getEntryCount(), 3U);
+    EXPECT_EQ(archive.find("text/b.txt"), nullptr);
+    EXPECT_EQ(archive.find("/text/a.txt"), nullptr);
+
+    const auto *textEntry = archive.find("text/a.txt");
+    ASSERT_NE(textEntry, nullptr);
+    EXPECT_EQ(textEntry->compression, AssetArchive::Compression::DEFLATE);
+    EXPECT_LT(textEntry->compressedSize, textEntry->size);
+    EXPECT_EQ(archive.getStoredData(*textEntry), nullptr);
+    ccstd::string decoded(textEntry->size, '\0');
+    ASSERT_TRUE(archive.read(*textEntry, decoded.data()));
+    EXPECT_EQ(decoded, text);
+
+    // Noise doesn't deflate, it is kept stored and served from the mapping.
+    const auto *binaryEntry = archive.find("bin/noise.bin");
+    ASSERT_NE(binaryEntry, nullptr);
+    EXPECT_EQ(binaryEntry->compression, AssetArchive::Compression::STORED);
+    const uint8_t *mapped = archive.getStoredData(*binaryEntry);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(mapped) % AssetArchive::DATA_ALIGNMENT, 0U);
+    EXPECT_EQ(memcmp(mapped, binary.data(), binary.size()), 0);
+
+    const auto *emptyEntry = archive.find("empty");
+    ASSERT_NE(emptyEntry, nullptr);
+    EXPECT_EQ(emptyEntry->size, 0U);
+
+    archive.close();
+    FileUtils::getInstance()->removeFile(archivePath());
+}
+
+TEST(assetArchiveTest, rejectsInvalidFiles) {
+    auto *fileUtils = FileUtils::getInstance();
+    ASSERT_TRUE(fileUtils->writeStringToFile("not an archive, just some text", archivePath()));
+
+    AssetArchive archive;
+    EXPECT_FALSE(archive.open(archivePath()));
+    EXPECT_FALSE(archive.isOpen());
+    EXPECT_FALSE(archive.open(archivePath() + ".missing"));
+
+    fileUtils->removeFile(archivePath());
+}
+
+TEST(assetArchiveTest, mountsAsSearchPath) {
+    const ccstd::string text = "archived text";
+    const auto binary = noise(256);
+
+    AssetArchiveWriter writer;
+    writer.addFile("archived/a.txt", text.data(), static_cast<uint32_t>(text.size()));
+    writer.addFile("archived/noise.bin", binary.data(), static_cast<uint32_t>(binary.size()));
+    ASSERT_TRUE(writer.save(archivePath()));
+
+    auto *fileUtils = FileUtils::getInstance();
+    ASSERT_TRUE(fileUtils->addSearchArchive(archivePath(), true));
+    EXPECT_TRUE(fileUtils->isFileExist("archived/a.txt"));
+    EXPECT_TRUE(fileUtils->isFileExist("archived/../archived/noise.bin"));
+    EXPECT_FALSE(fileUtils->isFileExist("archived/missing.txt"));
+    EXPECT_EQ(fileUtils->getStringFromFile("archived/a.txt"), text);
+    EXPECT_EQ(fileUtils->getFileSize("archived/noise.bin"), static_cast<long>(binary.size()));
+
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    ASSERT_TRUE(fileUtils->getMappedContents("archived/noise.bin", &data, &size));
+    EXPECT_EQ(size, binary.size());
+    EXPECT_EQ(memcmp(data, binary.data(), size), 0);
+
+    fileUtils->removeSearchArchive(archivePath());
+    EXPECT_FALSE(fileUtils->isFileExist("archived/a.txt"));
+    fileUtils->removeFile(archivePath());
+}
@@ -0,0 +1,111 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <cstring>
+#include <thread>
+#include "base/std/container/vector.h"
+#include "base/threading/ThreadLocalPool.h"
+#include "gtest/gtest.h"
+
+using cc::ThreadLocalPool;
+
+TEST(ThreadLocalPoolTest, alignment) {
+    for (size_t size : {1U, 17U, 100U, 4096U, 33000U}) {
+        void *ptr = ThreadLocalPool::allocate(size);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % ThreadLocalPool::ALIGNMENT, 0U);
+        memset(ptr, 0xCD, size);
+        ThreadLocalPool::deallocate(ptr);
+    }
+    EXPECT_EQ(ThreadLocalPool::allocate(0), nullptr);
+}
+
+TEST(ThreadLocalPoolTest, reuseOnSameThread) {
+    void *first = ThreadLocalPool::allocate(1000);
+    ThreadLocalPool::deallocate(first);
+    // same size class
+    void *second = ThreadLocalPool::allocate(1024);
+    EXPECT_EQ(first, second);
+    ThreadLocalPool::deallocate(second);
+}
+
+TEST(ThreadLocalPoolTest, reclaimFromOtherThread) {
+    // a size class nothing else on this thread has cached blocks of
+    const size_t size = 3U * 1024U * 1024U;
+    void *block = ThreadLocalPool::allocate(size);
+    std::thread([block]() {
+        ThreadLocalPool::deallocate(block);
+    }).join();
+    void *reclaimed = ThreadLocalPool::allocate(size);
+    EXPECT_EQ(block, reclaimed);
+    ThreadLocalPool::deallocate(reclaimed);
+}
+
+TEST(ThreadLocalPoolTest, freeBlocksOfExitedThread) {
+    void *block = nullptr;
+    std::thread([&block]() {
+        block = ThreadLocalPool::allocate(256);
+    }).join();
+    // the cache of the exited thread is idle, so the block goes back to the system allocator
+    const auto before = ThreadLocalPool::getStats();
+    ThreadLocalPool::deallocate(block);
+    const auto after = ThreadLocalPool::getStats();
+    EXPECT_LT(after.reservedBytes, before.reservedBytes);
+
+    // the next thread adopts the idle cache and allocates from it
+    std::thread([]() {
+        void *ptr = ThreadLocalPool::allocate(256);
+        EXPECT_NE(ptr, nullptr);
+        ThreadLocalPool::deallocate(ptr);
+    }).join();
+}
+
+TEST(ThreadLocalPoolTest, oversized) {
+    const size_t hugeSize = (size_t{1} << ThreadLocalPool::MAX_BLOCK_SIZE_LOG2) + 1;
+    const auto before = ThreadLocalPool::getStats();
+    void *huge = ThreadLocalPool::allocate(hugeSize);
+    const auto after = ThreadLocalPool::getStats();
+    EXPECT_EQ(after.allocationCount - before.allocationCount, 1U);
+    EXPECT_EQ(after.systemAllocationCount - before.systemAllocationCount, 1U);
+    EXPECT_GE(after.reservedBytes - before.reservedBytes, hugeSize);
+    ThreadLocalPool::deallocate(huge);
+}
+
+TEST(ThreadLocalPoolTest, cachedBytesAreBounded) {
+    std::thread([]() {
+        const auto before = ThreadLocalPool::getStats();
+        ccstd::vector<void *> blocks;
+        // the size classes from 64KB to 4MB could hold 11MB without the per thread limit
+        for (size_t size = 48U * 1024U; size < 4U * 1024U * 1024U; size *= 2) {
+            for (int i = 0; i < 32; ++i) {
+                blocks.push_back(ThreadLocalPool::allocate(size));
+            }
+        }
+        for (void *block : blocks) {
+            ThreadLocalPool::deallocate(block);
+        }
+        const auto after = ThreadLocalPool::getStats();
+        // only the cached blocks and their headers are still reserved
+        EXPECT_LE(after.reservedBytes - before.reservedBytes, ThreadLocalPool::CACHED_BYTES_PER_THREAD + blocks.size() * ThreadLocalPool::ALIGNMENT);
+    }).join();
+}
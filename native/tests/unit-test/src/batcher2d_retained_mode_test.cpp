@@ -0,0 +1,326 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "2d/renderer/Batcher2d.h"
+#include "2d/renderer/RenderDrawInfo.h"
+#include "2d/renderer/RenderEntity.h"
+#include "2d/renderer/UIMeshBuffer.h"
+#include "core/Root.h"
+#include "core/assets/Material.h"
+#include "core/scene-graph/Node.h"
+#include "core/scene-graph/Scene.h"
+#include "gtest/gtest.h"
+#include "renderer/core/ProgramLib.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/GlobalDescriptorSetManager.h"
+#include "scene/DrawBatch2D.h"
+#include "scene/Pass.h"
+#include "scene/RenderScene.h"
+
+using namespace cc;
+
+namespace {
+
+Node *addNode(Node *parent) {
+    auto *node = ccnew Node();
+    parent->addChild(node);
+    node->setActiveInHierarchy(true);
+    return node;
+}
+
+// Returns the number of root nodes whose batches were replayed.
+uint32_t drawFrame(Batcher2d &batcher) {
+    batcher.update();
+    const uint32_t replayed = batcher.getReplayedRootCount();
+    batcher.reset();
+    return replayed;
+}
+
+// vfmtPosUvColor
+constexpr uint32_t VERTEX_FLOATS = 9;
+constexpr uint32_t QUAD_VERTICES = 4;
+constexpr uint32_t QUAD_INDICES = 6;
+constexpr uint32_t MAX_QUADS = 4;
+
+// The vertex and index data script shares with the mesh buffer.
+struct MeshBufferData {
+    UIMeshBuffer buffer;
+    ccstd::array<float, MAX_QUADS * QUAD_VERTICES * VERTEX_FLOATS> vData{};
+    ccstd::array<uint16_t, MAX_QUADS * QUAD_INDICES> iData{};
+
+    MeshBufferData() {
+        buffer.initialize({{gfx::ATTR_NAME_POSITION, gfx::Format::RGB32F},
+                           {gfx::ATTR_NAME_TEX_COORD, gfx::Format::RG32F},
+                           {gfx::ATTR_NAME_COLOR, gfx::Format::RGBA32F}},
+                          true);
+        buffer.setVData(vData.data());
+        buffer.setIData(iData.data());
+    }
+};
+
+// A sprite quad as assembled by script, at the given vertex slot of the mesh buffer.
+struct Quad {
+    RenderDrawInfo drawInfo;
+    ccstd::array<float, QUAD_VERTICES * VERTEX_FLOATS> local{};
+    ccstd::array<uint16_t, QUAD_INDICES> indices{};
+
+    Quad(MeshBufferData &data, uint32_t slot, Material *material, gfx::Texture *texture, ccstd::hash_t dataHash) {
+        const auto vertexOffset = static_cast<uint16_t>(slot * QUAD_VERTICES);
+        const uint16_t quadIndices[] = {0, 1, 2, 2, 1, 3};
+        for (uint32_t i = 0; i < QUAD_INDICES; ++i) {
+            indices[i] = vertexOffset + quadIndices[i];
+        }
+        drawInfo.setStride(VERTEX_FLOATS);
+        drawInfo.setVbCount(QUAD_VERTICES);
+        drawInfo.setIbCount(QUAD_INDICES);
+        drawInfo.setVertDirty(true);
+        drawInfo.setMeshBuffer(&data.buffer);
+        drawInfo.setVbBuffer(data.vData.data() + vertexOffset * VERTEX_FLOATS);
+        drawInfo.setIbBuffer(indices.data());
+        drawInfo.setIDataBuffer(data.iData.data());
+        drawInfo.setRender2dBufferToNative(reinterpret_cast<uint8_t *>(local.data()));
+        drawInfo.setSampler(gfx::Device::getInstance()->getSampler({}));
+        drawInfo.setMaterial(material);
+        setTexture(texture, dataHash);
+    }
+
+    void setTexture(gfx::Texture *texture, ccstd::hash_t dataHash) {
+        drawInfo.setTexture(texture);
+        drawInfo.setDataHash(dataHash);
+    }
+};
+
+IntrusivePtr<RenderEntity> addSprite(Node *node, Quad &quad) {
+    IntrusivePtr<RenderEntity> entity = ccnew RenderEntity(RenderEntityType::DYNAMIC);
+    entity->addDynamicRenderDrawInfo(&quad.drawInfo);
+    entity->setNode(node);
+    // the attributes are written by script through the shared buffer
+    uint8_t *attrs = nullptr;
+    size_t length = 0;
+    entity->getEntitySharedBufferForJS()->getArrayBufferData(&attrs, &length);
+    reinterpret_cast<EntityAttrLayout *>(attrs)->enabledIndex = 1;
+    return entity;
+}
+
+IntrusivePtr<Material> createMaterial() {
+    // set up by the game at startup, the batches bind the sprite texture in the local set
+    pipeline::GlobalDSManager::setDescriptorSetLayout();
+    IShaderInfo shader;
+    shader.name = "batcher2d-retained-mode-test";
+    shader.hash = 1;
+    ProgramLib::getInstance()->define(shader);
+
+    IPassInfoFull info;
+    info.program = shader.name;
+    IntrusivePtr<scene::Pass> pass = ccnew scene::Pass(Root::getInstance());
+    pass->initialize(info);
+
+    IntrusivePtr<Material> material = ccnew Material();
+    material->getPasses()->emplace_back(pass);
+    return material;
+}
+
+struct BatchState {
+    gfx::InputAssembler *inputAssembler{nullptr};
+    gfx::DescriptorSet *descriptorSet{nullptr};
+    uint32_t firstIndex{0};
+    uint32_t indexCount{0};
+    uint32_t visFlags{0};
+
+    bool operator==(const BatchState &rhs) const {
+        return inputAssembler == rhs.inputAssembler && descriptorSet == rhs.descriptorSet &&
+               firstIndex == rhs.firstIndex && indexCount == rhs.indexCount && visFlags == rhs.visFlags;
+    }
+};
+
+struct FrameState {
+    uint32_t replayedRootCount{0};
+    ccstd::vector<BatchState> batches;
+    ccstd::vector<uint16_t> indices;
+};
+
+// Draws a frame the way Root does, the mesh buffer offsets are reset by script at the start of each frame.
+FrameState drawBatches(Batcher2d &batcher, MeshBufferData &data, scene::RenderScene *renderScene) {
+    data.buffer.reset();
+    batcher.update();
+
+    FrameState frame;
+    frame.replayedRootCount = batcher.getReplayedRootCount();
+    for (const auto *batch : renderScene->getBatches()) {
+        frame.batches.push_back({batch->getInputAssembler(), batch->getDescriptorSet(), batch->getDrawInfo().firstIndex, batch->getDrawInfo().indexCount, batch->getVisFlags()});
+    }
+    frame.indices.assign(data.iData.begin(), data.iData.begin() + data.buffer.getIndexOffset());
+
+    renderScene->removeBatches();
+    batcher.reset();
+    return frame;
+}
+
+} // namespace
+
+TEST(batcher2dRetainedModeTest, subtreeMutationInvalidatesReplay) {
+    Batcher2d batcher{Root::getInstance()};
+    batcher.setRetainedModeEnabled(true);
+
+    IntrusivePtr<Scene> scene = ccnew Scene("retained");
+    scene->setActiveInHierarchy(true);
+    auto *rootNode = addNode(scene);
+    auto *child = addNode(rootNode);
+    scene->load();
+    batcher.syncRootNodesToNative({rootNode});
+
+    // recorded, then the version is taken from the unchanged hierarchy
+    EXPECT_EQ(drawFrame(batcher), 0U);
+    EXPECT_EQ(drawFrame(batcher), 0U);
+    EXPECT_EQ(drawFrame(batcher), 1U);
+
+    auto *grandChild = addNode(child);
+    EXPECT_EQ(drawFrame(batcher), 0U);
+    EXPECT_EQ(drawFrame(batcher), 1U);
+
+    grandChild->setLayer(grandChild->getLayer() << 1);
+    EXPECT_EQ(drawFrame(batcher), 0U);
+    EXPECT_EQ(drawFrame(batcher), 1U);
+
+    IntrusivePtr<RenderEntity> entity = ccnew RenderEntity(RenderEntityType::DYNAMIC);
+    grandChild->setUserData(entity);
+    EXPECT_EQ(drawFrame(batcher), 0U);
+    EXPECT_EQ(drawFrame(batcher), 1U);
+
+    // an entity allocated at another address doesn't match the retained one
+    IntrusivePtr<RenderEntity> otherEntity = ccnew RenderEntity(RenderEntityType::DYNAMIC);
+    grandChild->setUserData(otherEntity);
+    EXPECT_EQ(drawFrame(batcher), 0U);
+    EXPECT_EQ(drawFrame(batcher), 1U);
+
+    grandChild->setActiveInHierarchy(false);
+    EXPECT_EQ(drawFrame(batcher), 0U);
+    EXPECT_EQ(drawFrame(batcher), 1U);
+
+    grandChild->setActiveInHierarchy(true);
+    rootNode->removeChild(child);
+    EXPECT_EQ(drawFrame(batcher), 0U);
+    EXPECT_EQ(drawFrame(batcher), 1U);
+}
+
+TEST(batcher2dRetainedModeTest, releasedDrawInfoInvalidatesReplay) {
+    Batcher2d batcher{Root::getInstance()};
+    batcher.setRetainedModeEnabled(true);
+
+    IntrusivePtr<Scene> scene = ccnew Scene("retained");
+    scene->setActiveInHierarchy(true);
+    auto *rootNode = addNode(scene);
+    addNode(rootNode);
+    scene->load();
+    batcher.syncRootNodesToNative({rootNode});
+
+    EXPECT_EQ(drawFrame(batcher), 0U);
+    EXPECT_EQ(drawFrame(batcher), 0U);
+    EXPECT_EQ(drawFrame(batcher), 1U);
+
+    // the address of a destroyed draw info can be reused by another one with the same hash
+    RenderDrawInfo drawInfo;
+    batcher.releaseDrawInfo(&drawInfo);
+    EXPECT_EQ(drawFrame(batcher), 0U);
+    EXPECT_EQ(drawFrame(batcher), 1U);
+
+    batcher.setRetainedModeEnabled(false);
+    EXPECT_EQ(drawFrame(batcher), 0U);
+}
+
+TEST(batcher2dRetainedModeTest, replayedBatchesMatchFreshWalk) {
+    ProgramLib programLib;
+    auto *device = gfx::Device::getInstance();
+    IntrusivePtr<gfx::Texture> texture = device->createTexture({gfx::TextureType::TEX2D, gfx::TextureUsageBit::SAMPLED, gfx::Format::RGBA8, 16, 16});
+    IntrusivePtr<gfx::Texture> otherTexture = device->createTexture({gfx::TextureType::TEX2D, gfx::TextureUsageBit::SAMPLED, gfx::Format::RGBA8, 16, 16});
+    IntrusivePtr<Material> material = createMaterial();
+
+    MeshBufferData data;
+    Batcher2d batcher{Root::getInstance()};
+    batcher.syncMeshBuffersToNative(0, {&data.buffer});
+    batcher.setRetainedModeEnabled(true);
+
+    IntrusivePtr<Scene> scene = ccnew Scene("retained");
+    scene->setActiveInHierarchy(true);
+    auto *rootNode = addNode(scene);
+    scene->load();
+    auto *renderScene = scene->getRenderScene();
+    ASSERT_NE(renderScene, nullptr);
+    batcher.syncRootNodesToNative({rootNode});
+
+    // the first two quads share a texture and are merged
+    Quad first{data, 0, material, texture, 1};
+    Quad second{data, 1, material, texture, 1};
+    Quad third{data, 2, material, otherTexture, 2};
+    auto firstEntity = addSprite(addNode(rootNode), first);
+    auto *secondNode = addNode(rootNode);
+    auto secondEntity = addSprite(secondNode, second);
+    auto thirdEntity = addSprite(addNode(rootNode), third);
+
+    EXPECT_EQ(drawBatches(batcher, data, renderScene).replayedRootCount, 0U);
+    EXPECT_EQ(drawBatches(batcher, data, renderScene).replayedRootCount, 0U);
+    const auto replayed = drawBatches(batcher, data, renderScene);
+    EXPECT_EQ(replayed.replayedRootCount, 1U);
+    ASSERT_EQ(replayed.batches.size(), 2U);
+    EXPECT_EQ(replayed.batches[0].indexCount, 2 * QUAD_INDICES);
+    EXPECT_EQ(replayed.batches[1].indexCount, QUAD_INDICES);
+    EXPECT_NE(replayed.batches[0].descriptorSet, replayed.batches[1].descriptorSet);
+
+    batcher.setRetainedModeEnabled(false);
+    const auto walked = drawBatches(batcher, data, renderScene);
+    EXPECT_EQ(walked.replayedRootCount, 0U);
+    EXPECT_EQ(walked.batches, replayed.batches);
+    EXPECT_EQ(walked.indices, replayed.indices);
+
+    // the third quad now batches with the others
+    batcher.setRetainedModeEnabled(true);
+    third.setTexture(texture, 1);
+    EXPECT_EQ(drawBatches(batcher, data, renderScene).replayedRootCount, 0U);
+    EXPECT_EQ(drawBatches(batcher, data, renderScene).replayedRootCount, 0U);
+    const auto mutated = drawBatches(batcher, data, renderScene);
+    EXPECT_EQ(mutated.replayedRootCount, 1U);
+    EXPECT_NE(mutated.batches, replayed.batches);
+    ASSERT_EQ(mutated.batches.size(), 1U);
+    EXPECT_EQ(mutated.batches[0].indexCount, 3 * QUAD_INDICES);
+
+    batcher.setRetainedModeEnabled(false);
+    EXPECT_EQ(drawBatches(batcher, data, renderScene).batches, mutated.batches);
+
+    // removing a quad from the subtree shrinks the merged batch
+    batcher.setRetainedModeEnabled(true);
+    rootNode->removeChild(secondNode);
+    EXPECT_EQ(drawBatches(batcher, data, renderScene).replayedRootCount, 0U);
+    EXPECT_EQ(drawBatches(batcher, data, renderScene).replayedRootCount, 0U);
+    const auto removed = drawBatches(batcher, data, renderScene);
+    EXPECT_EQ(removed.replayedRootCount, 1U);
+    EXPECT_NE(removed.batches, mutated.batches);
+    ASSERT_EQ(removed.batches.size(), 1U);
+    EXPECT_EQ(removed.batches[0].indexCount, 2 * QUAD_INDICES);
+    EXPECT_NE(removed.indices, mutated.indices);
+
+    batcher.setRetainedModeEnabled(false);
+    const auto removedWalked = drawBatches(batcher, data, renderScene);
+    EXPECT_EQ(removedWalked.batches, removed.batches);
+    EXPECT_EQ(removedWalked.indices, removed.indices);
+}
@@ -0,0 +1,202 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "base/std/container/vector.h"
+#include "core/scene-graph/Node.h"
+#include "core/scene-graph/TransformHierarchy.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+using NodeList = ccstd::vector<IntrusivePtr<Node>>;
+
+// Builds a chain of `chainLength` nodes with a tree of `count` nodes below it, every node of the
+// tree has at most `branching` children. The same seed gives the same transforms.
+NodeList createTree(uint32_t chainLength, uint32_t count, uint32_t branching, uint32_t seed) {
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<float> position{-10.F, 10.F};
+    std::uniform_real_distribution<float> angle{-180.F, 180.F};
+    std::uniform_real_distribution<float> scale{0.5F, 2.F};
+
+    NodeList nodes;
+    for (uint32_t i = 0; i < chainLength + count; ++i) {
+        auto *node = ccnew Node();
+        node->setPosition(position(rng), position(rng), position(rng));
+        node->setRotationFromEuler(angle(rng), angle(rng), angle(rng));
+        const float s = scale(rng);
+        node->setScale(s, s, s);
+        if (i > 0 && i <= chainLength) {
+            nodes[i - 1]->addChild(node);
+        } else if (i > chainLength) {
+            nodes[chainLength + (i - chainLength - 1) / branching]->addChild(node);
+        }
+        nodes.emplace_back(node);
+    }
+    return nodes;
+}
+
+// The hierarchy must leave every node clean, so reading the world transforms doesn't recompute them.
+void expectSameWorldTransforms(const NodeList &batched, const NodeList &reference) {
+    ASSERT_EQ(batched.size(), reference.size());
+    for (size_t i = 0; i < batched.size(); ++i) {
+        ASSERT_FALSE(batched[i]->isTransformDirty()) << "node " << i;
+        reference[i]->updateWorldTransform();
+        const auto &actual = batched[i]->getWorldMatrix();
+        const auto &expected = reference[i]->getWorldMatrix();
+        for (uint32_t j = 0; j < 16; ++j) {
+            ASSERT_NEAR(actual.m[j], expected.m[j], 1e-3F * std::max(1.F, std::abs(expected.m[j]))) << "node " << i << " element " << j;
+        }
+        const auto &position = batched[i]->getWorldPosition();
+        const auto &expectedPosition = reference[i]->getWorldPosition();
+        ASSERT_NEAR(position.x, expectedPosition.x, 1e-3F * std::max(1.F, std::abs(expectedPosition.x))) << "node " << i;
+        ASSERT_NEAR(position.y, expectedPosition.y, 1e-3F * std::max(1.F, std::abs(expectedPosition.y))) << "node " << i;
+        ASSERT_NEAR(position.z, expectedPosition.z, 1e-3F * std::max(1.F, std::abs(expectedPosition.z))) << "node " << i;
+    }
+}
+
+// Applies the same change to both trees.
+template <typename F>
+void change(const NodeList &batched, const NodeList &reference, F &&fn) {
+    fn(batched);
+    fn(reference);
+}
+
+} // namespace
+
+TEST(TransformHierarchyTest, matchesNodeUpdate) {
+    // large enough to be split into several chunks updated in parallel
+    const auto batched = createTree(3, 3000, 4, 1);
+    const auto reference = createTree(3, 3000, 4, 1);
+    TransformHierarchy hierarchy{batched[0]};
+    EXPECT_EQ(hierarchy.size(), batched.size());
+
+    hierarchy.update();
+    expectSameWorldTransforms(batched, reference);
+}
+
+TEST(TransformHierarchyTest, dirtyPropagation) {
+    const auto batched = createTree(1, 2000, 3, 2);
+    const auto reference = createTree(1, 2000, 3, 2);
+    TransformHierarchy hierarchy{batched[0]};
+    hierarchy.update();
+    expectSameWorldTransforms(batched, reference);
+
+    // a position only change keeps the rotation and scale of the descendants
+    change(batched, reference, [](const NodeList &nodes) {
+        nodes[5]->setPosition(1.F, 2.F, 3.F);
+    });
+    hierarchy.update();
+    expectSameWorldTransforms(batched, reference);
+
+    // rotation and scale changes on scattered nodes, parents before and after their children
+    change(batched, reference, [](const NodeList &nodes) {
+        for (size_t i = 1; i < nodes.size(); i += 97) {
+            nodes[i]->setRotationFromEuler(static_cast<float>(i), 30.F, 0.F);
+        }
+        for (size_t i = nodes.size() - 1; i > 131; i -= 131) {
+            nodes[i]->setScale(1.5F, 0.5F, 1.F);
+        }
+    });
+    hierarchy.update();
+    expectSameWorldTransforms(batched, reference);
+
+    // a change of the root dirties everything
+    change(batched, reference, [](const NodeList &nodes) {
+        nodes[0]->setRotationFromEuler(0.F, 45.F, 10.F);
+    });
+    hierarchy.update();
+    expectSameWorldTransforms(batched, reference);
+
+    // nothing dirty, nothing changes
+    hierarchy.update();
+    expectSameWorldTransforms(batched, reference);
+}
+
+TEST(TransformHierarchyTest, reparenting) {
+    const auto batched = createTree(2, 1500, 5, 3);
+    const auto reference = createTree(2, 1500, 5, 3);
+    TransformHierarchy hierarchy{batched[0]};
+    hierarchy.update();
+
+    // move a subtree to a node in another branch
+    change(batched, reference, [](const NodeList &nodes) {
+        nodes[10]->setParent(nodes[700]);
+    });
+    hierarchy.update();
+    expectSameWorldTransforms(batched, reference);
+    EXPECT_EQ(hierarchy.size(), batched.size());
+
+    // keep the world transform while reparenting, then move the new parent
+    change(batched, reference, [](const NodeList &nodes) {
+        nodes[1200]->setParent(nodes[3], true);
+        nodes[3]->setPosition(-4.F, 0.F, 2.F);
+    });
+    hierarchy.update();
+    expectSameWorldTransforms(batched, reference);
+
+    // nodes added below the root are picked up by the rebuild
+    const auto addNodes = [](const NodeList &nodes) {
+        NodeList added;
+        for (uint32_t i = 0; i < 8; ++i) {
+            auto *node = ccnew Node();
+            node->setPosition(static_cast<float>(i), 1.F, 0.F);
+            nodes[i * 50]->addChild(node);
+            added.emplace_back(node);
+        }
+        return added;
+    };
+    const auto addedBatched = addNodes(batched);
+    const auto addedReference = addNodes(reference);
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.size(), batched.size() + addedBatched.size());
+    expectSameWorldTransforms(batched, reference);
+    expectSameWorldTransforms(addedBatched, addedReference);
+
+    // a subtree taken out of the hierarchy is no longer updated by it
+    change(batched, reference, [](const NodeList &nodes) {
+        nodes[20]->setParent(nullptr);
+        nodes[0]->setPosition(0.F, 5.F, 0.F);
+    });
+    hierarchy.update();
+    EXPECT_LT(hierarchy.size(), batched.size() + addedBatched.size());
+    EXPECT_TRUE(batched[20]->isTransformDirty());
+    NodeList attachedBatched;
+    NodeList attachedReference;
+    for (size_t i = 0; i < batched.size(); ++i) {
+        const Node *root = batched[i];
+        while (root->getParent()) {
+            root = root->getParent();
+        }
+        if (root == batched[0]) {
+            attachedBatched.emplace_back(batched[i]);
+            attachedReference.emplace_back(reference[i]);
+        }
+    }
+    expectSameWorldTransforms(attachedBatched, attachedReference);
+}
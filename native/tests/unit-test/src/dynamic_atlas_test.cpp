@@ -0,0 +1,175 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "utils.h"
+
+#include "2d/renderer/DynamicAtlasManager.h"
+#include "renderer/gfx-base/GFXDevice.h"
+
+using namespace cc;
+
+namespace {
+
+struct PackedRect {
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+};
+
+bool overlaps(const PackedRect &a, const PackedRect &b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// usage of the textures SimpleTexture creates for sprites
+constexpr gfx::TextureUsageBit SPRITE_USAGE = gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST | gfx::TextureUsageBit::TRANSFER_SRC;
+
+IntrusivePtr<gfx::Texture> createTexture(gfx::TextureUsageBit usage, uint32_t size) {
+    return gfx::Device::getInstance()->createTexture({gfx::TextureType::TEX2D, usage, DynamicAtlasManager::PAGE_FORMAT, size, size});
+}
+
+} // namespace
+
+TEST(dynamicAtlasTest, skylinePacksWithoutOverlap) {
+    AtlasSkyline skyline{256, 256};
+    ccstd::vector<PackedRect> rects;
+    const uint32_t sizes[][2] = {{64, 32}, {17, 90}, {100, 10}, {33, 33}, {8, 8}, {120, 64}, {50, 70}, {31, 5}};
+    for (uint32_t round = 0; round < 4; ++round) {
+        for (const auto &size : sizes) {
+            PackedRect rect{0, 0, size[0], size[1]};
+            if (skyline.insert(rect.width, rect.height, rect.x, rect.y)) {
+                EXPECT_LE(rect.x + rect.width, 256U);
+                EXPECT_LE(rect.y + rect.height, 256U);
+                for (const auto &other : rects) {
+                    EXPECT_FALSE(overlaps(rect, other));
+                }
+                rects.push_back(rect);
+            }
+        }
+    }
+    EXPECT_GT(rects.size(), 16U);
+}
+
+TEST(dynamicAtlasTest, skylineFillsAndResets) {
+    AtlasSkyline skyline{64, 64};
+    uint32_t x = 0;
+    uint32_t y = 0;
+    for (uint32_t i = 0; i < 16; ++i) {
+        EXPECT_TRUE(skyline.insert(16, 16, x, y));
+        EXPECT_EQ(x % 16, 0U);
+        EXPECT_EQ(y % 16, 0U);
+    }
+    EXPECT_FALSE(skyline.insert(1, 1, x, y));
+    EXPECT_FALSE(skyline.insert(65, 1, x, y));
+
+    skyline.reset(64, 64);
+    EXPECT_TRUE(skyline.insert(64, 64, x, y));
+    EXPECT_EQ(x, 0U);
+    EXPECT_EQ(y, 0U);
+}
+
+TEST(dynamicAtlasTest, skylinePrefersLowestPosition) {
+    AtlasSkyline skyline{100, 100};
+    uint32_t x = 0;
+    uint32_t y = 0;
+    EXPECT_TRUE(skyline.insert(30, 50, x, y));
+    EXPECT_TRUE(skyline.insert(30, 10, x, y));
+    EXPECT_EQ(x, 30U);
+    EXPECT_EQ(y, 0U);
+    // too wide for the gap next to the first rect
+    EXPECT_TRUE(skyline.insert(80, 10, x, y));
+    EXPECT_EQ(y, 50U);
+}
+
+TEST(dynamicAtlasTest, onlyPacksUploadedTextures) {
+    auto *sampler = gfx::Device::getInstance()->getSampler({});
+    EXPECT_TRUE(DynamicAtlasManager::isPackable(createTexture(SPRITE_USAGE, 64), sampler));
+    EXPECT_FALSE(DynamicAtlasManager::isPackable(createTexture(SPRITE_USAGE, DynamicAtlasManager::MAX_TEXTURE_SIZE * 2), sampler));
+    // render targets are drawn into without the atlas knowing
+    const auto renderTargetUsage = gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_SRC;
+    EXPECT_FALSE(DynamicAtlasManager::isPackable(createTexture(renderTargetUsage, 64), sampler));
+
+    gfx::SamplerInfo mipmapped;
+    mipmapped.mipFilter = gfx::Filter::LINEAR;
+    EXPECT_FALSE(DynamicAtlasManager::isPackable(createTexture(SPRITE_USAGE, 64), gfx::Device::getInstance()->getSampler(mipmapped)));
+}
+
+TEST(dynamicAtlasTest, candidatesOnlyWhileEnabled) {
+    DynamicAtlasManager atlas;
+    // textures keep their usage when the atlas is off
+    EXPECT_FALSE(atlas.isCandidate(DynamicAtlasManager::PAGE_FORMAT, 64, 64));
+    atlas.setEnabled(true);
+    if (!atlas.isEnabled()) {
+        GTEST_SKIP() << "the backend can't copy textures";
+    }
+    EXPECT_TRUE(atlas.isCandidate(DynamicAtlasManager::PAGE_FORMAT, 64, 64));
+    EXPECT_TRUE(atlas.isCandidate(DynamicAtlasManager::PAGE_FORMAT, DynamicAtlasManager::MAX_TEXTURE_SIZE, 1));
+    EXPECT_FALSE(atlas.isCandidate(DynamicAtlasManager::PAGE_FORMAT, DynamicAtlasManager::MAX_TEXTURE_SIZE + 1, 1));
+    EXPECT_FALSE(atlas.isCandidate(gfx::Format::RGB8, 64, 64));
+}
+
+TEST(dynamicAtlasTest, updatedAndReleasedTextures) {
+    DynamicAtlasManager atlas;
+    atlas.setEnabled(true);
+    if (!atlas.isEnabled()) {
+        GTEST_SKIP() << "the backend can't copy textures";
+    }
+    auto *sampler = gfx::Device::getInstance()->getSampler({});
+    auto texture = createTexture(SPRITE_USAGE, 64);
+    auto other = createTexture(SPRITE_USAGE, 32);
+
+    const auto *region = atlas.getRegion(texture, sampler);
+    ASSERT_NE(region, nullptr);
+    const uint32_t stamp = region->stamp;
+    EXPECT_EQ(atlas.getPendingCopyCount(), 1U);
+    EXPECT_EQ(atlas.getRegion(texture, sampler)->stamp, stamp);
+
+    // the copy not flushed yet reads the new contents
+    atlas.updateTexture(texture);
+    EXPECT_EQ(atlas.getPendingCopyCount(), 1U);
+    // not packed
+    atlas.updateTexture(other);
+    EXPECT_EQ(atlas.getPendingCopyCount(), 1U);
+
+    atlas.releaseTexture(texture);
+    EXPECT_EQ(atlas.getPendingCopyCount(), 0U);
+    atlas.updateTexture(texture);
+    EXPECT_EQ(atlas.getPendingCopyCount(), 0U);
+
+    // packed again somewhere else
+    region = atlas.getRegion(texture, sampler);
+    ASSERT_NE(region, nullptr);
+    EXPECT_NE(region->stamp, stamp);
+    EXPECT_EQ(atlas.getPendingCopyCount(), 1U);
+    EXPECT_NE(atlas.getRegion(other, sampler), nullptr);
+    EXPECT_EQ(atlas.getPendingCopyCount(), 2U);
+
+    atlas.flush();
+    EXPECT_EQ(atlas.getPendingCopyCount(), 0U);
+    atlas.updateTexture(other);
+    EXPECT_EQ(atlas.getPendingCopyCount(), 1U);
+    atlas.updateTexture(other);
+    EXPECT_EQ(atlas.getPendingCopyCount(), 1U);
+}
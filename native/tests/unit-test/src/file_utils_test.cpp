@@ -0,0 +1,106 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include "gtest/gtest.h"
+#include "utils.h"
+
+#include "platform/FileUtils.h"
+
+using namespace cc;
+
+namespace {
+
+class FileUtilsTest : public testing::Test {
+protected:
+    void SetUp() override {
+        auto *fileUtils = FileUtils::getInstance();
+        _root = fileUtils->getWritablePath() + "file-utils-test/";
+        _searchPaths = fileUtils->getOriginalSearchPaths();
+        for (uint32_t i = 0; i < FILE_COUNT; ++i) {
+            const ccstd::string path = _root + "dir" + std::to_string(i % 4) + "/file" + std::to_string(i) + ".txt";
+            fileUtils->createDirectory(fileUtils->getFileDir(path));
+            fileUtils->writeStringToFile(std::to_string(i), path);
+        }
+        fileUtils->addSearchPath(_root, true);
+    }
+
+    void TearDown() override {
+        auto *fileUtils = FileUtils::getInstance();
+        fileUtils->setDirectoryIndexEnabled(false);
+        fileUtils->setSearchPaths(_searchPaths);
+        fileUtils->removeDirectory(_root);
+    }
+
+    static ccstd::string fileName(uint32_t index) {
+        return "dir" + std::to_string(index % 4) + "/file" + std::to_string(index) + ".txt";
+    }
+
+    static constexpr uint32_t FILE_COUNT = 64;
+    ccstd::string _root;
+    ccstd::vector<ccstd::string> _searchPaths;
+};
+
+} // namespace
+
+TEST_F(FileUtilsTest, resolvesPathsFromWorkerThreads) {
+    auto *fileUtils = FileUtils::getInstance();
+    ccstd::vector<std::thread> workers;
+    std::atomic<uint32_t> failures{0};
+    for (uint32_t t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t]() {
+            for (uint32_t round = 0; round < 200; ++round) {
+                const uint32_t index = (round * 7 + t) % FILE_COUNT;
+                if (fileUtils->fullPathForFilename(fileName(index)) != _root + fileName(index) ||
+                    fileUtils->getStringFromFile(fileName(index)) != std::to_string(index)) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    // Search paths changing under the workers must neither crash nor leave stale entries behind.
+    for (uint32_t round = 0; round < 50; ++round) {
+        fileUtils->addSearchPath(_root + "missing/", round % 2 == 0);
+        fileUtils->purgeCachedEntries();
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(failures.load(), 0U);
+}
+
+TEST_F(FileUtilsTest, directoryIndexAnswersLookups) {
+    auto *fileUtils = FileUtils::getInstance();
+    fileUtils->setDirectoryIndexEnabled(true);
+    EXPECT_TRUE(fileUtils->isFileExist(fileName(1)));
+    EXPECT_FALSE(fileUtils->isFileExist("dir1/missing.txt"));
+
+    // Files written after the directory was listed are only seen once the index is purged.
+    fileUtils->writeStringToFile("late", _root + "dir1/late.txt");
+    EXPECT_FALSE(fileUtils->isFileExist("dir1/late.txt"));
+    fileUtils->purgeCachedEntries();
+    EXPECT_TRUE(fileUtils->isFileExist("dir1/late.txt"));
+    EXPECT_EQ(fileUtils->getStringFromFile("dir1/late.txt"), "late");
+}
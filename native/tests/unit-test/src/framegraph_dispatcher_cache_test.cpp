@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/renderer/pipeline/custom/FGDispatcherGraphs.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherUtils.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gfx-base/GFXDef-common.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+struct TestGraphs {
+    explicit TestGraphs(boost::container::pmr::memory_resource* resource)
+    : renderGraph(resource), rescGraph(resource), layoutGraphData(resource) {
+        TEST_CASE_5;
+        fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+    }
+
+    ccstd::hash_t hash() const {
+        return cc::render::getFrameGraphStructureHash(renderGraph, rescGraph, layoutGraphData);
+    }
+
+    cc::render::RenderGraph renderGraph;
+    cc::render::ResourceGraph rescGraph;
+    cc::render::LayoutGraphData layoutGraphData;
+};
+
+cc::render::RasterPass& firstRasterPass(cc::render::RenderGraph& renderGraph) {
+    using namespace cc::render;
+    for (const auto vertID : cc::makeRange(vertices(renderGraph))) {
+        if (holds<RasterPassTag>(vertID, renderGraph)) {
+            return get(RasterPassTag{}, vertID, renderGraph);
+        }
+    }
+    CC_ABORT();
+    return get(RasterPassTag{}, 0, renderGraph);
+}
+
+} // namespace
+
+TEST(fgDispatcherCache, test15) {
+    using namespace cc;
+    using namespace cc::render;
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+
+    TestGraphs graphs(resource);
+    const auto structureHash = graphs.hash();
+    ExpectEq(graphs.hash() == structureHash, true);
+
+    // clear values are rebound every frame, they do not invalidate the dispatch
+    auto& view = firstRasterPass(graphs.renderGraph).rasterViews.begin()->second;
+    view.clearColor.x += 1.0F;
+    ExpectEq(graphs.hash() == structureHash, true);
+
+    // access changes do
+    const auto storeOp = view.storeOp;
+    view.storeOp = storeOp == gfx::StoreOp::STORE ? gfx::StoreOp::DISCARD : gfx::StoreOp::STORE;
+    ExpectEq(graphs.hash() == structureHash, false);
+    view.storeOp = storeOp;
+    ExpectEq(graphs.hash() == structureHash, true);
+
+    // so do resource descriptors
+    auto& desc = get(ResourceGraph::DescTag{}, graphs.rescGraph, 0);
+    desc.width += 1;
+    ExpectEq(graphs.hash() == structureHash, false);
+    desc.width -= 1;
+    ExpectEq(graphs.hash() == structureHash, true);
+
+    // a reused dispatch leaves side-effect resources in the same states as a full run
+    FrameGraphDispatcher fgDispatcher(graphs.rescGraph, graphs.renderGraph, graphs.layoutGraphData, resource, resource);
+    fgDispatcher.enablePassReorder(true);
+    FrameGraphDispatchResult result(resource);
+    dispatchFrameGraph(fgDispatcher, result);
+
+    ccstd::vector<gfx::AccessFlagBit> states;
+    for (const auto resID : cc::makeRange(vertices(graphs.rescGraph))) {
+        auto& resStates = get(ResourceGraph::StatesTag{}, graphs.rescGraph, resID);
+        states.emplace_back(resStates.states);
+        resStates.states = gfx::AccessFlagBit::NONE;
+    }
+    replayResourceStates(graphs.rescGraph, result);
+    for (const auto resID : cc::makeRange(vertices(graphs.rescGraph))) {
+        const auto& traits = get(ResourceGraph::TraitsTag{}, graphs.rescGraph, resID);
+        const auto& resStates = get(ResourceGraph::StatesTag{}, graphs.rescGraph, resID);
+        if (traits.hasSideEffects()) {
+            ExpectEq(resStates.states == states[resID], true);
+        }
+    }
+    ExpectEq(result.finalStates.empty(), false);
+}
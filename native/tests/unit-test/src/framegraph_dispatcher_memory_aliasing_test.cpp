@@ -0,0 +1,165 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/renderer/pipeline/custom/FGDispatcherGraphs.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherUtils.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gfx-base/GFXDef-common.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+// fillTestGraph adds untyped managed resources, only textures and buffers are aliased
+void addTransientTextures(const cc::render::ResourceInfo& resources, cc::render::ResourceGraph& rescGraph) {
+    using namespace cc::render;
+    for (const auto& [name, desc, traits, states] : resources) {
+        ResourceGraph::vertex_descriptor resID = ResourceGraph::null_vertex();
+        if (traits.residency == ResourceResidency::MANAGED) {
+            resID = addVertex(
+                ManagedTextureTag{},
+                std::forward_as_tuple(name.c_str()),
+                std::forward_as_tuple(desc),
+                std::forward_as_tuple(traits),
+                std::forward_as_tuple(),
+                std::forward_as_tuple(),
+                std::forward_as_tuple(),
+                rescGraph);
+        } else {
+            resID = add_vertex(rescGraph, ManagedTag{}, name.c_str());
+            rescGraph.descs[resID] = desc;
+            rescGraph.traits[resID] = traits;
+        }
+        rescGraph.states[resID].states = cc::gfx::AccessFlagBit::NONE;
+    }
+}
+
+bool overlaps(const cc::render::ResourceLifeRecord& lhs, const cc::render::ResourceLifeRecord& rhs) {
+    return lhs.start <= rhs.end && rhs.start <= lhs.end;
+}
+
+} // namespace
+
+TEST(fgDispatcherAliasing, test16) {
+    TEST_CASE_DEFINE;
+
+    // a chain of full screen passes, every intermediate target lives for two passes:
+    // "0" [0, 1], "1" [1, 2], "2" [2, 3], "3" [3, 4]
+    ViewInfo rasterData = {
+        {PassType::RASTER, {{{}, {"0"}}}},
+        {PassType::RASTER, {{{"0"}, {"1"}}}},
+        {PassType::RASTER, {{{"1"}, {"2"}}}},
+        {PassType::RASTER, {{{"2"}, {"3"}}}},
+        {PassType::RASTER, {{{"3"}, {"22"}}}},
+    };
+    LayoutInfo layoutInfo = {
+        {{"0", 0, ShaderStageFlagBit::FRAGMENT}},
+        {{"0", 0, ShaderStageFlagBit::FRAGMENT}, {"1", 1, ShaderStageFlagBit::FRAGMENT}},
+        {{"1", 1, ShaderStageFlagBit::FRAGMENT}, {"2", 2, ShaderStageFlagBit::FRAGMENT}},
+        {{"2", 2, ShaderStageFlagBit::FRAGMENT}, {"3", 3, ShaderStageFlagBit::FRAGMENT}},
+        {{"3", 3, ShaderStageFlagBit::FRAGMENT}, {"22", 22, ShaderStageFlagBit::FRAGMENT}},
+    };
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+    addTransientTextures(resources, rescGraph);
+    fillTestGraph(rasterData, {}, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enableMemoryAliasing(true);
+    FrameGraphDispatchResult result(resource);
+    dispatchFrameGraph(fgDispatcher, result);
+
+    const auto& rag = fgDispatcher.resourceAccessGraph;
+    const auto lifeOf = [&](ResourceGraph::vertex_descriptor resID) {
+        return rag.resourceLifeRecord.at(get(ResourceGraph::NameTag{}, rescGraph, resID));
+    };
+
+    // only the transient targets are tracked, the back buffer keeps its own memory
+    ExpectEq(rag.resourceLifeRecord.size() == 4, true);
+    ExpectEq(rag.resourceLifeRecord.count("22") == 0, true);
+
+    // resources sharing memory never overlap, neither with the owner nor with each other
+    for (const auto& [resID, ownerID] : result.aliasedResources) {
+        ExpectEq(resID != ownerID, true);
+        ExpectEq(overlaps(lifeOf(resID), lifeOf(ownerID)), false);
+        for (const auto& [otherID, otherOwnerID] : result.aliasedResources) {
+            if (otherID != resID && otherOwnerID == ownerID) {
+                ExpectEq(overlaps(lifeOf(resID), lifeOf(otherID)), false);
+            }
+        }
+    }
+
+    // neighbours overlap and keep their memory, disjoint targets ping-pong between two slots
+    ExpectEq(result.aliasedResources.count(0) == 0 && result.aliasedResources.count(1) == 0, true);
+    ExpectEq(result.aliasedResources.size() == 2, true);
+    ExpectEq(result.aliasedResources.at(2) == 0, true);
+    ExpectEq(result.aliasedResources.at(3) == 1, true);
+    ExpectEq(result.aliasedTransientMemorySize * 2 == result.transientMemorySize, true);
+
+    // the new occupant waits for the last access of the previous one
+    const auto& initialStatus = rag.resourceAccess.at("2").begin()->second;
+    ExpectEq(initialStatus.accessFlag != AccessFlagBit::NONE, true);
+}
+
+TEST(fgDispatcherAliasing, test17) {
+    TEST_CASE_DEFINE;
+
+    // "0" is read by the last pass, so it overlaps every other target
+    ViewInfo rasterData = {
+        {PassType::RASTER, {{{}, {"0"}}}},
+        {PassType::RASTER, {{{"0"}, {"1"}}}},
+        {PassType::RASTER, {{{"1"}, {"2"}}}},
+        {PassType::RASTER, {{{"0", "2"}, {"22"}}}},
+    };
+    LayoutInfo layoutInfo = {
+        {{"0", 0, ShaderStageFlagBit::FRAGMENT}},
+        {{"0", 0, ShaderStageFlagBit::FRAGMENT}, {"1", 1, ShaderStageFlagBit::FRAGMENT}},
+        {{"1", 1, ShaderStageFlagBit::FRAGMENT}, {"2", 2, ShaderStageFlagBit::FRAGMENT}},
+        {{"0", 0, ShaderStageFlagBit::FRAGMENT}, {"2", 2, ShaderStageFlagBit::FRAGMENT}, {"22", 22, ShaderStageFlagBit::FRAGMENT}},
+    };
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+    addTransientTextures(resources, rescGraph);
+    fillTestGraph(rasterData, {}, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    // nothing is aliased unless enabled
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    FrameGraphDispatchResult result(resource);
+    dispatchFrameGraph(fgDispatcher, result);
+    ExpectEq(result.aliasedResources.empty(), true);
+
+    fgDispatcher.enableMemoryAliasing(true);
+    dispatchFrameGraph(fgDispatcher, result);
+    const auto& rag = fgDispatcher.resourceAccessGraph;
+    ExpectEq(rag.resourceLifeRecord.size() == 3, true);
+    // "2" only overlaps "0" and "1" at its first pass, sharing a pass still counts as overlapping
+    ExpectEq(result.aliasedResources.empty(), true);
+    ExpectEq(result.aliasedTransientMemorySize == result.transientMemorySize, true);
+}
@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/renderer/pipeline/custom/FGDispatcherGraphs.h"
+#include "cocos/renderer/pipeline/custom/FGDispatcherUtils.h"
+#include "cocos/renderer/pipeline/custom/test/test.h"
+#include "gfx-base/GFXDef-common.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+
+struct ScheduleResult {
+    ccstd::vector<uint32_t> order;
+    ccstd::vector<uint32_t> groups;
+    size_t numBarriers{0};
+};
+
+ScheduleResult schedule(bool reorder, float paralellWeight) {
+    TEST_CASE_5;
+
+    boost::container::pmr::memory_resource* resource = boost::container::pmr::get_default_resource();
+    RenderGraph renderGraph(resource);
+    ResourceGraph rescGraph(resource);
+    LayoutGraphData layoutGraphData(resource);
+
+    fillTestGraph(rasterData, resources, layoutInfo, renderGraph, rescGraph, layoutGraphData);
+
+    FrameGraphDispatcher fgDispatcher(rescGraph, renderGraph, layoutGraphData, resource, resource);
+    fgDispatcher.enablePassReorder(reorder);
+    fgDispatcher.setParalellWeight(paralellWeight);
+    FrameGraphDispatchResult dispatchResult(resource);
+    dispatchFrameGraph(fgDispatcher, dispatchResult);
+
+    const auto& rag = fgDispatcher.resourceAccessGraph;
+    ScheduleResult result;
+    result.order.assign(rag.topologicalOrder.begin(), rag.topologicalOrder.end());
+    result.groups.assign(dispatchResult.parallelGroups.begin(), dispatchResult.parallelGroups.end());
+    ExpectEq(result.order.size() == num_vertices(rag), true);
+    ExpectEq(result.groups.size() == result.order.size(), true);
+
+    ccstd::vector<uint32_t> position(num_vertices(rag), 0xFFFFFFFF);
+    for (uint32_t i = 0; i != result.order.size(); ++i) {
+        position[result.order[i]] = i;
+    }
+
+    // every pass runs after the passes it depends on
+    for (const auto vertID : cc::makeRange(vertices(rag))) {
+        for (const auto e : cc::makeRange(out_edges(vertID, rag))) {
+            ExpectEq(position[vertID] < position[target(e, rag)], true);
+        }
+    }
+
+    // accesses of a resource keep their declaration order
+    for (const auto& [resName, accessRecord] : rag.resourceAccess) {
+        uint32_t last = 0;
+        for (const auto& [vertID, status] : accessRecord) {
+            if (vertID == 0) {
+                continue;
+            }
+            ExpectEq(position[vertID] > last, true);
+            last = position[vertID];
+        }
+    }
+
+    // barriers never end before they begin
+    auto checkBarriers = [&](const auto& barriers) {
+        for (const auto& barrier : barriers) {
+            const auto beginVert = rag.passIndex.at(barrier.beginVert);
+            const auto endVert = rag.passIndex.at(barrier.endVert);
+            ExpectEq(position[beginVert] <= position[endVert], true);
+            ++result.numBarriers;
+        }
+    };
+    for (const auto& node : rag.barrier) {
+        checkBarriers(node.frontBarriers);
+        checkBarriers(node.rearBarriers);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(fgDispatcherReorder, test14) {
+    // 0: start, 1 -> 3 and 2 -> 4 are independent branches, 5 joins them, 6: end
+    const auto declared = schedule(false, 0.0F);
+    ExpectEq(declared.order == ccstd::vector<uint32_t>{0, 1, 2, 3, 4, 5, 6}, true);
+
+    // memory first, a branch is finished before the next one starts,
+    // producers and consumers become adjacent so split barriers turn into full ones
+    const auto memorySaving = schedule(true, 0.0F);
+    ExpectEq(memorySaving.order == ccstd::vector<uint32_t>{0, 1, 3, 2, 4, 5, 6}, true);
+    ExpectEq(memorySaving.numBarriers < declared.numBarriers, true);
+
+    // overlap first, passes of both branches are grouped level by level
+    const auto parallel = schedule(true, 1.0F);
+    ExpectEq(parallel.order == ccstd::vector<uint32_t>{0, 1, 2, 3, 4, 5, 6}, true);
+    ExpectEq(parallel.groups == ccstd::vector<uint32_t>{0, 1, 1, 2, 2, 3, 4}, true);
+    ExpectEq(parallel.numBarriers == declared.numBarriers, true);
+}
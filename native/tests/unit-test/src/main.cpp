@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "bindings/jswrapper/SeApi.h"
 #include "core/Root.h"
 #include "gtest/gtest.h"
+#include "platform/FileUtils.h"
 #include "renderer/GFXDeviceManager.h"
 
 using namespace cc;
@@ -46,6 +47,8 @@ int main(int argc, const char* argv[]) {
     cocos_main(argc, argv);
 
     Root* root = new Root(DeviceManager::create());
+    // No Engine is created here, so create the FileUtils it would own.
+    FileUtils* fileUtils = createFileUtils();
     se::ScriptEngine* scriptEngine = new se::ScriptEngine();
     scriptEngine->start();
     {
@@ -56,5 +59,6 @@ int main(int argc, const char* argv[]) {
     scriptEngine->cleanup();
     delete root;
     delete scriptEngine;
+    delete fileUtils;
     return ret;
 }
@@ -28,6 +28,8 @@ THE SOFTWARE.
 #include "cocos/math/MathUtil.h"
 #include "cocos/math/Utils.h"
 #include "cocos/math/Vec2.h"
+#include "cocos/core/geometry/AABB.h"
+#include "cocos/core/geometry/Frustum.h"
 #include "gtest/gtest.h"
 #include "utils.h"
 
@@ -109,4 +111,93 @@ TEST(mathUtilsTest, test9) {
     ExpectEq(IsEqualF(cc::mathutils::absMax(1.0F, 3.0F), 3.0F), true);
     ExpectEq(IsEqualF(cc::mathutils::absMax(-1.0F, 3.0F), 3.0F), true);
     ExpectEq(IsEqualF(cc::mathutils::absMax(1.0F, -3.0F), -3.0F), true);
-}
\ No newline at end of file
+}
+TEST(mathUtilsTest, aabbFrustumSoA) {
+    logLabel = "test the MathUtil aabbFrustumSoA function";
+    cc::geometry::Frustum frustum;
+    cc::geometry::Frustum::createPerspective(&frustum, 1.0F, 1.5F, 0.1F, 100.0F, cc::Mat4::IDENTITY);
+
+    // odd count to cover the scalar tail of the SIMD kernels
+    constexpr uint32_t count = 37;
+    std::vector<float> center[3];
+    std::vector<float> halfExtents[3];
+    std::vector<bool> expected;
+    for (uint32_t i = 0; i < count; ++i) {
+        const cc::Vec3 c{static_cast<float>(i % 7) * 10.0F - 30.0F, static_cast<float>(i % 5) - 2.0F, -static_cast<float>(i) * 4.0F + 20.0F};
+        const cc::Vec3 h{0.5F + static_cast<float>(i % 3), 1.0F, 0.5F};
+        cc::geometry::AABB aabb(c.x, c.y, c.z, h.x, h.y, h.z);
+        expected.push_back(aabb.aabbFrustum(frustum));
+        center[0].push_back(c.x);
+        center[1].push_back(c.y);
+        center[2].push_back(c.z);
+        halfExtents[0].push_back(h.x);
+        halfExtents[1].push_back(h.y);
+        halfExtents[2].push_back(h.z);
+    }
+
+    float planes[24];
+    for (uint32_t i = 0; i < 6; ++i) {
+        planes[i * 4 + 0] = frustum.planes[i]->n.x;
+        planes[i * 4 + 1] = frustum.planes[i]->n.y;
+        planes[i * 4 + 2] = frustum.planes[i]->n.z;
+        planes[i * 4 + 3] = frustum.planes[i]->d;
+    }
+    const float *const centerPtr[3] = {center[0].data(), center[1].data(), center[2].data()};
+    const float *const halfExtentsPtr[3] = {halfExtents[0].data(), halfExtents[1].data(), halfExtents[2].data()};
+    std::vector<uint8_t> visible(count);
+    cc::MathUtil::aabbFrustumSoA(planes, centerPtr, halfExtentsPtr, count, visible.data());
+
+    for (uint32_t i = 0; i < count; ++i) {
+        ExpectEq(visible[i] != 0, expected[i]);
+    }
+}
+
+TEST(mathUtilsTest, multiplyJointMatrix) {
+    cc::Mat4 world;
+    cc::Mat4::fromRTS(cc::Quaternion(0.1F, 0.7F, -0.2F, 0.68F).getNormalized(), cc::Vec3(1.0F, -2.0F, 3.5F), cc::Vec3(1.0F, 2.0F, 0.5F), &world);
+    cc::Mat4 bindpose;
+    cc::Mat4::fromRTS(cc::Quaternion(-0.3F, 0.1F, 0.9F, 0.2F).getNormalized(), cc::Vec3(-0.5F, 4.0F, 0.25F), cc::Vec3(0.8F, 0.8F, 1.2F), &bindpose);
+
+    cc::Mat4 expected;
+    cc::Mat4::multiply(world, bindpose, &expected);
+
+    float packed[12];
+    cc::MathUtil::multiplyJointMatrix(world.m, bindpose.m, packed);
+    for (uint32_t c = 0; c < 3; ++c) {
+        for (uint32_t r = 0; r < 3; ++r) {
+            EXPECT_NEAR(packed[c * 4 + r], expected.m[c * 4 + r], 1e-5F);
+        }
+        EXPECT_NEAR(packed[c * 4 + 3], expected.m[12 + c], 1e-5F);
+    }
+}
+
+TEST(mathUtilsTest, transformPoints) {
+    cc::Mat4 affine;
+    cc::Mat4::fromRTS(cc::Quaternion(0.0F, 0.0F, 0.38F, 0.92F).getNormalized(), cc::Vec3(12.0F, -7.5F, 0.0F), cc::Vec3(2.0F, 0.5F, 1.0F), &affine);
+    cc::Mat4 projective;
+    cc::Mat4::createPerspective(60.0F, 1.5F, 0.1F, 100.0F, &projective);
+
+    // 2D vertices: position, uv and color, 7 points so the scalar tail is covered too
+    constexpr uint32_t stride = 9;
+    constexpr uint32_t count = 7;
+    std::vector<float> src(stride * count);
+    for (uint32_t i = 0; i < src.size(); ++i) {
+        src[i] = static_cast<float>(i % 13) - 6.0F;
+    }
+
+    for (const auto *m : {&affine, &projective}) {
+        std::vector<float> dst(src.size(), 42.0F);
+        cc::MathUtil::transformPoints(m->m, src.data(), dst.data(), stride, count);
+        for (uint32_t i = 0; i < count; ++i) {
+            cc::Vec3 expected(src[i * stride], src[i * stride + 1], src[i * stride + 2]);
+            expected.transformMat4(expected, *m);
+            EXPECT_NEAR(dst[i * stride], expected.x, 1e-4F);
+            EXPECT_NEAR(dst[i * stride + 1], expected.y, 1e-4F);
+            EXPECT_NEAR(dst[i * stride + 2], expected.z, 1e-4F);
+            // the other attributes are left alone
+            for (uint32_t k = 3; k < stride; ++k) {
+                EXPECT_EQ(dst[i * stride + k], 42.0F);
+            }
+        }
+    }
+}
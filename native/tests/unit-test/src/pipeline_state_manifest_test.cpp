@@ -0,0 +1,147 @@
+/****************************************************************************
+Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "utils.h"
+
+#include <cstdio>
+#include "renderer/pipeline/PipelineStateManifest.h"
+
+using namespace cc;
+using namespace cc::pipeline;
+
+namespace {
+
+PipelineStateRecord makeRecord(uint32_t phaseID) {
+    PipelineStateRecord record;
+    record.programName = "builtin-standard|standard-vs|standard-fs";
+    record.shaderName = "builtin-standard|standard-vs|standard-fs|USE_INSTANCING1";
+    record.phaseID = phaseID;
+    record.defines["USE_INSTANCING"] = true;
+    record.defines["CC_FORWARD_ADD"] = 0;
+    record.defines["CC_PIPELINE_TYPE"] = ccstd::string{"forward"};
+    record.passHash = 0x1234;
+    record.attributesHash = 0x5678;
+    record.attributes.push_back({"a_position", gfx::Format::RGB32F});
+    record.attributes.push_back({"a_normal", gfx::Format::RGB32F, false, 0, false, 1});
+
+    gfx::ColorAttachment color;
+    color.format = gfx::Format::RGBA8;
+    color.loadOp = gfx::LoadOp::LOAD;
+    record.renderPass.colorAttachments.push_back(color);
+    record.renderPass.depthStencilAttachment.format = gfx::Format::DEPTH_STENCIL;
+    gfx::SubpassInfo subpass;
+    subpass.colors.push_back(0);
+    subpass.depthStencil = 1;
+    record.renderPass.subpasses.push_back(subpass);
+    record.barriers.emplace_back(gfx::GeneralBarrierInfo{gfx::AccessFlagBit::NONE, gfx::AccessFlagBit::COLOR_ATTACHMENT_WRITE});
+    record.barriers.emplace_back();
+    record.barriers.emplace_back();
+
+    record.rasterizerState.cullMode = gfx::CullMode::NONE;
+    record.depthStencilState.depthWrite = 0;
+    record.blendState.targets[0].blend = 1;
+    record.blendState.targets[0].blendDst = gfx::BlendFactor::ONE_MINUS_SRC_ALPHA;
+    record.primitive = gfx::PrimitiveMode::TRIANGLE_STRIP;
+    record.dynamicStates = gfx::DynamicStateFlagBit::LINE_WIDTH;
+    return record;
+}
+
+} // namespace
+
+TEST(pipelineStateManifest, dedup) {
+    PipelineStateManifest manifest;
+    EXPECT_TRUE(manifest.add(makeRecord(1)));
+    EXPECT_FALSE(manifest.add(makeRecord(1)));
+    EXPECT_TRUE(manifest.add(makeRecord(2)));
+    EXPECT_EQ(manifest.getRecords().size(), 2);
+    EXPECT_TRUE(manifest.isDirty());
+}
+
+TEST(pipelineStateManifest, saveAndLoad) {
+    const ccstd::string path = "pipeline_state_manifest_test.bin";
+    {
+        PipelineStateManifest manifest;
+        manifest.add(makeRecord(1));
+        manifest.add(makeRecord(2));
+        EXPECT_TRUE(manifest.save(path));
+        EXPECT_FALSE(manifest.isDirty());
+    }
+
+    PipelineStateManifest manifest;
+    EXPECT_TRUE(manifest.load(path));
+    std::remove(path.c_str());
+    EXPECT_FALSE(manifest.isDirty());
+    ASSERT_EQ(manifest.getRecords().size(), 2);
+
+    const auto expected = makeRecord(2);
+    const auto &record = manifest.getRecords()[1];
+    EXPECT_EQ(PipelineStateManifest::getRecordHash(record), PipelineStateManifest::getRecordHash(expected));
+    EXPECT_EQ(record.programName, expected.programName);
+    EXPECT_EQ(record.defines, expected.defines);
+    ASSERT_EQ(record.attributes.size(), 2);
+    EXPECT_EQ(record.attributes[1].name, "a_normal");
+    EXPECT_EQ(record.attributes[1].format, gfx::Format::RGB32F);
+    EXPECT_EQ(record.attributes[1].location, 1);
+    EXPECT_EQ(record.renderPass, expected.renderPass);
+    ASSERT_EQ(record.barriers.size(), 3);
+    EXPECT_TRUE(record.barriers[0].has_value());
+    EXPECT_EQ(record.barriers[0]->nextAccesses, gfx::AccessFlagBit::COLOR_ATTACHMENT_WRITE);
+    EXPECT_FALSE(record.barriers[1].has_value());
+    EXPECT_EQ(record.rasterizerState.cullMode, gfx::CullMode::NONE);
+    EXPECT_EQ(record.depthStencilState.depthWrite, 0);
+    ASSERT_EQ(record.blendState.targets.size(), 1);
+    EXPECT_EQ(record.blendState.targets[0].blend, 1);
+    EXPECT_EQ(record.blendState.targets[0].blendDst, gfx::BlendFactor::ONE_MINUS_SRC_ALPHA);
+    EXPECT_EQ(record.primitive, expected.primitive);
+    EXPECT_EQ(record.dynamicStates, expected.dynamicStates);
+
+    // duplicated records are dropped on load
+    EXPECT_FALSE(manifest.add(makeRecord(1)));
+}
+
+TEST(pipelineStateManifest, truncated) {
+    const ccstd::string path = "pipeline_state_manifest_truncated.bin";
+    {
+        PipelineStateManifest manifest;
+        manifest.add(makeRecord(1));
+        manifest.add(makeRecord(2));
+        EXPECT_TRUE(manifest.save(path));
+    }
+    // cut the last record in half
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, 0, SEEK_END);
+    const auto size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    ccstd::vector<char> data(size);
+    std::fread(data.data(), 1, size, file);
+    std::fclose(file);
+    file = std::fopen(path.c_str(), "wb");
+    std::fwrite(data.data(), 1, size - 16, file);
+    std::fclose(file);
+
+    PipelineStateManifest manifest;
+    EXPECT_TRUE(manifest.load(path));
+    std::remove(path.c_str());
+    EXPECT_EQ(manifest.getRecords().size(), 1);
+}
@@ -0,0 +1,156 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <cmath>
+#include "gtest/gtest.h"
+#include "utils.h"
+
+#include "base/PixelConvert.h"
+#include "base/std/container/vector.h"
+
+using namespace cc;
+using pixel::Conversion;
+
+namespace {
+
+// An odd count, so the SIMD loops leave a scalar tail.
+constexpr uint32_t PIXEL_COUNT = 1037;
+
+ccstd::vector<uint8_t> noise(uint32_t size) {
+    ccstd::vector<uint8_t> bytes(size);
+    uint32_t state = 0x12345678;
+    for (auto &byte : bytes) {
+        state = state * 1664525 + 1013904223;
+        byte = static_cast<uint8_t>(state >> 24);
+    }
+    return bytes;
+}
+
+// Per pixel reference of every conversion.
+void convertReference(Conversion conversion, const uint8_t *in, uint8_t *out) {
+    switch (conversion) {
+        case Conversion::L8_TO_RGBA8:
+            out[0] = out[1] = out[2] = in[0];
+            out[3] = 255;
+            break;
+        case Conversion::LA8_TO_RGBA8:
+            out[0] = out[1] = out[2] = in[0];
+            out[3] = in[1];
+            break;
+        case Conversion::RGB8_TO_RGBA8:
+            out[0] = in[0];
+            out[1] = in[1];
+            out[2] = in[2];
+            out[3] = 255;
+            break;
+        case Conversion::SWAP_RB:
+            out[0] = in[2];
+            out[1] = in[1];
+            out[2] = in[0];
+            out[3] = in[3];
+            break;
+        case Conversion::PREMULTIPLY:
+            for (uint32_t c = 0; c < 3; ++c) {
+                out[c] = static_cast<uint8_t>(std::lround(in[c] * in[3] / 255.0));
+            }
+            out[3] = in[3];
+            break;
+        case Conversion::UNPREMULTIPLY:
+            for (uint32_t c = 0; c < 3; ++c) {
+                out[c] = in[3] ? static_cast<uint8_t>(std::min(255L, std::lrintf(static_cast<float>(in[c]) * (255.F / static_cast<float>(in[3]))))) : in[c];
+            }
+            out[3] = in[3];
+            break;
+    }
+}
+
+ccstd::vector<uint8_t> reference(Conversion conversion, const ccstd::vector<uint8_t> &src, uint32_t count) {
+    const uint32_t srcBpp = pixel::getSourceBytesPerPixel(conversion);
+    ccstd::vector<uint8_t> dst(count * 4);
+    for (uint32_t i = 0; i < count; ++i) {
+        convertReference(conversion, &src[i * srcBpp], &dst[i * 4]);
+    }
+    return dst;
+}
+
+const Conversion ALL_CONVERSIONS[] = {
+    Conversion::L8_TO_RGBA8,
+    Conversion::LA8_TO_RGBA8,
+    Conversion::RGB8_TO_RGBA8,
+    Conversion::SWAP_RB,
+    Conversion::PREMULTIPLY,
+    Conversion::UNPREMULTIPLY,
+};
+
+} // namespace
+
+TEST(pixelConvertTest, matchesReference) {
+    for (const auto conversion : ALL_CONVERSIONS) {
+        const auto src = noise(PIXEL_COUNT * pixel::getSourceBytesPerPixel(conversion));
+        ccstd::vector<uint8_t> dst(PIXEL_COUNT * 4);
+        pixel::convertPixels(conversion, src.data(), dst.data(), PIXEL_COUNT);
+        EXPECT_EQ(dst, reference(conversion, src, PIXEL_COUNT)) << "conversion " << static_cast<int>(conversion);
+    }
+}
+
+TEST(pixelConvertTest, convertsInPlace) {
+    for (const auto conversion : {Conversion::SWAP_RB, Conversion::PREMULTIPLY, Conversion::UNPREMULTIPLY}) {
+        auto pixels = noise(PIXEL_COUNT * 4);
+        const auto expected = reference(conversion, pixels, PIXEL_COUNT);
+        pixel::convertPixels(conversion, pixels.data(), pixels.data(), PIXEL_COUNT);
+        EXPECT_EQ(pixels, expected) << "conversion " << static_cast<int>(conversion);
+    }
+}
+
+TEST(pixelConvertTest, splitsLargeImagesByRows) {
+    constexpr uint32_t width = 601;
+    constexpr uint32_t height = 479;
+    for (const auto conversion : ALL_CONVERSIONS) {
+        const auto src = noise(width * height * pixel::getSourceBytesPerPixel(conversion));
+        ccstd::vector<uint8_t> dst(width * height * 4);
+        pixel::convertImage(conversion, src.data(), dst.data(), width, height);
+        EXPECT_EQ(dst, reference(conversion, src, width * height)) << "conversion " << static_cast<int>(conversion);
+    }
+}
+
+TEST(pixelConvertTest, premultiplyRoundTrip) {
+    // Opaque pixels and full intensity colors survive premultiply and unpremultiply unchanged.
+    ccstd::vector<uint8_t> pixels;
+    for (uint32_t a = 0; a < 256; ++a) {
+        pixels.insert(pixels.end(), {255, 128, 0, 255});
+        pixels.insert(pixels.end(), {255, 255, 255, static_cast<uint8_t>(a)});
+    }
+    const auto original = pixels;
+    const auto count = static_cast<uint32_t>(pixels.size() / 4);
+    pixel::convertPixels(Conversion::PREMULTIPLY, pixels.data(), pixels.data(), count);
+    pixel::convertPixels(Conversion::UNPREMULTIPLY, pixels.data(), pixels.data(), count);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (original[i * 4 + 3] == 0) {
+            continue;
+        }
+        for (uint32_t c = 0; c < 4; ++c) {
+            EXPECT_EQ(pixels[i * 4 + c], original[i * 4 + c]) << "pixel " << i << " channel " << c;
+        }
+    }
+}
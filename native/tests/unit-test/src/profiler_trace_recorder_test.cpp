@@ -0,0 +1,202 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <atomic>
+#include <thread>
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "gtest/gtest.h"
+#include "platform/FileUtils.h"
+#include "profiler/TraceRecorder.h"
+
+using cc::FileUtils;
+using cc::TraceRecorder;
+
+namespace {
+
+ccstd::string tracePath() {
+    return FileUtils::getInstance()->getWritablePath() + "trace-recorder-test.json";
+}
+
+struct TraceEvent {
+    ccstd::string text;
+    char phase{0};
+    int tid{-1};
+};
+
+ccstd::string field(const ccstd::string &text, const char *name) {
+    const ccstd::string key = ccstd::string{"\""} + name + "\":";
+    const auto pos = text.find(key);
+    if (pos == ccstd::string::npos) {
+        return {};
+    }
+    const auto begin = pos + key.size();
+    return text.substr(begin, text.find_first_of(",}", begin) - begin);
+}
+
+// The dump writes one event per line, this splits it back into events.
+ccstd::vector<TraceEvent> readTrace(const ccstd::string &path) {
+    const ccstd::string header = R"({"displayTimeUnit":"ms","traceEvents":[)";
+    const ccstd::string footer = "]}\n";
+    auto json = FileUtils::getInstance()->getStringFromFile(path);
+    EXPECT_EQ(json.compare(0, header.size(), header), 0);
+    EXPECT_GE(json.size(), header.size() + footer.size());
+    EXPECT_EQ(json.compare(json.size() - footer.size(), footer.size(), footer), 0);
+    json = json.substr(header.size(), json.size() - header.size() - footer.size());
+
+    ccstd::vector<TraceEvent> events;
+    size_t begin = 0;
+    while (begin < json.size()) {
+        auto end = json.find(",\n", begin);
+        if (end == ccstd::string::npos) {
+            end = json.size();
+        }
+        TraceEvent event;
+        event.text = json.substr(begin, end - begin);
+        EXPECT_EQ(event.text.front(), '{') << event.text;
+        EXPECT_EQ(event.text.back(), '}') << event.text;
+        const auto phase = field(event.text, "ph");
+        EXPECT_EQ(phase.size(), 3U) << event.text;
+        event.phase = phase.size() == 3 ? phase[1] : 0;
+        event.tid = std::stoi(field(event.text, "tid"));
+        events.emplace_back(std::move(event));
+        begin = end + 2;
+    }
+    return events;
+}
+
+// Every begin has its end on the same thread, and they nest.
+void expectBalanced(const ccstd::vector<TraceEvent> &events) {
+    ccstd::unordered_map<int, int> depths;
+    for (const auto &event : events) {
+        if (event.phase == 'B') {
+            ++depths[event.tid];
+        } else if (event.phase == 'E') {
+            ASSERT_GT(depths[event.tid], 0) << event.text;
+            --depths[event.tid];
+        }
+    }
+    for (const auto &depth : depths) {
+        EXPECT_EQ(depth.second, 0) << "thread " << depth.first;
+    }
+}
+
+bool hasEvent(const ccstd::vector<TraceEvent> &events, const ccstd::string &part) {
+    for (const auto &event : events) {
+        if (event.text.find(part) != ccstd::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(TraceRecorderTest, dumpsChromeTrace) {
+    TraceRecorder::setThreadName("TestMain");
+    TraceRecorder::setEnabled(true);
+    TraceRecorder::markFrame();
+    TraceRecorder::begin("Outer");
+    TraceRecorder::counter("Count", 42);
+    TraceRecorder::begin("Inner\"Quoted");
+    std::thread([]() {
+        TraceRecorder::setThreadName("TestWorker");
+        TraceRecorder::begin("WorkerBlock");
+        TraceRecorder::end("WorkerBlock");
+    }).join();
+    TraceRecorder::end("Inner\"Quoted");
+    // left open, the dump closes it
+    TraceRecorder::begin("Unfinished");
+
+    ASSERT_TRUE(TraceRecorder::dump(tracePath()));
+    EXPECT_TRUE(TraceRecorder::isEnabled());
+    TraceRecorder::end("Unfinished");
+    TraceRecorder::end("Outer");
+    TraceRecorder::setEnabled(false);
+
+    const auto events = readTrace(tracePath());
+    expectBalanced(events);
+    EXPECT_TRUE(hasEvent(events, R"("name":"thread_name","ph":"M")"));
+    EXPECT_TRUE(hasEvent(events, R"("args":{"name":"TestMain"})"));
+    EXPECT_TRUE(hasEvent(events, R"("args":{"name":"TestWorker"})"));
+    EXPECT_TRUE(hasEvent(events, R"({"name":"Outer","ph":"B")"));
+    EXPECT_TRUE(hasEvent(events, R"({"name":"Inner\"Quoted","ph":"E")"));
+    EXPECT_TRUE(hasEvent(events, R"({"name":"WorkerBlock","ph":"E")"));
+    EXPECT_TRUE(hasEvent(events, R"({"name":"Count","ph":"C")"));
+    EXPECT_TRUE(hasEvent(events, R"("args":{"value":42})"));
+    EXPECT_TRUE(hasEvent(events, R"({"name":"Frame","ph":"i")"));
+    FileUtils::getInstance()->removeFile(tracePath());
+}
+
+TEST(TraceRecorderTest, dumpsLastFrames) {
+    static const char *const FRAME_BLOCKS[] = {"FrameBlock0", "FrameBlock1", "FrameBlock2"};
+    TraceRecorder::setEnabled(true);
+    for (const char *block : FRAME_BLOCKS) {
+        TraceRecorder::markFrame();
+        TraceRecorder::begin(block);
+        TraceRecorder::end(block);
+    }
+    TraceRecorder::setEnabled(false);
+
+    ASSERT_TRUE(TraceRecorder::dump(tracePath(), 2));
+    const auto events = readTrace(tracePath());
+    expectBalanced(events);
+    EXPECT_FALSE(hasEvent(events, "FrameBlock0"));
+    EXPECT_TRUE(hasEvent(events, "FrameBlock1"));
+    EXPECT_TRUE(hasEvent(events, "FrameBlock2"));
+    uint32_t frames = 0;
+    for (const auto &event : events) {
+        frames += event.phase == 'i' ? 1 : 0;
+    }
+    EXPECT_EQ(frames, 2U);
+    FileUtils::getInstance()->removeFile(tracePath());
+}
+
+TEST(TraceRecorderTest, dumpWhileRecording) {
+    TraceRecorder::setEnabled(true);
+    std::atomic<bool> stop{false};
+    ccstd::vector<std::thread> workers;
+    for (uint32_t i = 0; i < 3; ++i) {
+        workers.emplace_back([&stop]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                TraceRecorder::begin("Busy");
+                TraceRecorder::counter("Iteration", 1);
+                TraceRecorder::end("Busy");
+            }
+        });
+    }
+    for (uint32_t i = 0; i < 5; ++i) {
+        ASSERT_TRUE(TraceRecorder::dump(tracePath()));
+        const auto events = readTrace(tracePath());
+        expectBalanced(events);
+        EXPECT_TRUE(hasEvent(events, R"({"name":"Busy","ph":"B")"));
+    }
+    stop = true;
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    TraceRecorder::setEnabled(false);
+    FileUtils::getInstance()->removeFile(tracePath());
+}
@@ -0,0 +1,195 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <algorithm>
+#include <random>
+#include "base/std/container/vector.h"
+#include "core/Root.h"
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "math/Math.h"
+#include "scene/BVH.h"
+#include "scene/Camera.h"
+#include "scene/Model.h"
+
+using namespace cc;
+
+namespace {
+
+using ModelList = ccstd::vector<IntrusivePtr<scene::Model>>;
+using ResultList = ccstd::vector<const scene::Model *>;
+
+// far outside the default octree bounds, the BVH has no fixed world box
+constexpr float SCENE_EXTENT = 5000.F;
+
+ModelList createModels(uint32_t count, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position{-SCENE_EXTENT, SCENE_EXTENT};
+    std::uniform_real_distribution<float> size{0.5F, 20.F};
+    ModelList models;
+    for (uint32_t i = 0; i < count; ++i) {
+        auto *node = ccnew Node();
+        node->setPosition(position(rng), position(rng), position(rng));
+        auto *model = ccnew scene::Model();
+        model->setNode(node);
+        model->setTransform(node);
+        const float halfSize = size(rng);
+        model->createBoundingShape(Vec3{-halfSize, -halfSize, -halfSize}, Vec3{halfSize, halfSize, halfSize});
+        model->updateTransform(0);
+        // some models are skipped by the query no matter where they are
+        model->setEnabled(i % 7 != 0);
+        model->setCastShadow(i % 3 == 0);
+        models.emplace_back(model);
+    }
+    return models;
+}
+
+void createFrustum(geometry::Frustum &frustum, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> position{-SCENE_EXTENT, SCENE_EXTENT};
+    std::uniform_real_distribution<float> angle{-180.F, 180.F};
+    Quaternion rotation;
+    Quaternion::fromEuler(angle(rng), angle(rng), angle(rng), &rotation);
+    Mat4 transform;
+    Mat4::fromRT(rotation, Vec3{position(rng), position(rng), position(rng)}, &transform);
+    frustum.setAccurate(true);
+    geometry::Frustum::createPerspective(&frustum, math::PI / 3.F, 16.F / 9.F, 1.F, SCENE_EXTENT, transform);
+}
+
+ResultList bruteForce(const ccstd::vector<scene::Model *> &live, const geometry::Frustum &frustum, bool isShadow) {
+    ResultList results;
+    for (const auto *model : live) {
+        if (model->isEnabled() && (!isShadow || model->isCastShadow()) && model->getWorldBounds()->aabbFrustum(frustum)) {
+            results.emplace_back(model);
+        }
+    }
+    std::sort(results.begin(), results.end());
+    return results;
+}
+
+ResultList query(const scene::BVH &bvh, const scene::Camera *camera, const geometry::Frustum &frustum, bool isShadow) {
+    ResultList results;
+    bvh.queryVisibility(camera, frustum, isShadow, results);
+    std::sort(results.begin(), results.end());
+    return results;
+}
+
+} // namespace
+
+// random inserts, removals and moves, every query has to match testing all models
+TEST(BVHTest, matchesBruteForce) {
+    std::mt19937 rng{7};
+    const auto models = createModels(6000, rng);
+    ccstd::vector<scene::Model *> idle;
+    for (const auto &model : models) {
+        idle.emplace_back(model);
+    }
+    ccstd::vector<scene::Model *> live;
+
+    scene::BVHInfo info;
+    info.setEnabled(true);
+    info.setLeafSize(4);
+    scene::BVH bvh;
+    bvh.initialize(info);
+
+    IntrusivePtr<scene::Camera> camera = ccnew scene::Camera(Root::getInstance()->getDevice());
+    std::uniform_real_distribution<float> offset{-60.F, 60.F};
+    geometry::Frustum frustum;
+    uint32_t visibleCount = 0;
+    for (uint32_t frame = 0; frame < 100; ++frame) {
+        // insert and remove so that both pending models and empty leaf slots are around
+        for (uint32_t i = 0; i < 80 && !idle.empty(); ++i) {
+            bvh.insert(idle.back());
+            live.emplace_back(idle.back());
+            idle.pop_back();
+        }
+        for (uint32_t i = 0; i < 20 && !live.empty(); ++i) {
+            const auto index = rng() % live.size();
+            bvh.remove(live[index]);
+            idle.insert(idle.begin(), live[index]);
+            live.erase(live.begin() + index);
+        }
+        for (size_t i = frame % 3; i < live.size(); i += 3) {
+            auto *bounds = live[i]->getWorldBounds();
+            bounds->setCenter(bounds->getCenter() + Vec3{offset(rng), offset(rng), offset(rng)});
+            bvh.update(live[i]);
+        }
+        bvh.commit();
+        // changes after the commit are seen by queries before the next one
+        for (uint32_t i = 0; i < 5 && !idle.empty(); ++i) {
+            bvh.insert(idle.back());
+            live.emplace_back(idle.back());
+            idle.pop_back();
+        }
+        for (uint32_t i = 0; i < 5 && !live.empty(); ++i) {
+            const auto index = rng() % live.size();
+            bvh.remove(live[index]);
+            idle.insert(idle.begin(), live[index]);
+            live.erase(live.begin() + index);
+        }
+        ASSERT_EQ(bvh.getModelCount(), live.size());
+
+        for (const bool isShadow : {false, true}) {
+            createFrustum(frustum, rng);
+            const auto expected = bruteForce(live, frustum, isShadow);
+            ASSERT_EQ(query(bvh, camera, frustum, isShadow), expected) << "frame " << frame;
+            visibleCount += static_cast<uint32_t>(expected.size());
+        }
+    }
+    EXPECT_GT(visibleCount, 0U);
+
+    for (auto *model : live) {
+        bvh.remove(model);
+    }
+    EXPECT_EQ(bvh.getModelCount(), 0U);
+}
+
+TEST(BVHTest, enableAndDisable) {
+    std::mt19937 rng{11};
+    const auto models = createModels(100, rng);
+
+    scene::BVHInfo info;
+    scene::BVH bvh;
+    info.activate(&bvh);
+    EXPECT_FALSE(bvh.isEnabled());
+    const auto generation = bvh.getGeneration();
+
+    // the scene inserts its models again when it sees a new generation
+    info.setEnabled(true);
+    EXPECT_TRUE(bvh.isEnabled());
+    EXPECT_NE(bvh.getGeneration(), generation);
+    for (const auto &model : models) {
+        bvh.insert(model);
+    }
+    bvh.commit();
+    EXPECT_EQ(bvh.getModelCount(), models.size());
+
+    // a disabled tree forgets its models, removal would not reach it anymore
+    info.setEnabled(false);
+    EXPECT_EQ(bvh.getModelCount(), 0U);
+    EXPECT_EQ(bvh.getNodeCount(), 0U);
+    for (const auto &model : models) {
+        EXPECT_EQ(model->getBVHIndex(), scene::BVH::INVALID_INDEX);
+    }
+}